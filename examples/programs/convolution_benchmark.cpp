@@ -0,0 +1,112 @@
+#include <sys/stat.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <complex>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+
+// contour library headers
+#include "cntr/cntr.hpp"
+#include "cntr/utils/read_inputfile.hpp"
+
+using namespace std;
+
+#define cplx std::complex<double>
+#define GREEN cntr::herm_matrix<double>
+// -----------------------------------------------------------------------
+// Timing of convolution_timestep at time step nt for the elementwise sums
+// (SIZE1=LARGESIZE) and for the matrix-product path, as a function of size1.
+// The crossover determines CNTR_CONVOLUTION_GEMM_SIZE.
+// -----------------------------------------------------------------------
+double time_convolution(int nt, GREEN &C, GREEN &A, GREEN &B, integration::Integrator<double> &I,
+                        double beta, double h, int nrep, bool gemm){
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  std::chrono::duration<double> elapsed;
+  start = std::chrono::system_clock::now();
+  for(int irep=0; irep<nrep; irep++){
+    if(gemm){
+      cntr::convolution_timestep_ret_gemm<double,GREEN>(nt,C,A,A,B,B,I,h);
+      cntr::convolution_timestep_tv_gemm<double,GREEN>(nt,C,A,A,B,B,I,beta,h);
+      cntr::convolution_timestep_les_gemm<double,GREEN>(nt,C,A,A,B,B,I,beta,h);
+    }else{
+      cntr::convolution_timestep_ret<double,GREEN,LARGESIZE>(nt,C,A,A,B,B,I,h);
+      cntr::convolution_timestep_tv<double,GREEN,LARGESIZE>(nt,C,A,A,B,B,I,beta,h);
+      cntr::convolution_timestep_les<double,GREEN,LARGESIZE>(nt,C,A,A,B,B,I,beta,h);
+    }
+  }
+  end = std::chrono::system_clock::now();
+  elapsed = end - start;
+  return elapsed.count()/nrep;
+}
+
+//==============================================================================
+//         main program
+//==============================================================================
+int main(int argc,char *argv[]){
+  const double beta = 10.0;
+  const double mu = 0.0;
+  const int sizes[] = {2, 3, 4, 6, 8, 12, 16, 24, 32};
+  const int nsizes = 9;
+  //..................................................
+  //                input
+  //..................................................
+  int Nt,Ntau,SolveOrder,nrep;
+  double h;
+  //..................................................
+  try{
+    //============================================================================
+    //                          (II) READ INPUT
+    //============================================================================
+    {
+      if(argc<3) throw("COMMAND LINE ARGUMENT MISSING");
+
+      find_param(argv[1],"__Nt=",Nt);
+      find_param(argv[1],"__Ntau=",Ntau);
+      find_param(argv[1],"__h=",h);
+      find_param(argv[1],"__SolveOrder=",SolveOrder);
+      find_param(argv[1],"__nrep=",nrep);
+    }
+
+    {
+      ofstream fout;
+      integration::Integrator<double> I(SolveOrder);
+      std::complex<double> iu(0.0,1.0);
+      double t_elem, t_gemm;
+
+      fout.open(argv[2]);
+      fout << "# size1  t_element[s]  t_gemm[s]  speedup" << endl;
+      cout << "# size1  t_element[s]  t_gemm[s]  speedup" << endl;
+      for(int is=0; is<nsizes; is++){
+        int size1=sizes[is];
+        cdmatrix eps_a(size1,size1), eps_b(size1,size1);
+        GREEN A(Nt,Ntau,size1,-1), B(Nt,Ntau,size1,-1), C(Nt,Ntau,size1,-1);
+        for(int i=0; i<size1; i++){
+          for(int j=0; j<size1; j++){
+            eps_a(i,j) = (i==j ? 0.3*i-1.0 : 0.1/(1.0+i+j) + iu*0.05*(double)(i-j));
+            eps_b(i,j) = (i==j ? 0.5-0.2*i : 0.2/(1.0+i*j) - iu*0.03*(double)(i-j));
+          }
+        }
+        cntr::green_from_H(A,mu,eps_a,beta,h);
+        cntr::green_from_H(B,mu,eps_b,beta,h);
+
+        t_elem = time_convolution(Nt,C,A,B,I,beta,h,nrep,false);
+        t_gemm = time_convolution(Nt,C,A,B,I,beta,h,nrep,true);
+        fout << setw(6) << size1 << "  " << t_elem << "  " << t_gemm << "  " << t_elem/t_gemm << endl;
+        cout << setw(6) << size1 << "  " << t_elem << "  " << t_gemm << "  " << t_elem/t_gemm << endl;
+      }
+      fout.close();
+    }
+
+  } // try
+  catch(char *message){
+    cerr << "exception\n**** " << message << " ****" << endl;
+    cerr << " No input file found. Exiting ... " << endl;
+  }
+  catch(...){
+    cerr << " No input file found. Exiting ... " << endl;
+  }
+  return 0;
+}
+//==============================================================================
@@ -390,29 +390,36 @@ int main(int argc,char *argv[]){
         diag::extrapolate_timestep_W(tstp-1,Nk_rank,SolverOrder,Nt,corrK_rank);
         // Corrector
         for (int iter=0; iter < CorrectorSteps; iter++){
-          // Gather propagators
-          diag::gather_gk_timestep(tstp,Nk_rank,gk_all_timesteps,corrK_rank,kindex_rank);
-          diag::gather_wk_timestep(tstp,Nk_rank,wk_all_timesteps,corrK_rank,kindex_rank);
+          // Gather propagators, the exchange of W overlaps with the mean field
+          diag::gather_gk_timestep(tstp,Nk_rank,gk_all_timesteps,corrK_rank,kindex_rank,false);
+          diag::gather_wk_timestep(tstp,Nk_rank,wk_all_timesteps,corrK_rank,kindex_rank,false);
+          gk_all_timesteps.mpi_wait();
 
           diag::set_density_k(tstp,Norb,gk_all_timesteps,lattice,density_k,kindex_rank,rho_loc);          
           if(tid==tid_root){
             diag::get_loc(tstp,Ntau,Norb,lattice,Gloc,gk_all_timesteps);
-            diag::get_loc(tstp,Ntau,Norb,lattice,Wloc,wk_all_timesteps);
           }
-	        // update mean field and SigmaGW
+	        // update mean field
           for(int k=0;k<Nk_rank;k++){
             diag::sigma_Hartree(tstp,Norb,corrK_rank[k].SHartree_,lattice,density_k,vertex,Ut);
             diag::sigma_Fock(tstp,Norb,kindex_rank[k],corrK_rank[k].SFock_,lattice,density_k,vertex,Ut);
+          }
+          wk_all_timesteps.mpi_wait();
+          if(tid==tid_root){
+            diag::get_loc(tstp,Ntau,Norb,lattice,Wloc,wk_all_timesteps);
+          }
+	        // update SigmaGW
+          for(int k=0;k<Nk_rank;k++){
             diag::sigma_GW(tstp,kindex_rank[k],corrK_rank[k].Sigma_,gk_all_timesteps,wk_all_timesteps,lattice,Ntau,Norb);
           }
           // Solve dyson, update polarization and solve two particle self-consistency
+          // the k points are independent and are solved as one batch
           double err_ele=0.0,err_bos=0.0;
+          err_ele = diag::step_dyson_batch(tstp,iter,Nk_rank,SolverOrder,corrK_rank,lattice);
           for(int k=0;k<Nk_rank;k++){
-            err_ele += corrK_rank[k].step_dyson_with_error(tstp,iter,SolverOrder,lattice);
             diag::get_Polarization_Bubble(tstp,Norb,Ntau,kindex_rank[k],corrK_rank[k].P_,gk_all_timesteps,lattice);
-            err_bos += corrK_rank[k].step_W_with_error(tstp,iter,SolverOrder,lattice);
-
           }
+          err_bos = diag::step_W_batch(tstp,Nk_rank,SolverOrder,corrK_rank);
           MPI_Allreduce(MPI_IN_PLACE,&err_ele,1,MPI_DOUBLE_PRECISION,MPI_SUM,MPI_COMM_WORLD);
           MPI_Allreduce(MPI_IN_PLACE,&err_bos,1,MPI_DOUBLE_PRECISION,MPI_SUM,MPI_COMM_WORLD);
     
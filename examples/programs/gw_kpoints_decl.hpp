@@ -38,6 +38,8 @@ namespace gw{
     void init_G_mat_nointeraction(lattice_1d_1b &latt,int SolverOrder);
     void set_hk(int tstp,int iter,lattice_1d_1b &latt);
     void set_vertex(int tstp,lattice_1d_1b &latt);    
+    void set_hkeff(int tstp,int iter,lattice_1d_1b &latt);
+    void set_PV_VP(int tstp,int SolverOrder);
     void write_to_hdf5(hid_t group_id);
     void write_to_hdf5(const char *filename);
     void write_to_hdf5_slices(hid_t group_id,int h,int tid);
@@ -112,14 +112,11 @@ namespace gw{
     
   }
 
-  void kpoint::step_W(int tstp,int SolverOrder,lattice_1d_1b &latt){
-    // solve W = V + V*Pi*W, assuming P is set on all relevant timesteps
+  void kpoint::set_PV_VP(int tstp,int SolverOrder){
+    // set PV=-P*V etc., assuming P is set on all relevant timesteps
     int n;
     int n1=(tstp==-1 || tstp>SolverOrder ? tstp : 0);
     int n2=(tstp==-1 || tstp>SolverOrder ? tstp : SolverOrder);   
-    //for(n=n1;n<=n2;n++) chi_.set_timestep(n,P_);
-    //return;
-    // set PV=-P*V etc.
     for(n=n1;n<=n2;n++){
       PV_.set_timestep(n,P_);
       PV_.right_multiply(n,vertex_);
@@ -128,6 +125,11 @@ namespace gw{
       VP_.left_multiply(n,vertex_);
       VP_.smul(n,-1.0);
     }
+  }
+
+  void kpoint::step_W(int tstp,int SolverOrder,lattice_1d_1b &latt){
+    // solve W = V + V*Pi*W, assuming P is set on all relevant timesteps
+    set_PV_VP(tstp,SolverOrder);
     // solve [1-UP]*W=U
     CFUNC tmpFsin(nt_,nrpa_);
     tmpFsin.set_zero();
@@ -136,23 +138,24 @@ namespace gw{
     cntr::vie2_timestep_sin(tstp,W_,vertex_,VP_,PV_,tmpFsin,Q,vertex_,beta_,h_,SolverOrder);
   }
 
+  void kpoint::set_hkeff(int tstp,int iter,lattice_1d_1b &latt){
+    // set hkeff=hk+Hartree+Fock+Symmetry breaking
+    cdmatrix tmp,tmp1,tmp2;
+    set_hk(tstp,iter,latt);
+    SHartree_.get_value(tstp,tmp);
+    SFock_.get_value(tstp,tmp1);
+    tmp+=tmp1;
+    hk_.get_value(tstp,tmp2);
+    tmp+=tmp2;
+    hkeff_.set_value(tstp,tmp);
+  }
+
   void kpoint::step_dyson(int tstp,int iter,int SolverOrder,lattice_1d_1b &latt){
     // solve G=(-idt+mu-hk-Hartree-Fock-Sigma)^{-1}, assuming Sigma is set
     int n;
     int n1=(tstp==-1 || tstp>SolverOrder ? tstp : 0);
     int n2=(tstp==-1 || tstp>SolverOrder ? tstp : SolverOrder);   
-    // set hkeff=hk+Hartree+Fock+Symmetry breaking
-    for(n=n1;n<=n2;n++){
-      cdmatrix tmp,tmp1,tmp2,rtmp(nrpa_,nrpa_);
-      set_hk(n,iter,latt);
-      SHartree_.get_value(n,tmp);
-      SFock_.get_value(n,tmp1);
-      tmp+=tmp1;
-      hk_.get_value(n,tmp2);
-      
-      tmp+=tmp2;
-      hkeff_.set_value(n,tmp);
-    }
+    for(n=n1;n<=n2;n++) set_hkeff(n,iter,latt);
     
     // solve Dyson
     if(tstp==-1 && iter==1){
@@ -17,9 +17,9 @@ using namespace cntr;
 namespace diag {
 	void init_G_mat_nointeraction(int Nk_rank,std::vector<gw::kpoint> &corrK_rank,lattice_1d_1b &lattice,int SolverOrder);
 	void gather_gk_timestep(int tstp,int Nk_rank,DIST_TIMESTEP &gk_all_timesteps, std::vector<gw::kpoint> &corrK_rank,
-		std::vector<int> &kindex_rank);
+		std::vector<int> &kindex_rank,bool wait=true);
 	void gather_wk_timestep(int tstp,int Nk_rank,DIST_TIMESTEP &wk_all_timesteps, std::vector<gw::kpoint> &corrK_rank,
-		std::vector<int> &kindex_rank);
+		std::vector<int> &kindex_rank,bool wait=true);
 	void set_density_k(int tstp, int Norb,DIST_TIMESTEP &gk_all_timesteps,lattice_1d_1b &lattice,std::vector<CFUNC> & density_k,std::vector<int> &kindex_rank,CFUNC &rho_loc);
 	void get_loc(int tstp,int Ntau,int Norb,lattice_1d_1b &lattice,GREEN &Gloc,DIST_TIMESTEP &gk_all_timesteps);
 	void sigma_Hartree(int tstp,int Norb,CFUNC &S,lattice_1d_1b &lattice,std::vector<CFUNC> &density_k,std::vector<CFUNC> &vertex,CFUNC &Ut);
@@ -30,6 +30,8 @@ namespace diag {
 	void extrapolate_timestep_W(int tstp,int Nk_rank,int SolverOrder,int Nt,std::vector<gw::kpoint> &corrK_rank);
 	void extrapolate_timestep_G(int tstp,int Nk_rank,int SolverOrder,int Nt,std::vector<gw::kpoint> &corrK_rank);
 	void extrapolate_rho(int tstp,int Nk,std::vector<CFUNC> &density_k);
+	double step_dyson_batch(int tstp,int iter,int Nk_rank,int SolverOrder,std::vector<gw::kpoint> &corrK_rank,lattice_1d_1b &lattice);
+	double step_W_batch(int tstp,int Nk_rank,int SolverOrder,std::vector<gw::kpoint> &corrK_rank);
 	double KineticEnergy(int tstp,lattice_1d_1b &lattice,std::vector<CFUNC> & density_k);
 	double current(int tstp,lattice_1d_1b &lattice,std::vector<CFUNC> & density_k);
 	double CorrelationEnergy(int tstp,int Nk_rank,int SolverOrder,double beta, double h,std::vector<gw::kpoint> &corrK_rank,std::vector<int> &kindex_rank,lattice_1d_1b &lattice);
@@ -15,7 +15,8 @@ namespace diag {
    }
 
    // update fermionic propagators via MPI
-   void gather_gk_timestep(int tstp,int Nk_rank,DIST_TIMESTEP &gk_all_timesteps,std::vector<gw::kpoint> &corrK_rank,std::vector<int> &kindex_rank){
+   // with wait=false the communication is only started, and gk_all_timesteps.mpi_wait() has to be called before gk_all_timesteps is used
+   void gather_gk_timestep(int tstp,int Nk_rank,DIST_TIMESTEP &gk_all_timesteps,std::vector<gw::kpoint> &corrK_rank,std::vector<int> &kindex_rank,bool wait){
       gk_all_timesteps.reset_tstp(tstp);
       for(int k=0;k<Nk_rank;k++){
          gk_all_timesteps.G()[kindex_rank[k]].get_data(corrK_rank[k].G_);
@@ -23,17 +24,25 @@ namespace diag {
       cdmatrix tmp;
       gk_all_timesteps.G()[0].density_matrix(tstp,tmp);
    // distribute to all nodes
-      gk_all_timesteps.mpi_bcast_all();
+      if(wait){
+         gk_all_timesteps.mpi_bcast_all();
+      }else{
+         gk_all_timesteps.mpi_start_bcast_all();
+      }
    }
 
    // update bosonic propagators via MPI
-   void gather_wk_timestep(int tstp,int Nk_rank,DIST_TIMESTEP &wk_all_timesteps,std::vector<gw::kpoint> &corrK_rank,std::vector<int> &kindex_rank){
+   void gather_wk_timestep(int tstp,int Nk_rank,DIST_TIMESTEP &wk_all_timesteps,std::vector<gw::kpoint> &corrK_rank,std::vector<int> &kindex_rank,bool wait){
       wk_all_timesteps.reset_tstp(tstp);
       for(int k=0;k<Nk_rank;k++){
          wk_all_timesteps.G()[kindex_rank[k]].get_data(corrK_rank[k].W_);
       }
    // distribute to all nodes
-      wk_all_timesteps.mpi_bcast_all();
+      if(wait){
+         wk_all_timesteps.mpi_bcast_all();
+      }else{
+         wk_all_timesteps.mpi_start_bcast_all();
+      }
    }
 
    // set densities
@@ -211,6 +220,61 @@ namespace diag {
       }
    }
 
+   //Solve the Dyson equation for all k points at a time step tstp>SolverOrder, returns the change of G
+   double step_dyson_batch(int tstp,int iter,int Nk_rank,int SolverOrder,std::vector<gw::kpoint> &corrK_rank,lattice_1d_1b &lattice){
+      assert(tstp>SolverOrder);
+      double err=0.0;
+      std::vector<GREEN_TSTP> gtmp(Nk_rank);
+      std::vector<GREEN*> G(Nk_rank),Sigma(Nk_rank);
+      std::vector<CFUNC*> hkeff(Nk_rank);
+      for(int k=0;k<Nk_rank;k++){
+         corrK_rank[k].G_.get_timestep(tstp,gtmp[k]);
+         corrK_rank[k].set_hkeff(tstp,iter,lattice);
+         G[k]=&corrK_rank[k].G_;
+         Sigma[k]=&corrK_rank[k].Sigma_;
+         hkeff[k]=&corrK_rank[k].hkeff_;
+      }
+      if(Nk_rank>0){
+         cntr::dyson_timestep_batch(tstp,G,corrK_rank[0].mu_,hkeff,Sigma,corrK_rank[0].beta_,corrK_rank[0].h_,SolverOrder);
+      }
+      for(int k=0;k<Nk_rank;k++){
+         corrK_rank[k].get_Density_matrix(tstp);
+         err+=cntr::distance_norm2(tstp,gtmp[k],corrK_rank[k].G_);
+      }
+      return err;
+   }
+
+   //Solve [1-VP]*W=V for all k points at a time step tstp>SolverOrder, returns the change of W
+   double step_W_batch(int tstp,int Nk_rank,int SolverOrder,std::vector<gw::kpoint> &corrK_rank){
+      assert(tstp>SolverOrder);
+      double err=0.0;
+      std::vector<GREEN_TSTP> wtmp(Nk_rank);
+      std::vector<GREEN*> W(Nk_rank),VP(Nk_rank),PV(Nk_rank),Q(Nk_rank);
+      std::vector<CFUNC*> vertex(Nk_rank),Fsin(Nk_rank);
+      if(Nk_rank==0) return err;
+      int nt=corrK_rank[0].nt_,ntau=corrK_rank[0].ntau_,nrpa=corrK_rank[0].nrpa_;
+      // the source and the singular part of the kernel vanish, and are only read by the solver
+      CFUNC zeroFsin(nt,nrpa);
+      zeroFsin.set_zero();
+      GREEN zeroQ(nt,ntau,nrpa,BOSON);
+      for(int k=0;k<Nk_rank;k++){
+         wtmp[k]=GREEN_TSTP(tstp,ntau,nrpa,nrpa,BOSON);
+         corrK_rank[k].W_.get_timestep(tstp,wtmp[k]);
+         corrK_rank[k].set_PV_VP(tstp,SolverOrder);
+         W[k]=&corrK_rank[k].W_;
+         VP[k]=&corrK_rank[k].VP_;
+         PV[k]=&corrK_rank[k].PV_;
+         Q[k]=&zeroQ;
+         vertex[k]=&corrK_rank[k].vertex_;
+         Fsin[k]=&zeroFsin;
+      }
+      cntr::vie2_timestep_sin_batch(tstp,W,vertex,VP,PV,Fsin,Q,vertex,corrK_rank[0].beta_,corrK_rank[0].h_,SolverOrder);
+      for(int k=0;k<Nk_rank;k++){
+         err+=cntr::distance_norm2(tstp,wtmp[k],corrK_rank[k].W_);
+      }
+      return err;
+   }
+
    //Evaluate the kinetic energy
    double KineticEnergy(int tstp,lattice_1d_1b &lattice,std::vector<CFUNC> & density_k){
       cdmatrix rtmp,hktmp;
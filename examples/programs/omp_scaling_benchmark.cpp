@@ -0,0 +1,135 @@
+#include <sys/stat.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <complex>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+
+// contour library headers
+#include "cntr/cntr.hpp"
+#include "cntr/utils/read_inputfile.hpp"
+
+using namespace std;
+
+#define cplx std::complex<double>
+#define GREEN cntr::herm_matrix<double>
+#define CFUNC cntr::function<double>
+// -----------------------------------------------------------------------
+// Strong scaling of convolution_timestep_omp and dyson_timestep_omp at time
+// step nt with 1, 2, 4, ... up to nthreads_max threads (at most 64). The rows
+// of ret, tv and les are distributed over the threads by a cost model, see
+// cntr_omp_schedule.hpp.
+// -----------------------------------------------------------------------
+#ifdef CNTR_USE_OMP
+double time_convolution(int nthreads, int nt, GREEN &C, GREEN &A, GREEN &B,
+                        integration::Integrator<double> &I, double beta, double h, int nrep){
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  std::chrono::duration<double> elapsed;
+  start = std::chrono::system_clock::now();
+  for(int irep=0; irep<nrep; irep++){
+    cntr::convolution_timestep_omp(nthreads,nt,C,A,A,B,B,I,beta,h);
+  }
+  end = std::chrono::system_clock::now();
+  elapsed = end - start;
+  return elapsed.count()/nrep;
+}
+
+double time_dyson(int nthreads, int nt, GREEN &G, double mu, CFUNC &H, GREEN &Sigma,
+                  integration::Integrator<double> &I, double beta, double h, int nrep){
+  std::chrono::time_point<std::chrono::system_clock> start, end;
+  std::chrono::duration<double> elapsed;
+  start = std::chrono::system_clock::now();
+  for(int irep=0; irep<nrep; irep++){
+    cntr::dyson_timestep_omp(nthreads,nt,G,mu,H,Sigma,I,beta,h);
+  }
+  end = std::chrono::system_clock::now();
+  elapsed = end - start;
+  return elapsed.count()/nrep;
+}
+#endif // CNTR_USE_OMP
+
+//==============================================================================
+//         main program
+//==============================================================================
+int main(int argc,char *argv[]){
+  const double beta = 10.0;
+  const double mu = 0.0;
+  //..................................................
+  //                input
+  //..................................................
+  int Nt,Ntau,size1,SolveOrder,nrep,nthreads_max;
+  double h;
+  //..................................................
+  try{
+    //============================================================================
+    //                          (II) READ INPUT
+    //============================================================================
+    {
+      if(argc<3) throw("COMMAND LINE ARGUMENT MISSING");
+
+      find_param(argv[1],"__Nt=",Nt);
+      find_param(argv[1],"__Ntau=",Ntau);
+      find_param(argv[1],"__size1=",size1);
+      find_param(argv[1],"__h=",h);
+      find_param(argv[1],"__SolveOrder=",SolveOrder);
+      find_param(argv[1],"__nrep=",nrep);
+      find_param(argv[1],"__nthreads_max=",nthreads_max);
+    }
+
+#ifdef CNTR_USE_OMP
+    {
+      ofstream fout;
+      integration::Integrator<double> I(SolveOrder);
+      std::complex<double> iu(0.0,1.0);
+      cdmatrix eps_a(size1,size1), eps_b(size1,size1);
+      GREEN A(Nt,Ntau,size1,-1), B(Nt,Ntau,size1,-1), C(Nt,Ntau,size1,-1), G;
+      CFUNC H(Nt,size1);
+      double t_conv1=0.0, t_dyson1=0.0, t_conv, t_dyson;
+
+      for(int i=0; i<size1; i++){
+        for(int j=0; j<size1; j++){
+          eps_a(i,j) = (i==j ? 0.3*i-1.0 : 0.1/(1.0+i+j) + iu*0.05*(double)(i-j));
+          eps_b(i,j) = (i==j ? 0.5-0.2*i : 0.2/(1.0+i*j) - iu*0.03*(double)(i-j));
+        }
+      }
+      // A: free Green's function, B: weak self-energy
+      cntr::green_from_H(A,mu,eps_a,beta,h);
+      cntr::green_from_H(B,mu,eps_b,beta,h);
+      for(int tstp=-1; tstp<=Nt; tstp++) B.smul(tstp,0.04);
+      H.set_constant(eps_a);
+      G = A;
+
+      fout.open(argv[2]);
+      fout << "# threads  t_conv[s]  speedup  t_dyson[s]  speedup" << endl;
+      cout << "# threads  t_conv[s]  speedup  t_dyson[s]  speedup" << endl;
+      for(int nthreads=1; nthreads<=nthreads_max && nthreads<=64; nthreads*=2){
+        t_conv = time_convolution(nthreads,Nt,C,A,B,I,beta,h,nrep);
+        t_dyson = time_dyson(nthreads,Nt,G,mu,H,B,I,beta,h,nrep);
+        if(nthreads==1){
+          t_conv1 = t_conv;
+          t_dyson1 = t_dyson;
+        }
+        fout << setw(9) << nthreads << "  " << t_conv << "  " << t_conv1/t_conv << "  "
+             << t_dyson << "  " << t_dyson1/t_dyson << endl;
+        cout << setw(9) << nthreads << "  " << t_conv << "  " << t_conv1/t_conv << "  "
+             << t_dyson << "  " << t_dyson1/t_dyson << endl;
+      }
+      fout.close();
+    }
+#else
+    cerr << " Compiled without OpenMP (CNTR_USE_OMP). Exiting ... " << endl;
+#endif // CNTR_USE_OMP
+
+  } // try
+  catch(char *message){
+    cerr << "exception\n**** " << message << " ****" << endl;
+    cerr << " No input file found. Exiting ... " << endl;
+  }
+  catch(...){
+    cerr << " No input file found. Exiting ... " << endl;
+  }
+  return 0;
+}
+//==============================================================================
@@ -46,6 +46,18 @@ template void convolution_timestep<double>(int n,herm_matrix<double> &C,herm_mat
 template void convolution<double>(herm_matrix<double> &C,herm_matrix<double> &A,herm_matrix<double> &Acc,
 	function<double> &ft, herm_matrix<double> &B,herm_matrix<double> &Bcc, double beta,double h, int SolveOrder);
 
+// single and mixed precision
+template void convolution_timestep<float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,herm_matrix<float> &Acc,
+	herm_matrix<float> &B, herm_matrix<float> &Bcc, integration::Integrator<float> &I, float beta,float h);
+template void convolution_timestep<float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,herm_matrix<float> &Acc,
+	herm_matrix<float> &B, herm_matrix<float> &Bcc, float beta,float h, int SolveOrder);
+template void convolution_timestep<float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,herm_matrix<float> &B,
+	float beta,float h, int SolveOrder);
+template void convolution_timestep_mixed<double,float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,
+	herm_matrix<float> &Acc,herm_matrix<float> &B,herm_matrix<float> &Bcc, double beta,double h, int SolveOrder);
+template void convolution_timestep_mixed<double,float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,
+	herm_matrix<float> &B, double beta,double h, int SolveOrder);
+
 template void convolution_density_matrix<double, herm_matrix<double> >(int tstp,cdmatrix &rho,herm_matrix<double> &A,
 	herm_matrix<double> &Acc, function<double> &ft,herm_matrix<double> &B,herm_matrix<double> &Bcc, double beta,double h, int SolveOrder);
 template void convolution_density_matrix<double, herm_matrix<double> >(int tstp,cdmatrix &rho,herm_matrix<double> &A,
@@ -59,6 +71,23 @@ template
   void convolution_les_timediag<double, herm_matrix<double> >(int tstp, cdmatrix &Cles, herm_matrix<double> &A, herm_matrix<double> &B,
                                 integration::Integrator<double> &I, double beta, double h);
   
+// fixed-size kernels for the element sizes of CNTR_SIZE1_DISPATCH
+#define CNTR_CONVOLUTION_KERNELS(SIZE1)                                                                    \
+  template                                                                                                 \
+  void convolution_timestep_ret<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &C,         \
+        herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix<double> &B,                          \
+        herm_matrix<double> &Bcc, integration::Integrator<double> &I, double h);                           \
+  template                                                                                                 \
+  void convolution_timestep_tv<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &C,          \
+        herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix<double> &B,                          \
+        herm_matrix<double> &Bcc, integration::Integrator<double> &I, double beta, double h);              \
+  template                                                                                                 \
+  void convolution_timestep_les<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &C,         \
+        herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix<double> &B,                          \
+        herm_matrix<double> &Bcc, integration::Integrator<double> &I, double beta, double h);
+  CNTR_SIZE1_FOR_EACH(CNTR_CONVOLUTION_KERNELS)
+#undef CNTR_CONVOLUTION_KERNELS
+
 #ifdef CNTR_USE_OMP
 
 
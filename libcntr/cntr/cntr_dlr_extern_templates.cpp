@@ -0,0 +1,9 @@
+#include "cntr_dlr_extern_templates.hpp"
+#include "cntr_dlr_impl.hpp"
+
+namespace cntr {
+
+template class dlr_basis<double>;
+template class herm_matrix_dlr<double>;
+
+}  // namespace cntr
@@ -0,0 +1,25 @@
+#include "cntr_dlr_solvers_extern_templates.hpp"
+#include "cntr_dlr_solvers_impl.hpp"
+
+namespace cntr {
+
+template void convolution_mat_dlr<double>(herm_matrix_dlr<double> &C,
+  herm_matrix_dlr<double> &A, herm_matrix_dlr<double> &B, dlr_basis<double> &basis);
+template void convolution_timestep_tv_dlr<double>(int n, herm_matrix_dlr<double> &C,
+  herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix_dlr<double> &Ad,
+  herm_matrix_dlr<double> &Bd, integration::Integrator<double> &I, double h,
+  dlr_basis<double> &basis);
+template void convolution_timestep_tv_dlr<double>(int n, herm_matrix_dlr<double> &C,
+  herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix_dlr<double> &Ad,
+  herm_matrix_dlr<double> &Bd, double h, dlr_basis<double> &basis, int SolveOrder);
+template void convolution_timestep_les_tvvt_dlr<double>(int n, int j1, int j2,
+  std::complex<double> *cles, herm_matrix_dlr<double> &A, herm_matrix_dlr<double> &Bcc,
+  dlr_basis<double> &basis);
+template void dyson_mat_dlr<double>(herm_matrix_dlr<double> &G, double mu,
+  function<double> &H, herm_matrix_dlr<double> &Sigma, dlr_basis<double> &basis,
+  const bool force_hermitian);
+template void vie2_mat_dlr<double>(herm_matrix_dlr<double> &G, herm_matrix_dlr<double> &F,
+  herm_matrix_dlr<double> &Q, dlr_basis<double> &basis);
+
+}  // namespace cntr
+
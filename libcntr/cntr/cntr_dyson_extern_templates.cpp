@@ -41,7 +41,7 @@ namespace cntr {
   			   integration::Integrator<double> &I, double beta,double h);
   template
   void dyson_timestep<double>(int n,herm_matrix<double> &G,double mu,function<double> &H, herm_matrix<double> &Sigma,
-  			      integration::Integrator<double> &I, double beta,double h);
+  			      integration::Integrator<double> &I, double beta,double h, dyson_workspace<double> &ws);
   template
   void dyson<double>(herm_matrix<double> &G,double mu,function<double> &H, herm_matrix<double> &Sigma,
   		     integration::Integrator<double> &I, double beta,double h, const int matsubara_method,
@@ -67,9 +67,44 @@ namespace cntr {
   void dyson_timestep<double>(int n, herm_matrix<double> &G, double mu, function<double> &H, herm_matrix<double> &Sigma, double beta, double h, 
     const int SolveOrder);
 
+ template
+  void dyson_timestep<double>(int n, herm_matrix<double> &G, double mu, function<double> &H, herm_matrix<double> &Sigma, double beta, double h,
+    dyson_workspace<double> &ws, const int SolveOrder);
+
+ template
+  void dyson_timestep_batch<double>(int n, std::vector<herm_matrix<double> *> &G, double mu,
+    std::vector<function<double> *> &H, std::vector<herm_matrix<double> *> &Sigma, double beta, double h,
+    const int SolveOrder);
+
+ // single precision
+ template
+  void dyson_timestep<float>(int n, herm_matrix<float> &G, float mu, function<float> &H, herm_matrix<float> &Sigma, float beta, float h,
+    const int SolveOrder);
+
+ template
+  void dyson_timestep<float>(int n, herm_matrix<float> &G, float mu, function<float> &H, herm_matrix<float> &Sigma, float beta, float h,
+    dyson_workspace<float> &ws, const int SolveOrder);
+
  template
   void dyson<double>(herm_matrix<double> &G, double mu, function<double> &H, herm_matrix<double> &Sigma, double beta, double h, 
     const int SolveOrder, const int matsubara_method,
     const bool force_hermitian);
 
+// fixed-size kernels for the element sizes of CNTR_SIZE1_DISPATCH
+#define CNTR_DYSON_KERNELS(SIZE1)                                                                          \
+  template                                                                                                 \
+  void dyson_timestep_ret<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &G, double mu,    \
+        std::complex<double> *H, herm_matrix<double> &Sigma, integration::Integrator<double> &I,           \
+        double h, dyson_workspace<double> &ws);                                                            \
+  template                                                                                                 \
+  void dyson_timestep_tv<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &G, double mu,     \
+        std::complex<double> *Hn, herm_matrix<double> &Sigma, integration::Integrator<double> &I,          \
+        double beta, double h, dyson_workspace<double> &ws);                                               \
+  template                                                                                                 \
+  void dyson_timestep_les<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &G, double mu,    \
+        std::complex<double> *H, herm_matrix<double> &Sigma, integration::Integrator<double> &I,           \
+        double beta, double h, dyson_workspace<double> &ws);
+  CNTR_SIZE1_FOR_EACH(CNTR_DYSON_KERNELS)
+#undef CNTR_DYSON_KERNELS
+
 }  // namespace cntr
@@ -0,0 +1,9 @@
+#include "cntr_dyson_workspace_extern_templates.hpp"
+#include "cntr_dyson_workspace_impl.hpp"
+
+namespace cntr {
+
+template class dyson_workspace<double>;
+template class dyson_workspace<float>;
+
+}  // namespace cntr
@@ -0,0 +1,182 @@
+#include "cntr_elements_simd.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CNTR_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace cntr {
+
+typedef std::complex<double> cplx;
+
+element_simd_kernel element_simd_incr_table[CNTR_SIMD_MAXSIZE + 1];
+element_simd_kernel element_simd_mult_table[CNTR_SIMD_MAXSIZE + 1];
+
+#ifdef CNTR_SIMD_X86
+
+/* #######################################################################################
+#
+#   The rows of z are accumulated as z(i,:) = sum_l a(i,l) z2(l,:), a = alpha*z1, with
+#   interleaved (re,im) storage: the real and imaginary part of a(i,l) are broadcast
+#   and multiplied with the row of z2 and with the row with swapped (re,im), into two
+#   separate accumulators. A final addsub gives (re*re-im*im, re*im+im*re).
+#
+########################################################################################*/
+/// @private
+template <int S, bool INCR>
+__attribute__((target("avx2,fma"))) static void
+element_kernel_avx2(cplx *z, cplx alpha, const cplx *z1, const cplx *z2) {
+    // S/2 full registers of two complex numbers, and one complex number for odd S
+    const int NV = S / 2;
+    const int NR = (NV > 0 ? NV : 1);
+    const double *b = reinterpret_cast<const double *>(z2);
+    double *c = reinterpret_cast<double *>(z);
+    __m256d re[NR], im[NR], ar, ai, x;
+    __m128d re1, im1, x1;
+    double a_re, a_im;
+    int i, l, v;
+    for (i = 0; i < S; i++) {
+        for (v = 0; v < NV; v++) {
+            re[v] = _mm256_setzero_pd();
+            im[v] = _mm256_setzero_pd();
+        }
+        re1 = _mm_setzero_pd();
+        im1 = _mm_setzero_pd();
+        for (l = 0; l < S; l++) {
+            a_re = alpha.real() * z1[i * S + l].real() - alpha.imag() * z1[i * S + l].imag();
+            a_im = alpha.real() * z1[i * S + l].imag() + alpha.imag() * z1[i * S + l].real();
+            ar = _mm256_set1_pd(a_re);
+            ai = _mm256_set1_pd(a_im);
+            for (v = 0; v < NV; v++) {
+                x = _mm256_loadu_pd(b + 2 * l * S + 4 * v);
+                re[v] = _mm256_fmadd_pd(ar, x, re[v]);
+                im[v] = _mm256_fmadd_pd(ai, _mm256_permute_pd(x, 0x5), im[v]);
+            }
+            if (S % 2) {
+                x1 = _mm_loadu_pd(b + 2 * l * S + 4 * NV);
+                re1 = _mm_fmadd_pd(_mm256_castpd256_pd128(ar), x1, re1);
+                im1 = _mm_fmadd_pd(_mm256_castpd256_pd128(ai), _mm_permute_pd(x1, 0x1), im1);
+            }
+        }
+        for (v = 0; v < NV; v++) {
+            x = _mm256_addsub_pd(re[v], im[v]);
+            if (INCR)
+                x = _mm256_add_pd(x, _mm256_loadu_pd(c + 2 * i * S + 4 * v));
+            _mm256_storeu_pd(c + 2 * i * S + 4 * v, x);
+        }
+        if (S % 2) {
+            x1 = _mm_addsub_pd(re1, im1);
+            if (INCR)
+                x1 = _mm_add_pd(x1, _mm_loadu_pd(c + 2 * i * S + 4 * NV));
+            _mm_storeu_pd(c + 2 * i * S + 4 * NV, x1);
+        }
+    }
+}
+
+/// @private
+template <int S, bool INCR>
+__attribute__((target("avx512f"))) static void
+element_kernel_avx512(cplx *z, cplx alpha, const cplx *z1, const cplx *z2) {
+    // four complex numbers per register, the last register of a row is masked
+    const int NV = (S + 3) / 4;
+    const int REM = S - 4 * (NV - 1);
+    const __mmask8 last = (__mmask8)((1 << (2 * REM)) - 1);
+    const double *b = reinterpret_cast<const double *>(z2);
+    double *c = reinterpret_cast<double *>(z);
+    const __m512d one = _mm512_set1_pd(1.0);
+    __m512d re[NV], im[NV], ar, ai, x;
+    __mmask8 mask;
+    double a_re, a_im;
+    int i, l, v;
+    for (i = 0; i < S; i++) {
+        for (v = 0; v < NV; v++) {
+            re[v] = _mm512_setzero_pd();
+            im[v] = _mm512_setzero_pd();
+        }
+        for (l = 0; l < S; l++) {
+            a_re = alpha.real() * z1[i * S + l].real() - alpha.imag() * z1[i * S + l].imag();
+            a_im = alpha.real() * z1[i * S + l].imag() + alpha.imag() * z1[i * S + l].real();
+            ar = _mm512_set1_pd(a_re);
+            ai = _mm512_set1_pd(a_im);
+            for (v = 0; v < NV; v++) {
+                mask = (v == NV - 1 ? last : (__mmask8)0xFF);
+                x = _mm512_maskz_loadu_pd(mask, b + 2 * l * S + 8 * v);
+                re[v] = _mm512_fmadd_pd(ar, x, re[v]);
+                im[v] = _mm512_fmadd_pd(ai, _mm512_permute_pd(x, 0x55), im[v]);
+            }
+        }
+        for (v = 0; v < NV; v++) {
+            mask = (v == NV - 1 ? last : (__mmask8)0xFF);
+            // (re - im, re + im) in the (even, odd) lanes
+            x = _mm512_fmaddsub_pd(one, re[v], im[v]);
+            if (INCR)
+                x = _mm512_add_pd(x, _mm512_maskz_loadu_pd(mask, c + 2 * i * S + 8 * v));
+            _mm512_mask_storeu_pd(c + 2 * i * S + 8 * v, mask, x);
+        }
+    }
+}
+
+/// @private
+template <int S>
+static void element_simd_set_kernels(int level) {
+    // a partially filled 512-bit register is slower than the AVX2 kernel
+    if (level == CNTR_SIMD_AVX512 && S >= 4 && S % 4 != 1 && S % 4 != 2) {
+        element_simd_incr_table[S] = &element_kernel_avx512<S, true>;
+        element_simd_mult_table[S] = &element_kernel_avx512<S, false>;
+    } else if (level >= CNTR_SIMD_AVX2) {
+        element_simd_incr_table[S] = &element_kernel_avx2<S, true>;
+        element_simd_mult_table[S] = &element_kernel_avx2<S, false>;
+    } else {
+        element_simd_incr_table[S] = NULL;
+        element_simd_mult_table[S] = NULL;
+    }
+}
+
+/// @private
+static int element_simd_cpu_level(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return CNTR_SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return CNTR_SIMD_AVX2;
+    return CNTR_SIMD_NONE;
+}
+
+#else  // CNTR_SIMD_X86
+
+template <int S>
+static void element_simd_set_kernels(int level) {
+    element_simd_incr_table[S] = NULL;
+    element_simd_mult_table[S] = NULL;
+}
+
+static int element_simd_cpu_level(void) {
+    return CNTR_SIMD_NONE;
+}
+
+#endif  // CNTR_SIMD_X86
+
+static int element_simd_current_level = element_simd_set_level(CNTR_SIMD_AVX512);
+
+int element_simd_level(void) {
+    return element_simd_current_level;
+}
+
+int element_simd_set_level(int level) {
+    int cpu = element_simd_cpu_level();
+    if (level > cpu)
+        level = cpu;
+    if (level < CNTR_SIMD_NONE)
+        level = CNTR_SIMD_NONE;
+    element_simd_set_kernels<2>(level);
+    element_simd_set_kernels<3>(level);
+    element_simd_set_kernels<4>(level);
+    element_simd_set_kernels<5>(level);
+    element_simd_set_kernels<6>(level);
+    element_simd_set_kernels<7>(level);
+    element_simd_set_kernels<8>(level);
+    element_simd_current_level = level;
+    return level;
+}
+
+}  // namespace cntr
@@ -12,4 +12,10 @@ namespace cntr {
   template void function<double>::set_matrixelement<Eigen::MatrixXcd>(int tstp,int i1,int i2,Eigen::MatrixXcd &M,int j1,int j2);
   //template void function<double>::set_matrixelement(int i1,int i2,function<double> &g,int j1,int j2);
 
+  // single precision
+  template class function<float>;
+
+  template void function<float>::set_value<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M);
+  template void function<float>::get_value<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M) const;
+
 }  // namespace cntr
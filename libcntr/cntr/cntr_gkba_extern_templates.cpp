@@ -0,0 +1,8 @@
+#include "cntr_gkba_extern_templates.hpp"
+#include "cntr_gkba_impl.hpp"
+
+namespace cntr {
+
+template class gkba<double>;
+
+}  // namespace cntr
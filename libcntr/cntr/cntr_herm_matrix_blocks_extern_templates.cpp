@@ -0,0 +1,34 @@
+#include "cntr_herm_matrix_blocks_extern_templates.hpp"
+#include "cntr_herm_matrix_blocks_impl.hpp"
+
+namespace cntr {
+
+template class herm_matrix_blocks<double>;
+template void herm_matrix_blocks<double>::density_matrix<Eigen::MatrixXcd>(int tstp, Eigen::MatrixXcd &M);
+
+template void convolution_timestep<double>(int n, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &Acc, herm_matrix_blocks<double> &B,
+  herm_matrix_blocks<double> &Bcc, double beta, double h, int SolveOrder);
+template void convolution_timestep<double>(int n, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &B, double beta, double h,
+  int SolveOrder);
+template void dyson_mat<double>(herm_matrix_blocks<double> &G, double mu, function<double> &H,
+  herm_matrix_blocks<double> &Sigma, double beta, const int SolveOrder, const int method,
+  const bool force_hermitian);
+template void dyson_start<double>(herm_matrix_blocks<double> &G, double mu, function<double> &H,
+  herm_matrix_blocks<double> &Sigma, double beta, double h, const int SolveOrder);
+template void dyson_timestep<double>(int n, herm_matrix_blocks<double> &G, double mu,
+  function<double> &H, herm_matrix_blocks<double> &Sigma, double beta, double h,
+  const int SolveOrder);
+template void Bubble1<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &Acc, herm_matrix_blocks<double> &B,
+  herm_matrix_blocks<double> &Bcc);
+template void Bubble1<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &B);
+template void Bubble2<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &Acc, herm_matrix_blocks<double> &B,
+  herm_matrix_blocks<double> &Bcc);
+template void Bubble2<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &B);
+
+}  // namespace cntr
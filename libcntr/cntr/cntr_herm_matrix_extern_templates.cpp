@@ -17,4 +17,18 @@ template void herm_matrix<double>::set_ret<Eigen::MatrixXcd>(int i, int j, Eigen
 template void herm_matrix<double>::set_tv<Eigen::MatrixXcd>(int i, int j, Eigen::MatrixXcd &M);
 template void herm_matrix<double>::set_mat<Eigen::MatrixXcd>(int i, Eigen::MatrixXcd &M);
 
+// single precision
+template class herm_matrix<float>;
+
+template void herm_matrix<float>::get_les<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M) const;
+template void herm_matrix<float>::get_ret<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M) const;
+template void herm_matrix<float>::get_tv<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M) const;
+template void herm_matrix<float>::get_mat<Eigen::MatrixXcd>(int i,Eigen::MatrixXcd &M) const;
+template void herm_matrix<float>::set_les<Eigen::MatrixXcd>(int i, int j, Eigen::MatrixXcd &M);
+template void herm_matrix<float>::set_ret<Eigen::MatrixXcd>(int i, int j, Eigen::MatrixXcd &M);
+template void herm_matrix<float>::set_tv<Eigen::MatrixXcd>(int i, int j, Eigen::MatrixXcd &M);
+template void herm_matrix<float>::set_mat<Eigen::MatrixXcd>(int i, Eigen::MatrixXcd &M);
+template void herm_matrix<float>::set_timestep<double>(int tstp, herm_matrix<double> &g1);
+template void herm_matrix<double>::set_timestep<float>(int tstp, herm_matrix<float> &g1);
+
 }  // namespace cntr
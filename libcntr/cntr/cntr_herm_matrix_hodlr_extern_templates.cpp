@@ -0,0 +1,15 @@
+#include "cntr_herm_matrix_hodlr_extern_templates.hpp"
+#include "cntr_herm_matrix_hodlr_impl.hpp"
+
+namespace cntr {
+
+template class hodlr_triangle<double>;
+template class herm_matrix_hodlr<double>;
+
+template void herm_matrix_hodlr<double>::get_les<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+template void herm_matrix_hodlr<double>::get_ret<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+template void herm_matrix_hodlr<double>::get_tv<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+template void herm_matrix_hodlr<double>::get_mat<Eigen::MatrixXcd>(int i,Eigen::MatrixXcd &M);
+template void herm_matrix_hodlr<double>::density_matrix<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M);
+
+}  // namespace cntr
@@ -4,6 +4,7 @@
 namespace cntr {
 
   template class herm_matrix_timestep<double>;
+  template class herm_matrix_timestep<float>;
 
   // preferred interfaces
   template void herm_matrix_timestep<double>::set_ret<Eigen::MatrixXcd>(int i, int j,Eigen::MatrixXcd &M);
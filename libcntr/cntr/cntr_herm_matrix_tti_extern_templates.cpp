@@ -0,0 +1,8 @@
+#include "cntr_herm_matrix_tti_extern_templates.hpp"
+#include "cntr_herm_matrix_tti_impl.hpp"
+
+namespace cntr {
+
+template class herm_matrix_tti<double>;
+
+}  // namespace cntr
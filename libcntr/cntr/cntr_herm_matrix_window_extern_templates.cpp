@@ -0,0 +1,14 @@
+#include "cntr_herm_matrix_window_extern_templates.hpp"
+#include "cntr_herm_matrix_window_impl.hpp"
+
+namespace cntr {
+
+template class herm_matrix_window<double>;
+
+template void herm_matrix_window<double>::get_les<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+template void herm_matrix_window<double>::get_ret<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+template void herm_matrix_window<double>::get_tv<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+template void herm_matrix_window<double>::get_mat<Eigen::MatrixXcd>(int i,Eigen::MatrixXcd &M);
+template void herm_matrix_window<double>::density_matrix<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M);
+
+}  // namespace cntr
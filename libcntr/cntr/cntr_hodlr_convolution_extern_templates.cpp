@@ -0,0 +1,15 @@
+#include "cntr_hodlr_convolution_extern_templates.hpp"
+#include "cntr_hodlr_convolution_impl.hpp"
+
+namespace cntr {
+
+  template
+  void convolution_timestep<double>(int n, herm_matrix_timestep<double> &C,
+    herm_matrix_hodlr<double> &A, herm_matrix_hodlr<double> &Acc, herm_matrix_hodlr<double> &B,
+    herm_matrix_hodlr<double> &Bcc, integration::Integrator<double> &I, double beta, double h);
+  template
+  void convolution_timestep<double>(int n, herm_matrix_timestep<double> &C,
+    herm_matrix_hodlr<double> &A, herm_matrix_hodlr<double> &Acc, herm_matrix_hodlr<double> &B,
+    herm_matrix_hodlr<double> &Bcc, double beta, double h, int SolveOrder);
+
+}  // namespace cntr
@@ -0,0 +1,61 @@
+#include "cntr_mmap_storage.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace cntr {
+
+void *mmap_storage_allocate(std::size_t nbytes, const char *dir) {
+    std::string path;
+    std::vector<char> name;
+    void *ptr;
+    int fd;
+    if (nbytes == 0)
+        return NULL;
+    if (dir == NULL)
+        dir = getenv("CNTR_MMAP_DIR");
+    if (dir == NULL)
+        dir = getenv("TMPDIR");
+    if (dir == NULL)
+        dir = "/tmp";
+    path = std::string(dir) + "/cntr_mmap_XXXXXX";
+    name.assign(path.begin(), path.end());
+    name.push_back('\0');
+    fd = mkstemp(name.data());
+    if (fd == -1) {
+        std::cerr << "mmap_storage_allocate: cannot create backing file " << path << ": "
+                  << strerror(errno) << std::endl;
+        abort();
+    }
+    // the file is only reachable through the mapping
+    unlink(name.data());
+    if (ftruncate(fd, (off_t)nbytes) != 0) {
+        std::cerr << "mmap_storage_allocate: cannot resize " << name.data() << " to "
+                  << nbytes << " bytes: " << strerror(errno) << std::endl;
+        close(fd);
+        abort();
+    }
+    ptr = mmap(NULL, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        std::cerr << "mmap_storage_allocate: mmap of " << nbytes
+                  << " bytes failed: " << strerror(errno) << std::endl;
+        abort();
+    }
+    return ptr;
+}
+
+void mmap_storage_release(void *ptr, std::size_t nbytes) {
+    if (ptr == NULL || nbytes == 0)
+        return;
+    munmap(ptr, nbytes);
+}
+
+}  // namespace cntr
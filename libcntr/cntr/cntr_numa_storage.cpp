@@ -0,0 +1,51 @@
+#include "cntr_numa_storage.hpp"
+#include "cntr_global_settings.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/mman.h>
+#ifdef CNTR_USE_OMP
+#include <omp.h>
+#endif
+
+namespace cntr {
+
+void *numa_storage_allocate(std::size_t nbytes, bool hugepages) {
+    std::size_t align = (hugepages ? CNTR_HUGEPAGE_SIZE : CNTR_STORAGE_ALIGNMENT);
+    void *ptr;
+    int err;
+    if (nbytes == 0)
+        return NULL;
+    err = posix_memalign(&ptr, align, nbytes);
+    if (err != 0) {
+        std::cerr << "numa_storage_allocate: allocation of " << nbytes
+                  << " bytes failed: " << strerror(err) << std::endl;
+        abort();
+    }
+#ifdef MADV_HUGEPAGE
+    // only a hint: without transparent huge pages, ordinary pages are used
+    if (hugepages)
+        madvise(ptr, nbytes, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void numa_storage_first_touch(void *ptr, const std::vector<std::size_t> &row) {
+    char *data = (char *)ptr;
+    int nrows = (int)row.size() - 1, r;
+    if (ptr == NULL || nrows <= 0)
+        return;
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for (r = 0; r < nrows; r++)
+        memset(data + row[r], 0, row[r + 1] - row[r]);
+}
+
+void numa_storage_release(void *ptr) {
+    free(ptr);
+}
+
+}  // namespace cntr
@@ -0,0 +1,363 @@
+#include "cntr_profile.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace cntr {
+
+/// @private
+/** \brief <b> The report: totals and per time step counters of all kernels.</b> */
+struct profile_registry {
+    std::mutex mutex;
+    std::map<std::string, profile_entry> total;
+    std::map<std::string, std::map<int, profile_entry> > timestep;
+    int nranks;
+};
+
+/// @private
+static profile_registry &profile_data(void) {
+    static profile_registry data;
+    return data;
+}
+
+/// @private
+// path of the scopes which are open on this thread
+static thread_local std::string profile_path;
+
+/// @private
+static void profile_entry_clear(profile_entry &e) {
+    e.calls = 0;
+    e.time = 0.0;
+    e.time_max = 0.0;
+    e.flops = 0.0;
+    e.bytes = 0.0;
+}
+
+/// @private
+// adds the counters of e1; time_max is the largest time of one of the ranks
+static void profile_entry_merge(profile_entry &e, const profile_entry &e1) {
+    e.calls += e1.calls;
+    e.time += e1.time;
+    e.time_max = (e1.time_max > e.time_max ? e1.time_max : e.time_max);
+    e.flops += e1.flops;
+    e.bytes += e1.bytes;
+}
+
+/// @private
+// entry of key, created with zero counters if needed
+template <class Key>
+static profile_entry &profile_entry_find(std::map<Key, profile_entry> &m, const Key &key) {
+    typename std::map<Key, profile_entry>::iterator it = m.find(key);
+    if (it == m.end()) {
+        profile_entry e;
+        profile_entry_clear(e);
+        it = m.insert(std::make_pair(key, e)).first;
+    }
+    return it->second;
+}
+
+/// @private
+static void profile_entry_add(profile_entry &e, double time, double flops, double bytes) {
+    e.calls += 1;
+    e.time += time;
+    e.time_max += time;
+    e.flops += flops;
+    e.bytes += bytes;
+}
+
+profile_scope::profile_scope(const char *name, int tstp, double flops, double bytes) {
+    parent_length_ = profile_path.size();
+    if (parent_length_ > 0)
+        profile_path += '/';
+    profile_path += name;
+    tstp_ = tstp;
+    flops_ = flops;
+    bytes_ = bytes;
+    start_ = profile_wtime();
+}
+
+profile_scope::~profile_scope() {
+    profile_record(profile_path, tstp_, profile_wtime() - start_, flops_, bytes_);
+    profile_path.resize(parent_length_);
+}
+
+/** \brief <b> Wall time in seconds since an arbitrary fixed point.</b> */
+double profile_wtime(void) {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/** \brief <b> Adds one call of a kernel to the report.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Thread safe. Calls with `tstp >= -1` are in addition counted for this time step.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param name
+ * > Name (path) of the kernel
+ * @param tstp
+ * > Time step, or `CNTR_PROFILE_NO_TSTP`
+ * @param time
+ * > Wall time of the call
+ * @param flops
+ * > Estimated floating point operations of the call
+ * @param bytes
+ * > Estimated bytes moved by the call
+ */
+void profile_record(const std::string &name, int tstp, double time, double flops,
+                    double bytes) {
+    profile_registry &data = profile_data();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    profile_entry_add(profile_entry_find(data.total, name), time, flops, bytes);
+    if (tstp >= -1)
+        profile_entry_add(profile_entry_find(data.timestep[name], tstp), time, flops, bytes);
+}
+
+/** \brief <b> Clears the report.</b> */
+void profile_reset(void) {
+    profile_registry &data = profile_data();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.total.clear();
+    data.timestep.clear();
+    data.nranks = 1;
+}
+
+/** \brief <b> Returns the counters of a kernel, in total or at one time step.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Returns zero counters if the kernel has not been called (at this time step).
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param name
+ * > Name (path) of the kernel, e.g. "dyson_timestep"
+ * @param tstp
+ * > Time step, or `CNTR_PROFILE_NO_TSTP` for the total
+ */
+profile_entry profile_get(const std::string &name, int tstp) {
+    profile_registry &data = profile_data();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    profile_entry e;
+    profile_entry_clear(e);
+    if (tstp < -1) {
+        std::map<std::string, profile_entry>::iterator it = data.total.find(name);
+        if (it != data.total.end())
+            e = it->second;
+    } else {
+        std::map<std::string, std::map<int, profile_entry> >::iterator it =
+            data.timestep.find(name);
+        if (it != data.timestep.end() && it->second.count(tstp))
+            e = it->second[tstp];
+    }
+    return e;
+}
+
+/// @private
+static void profile_write_json_entry(std::ostream &os, const profile_entry &e) {
+    os << "\"calls\": " << e.calls << ", \"time\": " << e.time << ", \"time_max\": "
+       << e.time_max << ", \"flops\": " << e.flops << ", \"bytes\": " << e.bytes;
+}
+
+/** \brief <b> Writes the report in JSON format.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The report is an object with the number of ranks "nranks" and the list "kernels". Each
+ *  kernel has its "name" (path of the nested scopes), the totals "calls", "time",
+ *  "time_max", "flops", "bytes" and the list "timesteps" of the same counters per "tstp".
+ *  With MPI, call `profile_mpi_reduce` first to write the report of all ranks.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param os
+ * > The output stream
+ */
+void profile_write_json(std::ostream &os) {
+    profile_registry &data = profile_data();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    std::map<std::string, profile_entry>::iterator it;
+    std::map<int, profile_entry>::iterator jt;
+    std::streamsize prec = os.precision(10);
+    os << "{\n  \"nranks\": " << (data.nranks > 1 ? data.nranks : 1) << ",\n  \"kernels\": [";
+    for (it = data.total.begin(); it != data.total.end(); it++) {
+        os << (it == data.total.begin() ? "\n" : ",\n");
+        os << "    {\"name\": \"" << it->first << "\", ";
+        profile_write_json_entry(os, it->second);
+        os << ",\n     \"timesteps\": [";
+        std::map<int, profile_entry> &steps = data.timestep[it->first];
+        for (jt = steps.begin(); jt != steps.end(); jt++) {
+            os << (jt == steps.begin() ? "\n" : ",\n");
+            os << "       {\"tstp\": " << jt->first << ", ";
+            profile_write_json_entry(os, jt->second);
+            os << "}";
+        }
+        os << "]}";
+    }
+    os << "\n  ]\n}\n";
+    os.precision(prec);
+}
+
+/** \brief <b> Writes the report in JSON format to the file `filename`.</b> */
+void profile_write_json(const char *filename) {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "profile_write_json: cannot open " << filename << std::endl;
+        return;
+    }
+    profile_write_json(out);
+}
+
+#ifdef CNTR_USE_HDF5
+/** \brief <b> Stores the report to a given HDF5 group.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Each kernel is stored in a group of its name; nested scopes are subgroups. The group
+ *  holds the totals "calls", "time", "time_max", "flops", "bytes" and the arrays "tstp",
+ *  "tstp_calls", "tstp_time", "tstp_flops", "tstp_bytes" of the counters per time step.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param group_id
+ * > [hid_t] The HDF5 group handle under which the report is stored.
+ */
+void profile_write_to_hdf5(hid_t group_id) {
+    profile_registry &data = profile_data();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    std::map<std::string, profile_entry>::iterator it;
+    std::map<int, profile_entry>::iterator jt;
+    store_int_attribute_to_hid(group_id, std::string("nranks"),
+                               (data.nranks > 1 ? data.nranks : 1));
+    // a scope is recorded after the scopes nested in it, but sorts before them
+    for (it = data.total.begin(); it != data.total.end(); it++) {
+        hid_t kernel_id = create_group(group_id, it->first);
+        profile_entry &e = it->second;
+        store_int_attribute_to_hid(kernel_id, std::string("calls"), (int)e.calls);
+        store_double_attribute_to_hid(kernel_id, std::string("time"), e.time);
+        store_double_attribute_to_hid(kernel_id, std::string("time_max"), e.time_max);
+        store_double_attribute_to_hid(kernel_id, std::string("flops"), e.flops);
+        store_double_attribute_to_hid(kernel_id, std::string("bytes"), e.bytes);
+        std::map<int, profile_entry> &steps = data.timestep[it->first];
+        if (!steps.empty()) {
+            size_t n = steps.size(), i = 0;
+            std::vector<int> tstp(n), calls(n);
+            std::vector<double> time(n), flops(n), bytes(n);
+            for (jt = steps.begin(); jt != steps.end(); jt++, i++) {
+                tstp[i] = jt->first;
+                calls[i] = (int)jt->second.calls;
+                time[i] = jt->second.time;
+                flops[i] = jt->second.flops;
+                bytes[i] = jt->second.bytes;
+            }
+            store_data_to_hid(kernel_id, std::string("tstp"), tstp.data(), n, H5T_NATIVE_INT);
+            store_data_to_hid(kernel_id, std::string("tstp_calls"), calls.data(), n,
+                              H5T_NATIVE_INT);
+            store_real_data_to_hid(kernel_id, std::string("tstp_time"), time.data(), n);
+            store_real_data_to_hid(kernel_id, std::string("tstp_flops"), flops.data(), n);
+            store_real_data_to_hid(kernel_id, std::string("tstp_bytes"), bytes.data(), n);
+        }
+        close_group(kernel_id);
+    }
+}
+/** \brief <b> Stores the report to a subgroup `groupname` of a given HDF5 group.</b> */
+void profile_write_to_hdf5(hid_t group_id, const char *groupname) {
+    hid_t sub_group_id = create_group(group_id, groupname);
+    profile_write_to_hdf5(sub_group_id);
+    close_group(sub_group_id);
+}
+#endif  // CNTR_USE_HDF5
+
+#ifdef CNTR_USE_MPI
+/** \brief <b> Collects the reports of all MPI ranks on rank MPI_MASTER.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Collective. On MPI_MASTER, the report is replaced by the sum over all ranks, where
+ *  "time_max" is the largest time of a single rank. The reports of the other ranks
+ *  are not changed.
+ */
+void profile_mpi_reduce(void) {
+    profile_registry &data = profile_data();
+    std::map<std::string, profile_entry>::iterator it;
+    std::map<std::string, std::map<int, profile_entry> >::iterator st;
+    std::map<int, profile_entry>::iterator jt;
+    std::ostringstream out;
+    std::string buf;
+    int tid, ntasks, len, rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &tid);
+    MPI_Comm_size(MPI_COMM_WORLD, &ntasks);
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        out << std::setprecision(17);
+        for (it = data.total.begin(); it != data.total.end(); it++)
+            out << "T " << it->first << " " << CNTR_PROFILE_NO_TSTP << " " << it->second.calls
+                << " " << it->second.time << " " << it->second.flops << " "
+                << it->second.bytes << "\n";
+        for (st = data.timestep.begin(); st != data.timestep.end(); st++)
+            for (jt = st->second.begin(); jt != st->second.end(); jt++)
+                out << "S " << st->first << " " << jt->first << " " << jt->second.calls << " "
+                    << jt->second.time << " " << jt->second.flops << " " << jt->second.bytes
+                    << "\n";
+    }
+    buf = out.str();
+    len = (int)buf.size();
+    std::vector<int> lens(ntasks), displs(ntasks, 0);
+    MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, MPI_MASTER, MPI_COMM_WORLD);
+    for (rank = 1; rank < ntasks; rank++)
+        displs[rank] = displs[rank - 1] + lens[rank - 1];
+    std::vector<char> all(tid == MPI_MASTER ? displs[ntasks - 1] + lens[ntasks - 1] + 1 : 1);
+    MPI_Gatherv((void *)buf.data(), len, MPI_CHAR, all.data(), lens.data(), displs.data(),
+                MPI_CHAR, MPI_MASTER, MPI_COMM_WORLD);
+    if (tid != MPI_MASTER)
+        return;
+    std::lock_guard<std::mutex> lock(data.mutex);
+    data.total.clear();
+    data.timestep.clear();
+    for (rank = 0; rank < ntasks; rank++) {
+        std::istringstream in(std::string(all.data() + displs[rank], lens[rank]));
+        std::string kind, name;
+        int tstp;
+        profile_entry e;
+        profile_entry_clear(e);
+        while (in >> kind >> name >> tstp >> e.calls >> e.time >> e.flops >> e.bytes) {
+            e.time_max = e.time;
+            if (kind == "T")
+                profile_entry_merge(profile_entry_find(data.total, name), e);
+            else
+                profile_entry_merge(profile_entry_find(data.timestep[name], tstp), e);
+        }
+    }
+    data.nranks = ntasks;
+}
+#endif  // CNTR_USE_MPI
+
+}  // namespace cntr
@@ -0,0 +1,23 @@
+#include "cntr_tti_solvers_extern_templates.hpp"
+#include "cntr_tti_solvers_impl.hpp"
+
+namespace cntr {
+
+template void green_from_H_tti<double>(herm_matrix_tti<double> &G, double mu, cdmatrix &H0,
+  double beta, double h);
+template void convolution_tti_ret<double>(int n, int size1, std::complex<double> *c,
+  std::complex<double> *a, std::complex<double> *b, integration::Integrator<double> &I, double h);
+template void convolution_tti_les_ret<double>(int n, int size1, std::complex<double> *c,
+  std::complex<double> *aret, std::complex<double> *bles, integration::Integrator<double> &I,
+  double h);
+template void convolution_tti_les_adv<double>(int n, int size1, std::complex<double> *c,
+  std::complex<double> *ales, std::complex<double> *bret, integration::Integrator<double> &I,
+  double h);
+template void convolution_tti<double>(herm_matrix_tti<double> &C, herm_matrix_tti<double> &A,
+  herm_matrix_tti<double> &B, double beta, double h, int SolveOrder);
+template void dyson_tti_ret<double>(int n, int size1, std::complex<double> *g,
+  std::complex<double> *g0, std::complex<double> *q, integration::Integrator<double> &I, double h);
+template void dyson_tti<double>(herm_matrix_tti<double> &G, double mu, cdmatrix &H0,
+  herm_matrix_tti<double> &Sigma, double h, int SolveOrder);
+
+}  // namespace cntr
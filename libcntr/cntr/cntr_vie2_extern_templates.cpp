@@ -32,6 +32,12 @@ namespace cntr {
   template void vie2_timestep<double>(int n, herm_matrix<double> &G,herm_matrix<double> &F,herm_matrix<double> &Fcc,
 				      herm_matrix<double> &Q, double beta, double h, const int SolveOrder,
 				      const int matsubara_method);
+  template void vie2_timestep<double>(int n,herm_matrix<double> &G,herm_matrix<double> &F,herm_matrix<double> &Fcc,
+				      herm_matrix<double> &Q, integration::Integrator<double> &I,
+				      double beta,double h, dyson_workspace<double> &ws, const int matsubara_method);
+  template void vie2_timestep<double>(int n, herm_matrix<double> &G,herm_matrix<double> &F,herm_matrix<double> &Fcc,
+				      herm_matrix<double> &Q, double beta, double h, dyson_workspace<double> &ws,
+				      const int SolveOrder, const int matsubara_method);
 
   template void vie2<double>(herm_matrix<double> &G,herm_matrix<double> &F,herm_matrix<double> &Fcc,
 			     herm_matrix<double> &Q, integration::Integrator<double> &I, double beta,double h,
@@ -43,6 +49,20 @@ namespace cntr {
   template void vie2_timestep_sin(int n,herm_matrix<double> &G,function<double> &Gsin,herm_matrix<double> &F,herm_matrix<double> &Fcc, function<double> &Fsin ,
       			 herm_matrix<double> &Q,function<double> &Qsin,double beta,double h,int SolveOrder);
 
+  template void vie2_timestep_batch<double>(int n, std::vector<herm_matrix<double> *> &G,
+                                            std::vector<herm_matrix<double> *> &F,
+                                            std::vector<herm_matrix<double> *> &Fcc,
+                                            std::vector<herm_matrix<double> *> &Q, double beta,
+                                            double h, const int SolveOrder, const int matsubara_method);
+  template void vie2_timestep_sin_batch<double>(int n, std::vector<herm_matrix<double> *> &G,
+                                                std::vector<function<double> *> &Gsin,
+                                                std::vector<herm_matrix<double> *> &F,
+                                                std::vector<herm_matrix<double> *> &Fcc,
+                                                std::vector<function<double> *> &Fsin,
+                                                std::vector<herm_matrix<double> *> &Q,
+                                                std::vector<function<double> *> &Qsin,
+                                                double beta, double h, int SolveOrder);
+
 #ifdef CNTR_USE_OMP
   template void vie2_timestep_omp<double>(int omp_num_threads,int n,herm_matrix<double> &G,
 					  herm_matrix<double> &F,herm_matrix<double> &Fcc,herm_matrix<double> &Q,
@@ -52,6 +72,14 @@ namespace cntr {
 					  herm_matrix<double> &F,herm_matrix<double> &Fcc,herm_matrix<double> &Q,
 					  double beta,double h,const int SolveOrder, 
 					  const int matsubara_method);
+  template void vie2_timestep_omp<double>(int omp_num_threads,int n,herm_matrix<double> &G,
+					  herm_matrix<double> &F,herm_matrix<double> &Fcc,herm_matrix<double> &Q,
+					  integration::Integrator<double> &I, double beta,double h,
+					  dyson_workspace<double> &ws, const int matsubara_method);
+  template void vie2_timestep_omp<double>(int omp_num_threads,int n,herm_matrix<double> &G,
+					  herm_matrix<double> &F,herm_matrix<double> &Fcc,herm_matrix<double> &Q,
+					  double beta,double h,dyson_workspace<double> &ws,const int SolveOrder,
+					  const int matsubara_method);
   template void vie2_omp<double>(int omp_num_threads, herm_matrix<double> &G, herm_matrix<double> &F, 
   		herm_matrix<double> &Fcc, herm_matrix<double> &Q, integration::Integrator<double> &I, double beta, double h,
 		const int matsubara_method);
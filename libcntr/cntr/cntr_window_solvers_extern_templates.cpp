@@ -0,0 +1,32 @@
+#include "cntr_window_solvers_extern_templates.hpp"
+#include "cntr_window_solvers_impl.hpp"
+
+namespace cntr {
+
+  template
+  void convolution_timestep_window<double>(int n, herm_matrix_window<double> &C,
+    herm_matrix_window<double> &A, herm_matrix_window<double> &Acc, herm_matrix_window<double> &B,
+    herm_matrix_window<double> &Bcc, integration::Integrator<double> &I, double beta, double h);
+  template
+  void convolution_timestep_window<double>(int n, herm_matrix_window<double> &C,
+    herm_matrix_window<double> &A, herm_matrix_window<double> &Acc, herm_matrix_window<double> &B,
+    herm_matrix_window<double> &Bcc, double beta, double h, int SolveOrder);
+
+  template
+  void dyson_timestep_window<double>(int n, herm_matrix_window<double> &G, double mu,
+    function<double> &H, herm_matrix_window<double> &Sigma, integration::Integrator<double> &I,
+    double beta, double h, dyson_workspace<double> &ws);
+  template
+  void dyson_timestep_window<double>(int n, herm_matrix_window<double> &G, double mu,
+    function<double> &H, herm_matrix_window<double> &Sigma, double beta, double h, int SolveOrder);
+
+  template
+  void vie2_timestep_window<double>(int n, herm_matrix_window<double> &G,
+    herm_matrix_window<double> &F, herm_matrix_window<double> &Fcc, herm_matrix_window<double> &Q,
+    integration::Integrator<double> &I, double beta, double h, dyson_workspace<double> &ws);
+  template
+  void vie2_timestep_window<double>(int n, herm_matrix_window<double> &G,
+    herm_matrix_window<double> &F, herm_matrix_window<double> &Fcc, herm_matrix_window<double> &Q,
+    double beta, double h, int SolveOrder);
+
+}  // namespace cntr
@@ -5,6 +5,11 @@
 PURPOSE:   fourier transforms of complex functions         */
 #include "./fourier.hpp"
 #include <cmath>
+#ifdef EIGEN_USE_MKL_ALL
+#include <mkl_dfti.h>
+#else
+#include <eigen3/unsupported/Eigen/FFT>
+#endif
 
 namespace fourier{
 
@@ -340,4 +345,156 @@ void dft_cplx(double w,int n,double a,double b,cplx *f,cplx &res,cplx &err)
   err=res-res2;
 }
 
+/** \brief <b> Returns the weights of the cubically corrected DFT.</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > The cubically corrected DFT computed by `dft_cplx` is linear in the function values,
+* > \f$I(\omega) = \sum_{j=0}^n c_j(\omega) f(t_j)\f$. `dft_cplx_weights` returns the weights
+* > \f$c_j(\omega)\f$, so that the Fourier integrals of many functions sampled on the same grid,
+* > or of one function at many frequencies, can be evaluated as a matrix product.
+* > The weights for \f$-\omega\f$ are the complex conjugates of those for \f$\omega\f$.
+*
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param w
+* > [double] frequency \f$\omega\f$
+* @param n
+* > [int] number of time points \f$t_j=a+j h, j=0,\dots,n\f$
+* @param a
+* > [double] starting point of interval
+* @param b
+* > [double] end point of interval
+* @param c
+* > [complex] on return, the weights 'c[j]', 'j=0,...,n'
+*/
+void dft_cplx_weights(double w,int n,double a,double b,cplx *c)
+{
+  double delta,theta,corfac,arg;
+  cplx endcor[4],expa,expb;
+  int j;
+
+  if(n<=16  || (n/2)*2!=n  || b-a<=0.0) {std::cerr << "dft_cplx_weights: wrong input"  << std::endl;abort();}
+  delta=(b-a)/((double) n);
+  theta=w*delta;
+  get_dftcorr_cubic(theta,&corfac,endcor);
+  arg=w*a;
+  expa=cplx(delta*cos(arg),delta*sin(arg));
+  arg=w*b;
+  expb=cplx(delta*cos(arg),delta*sin(arg));
+  for(j=0;j<=n;j++){
+    arg=((double) j)*theta;
+    c[j]=expa*corfac*cplx(cos(arg),sin(arg));
+  }
+  for(j=0;j<=3;j++){
+    c[j] += expa*endcor[j];
+    c[n-j] += expb*std::conj(endcor[j]);
+  }
+}
+
+/// @private
+/** \brief <b> Returns the largest prime factor of `n`.</b> */
+static int largest_prime_factor(int n){
+  int p=2,pmax=1;
+  while(p*p<=n){
+    if(n%p==0){
+      pmax=p;
+      n/=p;
+    }else{
+      p++;
+    }
+  }
+  return (n>1 && n>pmax ? n : pmax);
+}
+
+/** \brief <b> Computes `howmany` discrete Fourier transforms of length `n` by FFT.</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$x_m \to \sum_{r=0}^{n-1} e^{2\pi i\, s\, m r/n} x_r\f$, \f$m=0,\dots,n-1\f$,
+* > in place and without normalization, where \f$s\f$=`isign`. The `howmany` sequences are
+* > interleaved, element \f$r\f$ of sequence \f$l\f$ is stored at `x[r*howmany+l]`, which is
+* > the layout of the matrix elements of a contour function on a time grid.
+* > With MKL the transforms are done by DFTI, otherwise by the FFT module of Eigen; lengths with
+* > a prime factor larger than 7 are then computed by Bluestein's algorithm, so that the cost
+* > is \f$O(n\log n)\f$ for any `n`.
+*
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] length of the transforms
+* @param howmany
+* > [int] number of interleaved sequences
+* @param x
+* > [complex] the `n*howmany` values, overwritten by their transforms
+* @param isign
+* > [int] sign of the exponent, `+1` or `-1`
+*/
+void fft_cplx(int n,int howmany,cplx *x,int isign)
+{
+  assert(n>0 && howmany>0 && (isign==1 || isign==-1));
+  if(n==1) return;
+#ifdef EIGEN_USE_MKL_ALL
+  DFTI_DESCRIPTOR_HANDLE desc;
+  MKL_LONG status,strides[2]={0,(MKL_LONG)howmany};
+  status=DftiCreateDescriptor(&desc,DFTI_DOUBLE,DFTI_COMPLEX,1,(MKL_LONG)n);
+  if(!status) status=DftiSetValue(desc,DFTI_NUMBER_OF_TRANSFORMS,(MKL_LONG)howmany);
+  if(!status) status=DftiSetValue(desc,DFTI_INPUT_DISTANCE,(MKL_LONG)1);
+  if(!status) status=DftiSetValue(desc,DFTI_OUTPUT_DISTANCE,(MKL_LONG)1);
+  if(!status) status=DftiSetValue(desc,DFTI_INPUT_STRIDES,strides);
+  if(!status) status=DftiSetValue(desc,DFTI_OUTPUT_STRIDES,strides);
+  if(!status) status=DftiCommitDescriptor(desc);
+  if(!status) status=(isign==-1 ? DftiComputeForward(desc,x) : DftiComputeBackward(desc,x));
+  DftiFreeDescriptor(&desc);
+  if(status){std::cerr << "fft_cplx: " << DftiErrorMessage(status) << std::endl;abort();}
+#else
+  Eigen::FFT<double> fft;
+  int r,l;
+  fft.SetFlag(Eigen::FFT<double>::Unscaled);
+  if(largest_prime_factor(n)<=7){
+    std::vector<cplx> in(n),out(n);
+    for(l=0;l<howmany;l++){
+      for(r=0;r<n;r++) in[r]=x[r*howmany+l];
+      if(isign==-1) fft.fwd(&out[0],&in[0],n);
+      else fft.inv(&out[0],&in[0],n);
+      for(r=0;r<n;r++) x[r*howmany+l]=out[r];
+    }
+  }else{
+    // Bluestein: mr=(m^2+r^2-(m-r)^2)/2, convolution with the chirp of length nfft>=2n-1
+    int nfft=1;
+    long long r2;
+    double arg;
+    while(nfft<2*n-1) nfft*=2;
+    std::vector<cplx> chirp(n),u(nfft),uhat(nfft),vhat(nfft);
+    for(r=0;r<n;r++){
+      r2=((long long) r*r)%(2*n);
+      arg=isign*PI*r2/n;
+      chirp[r]=cplx(cos(arg),sin(arg));
+    }
+    for(r=0;r<nfft;r++) u[r]=0.0;
+    u[0]=std::conj(chirp[0]);
+    for(r=1;r<n;r++) u[r]=u[nfft-r]=std::conj(chirp[r]);
+    fft.fwd(&vhat[0],&u[0],nfft);
+    for(l=0;l<howmany;l++){
+      for(r=0;r<n;r++) u[r]=x[r*howmany+l]*chirp[r];
+      for(r=n;r<nfft;r++) u[r]=0.0;
+      fft.fwd(&uhat[0],&u[0],nfft);
+      for(r=0;r<nfft;r++) uhat[r]*=vhat[r];
+      fft.inv(&u[0],&uhat[0],nfft);
+      for(r=0;r<n;r++) x[r*howmany+l]=chirp[r]*u[r]/(double)nfft;
+    }
+  }
+#endif
+}
+
 } //namespace
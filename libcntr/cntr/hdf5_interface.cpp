@@ -130,6 +130,20 @@ void store_cplx_array_to_hid(
 		     shape, len_shape, H5T_COMPLEX);
 }
 
+// ********************************************************************
+void store_cplx_array_to_hid(
+  hid_t file_id, std::string label, 
+  std::complex<float> * data_ptr, hsize_t * shape, hsize_t len_shape) {
+
+  // -- SINGLE PRECISION COMPLEX COMPOUND HDF5 TYPE
+  hid_t H5T_COMPLEX = H5Tcreate(H5T_COMPOUND, sizeof(float)*2);
+  H5Tinsert(H5T_COMPLEX, "r", 0, H5T_NATIVE_FLOAT);
+  H5Tinsert(H5T_COMPLEX, "i", sizeof(float), H5T_NATIVE_FLOAT);
+  
+  store_array_to_hid(file_id, label, (void *) data_ptr,
+		     shape, len_shape, H5T_COMPLEX);
+}
+
 // ********************************************************************
 void store_cplx_data_to_hid(
   hid_t file_id, std::string label, 
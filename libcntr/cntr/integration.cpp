@@ -1181,4 +1181,36 @@ void read_rcorr(int k,double *w){
     return;
 }
 
+/*##########################################################################
+#
+# Single precision weights: computed in double precision and rounded
+#
+##########################################################################*/
+/// @private
+void read_gregory_weights(int k,float *w){
+  int k1=k+1,l;
+  double *w1 = new double [4*k1*k1];
+  read_gregory_weights(k,w1);
+  for(l=0;l<4*k1*k1;l++) w[l]=w1[l];
+  delete [] w1;
+}
+/// @private
+void read_bd_weights(int k,float *w){
+  int l;
+  double *w1 = new double [k+1];
+  read_bd_weights(k,w1);
+  for(l=0;l<=k;l++) w[l]=w1[l];
+  delete [] w1;
+}
+/// @private
+void read_rcorr(int k,float *w){
+  int k1=k+1,l;
+  double *w1;
+  if(k<2) return;
+  w1 = new double [(k-1)*k1*k1];
+  read_rcorr(k,w1);
+  for(l=0;l<(k-1)*k1*k1;l++) w[l]=w1[l];
+  delete [] w1;
+}
+
 } //namespace
@@ -4,5 +4,7 @@ namespace integration {
 
 template class Integrator<double>;
 template Integrator<double> &I<double>(int k);
+template class Integrator<float>;
+template Integrator<float> &I<float>(int k);
 
 }  // namespace integration
@@ -3,6 +3,7 @@
 
 #include "cntr_bubble_decl.hpp"
 #include "cntr_herm_matrix_timestep_view_decl.hpp"
+#include "cntr_profile.hpp"
 
 namespace cntr {
 
@@ -140,6 +141,8 @@ void Bubble1(int tstp, herm_matrix_timestep_view<T> &C, int c1, int c2,
              int a2, herm_matrix_timestep_view<T> &B, herm_matrix_timestep_view<T> &Bcc,
              int b1, int b2) {
     int ntau = C.ntau();
+    CNTR_PROFILE_SCOPE("Bubble1", tstp, 6.0 * profile_timestep_elements(tstp, ntau, 1),
+                       3.0 * sizeof(std::complex<T>) * profile_timestep_elements(tstp, ntau, 1));
     assert(ntau == A.ntau());
     assert(ntau == B.ntau());
     assert(ntau == Acc.ntau());
@@ -236,6 +239,8 @@ void Bubble2(int tstp, herm_matrix_timestep_view<T> &C, int c1, int c2,
              int a2, herm_matrix_timestep_view<T> &B, herm_matrix_timestep_view<T> &Bcc,
              int b1, int b2) {
     int ntau = C.ntau();
+    CNTR_PROFILE_SCOPE("Bubble2", tstp, 6.0 * profile_timestep_elements(tstp, ntau, 1),
+                       3.0 * sizeof(std::complex<T>) * profile_timestep_elements(tstp, ntau, 1));
 
     assert(ntau == A.ntau());
     assert(ntau == B.ntau());
@@ -80,6 +80,15 @@ template <typename T>
 void convolution(herm_matrix<T> &C, herm_matrix<T> &A, herm_matrix<T> &Acc, function<T> &ft,
                  herm_matrix<T> &B, herm_matrix<T> &Bcc,
                  T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+// mixed precision: functions stored in precision S, sums accumulated in precision T
+template <typename T, typename S>
+void convolution_timestep_mixed(int n, herm_matrix<S> &C, herm_matrix<S> &A,
+                                herm_matrix<S> &Acc, herm_matrix<S> &B, herm_matrix<S> &Bcc,
+                                T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+template <typename T, typename S>
+void convolution_timestep_mixed(int n, herm_matrix<S> &C, herm_matrix<S> &A,
+                                herm_matrix<S> &B, T beta, T h,
+                                int SolveOrder=MAX_SOLVE_ORDER);
 
 
 //
@@ -125,6 +134,14 @@ void convolution_density_matrix(int tstp, cdmatrix &rho, GG &A, GG &Acc, GG &B,
 template <typename T, class GG>
 void convolution_density_matrix(int tstp, cdmatrix &rho, GG &A, GG &B,
                                 T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+/// @private
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_ret(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
+                              integration::Integrator<T> &I, T h);
+/// @private
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_les(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
+                              integration::Integrator<T> &I, T beta, T h);
 // raw pointer versions 
 /// @private
 template <typename T, class GG>
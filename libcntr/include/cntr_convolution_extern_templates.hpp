@@ -1,6 +1,7 @@
 #ifndef CNTR_CONVOLUTION_EXTERN_TEMPLATES_H
 #define CNTR_CONVOLUTION_EXTERN_TEMPLATES_H
 
+#include "cntr_elements.hpp"
 #include "cntr_convolution_decl.hpp"
 #include "cntr_pseudo_convolution_decl.hpp"
 
@@ -73,6 +74,18 @@ extern template void convolution_timestep<double>(int n,herm_matrix<double> &C,h
 extern template void convolution<double>(herm_matrix<double> &C,herm_matrix<double> &A,herm_matrix<double> &Acc,
   function<double> &ft, herm_matrix<double> &B,herm_matrix<double> &Bcc, double beta,double h, int SolveOrder);
 
+// single and mixed precision
+extern template void convolution_timestep<float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,herm_matrix<float> &Acc,
+  herm_matrix<float> &B, herm_matrix<float> &Bcc, integration::Integrator<float> &I, float beta,float h);
+extern template void convolution_timestep<float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,herm_matrix<float> &Acc,
+  herm_matrix<float> &B, herm_matrix<float> &Bcc, float beta,float h, int SolveOrder);
+extern template void convolution_timestep<float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,herm_matrix<float> &B,
+  float beta,float h, int SolveOrder);
+extern template void convolution_timestep_mixed<double,float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,
+  herm_matrix<float> &Acc,herm_matrix<float> &B,herm_matrix<float> &Bcc, double beta,double h, int SolveOrder);
+extern template void convolution_timestep_mixed<double,float>(int n,herm_matrix<float> &C,herm_matrix<float> &A,
+  herm_matrix<float> &B, double beta,double h, int SolveOrder);
+
 extern template void convolution_density_matrix<double, herm_matrix<double> >(int tstp,cdmatrix &rho,herm_matrix<double> &A,
   herm_matrix<double> &Acc, function<double> &ft,herm_matrix<double> &B,herm_matrix<double> &Bcc, double beta,double h, int SolveOrder);
 extern template void convolution_density_matrix<double, herm_matrix<double> >(int tstp,cdmatrix &rho,herm_matrix<double> &A,
@@ -83,6 +96,23 @@ extern template void convolution_density_matrix<double, herm_matrix<double> >(in
   herm_matrix<double> &B, double beta,double h, int SolveOrder);
 
 
+// fixed-size kernels for the element sizes of CNTR_SIZE1_DISPATCH
+#define CNTR_CONVOLUTION_EXTERN_KERNELS(SIZE1)                                                             \
+  extern template                                                                                          \
+  void convolution_timestep_ret<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &C,         \
+        herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix<double> &B,                          \
+        herm_matrix<double> &Bcc, integration::Integrator<double> &I, double h);                           \
+  extern template                                                                                          \
+  void convolution_timestep_tv<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &C,          \
+        herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix<double> &B,                          \
+        herm_matrix<double> &Bcc, integration::Integrator<double> &I, double beta, double h);              \
+  extern template                                                                                          \
+  void convolution_timestep_les<double, herm_matrix<double>, SIZE1>(int n, herm_matrix<double> &C,         \
+        herm_matrix<double> &A, herm_matrix<double> &Acc, herm_matrix<double> &B,                          \
+        herm_matrix<double> &Bcc, integration::Integrator<double> &I, double beta, double h);
+  CNTR_SIZE1_FOR_EACH(CNTR_CONVOLUTION_EXTERN_KERNELS)
+#undef CNTR_CONVOLUTION_EXTERN_KERNELS
+
 #ifdef CNTR_USE_OMP
 
 extern template
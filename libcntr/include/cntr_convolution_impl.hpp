@@ -4,6 +4,9 @@
 #include "eigen_map.hpp"
 #include "cntr_convolution_decl.hpp"
 #include "cntr_elements.hpp"
+#include "fourier.hpp"
+#include "cntr_omp_schedule.hpp"
+#include "cntr_profile.hpp"
 #include "cntr_function_decl.hpp"
 #include "cntr_herm_matrix_decl.hpp"
 
@@ -562,6 +565,93 @@ void convolution_matsubara_dispatch(GG &C, GG &A, GG &B,
     return;
 }
 /// @private
+/** \brief <b> Performs the Matsubara convolution by FFT. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes the same Gregory quadrature of
+* > \f$ C^M(\tau) = \int_0^\beta dx A^M(\tau-x) B^M(x)\f$ as `matsubara_integral_1`,
+* > in \f$O(n_\tau \log n_\tau)\f$ operations. With unit weights, the contributions from
+* > \f$0...\tau_m\f$ and \f$\tau_m...\beta\f$ are the elements \f$m\f$ and \f$n_\tau+m\f$
+* > of the linear convolution \f$\sum_{a+b=n} A^M(\tau_a)B^M(\tau_b)\f$, which is computed
+* > by zero-padded FFT. The Gregory end-point weights are added as corrections, which
+* > involve \f$k+1\f$ points at each end of the two intervals. Points with
+* > \f$m<2k+1\f$ or \f$n_\tau-m<2k+1\f$, where `matsubara_integral_1` uses other weights,
+* > are computed directly.
+*
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param C
+* > [GG] Matrix to which the result of the convolution on Matsubara axis is given
+* @param A
+* > [GG] contour Green's function
+* @param B
+* > [GG] contour Green's function
+* @param I
+* > [Integrator] integrator class
+* @param beta
+* > inversed temperature
+*/
+template <typename T, class GG, int SIZE1>
+void convolution_matsubara_fft_dispatch(GG &C, GG &A, GG &B,
+                                        integration::Integrator<T> &I, T beta) {
+    typedef std::complex<T> cplx;
+    // the transforms are done in double precision for any T
+    typedef std::complex<double> cplx_fft;
+    int ntau = A.ntau(), k = I.get_k(), k2 = 2 * (k + 1), size1 = C.size1();
+    int sg = C.element_size(), sig = A.sig(), nfft, i, l, m;
+    cplx_fft *afft, *bfft, *cfft;
+    cplx *cmat;
+    T dtau = beta / ntau, weight;
+
+    nfft = 1;
+    while (nfft < 2 * ntau + 1)
+        nfft *= 2;
+    afft = new cplx_fft[nfft * sg];
+    bfft = new cplx_fft[nfft * sg];
+    cfft = new cplx_fft[nfft * sg];
+    for (l = 0; l < (ntau + 1) * sg; l++) {
+        afft[l] = A.matptr(0)[l];
+        bfft[l] = B.matptr(0)[l];
+    }
+    for (l = (ntau + 1) * sg; l < nfft * sg; l++) {
+        afft[l] = 0.0;
+        bfft[l] = 0.0;
+    }
+    fourier::fft_cplx(nfft, sg, afft, -1);
+    fourier::fft_cplx(nfft, sg, bfft, -1);
+    for (i = 0; i < nfft; i++)
+        element_mult<double, SIZE1>(size1, cfft + i * sg, afft + i * sg, bfft + i * sg);
+    fourier::fft_cplx(nfft, sg, cfft, 1);
+    for (m = 0; m <= ntau; m++) {
+        cmat = C.matptr(m);
+        if (m < k2 - 1 || ntau - m < k2 - 1) {
+            matsubara_integral_1<T, SIZE1>(size1, m, ntau, cmat, A.matptr(0), B.matptr(0), I, sig);
+        } else {
+            for (l = 0; l < sg; l++)
+                cmat[l] = (cplx)((cfft[m * sg + l] + (1.0 * sig) * cfft[(ntau + m) * sg + l]) / (1.0 * nfft));
+            for (i = 0; i <= k; i++) {
+                weight = I.gregory_omega(i) - 1.0;
+                element_incr<T, SIZE1>(size1, cmat, weight, A.matptr(m - i), B.matptr(i));
+                element_incr<T, SIZE1>(size1, cmat, weight, A.matptr(i), B.matptr(m - i));
+                weight *= sig;
+                element_incr<T, SIZE1>(size1, cmat, weight, A.matptr(ntau - i), B.matptr(m + i));
+                element_incr<T, SIZE1>(size1, cmat, weight, A.matptr(m + i), B.matptr(ntau - i));
+            }
+        }
+        element_smul<T, SIZE1>(size1, cmat, dtau);
+    }
+    delete[] afft;
+    delete[] bfft;
+    delete[] cfft;
+    return;
+}
+/// @private
 /** \brief <b> Returns the result of the Matsubara convolution of two matrices. </b>
 *
 * <!-- ====== DOCUMENTATION ====== -->
@@ -598,10 +688,16 @@ void convolution_matsubara(GG &C, GG &A, GG &B, integration::Integrator<T> &I,
     assert(C.ntau() == A.ntau());
     assert(B.size1() == size1);
     assert(C.size1() == size1);
-    if (size1 == 1)
-      convolution_matsubara_dispatch<T, GG, 1>(C, A, B, I, beta);
-    else
-      convolution_matsubara_dispatch<T, GG, LARGESIZE>(C, A, B, I, beta);
+    if (CNTR_MATSUBARA_FFT_NTAU > 0 && A.ntau() >= CNTR_MATSUBARA_FFT_NTAU &&
+        A.ntau() >= 4 * I.get_k() + 2) {
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_matsubara_fft_dispatch<T, GG, SIZE1>(C, A, B, I, beta);
+        );
+    } else {
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_matsubara_dispatch<T, GG, SIZE1>(C, A, B, I, beta);
+        );
+    }
 }
 
 #ifdef CNTR_USE_OMP
@@ -693,10 +789,9 @@ void convolution_matsubara_nomp(int nomp, GG &C, GG &A, GG &B, integration::Inte
     assert(C.ntau() == A.ntau());
     assert(B.size1() == size1);
     assert(C.size1() == size1);
-    if (size1 == 1)
-      convolution_matsubara_omp_dispatch<T, GG, 1>(nomp, C, A, B, I, beta);
-    else
-      convolution_matsubara_omp_dispatch<T, GG, LARGESIZE>(nomp, C, A, B, I, beta);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        convolution_matsubara_omp_dispatch<T, GG, SIZE1>(nomp, C, A, B, I, beta);
+    );
 }
 
 #endif // CNTR_USE_OMP
@@ -1544,6 +1639,359 @@ void convolution_timestep_les(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
     delete[] cles;
     return;
 }
+
+/* #######################################################################################
+#
+#   BATCHED (GEMM) CONVOLUTION FOR LARGE MATRIX SIZE
+#
+#   For size1 >= CNTR_CONVOLUTION_GEMM_SIZE (if > 0), the history sums of convolution_timestep
+#   are evaluated as matrix products of panels: for each output time, the weighted
+#   elements A(.,m) (m = 0 ... ) are gathered into a size1 x (len*size1) panel and the
+#   elements B(m,.) into a (len*size1) x size1 panel, and the sum over m is a single
+#   product of these panels (zgemm with EIGEN_USE_MKL_ALL). Where the Gregory weights
+#   do not factorize into a weight for A and a weight for B (intervals shorter than
+#   2k+1), the elementwise sums are used.
+#
+#   The panels and sums are in the precision T of the Integrator, which may be higher
+#   than the precision GG::scalar_type in which the functions are stored
+#   (see convolution_timestep_mixed).
+#
+###########################################################################################*/
+/// @private
+/** \brief <b> Retarded convolution at a given time-step, batched into matrix products. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `convolution_timestep_ret`. For \f$ n-j \ge 2k+1 \f$ the Gregory weight
+ * > \f$ w(n-j,n-m) \f$ factorizes into \f$ \omega(n-m) \f$ (for \f$ n-m \le k \f$) and
+ * > \f$ \omega(m-j) \f$ (for \f$ m-j \le k \f$), so \f$ C^\mathrm{R}(t_n,t_j) \f$ is the
+ * > product of the weighted row \f$ A^\mathrm{R}(t_n,t_m) \f$, \f$ m=j\dots n \f$, with the
+ * > weighted column \f$ B^\mathrm{R}(t_m,t_j) \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * [int] given time-step
+ * @param C
+ * > [GG] contour Green's function
+ * @param A
+ * > [GG] contour Green's function
+ * @param Acc
+ * > [GG] complex conjugate to A
+ * @param B
+ * > [GG] contour Green's function
+ * @param Bcc
+ * > [GG] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param h
+ * > time step interval
+ */
+template <typename T, class GG>
+void convolution_timestep_ret_gemm(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
+                                   integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    typedef typename GG::scalar_type S;
+    typedef Eigen::Matrix<cplx, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rmatrix;
+    typedef Eigen::Map<rmatrix> rmap;
+    typedef Eigen::Map<Eigen::Matrix<std::complex<S>, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor> > smap;
+    int k = I.get_k(), size1 = C.size1(), sc = C.element_size(), j, j0, m, l, len;
+    cplx *result, *atemp, *btemp;
+    std::complex<S> *cret;
+    rmatrix apanel, bpanel;
+    T weight;
+
+    if (n < k) {
+        convolution_timestep_ret<S, GG, LARGESIZE>(n, C, A, Acc, B, Bcc, integration::I<S>(k),
+                                                   (S)h);
+        return;
+    }
+    assert(A.element_size() == sc && B.element_size() == sc);
+    result = new cplx[(n + 1) * sc];
+    atemp = new cplx[sc];
+    btemp = new cplx[sc];
+    for (l = 0; l < (n + 1) * sc; l++)
+        result[l] = 0;
+    // j < j0: n-j >= 2k+1, factorized weights
+    j0 = n - 2 * k;
+    apanel.resize(size1, (n + 1) * size1);
+    bpanel.resize((n + 1) * size1, size1);
+    for (m = 0; m <= n; m++) {
+        weight = h * (n - m <= k ? I.gregory_omega(n - m) : 1.0);
+        apanel.block(0, m * size1, size1, size1) =
+            weight * smap(A.retptr(n, m), size1, size1).template cast<cplx>();
+    }
+    for (j = 0; j < j0; j++) {
+        len = n - j + 1;
+        for (m = j; m <= n; m++) {
+            weight = (m - j <= k ? I.gregory_omega(m - j) : 1.0);
+            bpanel.block((m - j) * size1, 0, size1, size1) =
+                weight * smap(B.retptr(m, j), size1, size1).template cast<cplx>();
+        }
+        rmap(result + j * sc, size1, size1).noalias() +=
+            apanel.middleCols(j * size1, len * size1) * bpanel.topRows(len * size1);
+    }
+    // j >= j0: short intervals, B(m,j) with m < j continued to -Bcc(j,m)*
+    for (j = (j0 > 0 ? j0 : 0); j <= n; j++) {
+        for (m = j; m <= n; m++) {
+            weight = h * I.gregory_weights(n - j, n - m);
+            rmap(atemp, size1, size1) = smap(A.retptr(n, m), size1, size1).template cast<cplx>();
+            rmap(btemp, size1, size1) = smap(B.retptr(m, j), size1, size1).template cast<cplx>();
+            element_incr<T, LARGESIZE>(size1, result + j * sc, weight, atemp, btemp);
+        }
+        for (m = n - k; m < j; m++) {
+            weight = h * I.gregory_weights(n - j, n - m);
+            rmap(atemp, size1, size1) = smap(A.retptr(n, m), size1, size1).template cast<cplx>();
+            rmap(btemp, size1, size1) =
+                smap(Bcc.retptr(j, m), size1, size1).adjoint().template cast<cplx>();
+            element_incr<T, LARGESIZE>(size1, result + j * sc, -weight, atemp, btemp);
+        }
+    }
+    cret = C.retptr(n, 0);
+    for (l = 0; l < (n + 1) * sc; l++)
+        cret[l] = result[l];
+    delete[] result;
+    delete[] atemp;
+    delete[] btemp;
+}
+
+/// @private
+/** \brief <b> Left-mixing convolution at a given time-step, batched into matrix products. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `convolution_timestep_tv`. The contribution
+ * > \f$ \int_0^t ds A^R(t,s) B^{\rceil}(s,\tau') \f$ is computed for each \f$ \tau' \f$
+ * > as the product of the weighted row \f$ A^\mathrm{R}(t_n,t_j) \f$ with the column
+ * > \f$ B^{\rceil}(t_j,\tau') \f$, \f$ j=0\dots n \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * [int] given time-step
+ * @param C
+ * > [GG] contour Green's function
+ * @param A
+ * > [GG] contour Green's function
+ * @param Acc
+ * > [GG] complex conjugate to A
+ * @param B
+ * > [GG] contour Green's function
+ * @param Bcc
+ * > [GG] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step
+ */
+template <typename T, class GG>
+void convolution_timestep_tv_gemm(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
+                                  integration::Integrator<T> &I, T beta, T h) {
+    typedef std::complex<T> cplx;
+    typedef typename GG::scalar_type S;
+    typedef Eigen::Matrix<cplx, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rmatrix;
+    typedef Eigen::Map<rmatrix> rmap;
+    typedef Eigen::Map<Eigen::Matrix<std::complex<S>, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor> > smap;
+    int k = I.get_k(), size1 = C.size1(), sc = C.element_size(), ntau = C.ntau(), j, m, l;
+    T dtau = beta / ntau, weight;
+    cplx *ctv, *ctemp, *atv, *bmat;
+    std::complex<S> *cptr;
+    rmatrix apanel, bpanel;
+
+    if (n < k) {
+        convolution_timestep_tv<S, GG, LARGESIZE>(n, C, A, Acc, B, Bcc, integration::I<S>(k),
+                                                  (S)beta, (S)h);
+        return;
+    }
+    assert(A.element_size() == sc && B.element_size() == sc);
+    assert(A.ntau() == ntau && B.ntau() == ntau);
+    ctv = new cplx[(ntau + 1) * sc];
+    ctemp = new cplx[sc];
+    atv = new cplx[(ntau + 1) * sc];
+    bmat = new cplx[(ntau + 1) * sc];
+    // Atv * Bmat
+    for (l = 0; l < (ntau + 1) * sc; l++) {
+        atv[l] = A.tvptr(n, 0)[l];
+        bmat[l] = B.matptr(0)[l];
+    }
+    for (m = 0; m <= ntau; m++) {
+        matsubara_integral_2<T, LARGESIZE>(size1, m, ntau, ctemp, atv, bmat, I, B.sig());
+        for (l = 0; l < sc; l++)
+            ctv[m * sc + l] = dtau * ctemp[l];
+    }
+    // Aret * Btv
+    apanel.resize(size1, (n + 1) * size1);
+    bpanel.resize((n + 1) * size1, size1);
+    for (j = 0; j <= n; j++) {
+        weight = h * I.gregory_weights(n, j);
+        apanel.block(0, j * size1, size1, size1) =
+            weight * smap(A.retptr(n, j), size1, size1).template cast<cplx>();
+    }
+    for (m = 0; m <= ntau; m++) {
+        for (j = 0; j <= n; j++)
+            bpanel.block(j * size1, 0, size1, size1) =
+                smap(B.tvptr(j, m), size1, size1).template cast<cplx>();
+        rmap(ctv + m * sc, size1, size1).noalias() += apanel * bpanel;
+    }
+    cptr = C.tvptr(n, 0);
+    for (l = 0; l < (ntau + 1) * sc; l++)
+        cptr[l] = ctv[l];
+    delete[] ctv;
+    delete[] ctemp;
+    delete[] atv;
+    delete[] bmat;
+}
+
+/// @private
+/** \brief <b> Lesser convolution at a given time-step, batched into matrix products. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `convolution_timestep_les`. For each \f$ t_j \f$, the contributions
+ * > \f$ A^\rceil * B^\lceil \f$, \f$ A^< * B^\mathrm{A} \f$ and (for \f$ j \ge 2k+1 \f$)
+ * > \f$ A^\mathrm{R} * B^< \f$ are products of a gathered row of \f$ A \f$ with a
+ * > column of \f$ B \f$, which is contiguous in memory.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * [int] given time-step
+ * @param C
+ * > [GG] contour Green's function
+ * @param A
+ * > [GG] contour Green's function
+ * @param Acc
+ * > [GG] complex conjugate to A
+ * @param B
+ * > [GG] contour Green's function
+ * @param Bcc
+ * > [GG] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step
+ */
+template <typename T, class GG>
+void convolution_timestep_les_gemm(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
+                                   integration::Integrator<T> &I, T beta, T h) {
+    typedef std::complex<T> cplx;
+    typedef typename GG::scalar_type S;
+    typedef Eigen::Matrix<cplx, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rmatrix;
+    typedef Eigen::Map<rmatrix> rmap;
+    typedef Eigen::Map<Eigen::Matrix<std::complex<S>, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor> > smap;
+    int k = I.get_k(), k2 = 2 * k + 2, size1 = C.size1(), sc = C.element_size();
+    int ntau = C.ntau(), sig = A.sig(), j, m, l;
+    T dtau = beta / ntau, weight;
+    cplx *cles, *atemp, idtau = cplx(0, -dtau);
+    std::complex<S> *cptr;
+    rmatrix apanel, bpanel;
+
+    if (n < k) {
+        convolution_timestep_les<S, GG, LARGESIZE>(n, C, A, Acc, B, Bcc, integration::I<S>(k),
+                                                   (S)beta, (S)h);
+        return;
+    }
+    assert(A.element_size() == sc && B.element_size() == sc);
+    assert(A.ntau() == ntau && B.ntau() == ntau);
+    cles = new cplx[(n + 1) * sc];
+    atemp = new cplx[sc];
+    for (l = 0; l < (n + 1) * sc; l++)
+        cles[l] = 0;
+    // Atv * Bvt: Atv(j,tau) * Bcc^tv(n,beta-tau)^* * (-Bose/Fermi)
+    apanel.resize(size1, (ntau + 1) * size1);
+    bpanel.resize((ntau + 1) * size1, size1);
+    for (m = 0; m <= ntau; m++) {
+        weight = I.gregory_weights(ntau, m);
+        bpanel.block(m * size1, 0, size1, size1) =
+            (weight * idtau * (-(T)sig)) *
+            smap(Bcc.tvptr(n, ntau - m), size1, size1).adjoint().template cast<cplx>();
+    }
+    for (j = 0; j <= n; j++) {
+        for (m = 0; m <= ntau; m++)
+            apanel.block(0, m * size1, size1, size1) =
+                smap(A.tvptr(j, m), size1, size1).template cast<cplx>();
+        rmap(cles + j * sc, size1, size1).noalias() += apanel * bpanel;
+    }
+    // Ales * Badv: Ales(j,m) = -Acc^les(m,j)^dagger for m < j
+    apanel.resize(size1, (n + 1) * size1);
+    bpanel.resize((n + 1) * size1, size1);
+    for (m = 0; m <= n; m++) {
+        weight = h * I.gregory_weights(n, m);
+        bpanel.block(m * size1, 0, size1, size1) =
+            weight * smap(Bcc.retptr(n, m), size1, size1).adjoint().template cast<cplx>();
+    }
+    for (j = 0; j <= n; j++) {
+        for (m = 0; m < j; m++)
+            apanel.block(0, m * size1, size1, size1) =
+                -smap(Acc.lesptr(m, j), size1, size1).adjoint().template cast<cplx>();
+        for (m = j; m <= n; m++)
+            apanel.block(0, m * size1, size1, size1) =
+                smap(A.lesptr(j, m), size1, size1).template cast<cplx>();
+        rmap(cles + j * sc, size1, size1).noalias() += apanel * bpanel;
+    }
+    // Aret * Bles
+    for (m = 0; m <= n; m++)
+        bpanel.block(m * size1, 0, size1, size1) =
+            h * smap(B.lesptr(m, n), size1, size1).template cast<cplx>();
+    for (j = 0; j <= n; j++) {
+        if (j >= k2 - 1) {
+            for (m = 0; m <= j; m++) {
+                if (m <= k)
+                    weight = I.gregory_omega(m);
+                else if (m >= j - k)
+                    weight = I.gregory_omega(j - m);
+                else
+                    weight = 1.0;
+                apanel.block(0, m * size1, size1, size1) =
+                    weight * smap(A.retptr(j, m), size1, size1).template cast<cplx>();
+            }
+            rmap(cles + j * sc, size1, size1).noalias() +=
+                apanel.leftCols((j + 1) * size1) * bpanel.topRows((j + 1) * size1);
+        } else {
+            for (m = 0; m <= j; m++) {
+                weight = I.gregory_weights(j, m);
+                rmap(atemp, size1, size1) =
+                    smap(A.retptr(j, m), size1, size1).template cast<cplx>();
+                element_incr<T, LARGESIZE>(size1, cles + j * sc, weight, atemp,
+                                           bpanel.data() + m * sc);
+            }
+            // short interval: A(j,m), m > j, continued to -Acc(m,j)*
+            for (m = j + 1; m <= k; m++) {
+                rmap(atemp, size1, size1) =
+                    smap(Acc.retptr(m, j), size1, size1).adjoint().template cast<cplx>();
+                weight = -I.gregory_weights(j, m);
+                element_incr<T, LARGESIZE>(size1, cles + j * sc, weight, atemp,
+                                           bpanel.data() + m * sc);
+            }
+        }
+    }
+    for (m = 0; m <= n; m++) {
+        cptr = C.lesptr(m, n);
+        for (l = 0; l < sc; l++)
+            cptr[l] = cles[m * sc + l];
+    }
+    delete[] cles;
+    delete[] atemp;
+}
 /// @private
 /** \brief <b> Returns convolution of two matrices at a given time step</b>
 *
@@ -1584,6 +2032,9 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A,
                           herm_matrix<T> &Bcc, integration::Integrator<T> &I,
                           T beta, T h) {
     int size1 = C.size1(), ntau = C.ntau(), k = I.k(), n1 = (n < k ? k : n);
+    CNTR_PROFILE_SCOPE("convolution_timestep", n, profile_convolution_flops(n, ntau, size1),
+                       sizeof(std::complex<T>) * (4.0 * profile_history_elements(n, ntau, size1) +
+                                                  profile_timestep_elements(n, ntau, size1)));
     if (n == -1) {
         convolution_matsubara(C, A, B, I, beta);
         return;
@@ -1602,23 +2053,111 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A,
     assert(B.nt() >= n1);
     assert(Bcc.nt() >= n1);
     assert(C.nt() >= n);
-    if (size1 == 1) {
-        convolution_timestep_ret<T, herm_matrix<T>, 1>(n, C, A, Acc, B, Bcc,
-                                                       I, h);
-        convolution_timestep_tv<T, herm_matrix<T>, 1>(n, C, A, Acc, B, Bcc, I,
-                                                      beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, 1>(n, C, A, Acc, B, Bcc,
-                                                       I, beta, h);
+    if (size1 > 1 && CNTR_CONVOLUTION_GEMM_SIZE > 0 && size1 >= CNTR_CONVOLUTION_GEMM_SIZE) {
+        convolution_timestep_ret_gemm<T, herm_matrix<T> >(n, C, A, Acc, B, Bcc, I, h);
+        convolution_timestep_tv_gemm<T, herm_matrix<T> >(n, C, A, Acc, B, Bcc, I, beta, h);
+        convolution_timestep_les_gemm<T, herm_matrix<T> >(n, C, A, Acc, B, Bcc, I, beta, h);
     } else {
-        convolution_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc,
-                                                               B, Bcc, I, h);
-        convolution_timestep_tv<T, herm_matrix<T>, LARGESIZE>(
-            n, C, A, Acc, B, Bcc, I, beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, LARGESIZE>(
-            n, C, A, Acc, B, Bcc, I, beta, h);
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_timestep_ret<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc, I, h);
+            convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc, I, beta, h);
+            convolution_timestep_les<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc, I, beta, h);
+        );
     }
 }
 
+/** \brief <b> Returns convolution of two matrices at a given time step, in mixed precision. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Same as `convolution_timestep`, for functions which are stored in a lower precision
+* > `S` (e.g. `herm_matrix<float>`, which halves memory and bandwidth of the history),
+* > while the Gregory weights and all sums over the history are evaluated in precision `T`
+* > (e.g. `double`). Elements are converted to `T` when they are gathered into the panels
+* > of the batched convolution, and the result is rounded to `S` once. The Matsubara
+* > component and the first `SolveOrder` time steps are computed in precision `S`.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] number of the time step ('t=nh')
+* @param C
+* > [herm_matrix<S>] Matrix to which the result of the convolution is given
+* @param A
+* > [herm_matrix<S>] contour Green's function
+* @param Acc
+* > [herm_matrix<S>] complex conjugate to A
+* @param B
+* > [herm_matrix<S>] contour Green's function
+* @param Bcc
+* > [herm_matrix<S>] complex conjugate to B
+* @param beta
+* > [T] inversed temperature
+* @param h
+* > [T] time step interval
+* @param SolveOrder
+* > [int] integrator order
+*/
+template <typename T, typename S>
+void convolution_timestep_mixed(int n, herm_matrix<S> &C, herm_matrix<S> &A,
+                                herm_matrix<S> &Acc, herm_matrix<S> &B, herm_matrix<S> &Bcc,
+                                T beta, T h, int SolveOrder) {
+    int size1 = C.size1(), ntau = C.ntau(), n1 = (n < SolveOrder ? SolveOrder : n);
+    integration::Integrator<T> &I = integration::I<T>(SolveOrder);
+    if (n == -1) {
+        convolution_matsubara(C, A, B, integration::I<S>(SolveOrder), (S)beta);
+        return;
+    }
+    assert(n >= 0);
+    assert(A.size1() == size1 && Acc.size1() == size1);
+    assert(B.size1() == size1 && Bcc.size1() == size1);
+    assert(A.ntau() == ntau && Acc.ntau() == ntau);
+    assert(B.ntau() == ntau && Bcc.ntau() == ntau);
+    assert(A.nt() >= n1 && Acc.nt() >= n1);
+    assert(B.nt() >= n1 && Bcc.nt() >= n1);
+    assert(C.nt() >= n);
+    convolution_timestep_ret_gemm<T, herm_matrix<S> >(n, C, A, Acc, B, Bcc, I, h);
+    convolution_timestep_tv_gemm<T, herm_matrix<S> >(n, C, A, Acc, B, Bcc, I, beta, h);
+    convolution_timestep_les_gemm<T, herm_matrix<S> >(n, C, A, Acc, B, Bcc, I, beta, h);
+}
+/** \brief <b> Returns convolution of two hermitian matrices at a given time step, in mixed
+* precision. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Same as `convolution_timestep_mixed` for \f$A=A^\ddagger\f$, \f$B=B^\ddagger\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] number of the time step ('t=nh')
+* @param C
+* > [herm_matrix<S>] Matrix to which the result of the convolution is given
+* @param A
+* > [herm_matrix<S>] contour Green's function
+* @param B
+* > [herm_matrix<S>] contour Green's function
+* @param beta
+* > [T] inversed temperature
+* @param h
+* > [T] time step interval
+* @param SolveOrder
+* > [int] integrator order
+*/
+template <typename T, typename S>
+void convolution_timestep_mixed(int n, herm_matrix<S> &C, herm_matrix<S> &A,
+                                herm_matrix<S> &B, T beta, T h, int SolveOrder) {
+    convolution_timestep_mixed<T, S>(n, C, A, A, B, B, beta, h, SolveOrder);
+}
+
 
 /** \brief <b> Returns convolution of two matrices at a given time step</b>
 *
@@ -1659,6 +2198,9 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A,
                           herm_matrix<T> &Bcc,
                           T beta, T h, int SolveOrder) {
     int size1 = C.size1(), ntau = C.ntau(), n1 = (n < SolveOrder ? SolveOrder : n);
+    CNTR_PROFILE_SCOPE("convolution_timestep", n, profile_convolution_flops(n, ntau, size1),
+                       sizeof(std::complex<T>) * (4.0 * profile_history_elements(n, ntau, size1) +
+                                                  profile_timestep_elements(n, ntau, size1)));
     if (n == -1) {
         convolution_matsubara(C, A, B, integration::I<T>(SolveOrder), beta);
         return;
@@ -1677,21 +2219,14 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A,
     assert(B.nt() >= n1);
     assert(Bcc.nt() >= n1);
     assert(C.nt() >= n);
-    if (size1 == 1) {
-        convolution_timestep_ret<T, herm_matrix<T>, 1>(n, C, A, Acc, B, Bcc,
-                                                       integration::I<T>(SolveOrder), h);
-        convolution_timestep_tv<T, herm_matrix<T>, 1>(n, C, A, Acc, B, Bcc, integration::I<T>(SolveOrder),
-                                                      beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, 1>(n, C, A, Acc, B, Bcc,
-                                                       integration::I<T>(SolveOrder), beta, h);
-    } else {
-        convolution_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc,
-                                                               B, Bcc, integration::I<T>(SolveOrder), h);
-        convolution_timestep_tv<T, herm_matrix<T>, LARGESIZE>(
-            n, C, A, Acc, B, Bcc, integration::I<T>(SolveOrder), beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, LARGESIZE>(
-            n, C, A, Acc, B, Bcc, integration::I<T>(SolveOrder), beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        convolution_timestep_ret<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc,
+                                                           integration::I<T>(SolveOrder), h);
+        convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc,
+                                                          integration::I<T>(SolveOrder), beta, h);
+        convolution_timestep_les<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc,
+                                                           integration::I<T>(SolveOrder), beta, h);
+    );
 }
 
 /// @private
@@ -1901,10 +2436,9 @@ void convolution_matsubara(GG &C, GG &A, std::complex<T> *f0, GG &B,
     assert(C.ntau() == A.ntau());
     assert(B.size1() == size1);
     assert(C.size1() == size1);
-    if (size1 == 1)
-        convolution_matsubara_dispatch<T, GG, 1>(C, A, f0, B, I, beta);
-    else
-        convolution_matsubara_dispatch<T, GG, LARGESIZE>(C, A, f0, B, I, beta);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        convolution_matsubara_dispatch<T, GG, SIZE1>(C, A, f0, B, I, beta);
+    );
 }
 /// @private
 /** \brief <b> Retarded convolution of two matrices and a function at given time-step. </b>
@@ -2743,20 +3277,12 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A, herm_matr
     assert(B.nt() >= n1);
     assert(Bcc.nt() >= n1);
     assert(C.nt() >= n);
-    if (size1 == 1) {
-        convolution_timestep_ret<T, herm_matrix<T>, 1>(n, C, A, Acc, ft, B, Bcc, I, h);
-        convolution_timestep_tv<T, herm_matrix<T>, 1>(n, C, A, Acc, f0, ft, B, Bcc, I, beta,
-                                                      h);
-        convolution_timestep_les<T, herm_matrix<T>, 1>(n, C, A, Acc, f0, ft, B, Bcc, I, beta,
-                                                       h);
-    } else {
-        convolution_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, ft, B, Bcc, I,
-                                                               h);
-        convolution_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, f0, ft, B, Bcc,
-                                                              I, beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, f0, ft, B, Bcc,
-                                                               I, beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        convolution_timestep_ret<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft, B, Bcc, I, h);
+        convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, f0, ft, B, Bcc, I, beta, h);
+        convolution_timestep_les<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, f0, ft, B, Bcc, I, beta,
+                                                           h);
+    );
 }
 /// @private
 /** \brief <b> Returns convolution of two hermitian matrices and a function at a given time step</b>
@@ -2910,21 +3436,13 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A, herm_matr
     assert(Bcc.nt() >= n1);
     assert(ft.nt() >= n1);
     assert(C.nt() >= n);
-    if (size1 == 1) {
-        convolution_timestep_ret<T, herm_matrix<T>, 1>(n, C, A, Acc, ft.ptr(0), B, Bcc, I,
-                                                       h);
-        convolution_timestep_tv<T, herm_matrix<T>, 1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B,
-                                                      Bcc, I, beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, 1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0),
-                                                       B, Bcc, I, beta, h);
-    } else {
-        convolution_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, ft.ptr(0), B,
-                                                               Bcc, I, h);
-        convolution_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, ft.ptr(-1),
-                                                              ft.ptr(0), B, Bcc, I, beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, LARGESIZE>(
-            n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B, Bcc, I, beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        convolution_timestep_ret<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft.ptr(0), B, Bcc, I, h);
+        convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B,
+                                                          Bcc, I, beta, h);
+        convolution_timestep_les<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B,
+                                                           Bcc, I, beta, h);
+    );
 }
 
 
@@ -2989,21 +3507,16 @@ void convolution_timestep(int n, herm_matrix<T> &C, herm_matrix<T> &A, herm_matr
     assert(Bcc.nt() >= n1);
     assert(ft.nt() >= n1);
     assert(C.nt() >= n);
-    if (size1 == 1) {
-        convolution_timestep_ret<T, herm_matrix<T>, 1>(n, C, A, Acc, ft.ptr(0), B, Bcc, integration::I<T>(SolveOrder),
-                                                       h);
-        convolution_timestep_tv<T, herm_matrix<T>, 1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B,
-                                                      Bcc, integration::I<T>(SolveOrder), beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, 1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0),
-                                                       B, Bcc, integration::I<T>(SolveOrder), beta, h);
-    } else {
-        convolution_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, ft.ptr(0), B,
-                                                               Bcc, integration::I<T>(SolveOrder), h);
-        convolution_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, C, A, Acc, ft.ptr(-1),
-                                                              ft.ptr(0), B, Bcc, integration::I<T>(SolveOrder), beta, h);
-        convolution_timestep_les<T, herm_matrix<T>, LARGESIZE>(
-            n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B, Bcc, integration::I<T>(SolveOrder), beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        convolution_timestep_ret<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft.ptr(0), B, Bcc,
+                                                           integration::I<T>(SolveOrder), h);
+        convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B,
+                                                          Bcc, integration::I<T>(SolveOrder), beta,
+                                                          h);
+        convolution_timestep_les<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, ft.ptr(-1), ft.ptr(0), B,
+                                                           Bcc, integration::I<T>(SolveOrder), beta,
+                                                           h);
+    );
 }
 
 
@@ -3722,23 +4235,16 @@ void convolution_density_matrix(int n, std::complex<T> *rho, GG &A, GG &Acc, fun
     assert(Bcc.nt() >= n1);
     assert(ft.nt() >= n1);
     if (n == -1) {
-        if (size1 == 1) {
-            // note:
-            convolution_matsubara_tau_dispatch<T, GG, 1>(ntau, rho, size1, A, ft.ptr(-1), B,
-                                                         I, beta);
-        } else {
-            convolution_matsubara_tau_dispatch<T, GG, LARGESIZE>(ntau, rho, size1, A,
-                                                                 ft.ptr(-1), B, I, beta);
-        }
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_matsubara_tau_dispatch<T, GG, SIZE1>(ntau, rho, size1, A, ft.ptr(-1), B, I,
+                                                             beta);
+        );
         element_smul<T, LARGESIZE>(size1, rho, -1.0);
     } else {
-        if (size1 == 1) {
-            convolution_timestep_les_jn<T, GG, 1>(n, n, rho, size1, A, Acc, ft.ptr(-1),
-                                                  ft.ptr(0), B, Bcc, I, beta, h);
-        } else {
-            convolution_timestep_les_jn<T, GG, LARGESIZE>(
-                n, n, rho, size1, A, Acc, ft.ptr(-1), ft.ptr(0), B, Bcc, I, beta, h);
-        }
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_timestep_les_jn<T, GG, SIZE1>(n, n, rho, size1, A, Acc, ft.ptr(-1),
+                                                      ft.ptr(0), B, Bcc, I, beta, h);
+        );
         element_smul<T, LARGESIZE>(size1, rho, std::complex<T>(0, -1.0));
     }
 }
@@ -3931,23 +4437,15 @@ void convolution_density_matrix(int n, std::complex<T> *rho, GG &A, GG &Acc, GG
     assert(B.nt() >= n1);
     assert(Bcc.nt() >= n1);
     if (n == -1) {
-        if (size1 == 1) {
-            // note:
-            convolution_matsubara_tau_dispatch<T, GG, 1>(ntau, rho, size1, A, NULL, B, I,
-                                                         beta);
-        } else {
-            convolution_matsubara_tau_dispatch<T, GG, LARGESIZE>(ntau, rho, size1, A, NULL,
-                                                                 B, I, beta);
-        }
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_matsubara_tau_dispatch<T, GG, SIZE1>(ntau, rho, size1, A, NULL, B, I, beta);
+        );
         element_smul<T, LARGESIZE>(size1, rho, -1.0);
     } else {
-        if (size1 == 1) {
-            convolution_timestep_les_jn<T, GG, 1>(n, n, rho, size1, A, Acc, NULL, NULL, B,
-                                                  Bcc, I, beta, h);
-        } else {
-            convolution_timestep_les_jn<T, GG, LARGESIZE>(n, n, rho, size1, A, Acc, NULL,
-                                                          NULL, B, Bcc, I, beta, h);
-        }
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            convolution_timestep_les_jn<T, GG, SIZE1>(n, n, rho, size1, A, Acc, NULL, NULL, B, Bcc,
+                                                      I, beta, h);
+        );
         element_smul<T, LARGESIZE>(size1, rho, std::complex<T>(0, -1.0));
     }
 }
@@ -4840,48 +5338,10 @@ void convolution_timestep_new(int tstp, herm_matrix<T> &C, herm_matrix<T> &A,
     C.set_timestep_zero(tstp);
     fttemp = (tstp == -1 ? ft.ptr(-1) : ft.ptr(0));
 
-    switch (size1) {
-    case 1:
-        incr_convolution<T, herm_matrix<T>, 1>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    case 2:
-        incr_convolution<T, herm_matrix<T>, 2>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    case 3:
-        incr_convolution<T, herm_matrix<T>, 3>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    case 4:
-        incr_convolution<T, herm_matrix<T>, 4>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    case 5:
-        incr_convolution<T, herm_matrix<T>, 5>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    case 6:
-        incr_convolution<T, herm_matrix<T>, 6>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    case 8:
-        incr_convolution<T, herm_matrix<T>, 8>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1),
-                                               fttemp, B, Bcc, integration::I<T>(SolveOrder), beta,
-                                               h);
-        break;
-    default:
-        incr_convolution<T, herm_matrix<T>, LARGESIZE>(tstp, CPLX(1, 0), C, A, Acc,
-                                                       ft.ptr(-1), fttemp, B, Bcc,
-                                                       integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        incr_convolution<T, herm_matrix<T>, SIZE1>(tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1), fttemp,
+                                                   B, Bcc, integration::I<T>(SolveOrder), beta, h);
+    );
 }
 /// @private
 template <typename T>
@@ -4939,40 +5399,10 @@ void convolution_timestep_new(int tstp, herm_matrix<T> &C, herm_matrix<T> &A,
     assert(C.ntau() == Bcc.ntau());
 
     C.set_timestep_zero(tstp);
-    switch (size1) {
-    case 1:
-        incr_convolution<T, herm_matrix<T>, 1>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 2:
-        incr_convolution<T, herm_matrix<T>, 2>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 3:
-        incr_convolution<T, herm_matrix<T>, 3>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 4:
-        incr_convolution<T, herm_matrix<T>, 4>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 5:
-        incr_convolution<T, herm_matrix<T>, 5>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 6:
-        incr_convolution<T, herm_matrix<T>, 6>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 8:
-        incr_convolution<T, herm_matrix<T>, 8>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B,
-                                               Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    default:
-        incr_convolution<T, herm_matrix<T>, LARGESIZE>(
-            tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B, Bcc, integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        incr_convolution<T, herm_matrix<T>, SIZE1>(tstp, CPLX(1, 0), C, A, Acc, NULL, NULL, B, Bcc,
+                                                   integration::I<T>(SolveOrder), beta, h);
+    );
 }
 /// @private
 template <typename T>
@@ -5041,6 +5471,8 @@ template <typename T, class GG, int SIZE1>
 void incr_convolution_omp(int omp_num_threads, int tstp, CPLX alpha, GG &C, GG &A, GG &Acc,
                           CPLX *f0, CPLX *ft, GG &B, GG &Bcc, integration::Integrator<T> &I,
                           T beta, T h) {
+    // rows of all components in one pool, distributed by their cost
+    std::vector<int> owner;
 #pragma omp parallel num_threads(omp_num_threads)
     {
         int nomp = omp_get_num_threads();
@@ -5057,15 +5489,16 @@ void incr_convolution_omp(int omp_num_threads, int tstp, CPLX alpha, GG &C, GG &
             std::vector<bool> mask_ret(tstp + 1, false);
             std::vector<bool> mask_tv(ntau + 1, false);
             std::vector<bool> mask_les(tstp + 1, false);
-            for (i = 0; i <= tstp; i++)
-                if (i % nomp == tid)
-                    mask_ret[i] = true;
-            for (i = 0; i <= ntau; i++)
-                if (i % nomp == tid)
-                    mask_tv[i] = true;
-            for (i = 0; i <= tstp; i++)
-                if (mask_ret[i])
-                    mask_les[tstp - i] = true;
+#pragma omp single
+            {
+                std::vector<double> cost;
+                omp_convolution_cost(tstp, ntau, I.get_k(), tstp + 1, ntau + 1, tstp + 1, 0.0,
+                                     cost);
+                omp_balance_work(nomp, cost, owner);
+            }
+            omp_owner_mask(owner, 0, tstp + 1, tid, mask_ret);
+            omp_owner_mask(owner, tstp + 1, ntau + 1, tid, mask_tv);
+            omp_owner_mask(owner, tstp + ntau + 2, tstp + 1, tid, mask_les);
             incr_convolution_ret<T, GG, SIZE1>(tstp, mask_ret, alpha, C, A, Acc, ft, B, Bcc,
                                                I, h);
             incr_convolution_tv<T, GG, SIZE1>(tstp, mask_tv, alpha, C, A, Acc, f0, ft, B,
@@ -5145,48 +5578,11 @@ void convolution_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &C,
     C.set_timestep_zero(tstp);
     fttemp = (tstp == -1 ? ft.ptr(-1) : ft.ptr(0));
 
-    switch (size1) {
-    case 1:
-        incr_convolution_omp<T, herm_matrix<T>, 1>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 2:
-        incr_convolution_omp<T, herm_matrix<T>, 2>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 3:
-        incr_convolution_omp<T, herm_matrix<T>, 3>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 4:
-        incr_convolution_omp<T, herm_matrix<T>, 4>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 5:
-        incr_convolution_omp<T, herm_matrix<T>, 5>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 6:
-        incr_convolution_omp<T, herm_matrix<T>, 6>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 8:
-        incr_convolution_omp<T, herm_matrix<T>, 8>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    default:
-        incr_convolution_omp<T, herm_matrix<T>, LARGESIZE>(
-            omp_num_threads, tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1), fttemp, B, Bcc,
-            integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        incr_convolution_omp<T, herm_matrix<T>, SIZE1>(omp_num_threads, tstp, CPLX(1, 0), C, A, Acc,
+                                                       ft.ptr(-1), fttemp, B, Bcc,
+                                                       integration::I<T>(SolveOrder), beta, h);
+    );
 }
 
 
@@ -5257,48 +5653,11 @@ void convolution_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &C,
     C.set_timestep_zero(tstp);
     fttemp = (tstp == -1 ? ft.ptr(-1) : ft.ptr(0));
 
-    switch (size1) {
-    case 1:
-        incr_convolution_omp<T, herm_matrix<T>, 1>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 2:
-        incr_convolution_omp<T, herm_matrix<T>, 2>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 3:
-        incr_convolution_omp<T, herm_matrix<T>, 3>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 4:
-        incr_convolution_omp<T, herm_matrix<T>, 4>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 5:
-        incr_convolution_omp<T, herm_matrix<T>, 5>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 6:
-        incr_convolution_omp<T, herm_matrix<T>, 6>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 8:
-        incr_convolution_omp<T, herm_matrix<T>, 8>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, ft.ptr(-1), fttemp, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    default:
-        incr_convolution_omp<T, herm_matrix<T>, LARGESIZE>(
-            omp_num_threads, tstp, CPLX(1, 0), C, A, Acc, ft.ptr(-1), fttemp, B, Bcc,
-            integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        incr_convolution_omp<T, herm_matrix<T>, SIZE1>(omp_num_threads, tstp, CPLX(1, 0), C, A, Acc,
+                                                       ft.ptr(-1), fttemp, B, Bcc,
+                                                       integration::I<T>(SolveOrder), beta, h);
+    );
 }
 
 /// @private
@@ -5619,48 +5978,11 @@ void convolution_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &C,
     assert(C.ntau()==Bcc.ntau());
     C.set_timestep_zero(tstp);
 
-    switch (size1) {
-    case 1:
-        incr_convolution_omp<T, herm_matrix<T>, 1>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 2:
-        incr_convolution_omp<T, herm_matrix<T>, 2>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 3:
-        incr_convolution_omp<T, herm_matrix<T>, 3>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 4:
-        incr_convolution_omp<T, herm_matrix<T>, 4>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 5:
-        incr_convolution_omp<T, herm_matrix<T>, 5>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 6:
-        incr_convolution_omp<T, herm_matrix<T>, 6>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 8:
-        incr_convolution_omp<T, herm_matrix<T>, 8>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    default:
-        incr_convolution_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads, tstp, CPLX(1, 0),
-                                                           C, A, Acc, NULL, NULL, B, Bcc,
-                                                           integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        incr_convolution_omp<T, herm_matrix<T>, SIZE1>(omp_num_threads, tstp, CPLX(1, 0), C, A, Acc,
+                                                       NULL, NULL, B, Bcc, integration::I<T>(SolveOrder),
+                                                       beta, h);
+    );
 }
 
 
@@ -5726,48 +6048,11 @@ void convolution_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &C,
     assert(C.ntau()==Bcc.ntau());
     C.set_timestep_zero(tstp);
 
-    switch (size1) {
-    case 1:
-        incr_convolution_omp<T, herm_matrix<T>, 1>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 2:
-        incr_convolution_omp<T, herm_matrix<T>, 2>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 3:
-        incr_convolution_omp<T, herm_matrix<T>, 3>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 4:
-        incr_convolution_omp<T, herm_matrix<T>, 4>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 5:
-        incr_convolution_omp<T, herm_matrix<T>, 5>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 6:
-        incr_convolution_omp<T, herm_matrix<T>, 6>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 8:
-        incr_convolution_omp<T, herm_matrix<T>, 8>(omp_num_threads, tstp, CPLX(1, 0), C, A,
-                                                   Acc, NULL, NULL, B, Bcc,
-                                                   integration::I<T>(SolveOrder), beta, h);
-        break;
-    default:
-        incr_convolution_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads, tstp, CPLX(1, 0),
-                                                           C, A, Acc, NULL, NULL, B, Bcc,
-                                                           integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        incr_convolution_omp<T, herm_matrix<T>, SIZE1>(omp_num_threads, tstp, CPLX(1, 0), C, A, Acc,
+                                                       NULL, NULL, B, Bcc, integration::I<T>(SolveOrder),
+                                                       beta, h);
+    );
 }
 
 
@@ -10,6 +10,12 @@
 #include "cntr_herm_matrix_decl.hpp"
 
 #include "cntr_herm_pseudo_decl.hpp"
+#include "cntr_herm_matrix_window_decl.hpp"
+#include "cntr_herm_matrix_hodlr_decl.hpp"
+#include "cntr_dlr_decl.hpp"
+#include "cntr_herm_matrix_tti_decl.hpp"
+
+#include "cntr_dyson_workspace_decl.hpp"
 
 #include "cntr_utilities_decl.hpp"
 #include "cntr_differentiation_decl.hpp"
@@ -23,12 +29,19 @@
 #include "cntr_dyson_decl.hpp"
 #include "cntr_dyson_omp_decl.hpp"
 #include "cntr_pseudodyson_decl.hpp"
+#include "cntr_window_solvers_decl.hpp"
+#include "cntr_hodlr_convolution_decl.hpp"
+#include "cntr_dlr_solvers_decl.hpp"
+#include "cntr_gkba_decl.hpp"
+#include "cntr_tti_solvers_decl.hpp"
+#include "cntr_herm_matrix_blocks_decl.hpp"
 
 #include "cntr_bubble_decl.hpp"
 #include "cntr_distributed_array_decl.hpp"
 #include "cntr_distributed_timestep_array_decl.hpp"
 
 #include "cntr_getset_decl.hpp"
+#include "cntr_profile.hpp"
 
 #ifdef CNTR_USE_MPI
 #include "cntr_mpitools_decl.hpp"
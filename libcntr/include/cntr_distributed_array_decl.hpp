@@ -42,6 +42,7 @@ public:
   T* block(int j);
   void clear(void);
   void reset_blocksize(int blocksize);
+  void reserve(int maxlen);
   T* data(void) const {return data_;}
   int n(void) const {return n_;}
   int numblock_rank(void);
@@ -58,14 +59,21 @@ public:
 #ifndef CNTR_USE_MPI
   void mpi_bcast_block(int j);
   void mpi_bcast_all(void);
+  void mpi_start_bcast_all(void);
+  void mpi_wait(void);
   void mpi_gather(void);
 #else  // CNTR_USE_MPI==1
   void mpi_send_block(int j,int dest);
   void mpi_gather(int dest);
   void mpi_bcast_block(int j);
   void mpi_bcast_all(void);
+  void mpi_start_bcast_all(void);
+  void mpi_wait(void);
 #endif  // CNTR_USE_MPI
 private:
+#ifdef CNTR_USE_MPI
+  void mpi_set_allgather_counts(void);
+#endif
   T *data_;                  /*!< Pointer to the contiguous data */
   int n_;                    /*!< Number of data blocks */ 
   int blocksize_;            /*!< Size of one element in the block. In combination with distributed_timestep_array this number is changed with increasing timesteps. */ 
@@ -73,6 +81,11 @@ private:
   std::vector<int> tid_map_; /*!< Returns the rank owning block j \f$ tid_map(j) = tid_\f$. */
   int tid_;                  /*!< mpi rank if MPI is defined, else 0 */
   int ntasks_;               /*!< mpi size if MPI is defined, else 1 */
+#ifdef CNTR_USE_MPI
+  std::vector<int> recvcount_; /*!< Number of ints received from each rank in mpi_bcast_all */
+  std::vector<int> displs_;    /*!< Offset of the data of each rank in mpi_bcast_all */
+  MPI_Request request_;        /*!< Pending mpi_start_bcast_all, or MPI_REQUEST_NULL */
+#endif
 };
 
 } //namespace cntr
@@ -8,6 +8,7 @@
 
 #include "cntr_herm_matrix_timestep_view_decl.hpp"
 #include "cntr_distributed_array_decl.hpp"
+#include "cntr_profile.hpp"
 
 
 namespace cntr {
@@ -25,12 +26,21 @@ distributed_array<T>::distributed_array(){
 	tid_=0;
 	ntasks_=1;
 	tid_map_=std::vector<int>(0);
+#ifdef CNTR_USE_MPI
+	request_=MPI_REQUEST_NULL;
+#endif
 }
 template <typename T> distributed_array<T>::~distributed_array(){ 
+#ifdef CNTR_USE_MPI
+   mpi_wait();
+#endif
    if(data_!=0) delete [] data_;
 }
 template <typename T> distributed_array<T>::distributed_array(const distributed_array &g){
 	size_t len;
+#ifdef CNTR_USE_MPI
+	request_=MPI_REQUEST_NULL;
+#endif
 	blocksize_=g.blocksize_;
 	n_=g.n();
 	tid_=g.tid();
@@ -48,6 +58,9 @@ template <typename T> distributed_array<T>::distributed_array(const distributed_
 template <typename T> distributed_array<T> & distributed_array<T>::operator=(const distributed_array &g){
  	size_t len;
 	if(this==&g) return *this;
+#ifdef CNTR_USE_MPI
+	mpi_wait();
+#endif
 	if(data_!=0) delete [] data_;
 	blocksize_=g.blocksize();
 	n_=g.n();
@@ -92,6 +105,9 @@ template <typename T> distributed_array<T> & distributed_array<T>::operator=(con
 	blocksize_ = maxlen_;
 	n_=n;
 	tid_map_.resize(n_);
+#ifdef CNTR_USE_MPI
+	request_=MPI_REQUEST_NULL;
+#endif
 	len=maxlen_*n_;
 	if(len==0){
 		data_=0;
@@ -209,6 +225,42 @@ template <typename T> void distributed_array<T>::reset_blocksize(int blocksize){
 	blocksize_=blocksize;
 }
 
+    /** \brief <b> Increase the maximum block size, keeping the data.  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+*
+* > Reallocate the data for blocks of size up to `maxlen`. The current blocks of size
+* > blocksize() are kept; nothing is done if maxlen() is already large enough.
+* > Pointers obtained from block() before the call are invalidated.
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param maxlen
+* > New maximum size of the block
+*/
+  
+template <typename T> void distributed_array<T>::reserve(int maxlen){
+	size_t len;
+	T *data;
+	if(maxlen<=maxlen_) return;
+#ifdef CNTR_USE_MPI
+	mpi_wait();
+#endif
+	len=(size_t)maxlen*n_;
+	if(len>0){
+		data = new T [len];
+		memset(data, 0, sizeof(T)*len);
+		if(data_!=0) memcpy(data, data_, sizeof(T)*blocksize_*n_);
+		delete [] data_;
+		data_=data;
+	}
+	maxlen_=maxlen;
+}
+
 /** \brief <b> Return number of blocks on rank.  </b>
 *
 * <!-- ====== DOCUMENTATION ====== -->
@@ -269,6 +321,12 @@ template <typename T> void distributed_array<T>::mpi_bcast_block(int j){
 template <typename T> void distributed_array<T>::mpi_bcast_all(void){
     // donothing
 }
+template <typename T> void distributed_array<T>::mpi_start_bcast_all(void){
+    // donothing
+}
+template <typename T> void distributed_array<T>::mpi_wait(void){
+    // donothing
+}
 template <typename T> void distributed_array<T>::mpi_gather(void){
     // donothing
 }
@@ -354,48 +412,109 @@ template <typename T> void distributed_array<T>::mpi_bcast_block(int j){
 //* in a global allgather operation, the data are send from the root to all 
 //  other processes
 
-/** \brief <b> MPI Allgather equivalent for the distributed array   </b>
+/// @private
+/** \brief <b> Counts and offsets of the blocks of each rank for the allgather   </b>
 *
 * <!-- ====== DOCUMENTATION ====== -->
 *
 *  \par Purpose
 * <!-- ========= -->
 *
-* MPI Allgather equivalent for the distributed array, which is used when all
-* processes needs to aggregate the data.
-* <!-- ARGUMENTS
-*      ========= -->
-*
+* Sets recvcount_ and displs_ (in units of int) for the current block size. The blocks
+* of a rank are contiguous in data_, so that the whole array is exchanged by a single
+* MPI_Allgatherv.
 */
-template <typename T> void distributed_array<T>::mpi_bcast_all(void){
+template <typename T> void distributed_array<T>::mpi_set_allgather_counts(void){
 
   size_t int_per_t = sizeof(T) / sizeof(int);
   assert(int_per_t * sizeof(int) == sizeof(T));
   int element_size = blocksize_ * int_per_t;
 	
-  std::vector<int> recvcount(ntasks_, 0);
+  recvcount_.assign(ntasks_, 0);
   for(int j=0;j<n_;j++) {
     int tid_ = tid_map_[j];
-    recvcount[tid_] += 1;
+    recvcount_[tid_] += 1;
   }
   
-  std::vector<int> displs(ntasks_, 0);
+  displs_.assign(ntasks_, 0);
   for(int rank = 1; rank < ntasks_; rank++) {
-    displs[rank] = displs[rank - 1] + recvcount[rank - 1];
+    displs_[rank] = displs_[rank - 1] + recvcount_[rank - 1];
   }
   
   for(int rank = 0; rank < ntasks_; rank++) {
-    recvcount[rank] *= element_size;
-    displs[rank] *= element_size;
+    recvcount_[rank] *= element_size;
+    displs_[rank] *= element_size;
   }
+}
+
+/** \brief <b> MPI Allgather equivalent for the distributed array   </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* MPI Allgather equivalent for the distributed array, which is used when all
+* processes needs to aggregate the data.
+* <!-- ARGUMENTS
+*      ========= -->
+*
+*/
+template <typename T> void distributed_array<T>::mpi_bcast_all(void){
+
+  CNTR_PROFILE_SCOPE("distributed_array::mpi_bcast_all", CNTR_PROFILE_NO_TSTP, 0.0,
+                     (double)sizeof(T) * blocksize_ * n_);
+  mpi_wait();
+  mpi_set_allgather_counts();
 	
   // MPI::COMM_WORLD.Allgatherv(MPI::IN_PLACE, 0, MPI::DATATYPE_NULL,
 		// 	     data_, recvcount.data(), displs.data(), MPI::INT);
 
   MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, data_, 
-  	recvcount.data(), displs.data(), MPI_INT, MPI_COMM_WORLD);
+  	recvcount_.data(), displs_.data(), MPI_INT, MPI_COMM_WORLD);
 	
 }
+
+/** \brief <b> Starts a non-blocking MPI Allgather of the distributed array   </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Same as mpi_bcast_all, but returns immediately, so that the communication can
+* overlap with computations that do not touch the array. The data of the array must
+* neither be read nor modified until mpi_wait() has returned. All ranks have to start
+* their non-blocking collectives in the same order.
+* <!-- ARGUMENTS
+*      ========= -->
+*
+*/
+template <typename T> void distributed_array<T>::mpi_start_bcast_all(void){
+
+  mpi_wait();
+  mpi_set_allgather_counts();
+
+  MPI_Iallgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, data_, 
+  	recvcount_.data(), displs_.data(), MPI_INT, MPI_COMM_WORLD, &request_);
+}
+
+/** \brief <b> Completes the communication started by mpi_start_bcast_all   </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Waits until the allgather started by mpi_start_bcast_all has finished. Does nothing
+* if there is no pending communication.
+* <!-- ARGUMENTS
+*      ========= -->
+*
+*/
+template <typename T> void distributed_array<T>::mpi_wait(void){
+  if(request_!=MPI_REQUEST_NULL) MPI_Wait(&request_, MPI_STATUS_IGNORE);
+}
 #endif // CNTR_USE_MPI
 
 
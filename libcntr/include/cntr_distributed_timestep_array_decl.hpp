@@ -35,6 +35,8 @@ namespace cntr{
     // #endif
     ////////////////////////////////////////////
     void reset_tstp(int tstp);
+    void resize_nt(int nt);
+    void reserve(int nt_capacity);
     void clear(void); // se all data to zero
     ////////////////////////////////////////////
     // access:
@@ -48,12 +50,15 @@ namespace cntr{
     std::vector<cntr::herm_matrix_timestep_view<T> > G(void) const {return G_;}
     int tstp(void) const {return tstp_;}
     int nt(void) const {return nt_;}
+    int nt_capacity(void) const {return nt_capacity_;}
     int ntau(void) const {return ntau_;}
     int size(void) const {return size_;}
     int sig(void) const {return sig_;}
 
     void mpi_bcast_block(int j);
     void mpi_bcast_all(void);
+    void mpi_start_bcast_all(void);
+    void mpi_wait(void);
 
   private:
     distributed_array<std::complex<T> > data_;          /*!< Pointer to the contiguous data */
@@ -62,7 +67,8 @@ namespace cntr{
     int ntasks_;                                        /*!< MPI size if MPI is defined, else 1 */
     std::vector<cntr::herm_matrix_timestep_view<T> > G_;/*!< Vector of views to the herm_matrix_timestep */
     int tstp_;                                          /*!< Current timestep */
-    int nt_;                                            /*!< The maximum allowed timestep (set by size of data_) */
+    int nt_;                                            /*!< The maximum allowed timestep */
+    int nt_capacity_;                                   /*!< The maximum timestep for which data_ is allocated; nt_capacity_>=nt_ */
     int ntau_;                                          /*!< Number of imaginary time step*/
     int size_;                                          /*!< Size of green's function*/
     int sig_;                                           /*!< Fermion(boson)=-1(1)*/
@@ -4,6 +4,7 @@
 #include "cntr_herm_matrix_timestep_view_decl.hpp"
 #include "cntr_distributed_array_decl.hpp"
 #include "cntr_distributed_timestep_array_decl.hpp"
+#include "cntr_profile.hpp"
 
 namespace cntr {
 
@@ -19,6 +20,7 @@ template <typename T> distributed_timestep_array<T>::distributed_timestep_array(
 	G_=std::vector<cntr::herm_matrix_timestep_view<T> >(n_);
 	tstp_=-2;
 	nt_=-2;
+	nt_capacity_=-2;
 	ntau_=-1;
 	size_=0;
 	sig_=-1;	
@@ -34,6 +36,7 @@ template <typename T> distributed_timestep_array<T>::distributed_timestep_array(
 	data_=a.data(); // note: this copies the data of a
 	tstp_=a.tstp();
 	nt_=a.nt();
+	nt_capacity_=a.nt_capacity();
 	ntau_=a.ntau();
 	size_=a.size();
 	sig_=a.sig();
@@ -49,6 +52,7 @@ template <typename T> distributed_timestep_array<T>& distributed_timestep_array<
 	data_=a.data(); // note: this copies the data of a
 	tstp_=a.tstp();
 	nt_=a.nt();
+	nt_capacity_=a.nt_capacity();
 	ntau_=a.ntau();
 	size_=a.size();
 	sig_=a.sig();
@@ -94,6 +98,7 @@ template <typename T> distributed_timestep_array<T>::distributed_timestep_array(
 	ntasks_=data_.ntasks();	
 	tstp_=-2;
 	nt_=nt;
+	nt_capacity_=nt;
 	ntau_=ntau;
 	size_=size;
 	sig_=sig;
@@ -125,6 +130,56 @@ template <typename T> void distributed_timestep_array<T>::reset_tstp(int tstp){
 	for(int j=0;j<n_;j++) G_[j].set_to_data(data_.block(j),tstp_,ntau_,size_,sig_);
 }
 
+/** \brief <b> Change the maximum allowed timestep  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Change the maximum allowed timestep to nt, keeping the data of the current timestep.
+* Within nt_capacity() nothing is reallocated; beyond it, the capacity is increased by at
+* least half, such that extending the time horizon in chunks is cheap.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt
+* > New maximum allowed timestep
+*/
+  
+template <typename T> void distributed_timestep_array<T>::resize_nt(int nt){
+	assert(-1<=nt && tstp_<=nt);
+	if(nt>nt_capacity_) reserve(nt>nt_capacity_+nt_capacity_/2 ? nt : nt_capacity_+nt_capacity_/2);
+	nt_=nt;
+}
+
+/** \brief <b> Allocate the data for timesteps up to nt_capacity  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Allocate the data for timesteps up to nt_capacity, keeping the data of the current
+* timestep. The views G(j) are reset to the new data.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt_capacity
+* > Maximum timestep to allocate the data for
+*/
+  
+template <typename T> void distributed_timestep_array<T>::reserve(int nt_capacity){
+	if(nt_capacity<=nt_capacity_) return;
+	data_.reserve((ntau_+1+2*(nt_capacity+1))*size_*size_);
+	nt_capacity_=nt_capacity;
+	if(tstp_>=-1){
+		for(int j=0;j<n_;j++) G_[j].set_to_data(data_.block(j),tstp_,ntau_,size_,sig_);
+	}
+}
+
 /** \brief <b> Clear the data   </b>
 *
 * <!-- ====== DOCUMENTATION ====== -->
@@ -195,8 +250,45 @@ template <typename T> void distributed_timestep_array<T>::mpi_bcast_block(int j)
 */
   
 template <typename T> void distributed_timestep_array<T>::mpi_bcast_all(void){
+	CNTR_PROFILE_SCOPE("distributed_timestep_array::mpi_bcast_all", tstp_, 0.0,
+	                   sizeof(std::complex<T>) * n_ * profile_timestep_elements(tstp_, ntau_, size_));
 	data_.mpi_bcast_all();
 }
 
+/** \brief <b> Starts a non-blocking MPI allgather  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Non-blocking version of mpi_bcast_all. The timesteps must neither be read nor
+* modified until mpi_wait() has returned.
+* <!-- ARGUMENTS
+*      ========= -->
+*
+*/
+  
+template <typename T> void distributed_timestep_array<T>::mpi_start_bcast_all(void){
+	data_.mpi_start_bcast_all();
+}
+
+/** \brief <b> Completes the allgather started by mpi_start_bcast_all  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Waits until the allgather started by mpi_start_bcast_all has finished.
+* <!-- ARGUMENTS
+*      ========= -->
+*
+*/
+  
+template <typename T> void distributed_timestep_array<T>::mpi_wait(void){
+	data_.mpi_wait();
+}
+
 }
 #endif
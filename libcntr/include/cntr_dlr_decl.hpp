@@ -0,0 +1,200 @@
+#ifndef CNTR_DLR_DECL_H
+#define CNTR_DLR_DECL_H
+
+#include "cntr_global_settings.hpp"
+
+namespace cntr {
+
+template <typename T> class herm_matrix;
+template <typename T> class herm_matrix_timestep;
+
+template <typename T>
+/** \brief <b> Class `dlr_basis` holds a discrete Lehmann representation (DLR) of functions
+ * on the imaginary-time interval \f$[0,\beta]\f$.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Imaginary-time Green's functions with spectral support in \f$[-\omega_{max},\omega_{max}]\f$
+ *  are, to accuracy `eps`, linear combinations of the \f$r\f$ basis functions
+ *  \f[ K(\tau,\omega_l) = -\frac{e^{-\omega_l\tau}}{1+e^{-\beta\omega_l}}, \f]
+ *  where \f$r = O(\log(\Lambda)\log(1/\epsilon))\f$ and \f$\Lambda=\beta\omega_{max}\f$.
+ *  The same basis represents the left-mixing components \f$C^\rceil(t,\tau)\f$ at fixed \f$t\f$.
+ *
+ *  The DLR frequencies \f$\omega_l\f$ are selected by a pivoted QR decomposition of the
+ *  kernel on a fine composite grid, and \f$r\f$ Matsubara frequencies \f$i\nu_k\f$ are
+ *  selected in the same way from \f$|n| \le \Lambda\f$. Coefficients are obtained from the
+ *  equidistant grid \f$\tau_m = m\beta/n_\tau\f$ by a least-squares fit, and from values at
+ *  the Matsubara nodes by interpolation, where
+ *  \f[ \hat K(i\nu,\omega) = \int_0^\beta d\tau\, e^{i\nu\tau} K(\tau,\omega)
+ *    = \frac{1-\xi e^{-\beta\omega}}{(i\nu-\omega)(1+e^{-\beta\omega})}, \f]
+ *  with \f$\xi=-1\f$ for fermions and \f$\xi=+1\f$ for bosons.
+ *
+ *  Coefficient arrays store `r` elements of `size` complex numbers each, element `l` at
+ *  offset `l*size`; grid arrays store `ntau+1` such elements.
+ *
+ */
+class dlr_basis {
+  public:
+    typedef std::complex<T> cplx;
+
+    dlr_basis();
+    dlr_basis(T beta, T lambda, int ntau, int sig = -1, T eps = CNTR_DLR_EPS);
+    /** \brief <b> Number of basis functions.</b> */
+    int r(void) const { return r_; }
+    int ntau(void) const { return ntau_; }
+    int sig(void) const { return sig_; }
+    T beta(void) const { return beta_; }
+    T lambda(void) const { return lambda_; }
+    T eps(void) const { return eps_; }
+    /** \brief <b> DLR frequency \f$\omega_l\f$.</b> */
+    double omega(int l) const { return omega_(l); }
+    /** \brief <b> Index \f$n\f$ of the Matsubara node \f$i\nu_k\f$.</b> */
+    int matsubara_index(int k) const { return nu_[k]; }
+    /** \brief <b> Matsubara node \f$\nu_k\f$.</b> */
+    double matsubara_frequency(int k) const {
+        return (sig_ == -1 ? 2 * nu_[k] + 1 : 2 * nu_[k]) * M_PI / beta_;
+    }
+    double kernel(double tau, double omega) const;
+    std::complex<double> kernel_matsubara(int n, double omega) const;
+    void grid_to_coeffs(int size, cplx *f, cplx *c) const;
+    void coeffs_to_grid(int size, cplx *c, cplx *f) const;
+    void coeffs_to_matsubara(int size, cplx *c, cdmatrix &F, bool negative = false) const;
+    void matsubara_to_coeffs(int size, cdmatrix &F, cplx *c) const;
+    /** \brief <b> Overlap \f$S_{lm}=\int_0^\beta d\tau K(\tau,\omega_l)K(\beta-\tau,\omega_m)\f$.</b> */
+    const dmatrix &overlap(void) const { return overlap_; }
+
+  private:
+    /// @private
+    void build_frequencies(void);
+    /// @private
+    void build_matsubara_nodes(void);
+    /// @private
+    void build_grid(void);
+    /// @private
+    void build_overlap(void);
+
+    /// @private
+    /** \brief <b> Inverse temperature.</b> */
+    T beta_;
+    /// @private
+    /** \brief <b> Dimensionless cutoff \f$\Lambda=\beta\omega_{max}\f$.</b> */
+    T lambda_;
+    /// @private
+    /** \brief <b> Accuracy of the representation.</b> */
+    T eps_;
+    /// @private
+    /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
+    int ntau_;
+    /// @private
+    /** \brief <b> Bose = +1, Fermi =-1. </b> */
+    int sig_;
+    /// @private
+    /** \brief <b> Number of basis functions.</b> */
+    int r_;
+    /// @private
+    /** \brief <b> DLR frequencies.</b> */
+    dvector omega_;
+    /// @private
+    /** \brief <b> Matsubara indices of the interpolation nodes.</b> */
+    std::vector<int> nu_;
+    /// @private
+    /** \brief <b> QR decomposition of `cf2it_` for the least-squares fit from the equidistant grid.</b> */
+    Eigen::HouseholderQR<dmatrix> it2cf_;
+    /// @private
+    /** \brief <b> Evaluation on the equidistant grid, `(ntau+1) x r`.</b> */
+    dmatrix cf2it_;
+    /// @private
+    /** \brief <b> LU decomposition of `cf2if_` for the interpolation from the Matsubara nodes.</b> */
+    Eigen::PartialPivLU<cdmatrix> if2cf_;
+    /// @private
+    /** \brief <b> Evaluation at the Matsubara nodes, `r x r`.</b> */
+    cdmatrix cf2if_;
+    /// @private
+    /** \brief <b> Overlap of the basis functions with the reflected basis functions.</b> */
+    dmatrix overlap_;
+};
+
+template <typename T>
+/** \brief <b> Class `herm_matrix_dlr` stores the Matsubara and left-mixing components of a
+ * contour function in a discrete Lehmann representation.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The Matsubara component \f$C^\mathrm{M}(\tau)\f$ and the left-mixing components
+ *  \f$C^\rceil(t_i,\tau)\f$, \f$i=0,\dots,n_t\f$, are stored as `r` DLR coefficients
+ *  each (see `dlr_basis`), instead of `ntau+1` values on the equidistant grid.
+ *  The real-time components are not stored; they remain in a `herm_matrix`.
+ *
+ *  `set_timestep` compresses a time step of a `herm_matrix` or `herm_matrix_timestep`
+ *  (`tstp=-1` for the Matsubara component), `get_timestep` expands it back onto the
+ *  equidistant grid of the basis.
+ *
+ */
+class herm_matrix_dlr {
+  public:
+    typedef std::complex<T> cplx;
+    typedef T scalar_type;
+
+    /* construction, destruction */
+    herm_matrix_dlr();
+    ~herm_matrix_dlr();
+    herm_matrix_dlr(int nt, int r, int size1 = 1, int sig = -1);
+    herm_matrix_dlr(const herm_matrix_dlr &g);
+    herm_matrix_dlr &operator=(const herm_matrix_dlr &g);
+    void clear(void);
+    /* access size etc ... */
+    /// @private
+    int element_size(void) const { return element_size_; }
+    int size1(void) const { return size1_; }
+    int size2(void) const { return size2_; }
+    int r(void) const { return r_; }
+    int nt(void) const { return nt_; }
+    int sig(void) const { return sig_; }
+    // raw pointer to coefficients ... to be used with care
+    /// @private
+    inline cplx *tvptr(int i, int l) { return tv_ + (i * r_ + l) * element_size_; }
+    /// @private
+    inline cplx *matptr(int l) { return mat_ + l * element_size_; }
+    /* copy timesteps from and to full contour functions */
+    void set_timestep(int tstp, herm_matrix<T> &g, dlr_basis<T> &basis);
+    void set_timestep(int tstp, herm_matrix_timestep<T> &g, dlr_basis<T> &basis);
+    void get_timestep(int tstp, herm_matrix<T> &g, dlr_basis<T> &basis);
+    void get_timestep(int tstp, herm_matrix_timestep<T> &g, dlr_basis<T> &basis);
+    void set_timestep_zero(int tstp);
+
+  private:
+    /// @private
+    /** \brief <b> DLR coefficients of the left-mixing component.</b> */
+    cplx *tv_;
+    /// @private
+    /** \brief <b> DLR coefficients of the Matsubara component.</b> */
+    cplx *mat_;
+    /// @private
+    /** \brief <b> Maximum number of the time steps.</b> */
+    int nt_;
+    /// @private
+    /** \brief <b> Number of DLR coefficients.</b> */
+    int r_;
+    /// @private
+    /** \brief <b> Number of the colums in the Matrix form.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Number of the rows in the Matrix form.</b> */
+    int size2_;
+    /// @private
+    /** \brief <b> Size of the Matrix form; size1*size2. </b> */
+    int element_size_;
+    /// @private
+    /** \brief <b> Bose = +1, Fermi =-1. </b> */
+    int sig_;
+};
+
+}  // namespace cntr
+
+#endif  // CNTR_DLR_DECL_H
@@ -0,0 +1,13 @@
+#ifndef CNTR_DLR_EXTERN_TEMPLATES_H
+#define CNTR_DLR_EXTERN_TEMPLATES_H
+
+#include "cntr_dlr_decl.hpp"
+
+namespace cntr {
+
+extern template class dlr_basis<double>;
+extern template class herm_matrix_dlr<double>;
+
+}  // namespace cntr
+
+#endif  // CNTR_DLR_EXTERN_TEMPLATES_H
@@ -0,0 +1,609 @@
+#ifndef CNTR_DLR_IMPL_H
+#define CNTR_DLR_IMPL_H
+
+#include "cntr_dlr_decl.hpp"
+#include "cntr_herm_matrix_impl.hpp"
+#include "cntr_herm_matrix_timestep_impl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   DLR_BASIS: KERNEL
+#
+#   All kernels are evaluated in a form which does not overflow for large beta*omega.
+#
+########################################################################################*/
+
+/// @private
+/** \brief <b> Dimensionless DLR kernel \f$K(t,w)=-e^{-wt}/(1+e^{-w})\f$, \f$t=\tau/\beta\f$, \f$w=\beta\omega\f$.</b> */
+inline double dlr_kernel(double t, double w) {
+    if (w >= 0.0)
+        return -exp(-w * t) / (1.0 + exp(-w));
+    else
+        return -exp(w * (1.0 - t)) / (1.0 + exp(w));
+}
+
+/// @private
+/** \brief <b> \f$1/(1+e^{-w})\f$.</b> */
+inline double dlr_occupation(double w) {
+    if (w >= 0.0)
+        return 1.0 / (1.0 + exp(-w));
+    else
+        return exp(w) / (1.0 + exp(w));
+}
+
+/// @private
+/** \brief <b> Appends the Chebyshev points of the panels `[edges[i],edges[i+1]]` to `x`.</b> */
+inline void dlr_composite_chebyshev(const std::vector<double> &edges, int p,
+                                    std::vector<double> &x) {
+    int i, j;
+    double a, b;
+    for (i = 0; i + 1 < (int)edges.size(); i++) {
+        a = edges[i];
+        b = edges[i + 1];
+        for (j = p - 1; j >= 0; j--)
+            x.push_back(0.5 * (a + b) + 0.5 * (b - a) * cos((2 * j + 1) * M_PI / (2.0 * p)));
+    }
+}
+
+/* #######################################################################################
+#
+#   DLR_BASIS: CONSTRUCTION
+#
+########################################################################################*/
+template <typename T>
+dlr_basis<T>::dlr_basis() {
+    beta_ = 0;
+    lambda_ = 0;
+    eps_ = 0;
+    ntau_ = 0;
+    sig_ = -1;
+    r_ = 0;
+}
+
+/** \brief <b> Constructs the DLR basis for the inverse temperature `beta` and cutoff `lambda`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Selects the DLR frequencies and Matsubara nodes, and precomputes the transforms from
+ * > and to the equidistant grid with `ntau+1` points. `lambda` is the dimensionless cutoff
+ * > \f$\beta\omega_{max}\f$; spectral weight outside \f$[-\omega_{max},\omega_{max}]\f$ is
+ * > not represented. `ntau+1` must be at least the number of basis functions.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param beta
+ * > Inverse temperature.
+ * @param lambda
+ * > Dimensionless cutoff \f$\beta\omega_{max}\f$.
+ * @param ntau
+ * > Number of the time grids on the Matsubara axis.
+ * @param sig
+ * > Set `sig = -1` for fermions or `sig = +1` for bosons.
+ * @param eps
+ * > Accuracy of the representation.
+ */
+template <typename T>
+dlr_basis<T>::dlr_basis(T beta, T lambda, int ntau, int sig, T eps) {
+    assert(beta > 0 && lambda > 0 && ntau > 0 && sig * sig == 1 && eps > 0);
+    beta_ = beta;
+    lambda_ = lambda;
+    eps_ = eps;
+    ntau_ = ntau;
+    sig_ = sig;
+    build_frequencies();
+    build_matsubara_nodes();
+    build_grid();
+    build_overlap();
+}
+
+/// @private
+/** \brief <b> Selects the DLR frequencies by a pivoted QR decomposition of the kernel on a fine grid.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > The fine grid in \f$w=\beta\omega\f$ consists of dyadic panels \f$[0,\Lambda 2^{-m+1}],\dots,
+ * > [\Lambda/2,\Lambda]\f$ and their mirror images, the fine grid in \f$t=\tau/\beta\f$ of
+ * > panels refined dyadically towards \f$t=0\f$ and \f$t=1\f$. The frequencies of the first
+ * > `r` pivot columns, with the diagonal of R above `eps` relative to the first, are selected.
+ */
+template <typename T>
+void dlr_basis<T>::build_frequencies(void) {
+    const int p = 24;
+    double lambda = lambda_;
+    int m = (lambda > 2.0 ? (int)ceil(log(lambda) / log(2.0)) : 1), i, j;
+    std::vector<double> wedge, tedge, w, t;
+    // frequency panels
+    wedge.push_back(0.0);
+    for (i = 1; i <= m; i++)
+        wedge.push_back(lambda * pow(2.0, i - m));
+    dlr_composite_chebyshev(wedge, p, w);
+    for (i = w.size() - 1; i >= 0; i--)
+        w.push_back(-w[i]);
+    // time panels on [0,1/2], mirrored to [1/2,1]
+    tedge.push_back(0.0);
+    for (i = 1; i <= m + 1; i++)
+        tedge.push_back(pow(2.0, i - m - 2));
+    dlr_composite_chebyshev(tedge, p, t);
+    for (i = t.size() - 1; i >= 0; i--)
+        t.push_back(1.0 - t[i]);
+    dmatrix K(t.size(), w.size());
+    for (i = 0; i < (int)t.size(); i++)
+        for (j = 0; j < (int)w.size(); j++)
+            K(i, j) = dlr_kernel(t[i], w[j]);
+    Eigen::ColPivHouseholderQR<dmatrix> qr(K);
+    dvector d = qr.matrixQR().diagonal().cwiseAbs();
+    r_ = 0;
+    while (r_ < d.size() && d(r_) > eps_ * d(0))
+        r_++;
+    std::vector<double> wsel(r_);
+    for (i = 0; i < r_; i++)
+        wsel[i] = w[qr.colsPermutation().indices()(i)];
+    std::sort(wsel.begin(), wsel.end());
+    omega_.resize(r_);
+    for (i = 0; i < r_; i++)
+        omega_(i) = wsel[i] / beta_;
+}
+
+/// @private
+/** \brief <b> Selects `r` Matsubara frequencies \f$|n|\le\max(\Lambda,r)\f$ by a pivoted QR decomposition.</b> */
+template <typename T>
+void dlr_basis<T>::build_matsubara_nodes(void) {
+    int nmax = std::max((int)ceil(lambda_), r_), nn = 2 * nmax + 1, i, l;
+    cdmatrix M(r_, nn);
+    for (i = 0; i < nn; i++)
+        for (l = 0; l < r_; l++)
+            M(l, i) = kernel_matsubara(i - nmax, omega_(l));
+    Eigen::ColPivHouseholderQR<cdmatrix> qr(M);
+    nu_.resize(r_);
+    for (i = 0; i < r_; i++)
+        nu_[i] = qr.colsPermutation().indices()(i) - nmax;
+    std::sort(nu_.begin(), nu_.end());
+    cf2if_.resize(r_, r_);
+    for (i = 0; i < r_; i++)
+        for (l = 0; l < r_; l++)
+            cf2if_(i, l) = kernel_matsubara(nu_[i], omega_(l));
+    if2cf_.compute(cf2if_);
+}
+
+/// @private
+/** \brief <b> Precomputes the evaluation on, and the least-squares fit from, the equidistant grid.</b> */
+template <typename T>
+void dlr_basis<T>::build_grid(void) {
+    int m, l;
+    if (ntau_ + 1 < r_) {
+        std::cerr << "dlr_basis: ntau+1=" << ntau_ + 1 << " < r=" << r_ << std::endl;
+        abort();
+    }
+    cf2it_.resize(ntau_ + 1, r_);
+    for (m = 0; m <= ntau_; m++)
+        for (l = 0; l < r_; l++)
+            cf2it_(m, l) = kernel(m * beta_ / ntau_, omega_(l));
+    it2cf_.compute(cf2it_);
+}
+
+/// @private
+/** \brief <b> Overlap \f$S_{lm}=\int_0^\beta d\tau K(\tau,\omega_l)K(\tau,-\omega_m)\f$, with \f$K(\beta-\tau,\omega)=K(\tau,-\omega)\f$.</b> */
+template <typename T>
+void dlr_basis<T>::build_overlap(void) {
+    int l, m;
+    double a, b, c, g;
+    overlap_.resize(r_, r_);
+    for (l = 0; l < r_; l++) {
+        for (m = 0; m < r_; m++) {
+            a = beta_ * omega_(l);
+            b = beta_ * omega_(m);
+            c = a - b;
+            g = (c == 0.0 ? beta_ : -beta_ * expm1(-fabs(c)) / fabs(c));
+            if (c >= 0.0)
+                overlap_(l, m) = dlr_occupation(a) * dlr_occupation(-b) * g;
+            else
+                overlap_(l, m) = dlr_occupation(-a) * dlr_occupation(b) * g;
+        }
+    }
+}
+
+/* #######################################################################################
+#
+#   DLR_BASIS: EVALUATION AND TRANSFORMS
+#
+########################################################################################*/
+
+/** \brief <b> DLR kernel \f$K(\tau,\omega)\f$. </b> */
+template <typename T>
+double dlr_basis<T>::kernel(double tau, double omega) const {
+    return dlr_kernel(tau / beta_, beta_ * omega);
+}
+
+/** \brief <b> Matsubara transform \f$\hat K(i\nu_n,\omega)\f$ of the DLR kernel. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > \f$\nu_n=(2n+1)\pi/\beta\f$ for fermions and \f$\nu_n=2n\pi/\beta\f$ for bosons.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > Index of the Matsubara frequency.
+ * @param omega
+ * > Real frequency.
+ */
+template <typename T>
+std::complex<double> dlr_basis<T>::kernel_matsubara(int n, double omega) const {
+    double w = beta_ * omega, nu, num, den;
+    nu = (sig_ == -1 ? (2 * n + 1) : 2 * n) * M_PI / beta_;
+    if (sig_ == 1 && n == 0 && w == 0.0)
+        return -0.5 * beta_;
+    if (w >= 0.0) {
+        num = 1.0 - sig_ * exp(-w);
+        den = 1.0 + exp(-w);
+    } else {
+        num = exp(w) - sig_;
+        den = exp(w) + 1.0;
+    }
+    return num / (den * std::complex<double>(-omega, nu));
+}
+
+/** \brief <b> DLR coefficients from the values on the equidistant grid. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Least-squares fit of the `ntau+1` values `f` by `r` coefficients `c`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param size
+ * > Number of complex numbers per element.
+ * @param f
+ * > Values on the equidistant grid, `(ntau+1)*size`.
+ * @param c
+ * > On return, the coefficients, `r*size`.
+ */
+template <typename T>
+void dlr_basis<T>::grid_to_coeffs(int size, cplx *f, cplx *c) const {
+    int m, l, e;
+    dmatrix fr(ntau_ + 1, size), fi(ntau_ + 1, size), cr, ci;
+    for (m = 0; m <= ntau_; m++) {
+        for (e = 0; e < size; e++) {
+            fr(m, e) = f[m * size + e].real();
+            fi(m, e) = f[m * size + e].imag();
+        }
+    }
+    cr = it2cf_.solve(fr);
+    ci = it2cf_.solve(fi);
+    for (l = 0; l < r_; l++)
+        for (e = 0; e < size; e++)
+            c[l * size + e] = cplx(cr(l, e), ci(l, e));
+}
+
+/** \brief <b> Values on the equidistant grid from the DLR coefficients. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Evaluates \f$f(\tau_m)=\sum_l K(\tau_m,\omega_l)c_l\f$, \f$m=0,\dots,n_\tau\f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param size
+ * > Number of complex numbers per element.
+ * @param c
+ * > Coefficients, `r*size`.
+ * @param f
+ * > On return, the values on the equidistant grid, `(ntau+1)*size`.
+ */
+template <typename T>
+void dlr_basis<T>::coeffs_to_grid(int size, cplx *c, cplx *f) const {
+    int m, l, e;
+    dmatrix cr(r_, size), ci(r_, size), fr, fi;
+    for (l = 0; l < r_; l++) {
+        for (e = 0; e < size; e++) {
+            cr(l, e) = c[l * size + e].real();
+            ci(l, e) = c[l * size + e].imag();
+        }
+    }
+    fr = cf2it_ * cr;
+    fi = cf2it_ * ci;
+    for (m = 0; m <= ntau_; m++)
+        for (e = 0; e < size; e++)
+            f[m * size + e] = cplx(fr(m, e), fi(m, e));
+}
+
+/** \brief <b> Values at the Matsubara nodes from the DLR coefficients. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Row `k` of `F` is \f$\hat f(i\nu_k)=\sum_l \hat K(i\nu_k,\omega_l)c_l\f$, or
+ * > \f$\hat f(-i\nu_k)\f$ if `negative` is set.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param size
+ * > Number of complex numbers per element.
+ * @param c
+ * > Coefficients, `r*size`.
+ * @param F
+ * > On return, `r x size` matrix of the values at the Matsubara nodes.
+ * @param negative
+ * > Evaluate at \f$-i\nu_k\f$.
+ */
+template <typename T>
+void dlr_basis<T>::coeffs_to_matsubara(int size, cplx *c, cdmatrix &F, bool negative) const {
+    int l, e;
+    cdmatrix cm(r_, size);
+    for (l = 0; l < r_; l++)
+        for (e = 0; e < size; e++)
+            cm(l, e) = c[l * size + e];
+    if (negative)
+        F = cf2if_.conjugate() * cm;
+    else
+        F = cf2if_ * cm;
+}
+
+/** \brief <b> DLR coefficients from the values at the Matsubara nodes. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Inverse of `coeffs_to_matsubara`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param size
+ * > Number of complex numbers per element.
+ * @param F
+ * > `r x size` matrix of the values at the Matsubara nodes.
+ * @param c
+ * > On return, the coefficients, `r*size`.
+ */
+template <typename T>
+void dlr_basis<T>::matsubara_to_coeffs(int size, cdmatrix &F, cplx *c) const {
+    int l, e;
+    cdmatrix cm = if2cf_.solve(F);
+    for (l = 0; l < r_; l++)
+        for (e = 0; e < size; e++)
+            c[l * size + e] = cm(l, e);
+}
+
+/* #######################################################################################
+#
+#   HERM_MATRIX_DLR: CONSTRUCTION
+#
+########################################################################################*/
+template <typename T>
+herm_matrix_dlr<T>::herm_matrix_dlr() {
+    tv_ = 0;
+    mat_ = 0;
+    nt_ = -2;
+    r_ = 0;
+    size1_ = 0;
+    size2_ = 0;
+    element_size_ = 0;
+    sig_ = -1;
+}
+template <typename T>
+herm_matrix_dlr<T>::~herm_matrix_dlr() {
+    delete[] tv_;
+    delete[] mat_;
+}
+
+/** \brief <b> Initializes the `herm_matrix_dlr` class. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Allocates the DLR coefficients of the Matsubara and left-mixing components,
+ * > which are set to zero.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nt
+ * > Number of the time steps; `nt=-1` stores only the Matsubara component.
+ * @param r
+ * > Number of DLR coefficients, `dlr_basis::r()`.
+ * @param size1
+ * > Matrix rank of the contour function.
+ * @param sig
+ * > Set `sig = -1` for fermions or `sig = +1` for bosons.
+ */
+template <typename T>
+herm_matrix_dlr<T>::herm_matrix_dlr(int nt, int r, int size1, int sig) {
+    assert(nt >= -1 && r > 0 && size1 > 0 && sig * sig == 1);
+    nt_ = nt;
+    r_ = r;
+    size1_ = size1;
+    size2_ = size1;
+    element_size_ = size1 * size1;
+    sig_ = sig;
+    tv_ = new cplx[(nt_ + 1) * r_ * element_size_];
+    mat_ = new cplx[r_ * element_size_];
+    memset(tv_, 0, sizeof(cplx) * (nt_ + 1) * r_ * element_size_);
+    memset(mat_, 0, sizeof(cplx) * r_ * element_size_);
+}
+template <typename T>
+herm_matrix_dlr<T>::herm_matrix_dlr(const herm_matrix_dlr &g) {
+    nt_ = g.nt_;
+    r_ = g.r_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    if (size1_ > 0) {
+        tv_ = new cplx[(nt_ + 1) * r_ * element_size_];
+        mat_ = new cplx[r_ * element_size_];
+        memcpy(tv_, g.tv_, sizeof(cplx) * (nt_ + 1) * r_ * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * r_ * element_size_);
+    } else {
+        tv_ = 0;
+        mat_ = 0;
+    }
+}
+template <typename T>
+herm_matrix_dlr<T> &herm_matrix_dlr<T>::operator=(const herm_matrix_dlr &g) {
+    if (this == &g)
+        return *this;
+    delete[] tv_;
+    delete[] mat_;
+    nt_ = g.nt_;
+    r_ = g.r_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    if (size1_ > 0) {
+        tv_ = new cplx[(nt_ + 1) * r_ * element_size_];
+        mat_ = new cplx[r_ * element_size_];
+        memcpy(tv_, g.tv_, sizeof(cplx) * (nt_ + 1) * r_ * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * r_ * element_size_);
+    } else {
+        tv_ = 0;
+        mat_ = 0;
+    }
+    return *this;
+}
+
+/** \brief <b> Sets all coefficients to zero. </b> */
+template <typename T>
+void herm_matrix_dlr<T>::clear(void) {
+    if (size1_ == 0)
+        return;
+    memset(tv_, 0, sizeof(cplx) * (nt_ + 1) * r_ * element_size_);
+    memset(mat_, 0, sizeof(cplx) * r_ * element_size_);
+}
+
+/** \brief <b> Sets the coefficients of time step `tstp` to zero (`tstp=-1`: Matsubara). </b> */
+template <typename T>
+void herm_matrix_dlr<T>::set_timestep_zero(int tstp) {
+    assert(-1 <= tstp && tstp <= nt_);
+    if (tstp == -1)
+        memset(mat_, 0, sizeof(cplx) * r_ * element_size_);
+    else
+        memset(tvptr(tstp, 0), 0, sizeof(cplx) * r_ * element_size_);
+}
+
+/* #######################################################################################
+#
+#   HERM_MATRIX_DLR: COMPRESSION AND EXPANSION
+#
+########################################################################################*/
+
+/** \brief <b> Compresses time step `tstp` of a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp=-1` the Matsubara component \f$g^\mathrm{M}(\tau_m)\f$, otherwise the
+ * > left-mixing component \f$g^\rceil(t_{tstp},\tau_m)\f$ is fitted by DLR coefficients.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param g
+ * > The `herm_matrix`, with `g.ntau()==basis.ntau()`.
+ * @param basis
+ * > The DLR basis.
+ */
+template <typename T>
+void herm_matrix_dlr<T>::set_timestep(int tstp, herm_matrix<T> &g, dlr_basis<T> &basis) {
+    assert(-1 <= tstp && tstp <= nt_ && tstp <= g.nt());
+    assert(g.ntau() == basis.ntau() && r_ == basis.r());
+    assert(g.size1() == size1_ && g.sig() == sig_ && basis.sig() == sig_);
+    if (tstp == -1)
+        basis.grid_to_coeffs(element_size_, g.matptr(0), mat_);
+    else
+        basis.grid_to_coeffs(element_size_, g.tvptr(tstp, 0), tvptr(tstp, 0));
+}
+
+/** \brief <b> Compresses a `herm_matrix_timestep` at time step `tstp`. </b> */
+template <typename T>
+void herm_matrix_dlr<T>::set_timestep(int tstp, herm_matrix_timestep<T> &g,
+                                      dlr_basis<T> &basis) {
+    assert(-1 <= tstp && tstp <= nt_ && tstp == g.tstp());
+    assert(g.ntau() == basis.ntau() && r_ == basis.r());
+    assert(g.size1() == size1_ && g.sig() == sig_ && basis.sig() == sig_);
+    if (tstp == -1)
+        basis.grid_to_coeffs(element_size_, g.matptr(0), mat_);
+    else
+        basis.grid_to_coeffs(element_size_, g.tvptr(0), tvptr(tstp, 0));
+}
+
+/** \brief <b> Expands time step `tstp` onto the equidistant grid of a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp=-1` the Matsubara component, otherwise the left-mixing component at
+ * > `tstp` is evaluated on the grid. The other components of `g` are untouched.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param g
+ * > The `herm_matrix`, with `g.ntau()==basis.ntau()`.
+ * @param basis
+ * > The DLR basis.
+ */
+template <typename T>
+void herm_matrix_dlr<T>::get_timestep(int tstp, herm_matrix<T> &g, dlr_basis<T> &basis) {
+    assert(-1 <= tstp && tstp <= nt_ && tstp <= g.nt());
+    assert(g.ntau() == basis.ntau() && r_ == basis.r());
+    assert(g.size1() == size1_ && g.sig() == sig_);
+    if (tstp == -1)
+        basis.coeffs_to_grid(element_size_, mat_, g.matptr(0));
+    else
+        basis.coeffs_to_grid(element_size_, tvptr(tstp, 0), g.tvptr(tstp, 0));
+}
+
+/** \brief <b> Expands time step `tstp` onto the equidistant grid of a `herm_matrix_timestep`. </b> */
+template <typename T>
+void herm_matrix_dlr<T>::get_timestep(int tstp, herm_matrix_timestep<T> &g,
+                                      dlr_basis<T> &basis) {
+    assert(-1 <= tstp && tstp <= nt_ && tstp == g.tstp());
+    assert(g.ntau() == basis.ntau() && r_ == basis.r());
+    assert(g.size1() == size1_ && g.sig() == sig_);
+    if (tstp == -1)
+        basis.coeffs_to_grid(element_size_, mat_, g.matptr(0));
+    else
+        basis.coeffs_to_grid(element_size_, tvptr(tstp, 0), g.tvptr(0));
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_DLR_IMPL_H
@@ -0,0 +1,51 @@
+#ifndef CNTR_DLR_SOLVERS_DECL_H
+#define CNTR_DLR_SOLVERS_DECL_H
+
+#include "cntr_global_settings.hpp"
+#include "integration.hpp"
+
+namespace cntr {
+
+  template <typename T> class function;
+  template <typename T> class herm_matrix;
+  template <typename T> class dlr_basis;
+  template <typename T> class herm_matrix_dlr;
+
+/*###########################################################################################
+#
+#   CONVOLUTIONS AND SOLVERS IN THE DISCRETE LEHMANN REPRESENTATION
+#
+#   The imaginary-time integrals are evaluated at the r Matsubara nodes of the DLR basis,
+#   where convolutions are products, so that the cost is O(r) instead of O(ntau) per
+#   element. The Matsubara and left-mixing components are herm_matrix_dlr, the real-time
+#   components of the kernels stay in herm_matrix.
+#
+###########################################################################################*/
+
+  template <typename T>
+  void convolution_mat_dlr(herm_matrix_dlr<T> &C, herm_matrix_dlr<T> &A, herm_matrix_dlr<T> &B,
+    dlr_basis<T> &basis);
+  /// @private
+  template <typename T>
+  void convolution_timestep_tv_dlr(int n, herm_matrix_dlr<T> &C, herm_matrix<T> &A,
+    herm_matrix<T> &Acc, herm_matrix_dlr<T> &Ad, herm_matrix_dlr<T> &Bd,
+    integration::Integrator<T> &I, T h, dlr_basis<T> &basis);
+  template <typename T>
+  void convolution_timestep_tv_dlr(int n, herm_matrix_dlr<T> &C, herm_matrix<T> &A,
+    herm_matrix<T> &Acc, herm_matrix_dlr<T> &Ad, herm_matrix_dlr<T> &Bd, T h,
+    dlr_basis<T> &basis, int SolveOrder=MAX_SOLVE_ORDER);
+  /// @private
+  template <typename T>
+  void convolution_timestep_les_tvvt_dlr(int n, int j1, int j2, std::complex<T> *cles,
+    herm_matrix_dlr<T> &A, herm_matrix_dlr<T> &Bcc, dlr_basis<T> &basis);
+
+  template <typename T>
+  void dyson_mat_dlr(herm_matrix_dlr<T> &G, T mu, function<T> &H, herm_matrix_dlr<T> &Sigma,
+    dlr_basis<T> &basis, const bool force_hermitian=true);
+  template <typename T>
+  void vie2_mat_dlr(herm_matrix_dlr<T> &G, herm_matrix_dlr<T> &F, herm_matrix_dlr<T> &Q,
+    dlr_basis<T> &basis);
+
+}  // namespace cntr
+
+#endif  // CNTR_DLR_SOLVERS_DECL_H
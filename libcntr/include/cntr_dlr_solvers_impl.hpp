@@ -0,0 +1,352 @@
+#ifndef CNTR_DLR_SOLVERS_IMPL_H
+#define CNTR_DLR_SOLVERS_IMPL_H
+
+#include "cntr_dlr_solvers_decl.hpp"
+#include "cntr_elements.hpp"
+#include "cntr_dlr_impl.hpp"
+#include "cntr_function_impl.hpp"
+
+namespace cntr {
+
+/// @private
+/** \brief <b> Element `k` of an `r x size` matrix of Matsubara values as a `size1 x size1` matrix.</b> */
+inline void dlr_get_element(cdmatrix &F, int k, int size1, cdmatrix &M) {
+    int i, j;
+    M.resize(size1, size1);
+    for (i = 0; i < size1; i++)
+        for (j = 0; j < size1; j++)
+            M(i, j) = F(k, i * size1 + j);
+}
+
+/// @private
+/** \brief <b> Sets element `k` of an `r x size` matrix of Matsubara values.</b> */
+inline void dlr_set_element(cdmatrix &F, int k, int size1, const cdmatrix &M) {
+    int i, j;
+    for (i = 0; i < size1; i++)
+        for (j = 0; j < size1; j++)
+            F(k, i * size1 + j) = M(i, j);
+}
+
+/** \brief <b> Matsubara convolution \f$C^M=A^M*B^M\f$ in the DLR basis. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$ C^M(\tau) = \int_0^\beta dx A^M(\tau-x) B^M(x)\f$ as the product
+ * > \f$\hat C(i\nu_k)=\hat A(i\nu_k)\hat B(i\nu_k)\f$ at the Matsubara nodes.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param C
+ * > [herm_matrix_dlr] Matsubara component of the result.
+ * @param A
+ * > [herm_matrix_dlr] contour function.
+ * @param B
+ * > [herm_matrix_dlr] contour function.
+ * @param basis
+ * > [dlr_basis] DLR basis.
+ */
+template <typename T>
+void convolution_mat_dlr(herm_matrix_dlr<T> &C, herm_matrix_dlr<T> &A, herm_matrix_dlr<T> &B,
+                         dlr_basis<T> &basis) {
+    int r = basis.r(), size1 = C.size1(), sc = C.element_size(), k;
+    cdmatrix FA, FB, FC(r, sc), a, b;
+    assert(A.r() == r && B.r() == r && C.r() == r);
+    assert(A.size1() == size1 && B.size1() == size1);
+    basis.coeffs_to_matsubara(sc, A.matptr(0), FA);
+    basis.coeffs_to_matsubara(sc, B.matptr(0), FB);
+    for (k = 0; k < r; k++) {
+        dlr_get_element(FA, k, size1, a);
+        dlr_get_element(FB, k, size1, b);
+        dlr_set_element(FC, k, size1, a * b);
+    }
+    basis.matsubara_to_coeffs(sc, FC, C.matptr(0));
+}
+
+/// @private
+/** \brief <b> Left-mixing convolution at a given time step in the DLR basis. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Here we calculate, as `convolution_timestep_tv`,
+ * > \f{eqnarray*}{
+ *     C^{\rceil}(t,\tau') &=& \int_0^\beta ds  A^{\rceil}(t,s) B^M(s - \tau')
+ *                       + \int_0^t ds A^R(t,s) B^{\rceil}(s,\tau') \f}
+ * > at `t = n h`. The first term is the product \f$\hat A^\rceil(t,i\nu_k)\hat B^M(-i\nu_k)\f$
+ * > at the Matsubara nodes, the second term is integrated directly on the DLR coefficients
+ * > of \f$B^\rceil\f$. The cost is \f$O(r(n+r))\f$ instead of \f$O(n_\tau(n+n_\tau))\f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param C
+ * > [herm_matrix_dlr] left-mixing component at `n` of the result.
+ * @param A
+ * > [herm_matrix] contour function, retarded component up to `max(n,k)`.
+ * @param Acc
+ * > [herm_matrix] hermitian conjugate of A.
+ * @param Ad
+ * > [herm_matrix_dlr] left-mixing component of A at `n`.
+ * @param Bd
+ * > [herm_matrix_dlr] Matsubara and left-mixing components of B up to `max(n,k)`.
+ * @param I
+ * > [Integrator] integrator class
+ * @param h
+ * > time step
+ * @param basis
+ * > [dlr_basis] DLR basis.
+ */
+template <typename T>
+void convolution_timestep_tv_dlr(int n, herm_matrix_dlr<T> &C, herm_matrix<T> &A,
+                                 herm_matrix<T> &Acc, herm_matrix_dlr<T> &Ad,
+                                 herm_matrix_dlr<T> &Bd, integration::Integrator<T> &I, T h,
+                                 dlr_basis<T> &basis) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), n1 = (n > k ? n : k), r = basis.r(), size1 = C.size1();
+    int sc = C.element_size(), j, l;
+    T weight;
+    cdmatrix FA, FB, FC(r, sc), a, b;
+    cplx *atemp;
+
+    assert(Ad.r() == r && Bd.r() == r && C.r() == r);
+    assert(A.size1() == size1 && Ad.size1() == size1 && Bd.size1() == size1);
+    assert(A.nt() >= n1 && Acc.nt() >= n1 && Bd.nt() >= n1);
+    assert(Ad.nt() >= n && C.nt() >= n);
+
+    // CONTRIBUTION FROM Atv * Bmat: product at the Matsubara nodes
+    basis.coeffs_to_matsubara(sc, Ad.tvptr(n, 0), FA);
+    basis.coeffs_to_matsubara(sc, Bd.matptr(0), FB, true);
+    for (l = 0; l < r; l++) {
+        dlr_get_element(FA, l, size1, a);
+        dlr_get_element(FB, l, size1, b);
+        dlr_set_element(FC, l, size1, a * b);
+    }
+    basis.matsubara_to_coeffs(sc, FC, C.tvptr(n, 0));
+
+    // CONTRIBUTION FROM Aret * Btv: on the DLR coefficients
+    atemp = new cplx[sc];
+    for (j = 0; j <= n1; j++) {
+        weight = I.gregory_weights(n, j);
+        if (n < j) {
+            element_conj<T, LARGESIZE>(size1, atemp, Acc.retptr(j, n));
+            element_smul<T, LARGESIZE>(size1, atemp, -1);
+        } else {
+            element_set<T, LARGESIZE>(size1, atemp, A.retptr(n, j));
+        }
+        element_smul<T, LARGESIZE>(size1, atemp, h * weight);
+        for (l = 0; l < r; l++)
+            element_incr<T, LARGESIZE>(size1, C.tvptr(n, l), atemp, Bd.tvptr(j, l));
+    }
+    delete[] atemp;
+}
+
+/** \brief <b> Left-mixing convolution at a given time step in the DLR basis. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as above, with the integrator of order `SolveOrder`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param C
+ * > [herm_matrix_dlr] left-mixing component at `n` of the result.
+ * @param A
+ * > [herm_matrix] contour function, retarded component up to `max(n,k)`.
+ * @param Acc
+ * > [herm_matrix] hermitian conjugate of A.
+ * @param Ad
+ * > [herm_matrix_dlr] left-mixing component of A at `n`.
+ * @param Bd
+ * > [herm_matrix_dlr] Matsubara and left-mixing components of B up to `max(n,k)`.
+ * @param h
+ * > time step
+ * @param basis
+ * > [dlr_basis] DLR basis.
+ * @param SolveOrder
+ * > [int] order of integration
+ */
+template <typename T>
+void convolution_timestep_tv_dlr(int n, herm_matrix_dlr<T> &C, herm_matrix<T> &A,
+                                 herm_matrix<T> &Acc, herm_matrix_dlr<T> &Ad,
+                                 herm_matrix_dlr<T> &Bd, T h, dlr_basis<T> &basis,
+                                 int SolveOrder) {
+    convolution_timestep_tv_dlr(n, C, A, Acc, Ad, Bd, integration::I<T>(SolveOrder), h, basis);
+}
+
+/// @private
+/** \brief <b> Calculation of \f$C = A^{\rceil}*B^{\lceil}\f$ at a given time-step in the DLR basis. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Adds, as `convolution_timestep_les_tvvt`, the contribution
+ * > \f$ -i \int_0^\beta d\tau A^\rceil(t_j,\tau) B^\lceil(\tau,t_n) \f$ with
+ * > \f$ B^\lceil(\tau,t) = -\xi [B_{cc}^\rceil(t,\beta-\tau)]^\dagger \f$ to `cles[j]`,
+ * > `j1 <= j <= j2`. With the overlap matrix of the basis the integral is a sum over
+ * > the DLR coefficients, \f$O(r)\f$ per `j` instead of \f$O(n_\tau)\f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param j1
+ * > [int] first row
+ * @param j2
+ * > [int] last row
+ * @param cles
+ * > [std::complex] part of the lesser component, `(j2+1)*element_size`
+ * @param A
+ * > [herm_matrix_dlr] left-mixing component of A for `j1...j2`.
+ * @param Bcc
+ * > [herm_matrix_dlr] left-mixing component of the hermitian conjugate of B at `n`.
+ * @param basis
+ * > [dlr_basis] DLR basis.
+ */
+template <typename T>
+void convolution_timestep_les_tvvt_dlr(int n, int j1, int j2, std::complex<T> *cles,
+                                       herm_matrix_dlr<T> &A, herm_matrix_dlr<T> &Bcc,
+                                       dlr_basis<T> &basis) {
+    typedef std::complex<T> cplx;
+    int r = basis.r(), size1 = A.size1(), sc = A.element_size(), sig = A.sig(), j, l, m;
+    const dmatrix &S = basis.overlap();
+    cplx *x, *btemp;
+
+    assert(A.r() == r && Bcc.r() == r && Bcc.size1() == size1 && Bcc.sig() == sig);
+    assert(0 <= j1 && j1 <= j2 && j2 <= A.nt() && n <= Bcc.nt());
+
+    // x_l = i sig sum_m S_lm Bcc_m^dagger
+    x = new cplx[r * sc];
+    btemp = new cplx[sc];
+    memset(x, 0, sizeof(cplx) * r * sc);
+    for (m = 0; m < r; m++) {
+        element_conj<T, LARGESIZE>(size1, btemp, Bcc.tvptr(n, m));
+        for (l = 0; l < r; l++)
+            element_incr<T, LARGESIZE>(size1, x + l * sc, cplx(0, sig * S(l, m)), btemp);
+    }
+    for (j = j1; j <= j2; j++) {
+        for (l = 0; l < r; l++)
+            element_incr<T, LARGESIZE>(size1, cles + j * sc, A.tvptr(j, l), x + l * sc);
+    }
+    delete[] btemp;
+    delete[] x;
+}
+
+/** \brief <b> Solves the Dyson equation on the Matsubara axis in the DLR basis. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Solves \f$ [-\partial_\tau + \mu - H]G^M - \Sigma^M*G^M = \delta \f$ as
+ * > \f$ \hat G(i\nu_k) = [i\nu_k + \mu - H - \hat\Sigma(i\nu_k)]^{-1} \f$ at the `r` Matsubara
+ * > nodes of the basis, and interpolates the DLR coefficients of \f$G^M\f$ from these values.
+ * > Unlike `dyson_mat`, no iteration and no Matsubara grid of size `ntau` are needed.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param G
+ * > [herm_matrix_dlr] Matsubara component of the solution.
+ * @param mu
+ * > chemical potential
+ * @param H
+ * > [function] time-dependent Hamiltonian, the value at `-1` is used.
+ * @param Sigma
+ * > [herm_matrix_dlr] Matsubara component of the self-energy.
+ * @param basis
+ * > [dlr_basis] DLR basis.
+ * @param force_hermitian
+ * > [const bool] symmetrize the coefficients (default: true)
+ */
+template <typename T>
+void dyson_mat_dlr(herm_matrix_dlr<T> &G, T mu, function<T> &H, herm_matrix_dlr<T> &Sigma,
+                   dlr_basis<T> &basis, const bool force_hermitian) {
+    typedef std::complex<T> cplx;
+    int r = basis.r(), size1 = G.size1(), sg = G.element_size(), k, l;
+    cdmatrix FS, FG(r, sg), s, h0, one = cdmatrix::Identity(size1, size1), tmp;
+    cplx *gtemp;
+
+    assert(Sigma.r() == r && G.r() == r && Sigma.size1() == size1 && H.size1() == size1);
+    assert(G.sig() == basis.sig() && Sigma.sig() == basis.sig());
+
+    H.get_value(-1, h0);
+    basis.coeffs_to_matsubara(sg, Sigma.matptr(0), FS);
+    for (k = 0; k < r; k++) {
+        dlr_get_element(FS, k, size1, s);
+        tmp = std::complex<double>(mu, basis.matsubara_frequency(k)) * one - h0 - s;
+        dlr_set_element(FG, k, size1, tmp.inverse());
+    }
+    basis.matsubara_to_coeffs(sg, FG, G.matptr(0));
+    if (force_hermitian) {
+        gtemp = new cplx[sg];
+        for (l = 0; l < r; l++) {
+            element_conj<T, LARGESIZE>(size1, gtemp, G.matptr(l));
+            element_incr<T, LARGESIZE>(size1, G.matptr(l), gtemp);
+            element_smul<T, LARGESIZE>(size1, G.matptr(l), 0.5);
+        }
+        delete[] gtemp;
+    }
+}
+
+/** \brief <b> Solves the linear Volterra integral equation on the Matsubara axis in the DLR basis. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Solves \f$(1+F)*G=Q\f$ on the Matsubara axis as
+ * > \f$ \hat G(i\nu_k) = [1 + \hat F(i\nu_k)]^{-1}\hat Q(i\nu_k) \f$ at the `r` Matsubara nodes.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param G
+ * > [herm_matrix_dlr] Matsubara component of the solution.
+ * @param F
+ * > [herm_matrix_dlr] Matsubara component of the kernel.
+ * @param Q
+ * > [herm_matrix_dlr] Matsubara component of the source term.
+ * @param basis
+ * > [dlr_basis] DLR basis.
+ */
+template <typename T>
+void vie2_mat_dlr(herm_matrix_dlr<T> &G, herm_matrix_dlr<T> &F, herm_matrix_dlr<T> &Q,
+                  dlr_basis<T> &basis) {
+    int r = basis.r(), size1 = G.size1(), sg = G.element_size(), k;
+    cdmatrix FF, FQ, FG(r, sg), f, q, one = cdmatrix::Identity(size1, size1);
+
+    assert(F.r() == r && Q.r() == r && G.r() == r);
+    assert(F.size1() == size1 && Q.size1() == size1);
+
+    basis.coeffs_to_matsubara(sg, F.matptr(0), FF);
+    basis.coeffs_to_matsubara(sg, Q.matptr(0), FQ);
+    for (k = 0; k < r; k++) {
+        dlr_get_element(FF, k, size1, f);
+        dlr_get_element(FQ, k, size1, q);
+        dlr_set_element(FG, k, size1, (one + f).partialPivLu().solve(q));
+    }
+    basis.matsubara_to_coeffs(sg, FG, G.matptr(0));
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_DLR_SOLVERS_IMPL_H
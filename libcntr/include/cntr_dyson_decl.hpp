@@ -3,11 +3,13 @@
 
 #include "cntr_global_settings.hpp"
 #include "integration.hpp"
+#include <vector>
 
 namespace cntr {
 
   template <typename T> class function;
   template <typename T> class herm_matrix;
+  template <typename T> class dyson_workspace;
 
 /*###########################################################################################
 #
@@ -20,6 +22,21 @@ namespace cntr {
 ###########################################################################################*/
 // internal interface 
   /// @private
+  template <typename T, class GG, int SIZE1>
+  void dyson_timestep_ret(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
+        integration::Integrator<T> &I, T h,
+        dyson_workspace<T> &ws = dyson_workspace<T>::local());
+  /// @private
+  template <typename T, class GG, int SIZE1>
+  void dyson_timestep_tv(int n, GG &G, T mu, std::complex<T> *Hn, GG &Sigma,
+        integration::Integrator<T> &I, T beta, T h,
+        dyson_workspace<T> &ws = dyson_workspace<T>::local());
+  /// @private
+  template <typename T, class GG, int SIZE1>
+  void dyson_timestep_les(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
+        integration::Integrator<T> &I, T beta, T h,
+        dyson_workspace<T> &ws = dyson_workspace<T>::local());
+  /// @private
   template <typename T>
   void dyson_mat_fourier(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function<T> &H, T beta,
     int order = 3);
@@ -65,7 +82,8 @@ namespace cntr {
   /// @private
   template <typename T>
   void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
-    integration::Integrator<T> &I, T beta, T h);
+    integration::Integrator<T> &I, T beta, T h,
+    dyson_workspace<T> &ws = dyson_workspace<T>::local());
   /// @private
   template <typename T>
   void dyson(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
@@ -92,6 +110,15 @@ namespace cntr {
   void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma, T beta, T h, 
     const int SolveOrder=MAX_SOLVE_ORDER);
 
+  template <typename T>
+  void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma, T beta, T h,
+    dyson_workspace<T> &ws, const int SolveOrder=MAX_SOLVE_ORDER);
+
+  template <typename T>
+  void dyson_timestep_batch(int n, std::vector<herm_matrix<T> *> &G, T mu,
+    std::vector<function<T> *> &H, std::vector<herm_matrix<T> *> &Sigma, T beta, T h,
+    const int SolveOrder=MAX_SOLVE_ORDER);
+
   template <typename T>
   void dyson(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma, T beta, T h, 
     const int SolveOrder=MAX_SOLVE_ORDER, const int matsubara_method=CNTR_MAT_FIXPOINT,
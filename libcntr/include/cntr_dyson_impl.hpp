@@ -4,6 +4,7 @@
 #include "cntr_dyson_decl.hpp"
 //#include "cntr_exception.hpp"
 #include "cntr_elements.hpp"
+#include "cntr_profile.hpp"
 #include "cntr_function_decl.hpp"
 #include "cntr_herm_matrix_decl.hpp"
 #include "cntr_matsubara_impl.hpp"
@@ -11,6 +12,7 @@
 #include "cntr_equilibrium_decl.hpp"
 #include "cntr_vie2_decl.hpp"
 #include "cntr_utilities_decl.hpp"
+#include "cntr_dyson_workspace_decl.hpp"
 
 namespace cntr {
 
@@ -78,7 +80,8 @@ namespace cntr {
 */
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_ret(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
-                        integration::Integrator<T> &I, T h) {
+                        integration::Integrator<T> &I, T h,
+                        dyson_workspace<T> &ws) {
     typedef std::complex<T> cplx;
     int k = I.get_k(), k1 = k + 1, k2 = 2 * k1;
     int ss, sg, n1, l, j, i, p, q, m, j1, j2, size1 = G.size1();
@@ -89,13 +92,14 @@ void dyson_timestep_ret(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
 
     ss = Sigma.element_size();
     sg = G.element_size();
-    gtemp = new cplx[k * sg];
-    diffw = new cplx[k1 + 1];
-    qq = new cplx[(n + 1) * sg];
-    one = new cplx[sg];
-    mm = new cplx[k * k * sg];
-    hj = new cplx[sg];
-    stemp = new cplx[sg]; // sic
+    ws.reserve(n, G.ntau(), size1, k);
+    gtemp = ws.gtemp();
+    diffw = ws.diffw();
+    qq = ws.qq();
+    one = ws.one();
+    mm = ws.mm();
+    hj = ws.htemp();
+    stemp = ws.stemp(); // sic
     element_set<T, SIZE1>(size1, one, 1);
     // check consistency:
     assert(n > k);
@@ -212,13 +216,6 @@ void dyson_timestep_ret(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
             sret += ss;
         }
     }
-    delete[] diffw;
-    delete[] stemp;
-    delete[] qq;
-    delete[] mm;
-    delete[] gtemp;
-    delete[] one;
-    delete[] hj;
     return;
 }
 
@@ -356,8 +353,8 @@ template <typename T, class GG, int SIZE1>
 void dyson_mat_fourier_dispatch(GG &G, GG &Sigma, T mu, std::complex<T> *H0, T beta, int order = 3) {
     typedef std::complex<double> cplx;
     cplx *sigmadft, *sigmaiomn, *z1, *z2, *one;
-    cplx *expfac, *gmat, *hj, iomn, *zinv;
-    int ntau, m, r, pcf, p, m2, sg, ss, l, sig, size1 = G.size1();
+    cplx *expfac, *gmat, *gomn, *hj, iomn, *zinv;
+    int ntau, m, m1, r, pcf, p, m2, sg, ss, l, sig, size1 = G.size1();
     double dtau;
 
     assert(G.ntau() == Sigma.ntau());
@@ -375,6 +372,7 @@ void dyson_mat_fourier_dispatch(GG &G, GG &Sigma, T mu, std::complex<T> *H0, T b
     sigmaiomn = new cplx[ss];
     expfac = new cplx[ntau + 1];
     gmat = new cplx[(ntau + 1) * sg];
+    gomn = new cplx[(ntau + 1) * sg];
     z1 = new cplx[sg];
     z2 = new cplx[sg];
     hj = new cplx[sg];
@@ -388,8 +386,12 @@ void dyson_mat_fourier_dispatch(GG &G, GG &Sigma, T mu, std::complex<T> *H0, T b
     m2 = ntau / 2;
     matsubara_dft<T, GG, SIZE1>(sigmadft, Sigma, sig);
     set_first_order_tail<T, SIZE1>(gmat, one, beta, sg, ntau, sig, size1);
+    for (l = 0; l < (ntau + 1) * sg; l++)
+        gomn[l] = 0.0;
 
     for (m = -m2; m <= m2 - 1; m++) {
+        // all frequencies m+p*ntau contribute to the same Fourier component on the grid
+        m1 = (m < 0 ? m + ntau : m);
         for (p = -pcf; p <= pcf; p++) {
 
             iomn = cplx(0, get_omega(m + p * ntau, beta, sig));
@@ -423,14 +425,13 @@ void dyson_mat_fourier_dispatch(GG &G, GG &Sigma, T mu, std::complex<T> *H0, T b
             }
 
             element_smul<T, SIZE1>(size1, z2, 1 / beta);
-            for (r = 0; r <= ntau; r++) {
-                cplx expfac(std::exp(-get_tau(r, beta, ntau) * iomn));
-                for (l = 0; l < sg; l++)
-                    gmat[r * sg + l] += z2[l] * expfac;
-            }
+            for (l = 0; l < sg; l++)
+                gomn[m1 * sg + l] += z2[l];
         }
     }
+    matsubara_idft<T>(gomn, ntau, sig, sg);
     for (r = 0; r <= ntau; r++) {
+        element_incr<T, SIZE1>(size1, gmat + r * sg, gomn + r * sg);
         element_set<T, SIZE1>(size1, G.matptr(r), gmat + r * sg);
     }
 
@@ -438,6 +439,7 @@ void dyson_mat_fourier_dispatch(GG &G, GG &Sigma, T mu, std::complex<T> *H0, T b
     delete[] sigmaiomn;
     delete[] expfac;
     delete[] gmat;
+    delete[] gomn;
     delete[] z1;
     delete[] z2;
     delete[] hj;
@@ -649,7 +651,8 @@ void dyson_mat_steep_dispatch(GG &G, GG &Sigma, T mu, cdmatrix &H0, cdmatrix &Si
 */
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_tv(int n, GG &G, T mu, std::complex<T> *Hn, GG &Sigma,
-                       integration::Integrator<T> &I, T beta, T h) {
+                       integration::Integrator<T> &I, T beta, T h,
+                       dyson_workspace<T> &ws) {
     typedef std::complex<T> cplx;
     int k = I.get_k();
     int sg, n1, l, m, j, ntau, size1 = G.size1();
@@ -664,11 +667,12 @@ void dyson_timestep_tv(int n, GG &G, T mu, std::complex<T> *Hn, GG &Sigma,
     assert(G.nt() >= n);
     assert(G.sig() == Sigma.sig());
 
-    one = new cplx[sg];
-    qq = new cplx[sg];
-    mm = new cplx[sg];
-    stemp = new cplx[sg]; // sic
-    htemp = new cplx[sg];
+    ws.reserve(n, ntau, size1, k);
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    stemp = ws.stemp(); // sic
+    htemp = ws.htemp();
     element_set<T, SIZE1>(size1, one, 1.0);
     // SET ENTRIES IN TIMESTEP(TV) TO 0
     gtv = G.tvptr(n, 0);
@@ -676,8 +680,10 @@ void dyson_timestep_tv(int n, GG &G, T mu, std::complex<T> *Hn, GG &Sigma,
     for (l = 0; l < n1; l++)
         gtv[l] = 0;
     // CONVOLUTION SIGMA*G:  --->  Gtv(n,m)
-    convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, G, Sigma, Sigma, G, G, I, beta,
-                                                      h); // note: this sets only tv
+    convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, ws.tv(), G, Sigma, Sigma, G, G, I,
+                                                      beta, h); // note: this sets only tv
+    for (m = 0; m <= ntau; m++)
+        element_set<T, SIZE1>(size1, G.tvptr(n, m), ws.tv() + m * sg);
     // ACCUMULATE CONTRIBUTION TO id/dt G(t,t') FROM t=mh, m=n-k..n-1
     ih = cplx(0, 1 / h);
     for (m = n - k - 1; m < n; m++) {
@@ -702,11 +708,6 @@ void dyson_timestep_tv(int n, GG &G, T mu, std::complex<T> *Hn, GG &Sigma,
             qq[l] = G.tvptr(n, j)[l];
         element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
     }
-    delete[] stemp;
-    delete[] htemp;
-    delete[] qq;
-    delete[] mm;
-    delete[] one;
     return;
 }
 /// @private
@@ -891,7 +892,8 @@ void dyson_start_tv(GG &G, T mu, std::complex<T> *H, GG &Sigma,
 */
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_les(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
-                        integration::Integrator<T> &I, T beta, T h) {
+                        integration::Integrator<T> &I, T beta, T h,
+                        dyson_workspace<T> &ws) {
     typedef std::complex<T> cplx;
     int k = I.get_k(), k1 = k + 1;
     int sg, n1, l, m, j, ntau, p, q, sig, size1 = G.size1();
@@ -906,12 +908,13 @@ void dyson_timestep_les(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
     assert(G.nt() >= n1);
     assert(G.sig() == Sigma.sig());
 
-    one = new cplx[sg];
-    qq = new cplx[k * sg];
-    mm = new cplx[k * k * sg];
-    gtemp = new cplx[sg];
-    stemp = new cplx[sg]; // sic
-    gles = new cplx[(n1 + 1) * sg];
+    ws.reserve(n1, ntau, size1, k);
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    gtemp = ws.htemp();
+    stemp = ws.stemp(); // sic
+    gles = ws.gles();
     for (j = 0; j <= n1; j++)
         element_set_zero<T, SIZE1>(size1, gles + j * sg);
     element_set<T, SIZE1>(size1, one, 1.0);
@@ -1012,12 +1015,6 @@ void dyson_timestep_les(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
     // write elements into Gles
     for (j = 0; j <= n; j++)
         element_set<T, SIZE1>(size1, G.lesptr(j, n), gles + j * sg);
-    delete[] stemp;
-    delete[] gtemp;
-    delete[] gles;
-    delete[] qq;
-    delete[] mm;
-    delete[] one;
     return;
 }
 
@@ -1071,11 +1068,9 @@ void dyson_mat_fourier(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function<
     int size1 = G.size1();
     assert(G.size1() == Sigma.size1());
     assert(G.ntau() == Sigma.ntau());
-    if (size1 == 1)
-      dyson_mat_fourier_dispatch<T, herm_matrix<T>, 1>(G, Sigma, mu, H.ptr(-1), beta, order);
-    else
-      dyson_mat_fourier_dispatch<T, herm_matrix<T>, LARGESIZE>(G, Sigma, mu, H.ptr(-1), beta,
-                                                         order);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_mat_fourier_dispatch<T, herm_matrix<T>, SIZE1>(G, Sigma, mu, H.ptr(-1), beta, order);
+    );
 }
 /// @private
 template <typename T>
@@ -1087,16 +1082,11 @@ void dyson_mat_fourier(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function<
     std::complex<T> *hmf;
     hmf = new std::complex<T>[size1*size1];
 
-    if (size1 == 1){
-      element_set<T, 1>(size1, hmf, H.ptr(-1));
-      element_incr<T, 1>(size1, hmf, 1.0, SigmaMF.ptr(-1));
-      dyson_mat_fourier_dispatch<T, herm_matrix<T>, 1>(G, Sigma, mu, hmf, beta, order);
-    } else {
-      element_set<T, LARGESIZE>(size1, hmf, H.ptr(-1));
-      element_incr<T, LARGESIZE>(size1, hmf, 1.0, SigmaMF.ptr(-1));
-      dyson_mat_fourier_dispatch<T, herm_matrix<T>, LARGESIZE>(G, Sigma, mu, hmf, beta,
-                                                         order);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        element_set<T, SIZE1>(size1, hmf, H.ptr(-1));
+        element_incr<T, SIZE1>(size1, hmf, 1.0, SigmaMF.ptr(-1));
+        dyson_mat_fourier_dispatch<T, herm_matrix<T>, SIZE1>(G, Sigma, mu, hmf, beta, order);
+    );
     delete hmf;
 }
 /// @private
@@ -1109,11 +1099,9 @@ void dyson_mat_fixpoint(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function
     cdmatrix h0(size1,size1);
 
     H.get_value(-1,h0);
-    if (size1 == 1)
-      dyson_mat_fixpoint_dispatch<T, herm_matrix<T>, 1>(G, Sigma, mu, h0, I, beta, fixpiter);
-    else
-      dyson_mat_fixpoint_dispatch<T, herm_matrix<T>, LARGESIZE>(G, Sigma, mu, h0, I, beta,
-                                fixpiter);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_mat_fixpoint_dispatch<T, herm_matrix<T>, SIZE1>(G, Sigma, mu, h0, I, beta, fixpiter);
+    );
 }
 /// @private
 template <typename T>
@@ -1125,11 +1113,10 @@ void dyson_mat_fixpoint(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function
     cdmatrix h0(size1,size1);
 
     H.get_value(-1,h0);
-    if (size1 == 1)
-      dyson_mat_fixpoint_dispatch<T, herm_matrix<T>, 1>(G, Sigma, mu, h0, SigmaMF, I, beta, fixpiter);
-    else
-      dyson_mat_fixpoint_dispatch<T, herm_matrix<T>, LARGESIZE>(G, Sigma, mu, h0, SigmaMF, I, beta,
-                                fixpiter);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_mat_fixpoint_dispatch<T, herm_matrix<T>, SIZE1>(G, Sigma, mu, h0, SigmaMF, I, beta,
+                                                              fixpiter);
+    );
 }
 
 
@@ -1144,11 +1131,9 @@ void dyson_mat_steep(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function<T>
     cdmatrix h0(size1,size1);
 
     H.get_value(-1,h0);
-    if (size1 == 1)
-      dyson_mat_steep_dispatch<T, herm_matrix<T>, 1>(G, Sigma, mu, h0, I, beta, maxiter, tol);
-    else
-      dyson_mat_steep_dispatch<T, herm_matrix<T>, LARGESIZE>(G, Sigma, mu, h0, I, beta,
-                                 maxiter, tol);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_mat_steep_dispatch<T, herm_matrix<T>, SIZE1>(G, Sigma, mu, h0, I, beta, maxiter, tol);
+    );
 }
 
 /// @private
@@ -1162,11 +1147,10 @@ void dyson_mat_steep(herm_matrix<T> &G, herm_matrix<T> &Sigma, T mu, function<T>
     cdmatrix h0(size1,size1);
 
     H.get_value(-1,h0);
-    if (size1 == 1)
-      dyson_mat_steep_dispatch<T, herm_matrix<T>, 1>(G, Sigma, mu, h0, SigmaMF, I, beta, maxiter, tol);
-    else
-      dyson_mat_steep_dispatch<T, herm_matrix<T>, LARGESIZE>(G, Sigma, mu, h0, SigmaMF, I, beta,
-                                 maxiter, tol);
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_mat_steep_dispatch<T, herm_matrix<T>, SIZE1>(G, Sigma, mu, h0, SigmaMF, I, beta,
+                                                           maxiter, tol);
+    );
 }
 
 /// @private
@@ -1456,15 +1440,11 @@ void dyson_start(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
     assert(G.ntau() == Sigma.ntau());
     assert(G.nt() >= k);
     assert(Sigma.nt() >= k);
-    if (size1 == 1) {
-        dyson_start_ret<T, herm_matrix<T>, 1>(G, mu, H.ptr(0), Sigma, I, h);
-        dyson_start_tv<T, herm_matrix<T>, 1>(G, mu, H.ptr(0), Sigma, I, beta, h);
-        dyson_start_les<T, herm_matrix<T>, 1>(G, mu, H.ptr(0), Sigma, I, beta, h);
-    } else {
-        dyson_start_ret<T, herm_matrix<T>, LARGESIZE>(G, mu, H.ptr(0), Sigma, I, h);
-        dyson_start_tv<T, herm_matrix<T>, LARGESIZE>(G, mu, H.ptr(0), Sigma, I, beta, h);
-        dyson_start_les<T, herm_matrix<T>, LARGESIZE>(G, mu, H.ptr(0), Sigma, I, beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_start_ret<T, herm_matrix<T>, SIZE1>(G, mu, H.ptr(0), Sigma, I, h);
+        dyson_start_tv<T, herm_matrix<T>, SIZE1>(G, mu, H.ptr(0), Sigma, I, beta, h);
+        dyson_start_les<T, herm_matrix<T>, SIZE1>(G, mu, H.ptr(0), Sigma, I, beta, h);
+    );
 }
 
 /** \brief <b> Start-up procedure for solving the Dyson equation of the integral-differential form for a Green's function \f$G\f$</b>
@@ -1506,15 +1486,14 @@ void dyson_start(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
     assert(G.ntau() == Sigma.ntau());
     assert(G.nt() >= SolveOrder);
     assert(Sigma.nt() >= SolveOrder);
-    if (size1 == 1) {
-        dyson_start_ret<T, herm_matrix<T>, 1>(G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), h);
-        dyson_start_tv<T, herm_matrix<T>, 1>(G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta, h);
-        dyson_start_les<T, herm_matrix<T>, 1>(G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta, h);
-    } else {
-        dyson_start_ret<T, herm_matrix<T>, LARGESIZE>(G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), h);
-        dyson_start_tv<T, herm_matrix<T>, LARGESIZE>(G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta, h);
-        dyson_start_les<T, herm_matrix<T>, LARGESIZE>(G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_start_ret<T, herm_matrix<T>, SIZE1>(G, mu, H.ptr(0), Sigma,
+                                                  integration::I<T>(SolveOrder), h);
+        dyson_start_tv<T, herm_matrix<T>, SIZE1>(G, mu, H.ptr(0), Sigma,
+                                                 integration::I<T>(SolveOrder), beta, h);
+        dyson_start_les<T, herm_matrix<T>, SIZE1>(G, mu, H.ptr(0), Sigma,
+                                                  integration::I<T>(SolveOrder), beta, h);
+    );
 }
 /// @private
 /** \brief <b> One step Dyson solver (integral-differential form) for a Green's function \f$G\f$</b>
@@ -1553,27 +1532,26 @@ void dyson_start(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
 * > [double] inverse temperature
 * @param h
 * > [double] time interval
+* @param &ws
+* > [dyson_workspace<T>] scratch memory, enlarged if needed
 */
 template <typename T>
 void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
-                    integration::Integrator<T> &I, T beta, T h) {
+                    integration::Integrator<T> &I, T beta, T h, dyson_workspace<T> &ws) {
     int size1 = G.size1(), k = I.k();
+    CNTR_PROFILE_SCOPE("dyson_timestep", n, profile_convolution_flops(n, G.ntau(), size1),
+                       sizeof(std::complex<T>) * (2.0 * profile_history_elements(n, G.ntau(), size1) +
+                                                  profile_timestep_elements(n, G.ntau(), size1)));
     assert(G.size1() == Sigma.size1());
     assert(G.ntau() == Sigma.ntau());
     assert(G.nt() >= n);
     assert(Sigma.nt() >= n);
     assert(n > k);
-    if (size1 == 1) {
-        dyson_timestep_ret<T, herm_matrix<T>, 1>(n, G, mu, H.ptr(0), Sigma, I, h);
-        dyson_timestep_tv<T, herm_matrix<T>, 1>(n, G, mu, H.ptr(n), Sigma, I, beta, h);
-        dyson_timestep_les<T, herm_matrix<T>, 1>(n, G, mu, H.ptr(0), Sigma, I, beta, h);
-    } else {
-        dyson_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, G, mu, H.ptr(0), Sigma, I, h);
-        dyson_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, G, mu, H.ptr(n), Sigma, I, beta,
-                                                        h);
-        dyson_timestep_les<T, herm_matrix<T>, LARGESIZE>(n, G, mu, H.ptr(0), Sigma, I, beta,
-                                                         h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_timestep_ret<T, herm_matrix<T>, SIZE1>(n, G, mu, H.ptr(0), Sigma, I, h, ws);
+        dyson_timestep_tv<T, herm_matrix<T>, SIZE1>(n, G, mu, H.ptr(n), Sigma, I, beta, h, ws);
+        dyson_timestep_les<T, herm_matrix<T>, SIZE1>(n, G, mu, H.ptr(0), Sigma, I, beta, h, ws);
+    );
 }
 
 
@@ -1617,23 +1595,100 @@ void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<
 template <typename T>
 void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
                     T beta, T h, const int SolveOrder) {
-    int size1 = G.size1();
-    assert(G.size1() == Sigma.size1());
-    assert(G.ntau() == Sigma.ntau());
-    assert(G.nt() >= n);
-    assert(Sigma.nt() >= n);
+    dyson_timestep(n, G, mu, H, Sigma, beta, h, dyson_workspace<T>::local(), SolveOrder);
+}
+
+/** \brief <b> One step Dyson solver (integral-differential form) for a Green's function \f$G\f$
+* with a user-provided workspace</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Same as `dyson_timestep` without workspace argument, but all scratch arrays of the
+* > solver are taken from `ws`. If `ws` is created for the largest timestep of the
+* > propagation, the solver does not allocate its scratch memory at every timestep.
+* > A workspace can be reused for Green's functions of the same matrix size.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] time step
+* @param &G
+* > [herm_matrix<T>] solution
+* @param mu
+* > [T] chemical potential
+* @param &H
+* > [function<T>] time-dependent function
+* @param &Sigma
+* > [herm_matrix<T>] self-energy
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param &ws
+* > [dyson_workspace<T>] scratch memory, enlarged if needed
+* @param SolveOrder
+* > [int] integrator order
+*/
+template <typename T>
+void dyson_timestep(int n, herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
+                    T beta, T h, dyson_workspace<T> &ws, const int SolveOrder) {
     assert(n > SolveOrder);
-    if (size1 == 1) {
-        dyson_timestep_ret<T, herm_matrix<T>, 1>(n, G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), h);
-        dyson_timestep_tv<T, herm_matrix<T>, 1>(n, G, mu, H.ptr(n), Sigma, integration::I<T>(SolveOrder), beta, h);
-        dyson_timestep_les<T, herm_matrix<T>, 1>(n, G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta, h);
-    } else {
-        dyson_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), h);
-        dyson_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, G, mu, H.ptr(n), Sigma, integration::I<T>(SolveOrder), beta,
-                                                        h);
-        dyson_timestep_les<T, herm_matrix<T>, LARGESIZE>(n, G, mu, H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta,
-                                                         h);
-    }
+    dyson_timestep(n, G, mu, H, Sigma, integration::I<T>(SolveOrder), beta, h, ws);
+}
+
+/** \brief <b> One step Dyson solver for a batch of independent Green's functions</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Solves the Dyson equation at timestep `n` for each Green's function `*G[i]` with the
+* > Hamiltonian `*H[i]` and self-energy `*Sigma[i]`, e.g., for all momenta of a lattice
+* > model. With OpenMP (CNTR_USE_OMP), the problems are distributed over the threads of
+* > the enclosing parallel environment; each thread uses its own workspace, and the
+* > integration weights are shared. The result is the same as calling `dyson_timestep`
+* > for each problem. Timestep must be >SolveOrder.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] time step
+* @param &G
+* > [std::vector<herm_matrix<T>*>] solutions
+* @param mu
+* > [T] chemical potential
+* @param &H
+* > [std::vector<function<T>*>] time-dependent functions
+* @param &Sigma
+* > [std::vector<herm_matrix<T>*>] self-energies
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param SolveOrder
+* > [int] integrator order
+*/
+template <typename T>
+void dyson_timestep_batch(int n, std::vector<herm_matrix<T> *> &G, T mu,
+                          std::vector<function<T> *> &H, std::vector<herm_matrix<T> *> &Sigma,
+                          T beta, T h, const int SolveOrder) {
+    int nbatch = G.size(), i;
+    assert(n > SolveOrder);
+    assert((int)H.size() == nbatch);
+    assert((int)Sigma.size() == nbatch);
+    // initializes the integration weights before they are shared by the threads
+    integration::Integrator<T> &I = integration::I<T>(SolveOrder);
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (i = 0; i < nbatch; i++)
+        dyson_timestep(n, *G[i], mu, *H[i], *Sigma[i], I, beta, h, dyson_workspace<T>::local());
 }
 /// @private
 /** \brief <b> Solver of the Dyson equation in the integral-differential form for a Green's function \f$G\f$</b>
@@ -1680,8 +1735,11 @@ void dyson(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
     dyson_mat(G, Sigma, mu, H, I, beta,  matsubara_method, force_hermitian);
     if (nt >= 0)
         dyson_start(G, mu, H, Sigma, I, beta, h);
+    if (nt <= k)
+        return;
+    dyson_workspace<T> ws(nt, G.ntau(), G.size1(), k);
     for (n = k + 1; n <= nt; n++)
-        dyson_timestep(n, G, mu, H, Sigma, I, beta, h);
+        dyson_timestep(n, G, mu, H, Sigma, I, beta, h, ws);
 }
 
 
@@ -1729,8 +1787,11 @@ void dyson(herm_matrix<T> &G, T mu, function<T> &H, herm_matrix<T> &Sigma,
     dyson_mat(G, mu, H, Sigma, beta, SolveOrder, matsubara_method, force_hermitian);
     if (nt >= 0)
         dyson_start(G, mu, H, Sigma, beta, h, SolveOrder);
+    if (nt <= SolveOrder)
+        return;
+    dyson_workspace<T> ws(nt, G.ntau(), G.size1(), SolveOrder);
     for (n = SolveOrder + 1; n <= nt; n++)
-        dyson_timestep(n, G, mu, H, Sigma, beta, h, SolveOrder);
+        dyson_timestep(n, G, mu, H, Sigma, beta, h, ws, SolveOrder);
 }
 
 }
@@ -10,25 +10,35 @@ template <typename T> class function;
 template <typename T> class herm_matrix;
 /// @private
 template <typename T> class herm_pseudo;
+template <typename T> class dyson_workspace;
 
 #ifdef CNTR_USE_OMP
 /// @private
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_ret_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
-                            GG &Sigma, integration::Integrator<T> &I, T h);
+                            GG &Sigma, integration::Integrator<T> &I, T h,
+                            dyson_workspace<T> &ws = dyson_workspace<T>::local());
 /// @private
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_tv_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *Hn,
-                           GG &Sigma, integration::Integrator<T> &I, T beta, T h);
+                           GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                           dyson_workspace<T> &ws = dyson_workspace<T>::local());
 /// @private
 template <typename T, class GG, int SIZE1>
 void pseudodyson_timestep_tv_omp(int omp_num_threads, int n, GG &G, T mu,
                                  std::complex<T> *Hn, GG &Sigma,
-                                 integration::Integrator<T> &I, T beta, T h);
+                                 integration::Integrator<T> &I, T beta, T h,
+                                 dyson_workspace<T> &ws = dyson_workspace<T>::local());
 /// @private
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_les_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
-                            GG &Sigma, integration::Integrator<T> &I, T beta, T h);
+                            GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                            dyson_workspace<T> &ws = dyson_workspace<T>::local());
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_rtl_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
+                            GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                            dyson_workspace<T> &ws = dyson_workspace<T>::local());
 /// @private
 template <typename T>
 void pseudodyson_timestep_omp(int omp_num_threads, int n, herm_pseudo<T> &G, T lam0,
@@ -48,13 +58,18 @@ void pseudodyson_timestep_omp(int omp_num_threads, int n, herm_pseudo<T> &G, T l
 template <typename T>
 void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
                         function<T> &H, herm_matrix<T> &Sigma, integration::Integrator<T> &I,
-                        T beta, T h);
+                        T beta, T h, dyson_workspace<T> &ws = dyson_workspace<T>::local());
 
 template <typename T>
 void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
                         function<T> &H, herm_matrix<T> &Sigma,
                         T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
 
+template <typename T>
+void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
+                        function<T> &H, herm_matrix<T> &Sigma,
+                        T beta, T h, dyson_workspace<T> &ws, int SolveOrder=MAX_SOLVE_ORDER);
+
 #endif // CNTR_USE_OMP
 
 }  // namespace cntr
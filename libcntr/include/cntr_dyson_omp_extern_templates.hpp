@@ -8,10 +8,13 @@ namespace cntr {
 #ifdef CNTR_USE_OMP
 extern template void dyson_timestep_omp<double>(int omp_num_threads, int n, herm_matrix<double> &G,
 	double mu, function<double> &H, herm_matrix<double> &Sigma, integration::Integrator<double> &I,
-	double beta, double h);
+	double beta, double h, dyson_workspace<double> &ws);
 extern template void dyson_timestep_omp<double>(int omp_num_threads, int n, herm_matrix<double> &G,
 	double mu, function<double> &H, herm_matrix<double> &Sigma,
 	double beta, double h, int SolveOrder);
+extern template void dyson_timestep_omp<double>(int omp_num_threads, int n, herm_matrix<double> &G,
+	double mu, function<double> &H, herm_matrix<double> &Sigma,
+	double beta, double h, dyson_workspace<double> &ws, int SolveOrder);
 #endif // CNTR_USE_OMP
 
 }  // namespace cntr
@@ -12,6 +12,8 @@
 #include "cntr_pseudo_convolution_decl.hpp"
 #include "cntr_pseudodyson_decl.hpp"
 #include "cntr_convolution_impl.hpp"
+#include "cntr_dyson_workspace_decl.hpp"
+#include "cntr_omp_schedule.hpp"
 
 namespace cntr {
 
@@ -29,23 +31,134 @@ namespace cntr {
 #
 ###########################################################################################*/
 
+/*###########################################################################################
+#   ROW SOLVERS AND SCHEDULE:
+#
+#   After the convolutions Sigma*G (G*Sigma for les) are stored in G(n,j), the rows
+#   j of ret, tv and les at time step n are independent. They are distributed over the
+#   threads by the cost model in cntr_omp_schedule.hpp, see dyson_timestep_rtl_omp.
+###########################################################################################*/
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_ret_row_omp(int tid, int n, int j, GG &G, T mu, std::complex<T> *H,
+                                GG &Sigma, integration::Integrator<T> &I, T h,
+                                dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k1 = I.get_k() + 1, p;
+    int size1 = G.size1();
+    int sg = G.element_size();
+    cplx cplx_i = cplx(0, 1);
+    cplx w0 = h * I.gregory_omega(0);
+    cplx *diffw = ws.thread_diffw(tid);
+    cplx *qq = ws.thread_qq(tid);
+    cplx *mm = ws.thread_mm(tid);
+    for (p = 0; p <= k1; p++)
+        diffw[p] = I.bd_weights(p) * cplx_i / h; // use BD(k+1!!)
+    element_set<T, SIZE1>(size1, qq, G.retptr(n, j)); // << Sigma*G(n,j)
+    // set up mm and qqj for 1x1 problem:
+    for (p = 1; p <= k1; p++)
+        element_incr<T, SIZE1>(size1, qq, -diffw[p], G.retptr(n - p, j));
+    element_set<T, SIZE1>(size1, mm, diffw[0] + mu);
+    element_incr<T, SIZE1>(size1, mm, -w0, Sigma.retptr(j, j));
+    element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), H + n * sg);
+    element_linsolve_right<T, SIZE1>(size1, G.retptr(n, j), mm, qq); // mm*G=qq
+}
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_tv_row_omp(int tid, int n, int j, GG &G, T mu, std::complex<T> *Hn,
+                               GG &Sigma, integration::Integrator<T> &I, T h,
+                               dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k1 = I.get_k() + 1, p;
+    int size1 = G.size1();
+    cplx ih = cplx(0, 1.0 / h);
+    cplx *diffw = ws.thread_diffw(tid);
+    cplx *qq = ws.thread_qq(tid);
+    cplx *mm = ws.thread_mm(tid);
+    // Now solve
+    // [ i/h bd(0) - H - h w(n,0) Sigma(n,n) ] G(n,m)  = Q(m),
+    // where Q is initially stored in G(n,m)
+    element_set<T, SIZE1>(size1, mm, ih * I.bd_weights(0) + mu);
+    element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), Hn);
+    element_incr<T, SIZE1>(size1, mm, cplx(-h * I.gregory_weights(n, 0), 0.0),
+                           Sigma.retptr(n, n));
+    // ACCUMULATE CONTRIBUTION TO id/dt G(t,t') FROM t=mh, m=n-k..n-1
+    for (p = 0; p <= k1; p++)
+        diffw[p] = ih * I.bd_weights(p); // use BD(k+1!!)
+    element_set<T, SIZE1>(size1, qq, G.tvptr(n, j));
+    for (p = 1; p <= k1; p++)
+        element_incr<T, SIZE1>(size1, qq, -diffw[p], G.tvptr(n - p, j));
+    element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
+}
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_les_row_omp(int tid, int n, int j, GG &G, T mu, std::complex<T> *H,
+                                GG &Sigma, integration::Integrator<T> &I, T h,
+                                dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k1 = I.get_k() + 1, p;
+    int size1 = G.size1();
+    int sg = G.element_size();
+    cplx cplx_i = cplx(0, 1);
+    cplx w0 = h * I.gregory_omega(0);
+    cplx *diffw = ws.thread_diffw(tid);
+    cplx *qq = ws.thread_qq(tid);
+    cplx *mm = ws.thread_mm(tid);
+    cplx *stemp = ws.thread_stemp(tid);
+    for (p = 0; p <= k1; p++)
+        diffw[p] = I.bd_weights(p) * cplx_i / h; // use BD(k+1!!)
+    element_set<T, SIZE1>(size1, qq, G.lesptr(j, n)); // << G*Sigma(j,n)
+    // set up mm and qqj for 1x1 problem:
+    for (p = 1; p <= k1; p++)
+        element_incr<T, SIZE1>(size1, qq, diffw[p], G.lesptr(j, n - p));
+    element_set<T, SIZE1>(size1, mm, -diffw[0] + mu);
+    element_conj<T, SIZE1>(size1, stemp, Sigma.retptr(j, j));
+    element_incr<T, SIZE1>(size1, mm, -w0, stemp);
+    element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), H + n * sg);
+    element_linsolve_left<T, SIZE1>(size1, G.lesptr(j, n), mm, qq);
+}
+/// @private
+/** \brief <b> Distributes the rows of ret, tv and les at time step n over the threads.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Rows `0 ... nret-1` (ret), `0 ... ntv-1` (tv) and `0 ... nles-1` (les) are one pool of
+ *  work items, in this order. Called by all threads of a team, returns the masks of
+ *  the calling thread. Implies a barrier.
+ */
+inline void dyson_timestep_masks_omp(int n, int ntau, int k, int size1, int nret, int ntv,
+                                     int nles, std::vector<int> &owner,
+                                     std::vector<bool> &mask_ret, std::vector<bool> &mask_tv,
+                                     std::vector<bool> &mask_les) {
+    int tid = omp_get_thread_num();
+#pragma omp single
+    {
+        std::vector<double> cost;
+        // the linear solve of each row, in units of the element products
+        omp_convolution_cost(n, ntau, k, nret, ntv, nles, k + 3.0 + size1 / 3.0, cost);
+        omp_balance_work(omp_get_num_threads(), cost, owner);
+    }
+    omp_owner_mask(owner, 0, nret, tid, mask_ret);
+    omp_owner_mask(owner, nret, ntv, tid, mask_tv);
+    omp_owner_mask(owner, nret + ntv, nles, tid, mask_les);
+}
+
 /*###########################################################################################
 #   RETARDED FUNCTION: (GG = herm_matrix or herm_pseudo)
 ###########################################################################################*/
 /// @private
 template <typename T, class GG, int SIZE1>
-void dyson_timestep_ret_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
-                            GG &Sigma, integration::Integrator<T> &I, T h) {
+void dyson_timestep_ret_start_omp(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
+                                  integration::Integrator<T> &I, T h,
+                                  dyson_workspace<T> &ws) {
     typedef std::complex<T> cplx;
-    int k = I.get_k(), k1 = k + 1;
+    int k = I.get_k();
     cplx cplx_i = cplx(0, 1);
     int size1 = G.size1();
     int sg = G.element_size();
-    // check consistency:
-    assert(k + 1<= n);
-    assert(n<= Sigma.nt());
-    assert(n<= G.nt());
-    assert(G.sig()== Sigma.sig());
 
     ///////////////////////////////////////////////////////////////////////////////////////
     // SET ENTRIES IN TIMESTEP TO 0
@@ -67,13 +180,11 @@ void dyson_timestep_ret_omp(int omp_num_threads, int n, GG &G, T mu, std::comple
         int i, j, p, l, q;
         cplx w0, cweight;
         T weight;
-        cplx *gtemp = new cplx[k * sg];
-        cplx *diffw = new cplx[k1 + 1];
-        cplx *qq = new cplx[(n + 1) * sg];
-        cplx *one = new cplx[sg];
-        cplx *mm = new cplx[k * k * sg];
-        cplx *hj = new cplx[sg];
-        cplx *stemp = new cplx[sg]; // sic
+        cplx *gtemp = ws.gtemp();
+        cplx *qq = ws.qq();
+        cplx *one = ws.one();
+        cplx *mm = ws.mm();
+        cplx *stemp = ws.stemp(); // sic
         element_set<T, SIZE1>(size1, one, 1);
         for (i = 0; i < k * k * sg; i++)
             mm[i] = 0;
@@ -121,51 +232,41 @@ void dyson_timestep_ret_omp(int omp_num_threads, int n, GG &G, T mu, std::comple
         element_linsolve_left<T, SIZE1>(size1, k, gtemp, mm, qq); // gtemp * mm = qq
         for (j = 1; j <= k; j++)
             element_set<T, SIZE1>(size1, G.retptr(n, n - j), gtemp + (j - 1) * sg);
-        delete[] gtemp;
-        delete[] diffw;
-        delete[] qq;
-        delete[] one;
-        delete[] mm;
-        delete[] hj;
-        delete[] stemp;
     }
+}
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_ret_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
+                            GG &Sigma, integration::Integrator<T> &I, T h,
+                            dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k();
+    int size1 = G.size1();
+    // check consistency:
+    assert(k + 1<= n);
+    assert(n<= Sigma.nt());
+    assert(n<= G.nt());
+    assert(G.sig()== Sigma.sig());
+    ws.reserve(n, G.ntau(), size1, k, omp_num_threads);
+    dyson_timestep_ret_start_omp<T, GG, SIZE1>(n, G, mu, H, Sigma, I, h, ws);
 ///////////////////////////////////////////////////////////////////////////////////////
 // now use equation ii*d/dt G(t,t1) = ... to compute G(n*h,j*h),j=0 ... n-k-1
 // OMP parallelization over j
-
+    std::vector<int> owner;
 #pragma omp parallel num_threads(omp_num_threads)
     {
         // convolution Sigma*G ->> written to G, on
-        int j, p, i;
-        int nomp = omp_get_num_threads();
+        int j;
         int tid = omp_get_thread_num();
-        std::vector<bool> mask_ret(n + 1, false);
-        cplx w0 = h * I.gregory_omega(0);
-        cplx *diffw = new cplx[k1 + 1];
-        cplx *qq = new cplx[sg];
-        cplx *mm = new cplx[sg];
-        for (i = 0; i < n - k; i++)
-            if (i % nomp == tid)
-                mask_ret[i] = true;
+        std::vector<bool> mask_ret(n + 1, false), mask_tv, mask_les;
+        dyson_timestep_masks_omp(n, G.ntau(), k, size1, n - k, 0, 0, owner, mask_ret,
+                                    mask_tv, mask_les);
         incr_convolution_ret<T, GG, SIZE1>(n, mask_ret, cplx(1.0, 0.0), G, Sigma, Sigma,
                                            NULL, G, G, I, h);
-        for (p = 0; p <= k1; p++)
-            diffw[p] = I.bd_weights(p) * cplx_i / h; // use BD(k+1!!)
         for (j = 0; j < n - k; j++) {
-            if (mask_ret[j]) {
-                element_set<T, SIZE1>(size1, qq, G.retptr(n, j)); // << Sigma*G(n,j)
-                // set up mm and qqj for 1x1 problem:
-                for (p = 1; p <= k1; p++)
-                    element_incr<T, SIZE1>(size1, qq, -diffw[p], G.retptr(n - p, j));
-                element_set<T, SIZE1>(size1, mm, diffw[0] + mu);
-                element_incr<T, SIZE1>(size1, mm, -w0, Sigma.retptr(j, j));
-                element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), H + n * sg);
-                element_linsolve_right<T, SIZE1>(size1, G.retptr(n, j), mm, qq); // mm*G=qq
-            }
+            if (mask_ret[j])
+                dyson_timestep_ret_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, H, Sigma, I, h, ws);
         }
-        delete[] diffw;
-        delete[] qq;
-        delete[] mm;
     }
     return;
 }
@@ -177,57 +278,35 @@ void dyson_timestep_ret_omp(int omp_num_threads, int n, GG &G, T mu, std::comple
 /// @private
 template <typename T, class GG, int SIZE1>
 void dyson_timestep_tv_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *Hn,
-                           GG &Sigma, integration::Integrator<T> &I, T beta, T h) {
+                           GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                           dyson_workspace<T> &ws) {
     typedef std::complex<T> cplx;
     int size1 = G.size1();
-    int k = I.get_k(), k1 = k + 1;
-    int sg = G.element_size();
+    int k = I.get_k();
     int ntau = G.ntau();
-    cplx ih = cplx(0, 1.0 / h);
     assert(k + 1<= n);
     assert(n<= Sigma.nt());
     assert(n<= G.nt());
     assert(G.sig()== Sigma.sig());
+    ws.reserve(n, ntau, size1, k, omp_num_threads);
 
     for (int j = 0; j <= ntau; j++)
         element_set_zero<T, SIZE1>(size1, G.tvptr(n, j));
+    std::vector<int> owner;
 #pragma omp parallel num_threads(omp_num_threads)
     {
         // convolution Sigma*G ->> written to G.tv
-        int j, p, i;
-        int nomp = omp_get_num_threads();
+        int j;
         int tid = omp_get_thread_num();
-        std::vector<bool> mask(ntau + 1, false);
-        cplx cweight;
-        cplx *diffw = new cplx[k1 + 1];
-        cplx *qq = new cplx[sg];
-        cplx *mm = new cplx[sg];
-        for (i = 0; i <= ntau; i++)
-            if (i % nomp == tid)
-                mask[i] = true;
+        std::vector<bool> mask(ntau + 1, false), mask_ret, mask_les;
+        dyson_timestep_masks_omp(n, ntau, k, size1, 0, ntau + 1, 0, owner, mask_ret,
+                                    mask, mask_les);
         incr_convolution_tv<T, GG, SIZE1>(n, mask, cplx(1.0, 0.0), G, Sigma, Sigma, NULL,
                                           NULL, G, G, I, beta, h);
-        // Now solve
-        // [ i/h bd(0) - H - h w(n,0) Sigma(n,n) ] G(n,m)  = Q(m),
-        // where Q is initially stored in G(n,m)
-        element_set<T, SIZE1>(size1, mm, ih * I.bd_weights(0) + mu);
-        element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), Hn);
-        cweight = -h * I.gregory_weights(n, 0);
-        element_incr<T, SIZE1>(size1, mm, cweight, Sigma.retptr(n, n));
-        // ACCUMULATE CONTRIBUTION TO id/dt G(t,t') FROM t=mh, m=n-k..n-1
-        for (p = 0; p <= k1; p++)
-            diffw[p] = ih * I.bd_weights(p); // use BD(k+1!!)
         for (j = 0; j <= ntau; j++) {
-            if (mask[j]) {
-                element_set<T, SIZE1>(size1, qq, G.tvptr(n, j));
-                for (p = 1; p <= k1; p++)
-                    element_incr<T, SIZE1>(size1, qq, -diffw[p], G.tvptr(n - p, j));
-                element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
-            }
+            if (mask[j])
+                dyson_timestep_tv_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, Hn, Sigma, I, h, ws);
         }
-        delete[] qq;
-        delete[] mm;
-        delete[] diffw;
     }
     return;
 }
@@ -236,57 +315,35 @@ void dyson_timestep_tv_omp(int omp_num_threads, int n, GG &G, T mu, std::complex
 template <typename T, class GG, int SIZE1>
 void pseudodyson_timestep_tv_omp(int omp_num_threads, int n, GG &G, T mu,
                                  std::complex<T> *Hn, GG &Sigma,
-                                 integration::Integrator<T> &I, T beta, T h) {
+                                 integration::Integrator<T> &I, T beta, T h,
+                                 dyson_workspace<T> &ws) {
     typedef std::complex<T> cplx;
     int size1 = G.size1();
-    int k = I.get_k(), k1 = k + 1;
-    int sg = G.element_size();
+    int k = I.get_k();
     int ntau = G.ntau();
-    cplx ih = cplx(0, 1.0 / h);
     assert(k + 1<= n);
     assert(n<= Sigma.nt());
     assert(n<= G.nt());
     assert(G.sig()== Sigma.sig());
+    ws.reserve(n, ntau, size1, k, omp_num_threads);
 
     for (int j = 0; j <= ntau; j++)
         element_set_zero<T, SIZE1>(size1, G.tvptr(n, j));
+    std::vector<int> owner;
 #pragma omp parallel num_threads(omp_num_threads)
     {
         // convolution Sigma*G ->> written to G.tv
-        int j, p, i;
-        int nomp = omp_get_num_threads();
+        int j;
         int tid = omp_get_thread_num();
-        std::vector<bool> mask(ntau + 1, false);
-        cplx cweight;
-        cplx *diffw = new cplx[k1 + 1];
-        cplx *qq = new cplx[sg];
-        cplx *mm = new cplx[sg];
-        for (i = 0; i <= ntau; i++)
-            if (i % nomp == tid)
-                mask[i] = true;
+        std::vector<bool> mask(ntau + 1, false), mask_ret, mask_les;
+        dyson_timestep_masks_omp(n, ntau, k, size1, 0, ntau + 1, 0, owner, mask_ret,
+                                    mask, mask_les);
         incr_pseudo_convolution_tv<T, GG, SIZE1>(n, mask, cplx(1.0, 0.0), G, Sigma, Sigma,
                                                  NULL, NULL, G, G, I, beta, h);
-        // Now solve
-        // [ i/h bd(0) - H - h w(n,0) Sigma(n,n) ] G(n,m)  = Q(m),
-        // where Q is initially stored in G(n,m)
-        element_set<T, SIZE1>(size1, mm, ih * I.bd_weights(0) + mu);
-        element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), Hn);
-        cweight = -h * I.gregory_weights(n, 0);
-        element_incr<T, SIZE1>(size1, mm, cweight, Sigma.retptr(n, n));
-        // ACCUMULATE CONTRIBUTION TO id/dt G(t,t') FROM t=mh, m=n-k..n-1
-        for (p = 0; p <= k1; p++)
-            diffw[p] = ih * I.bd_weights(p); // use BD(k+1!!)
         for (j = 0; j <= ntau; j++) {
-            if (mask[j]) {
-                element_set<T, SIZE1>(size1, qq, G.tvptr(n, j));
-                for (p = 1; p <= k1; p++)
-                    element_incr<T, SIZE1>(size1, qq, -diffw[p], G.tvptr(n - p, j));
-                element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
-            }
+            if (mask[j])
+                dyson_timestep_tv_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, Hn, Sigma, I, h, ws);
         }
-        delete[] qq;
-        delete[] mm;
-        delete[] diffw;
     }
     return;
 }
@@ -295,13 +352,68 @@ void pseudodyson_timestep_tv_omp(int omp_num_threads, int n, GG &G, T mu,
 ###########################################################################################*/
 /// @private
 template <typename T, class GG, int SIZE1>
-void dyson_timestep_les_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
-                            GG &Sigma, integration::Integrator<T> &I, T beta, T h) {
+void dyson_timestep_les_end_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
+                                GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                                dyson_workspace<T> &ws) {
+    ///////////////////////////////////////////////////////////////////////////////////////////
+    // get G(j,n), j=n-k...n from d/dt G(t,t') equation (old implementation)
+    // currently not paralellized
     typedef std::complex<T> cplx;
     cplx cplx_i = cplx(0, 1);
     int k = I.get_k(), k1 = k + 1;
     int size1 = G.size1();
     int sg = G.element_size();
+    int j, p, m;
+    cplx *gles = ws.gles();
+    cplx *qq = ws.qq();
+    cplx *mm = ws.mm();
+    cplx cweight;
+// CONVOLUTION SIGMA*G:  --->  G^les(j,n) j=n-k...n
+// Note: this is only the tv*vt + les*adv part, Gles is not adressed
+// coupld parallelize this:
+#pragma omp parallel num_threads(omp_num_threads)
+    {
+        int j1;
+        int nomp = omp_get_num_threads();
+        int tid = omp_get_thread_num();
+        for (j1 = n - k; j1 <= n; j1++) {
+            if ((n - j1) % nomp == tid) {
+                element_set_zero<T, SIZE1>(size1, gles + j1 * sg);
+                convolution_timestep_les_tvvt<T, GG, SIZE1>(n, j1, j1, gles, G, Sigma,
+                                                            Sigma, G, G, I, beta, h);
+                convolution_timestep_les_lesadv<T, GG, SIZE1>(n, j1, j1, gles, G, Sigma,
+                                                              Sigma, G, G, I, beta, h);
+            }
+        }
+    }
+    for (j = n - k; j <= n; j++) {
+        // CONTRIBUTION FROM INTEGRAL tv*vt+les*adv
+        element_set<T, SIZE1>(size1, qq, gles + j * sg);
+        // ACCUMULATE CONTRIBUTION TO id/dt G(j-p,n) p=1...k1 into qq
+        for (p = 1; p <= k1; p++) { // use BD(k+1) !!!
+            cweight = -cplx_i / h * I.bd_weights(p);
+            element_incr<T, SIZE1>(size1, qq, cweight, G.lesptr(j - p, n));
+        }
+        element_set<T, SIZE1>(size1, mm, cplx_i / h * I.bd_weights(0) + mu);
+        element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), H + sg * j);
+        cweight = -h * I.gregory_weights(j, j);
+        element_incr<T, SIZE1>(size1, mm, cweight, Sigma.retptr(j, j));
+        for (m = 0; m < j; m++) {
+            cweight = h * I.gregory_weights(j, m);
+            element_incr<T, SIZE1>(size1, qq, cweight, Sigma.retptr(j, m),
+                                   G.lesptr(m, n));
+        }
+        element_linsolve_right<T, SIZE1>(size1, G.lesptr(j, n), mm, qq);
+    }
+}
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_les_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
+                            GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                            dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k();
+    int size1 = G.size1();
     int n1 = (n > k ? n : k);
     //////////////////////////////////////////////////////////////////////////////////////////
     // check consistency:  (more assertations follow in convolution)
@@ -312,102 +424,102 @@ void dyson_timestep_les_omp(int omp_num_threads, int n, GG &G, T mu, std::comple
     assert(G.sig()== Sigma.sig());
     // OMP PARALELLIZARION STARTS ONLY FOR n>=2*k+1
     if (n < 2 * k + 1) {
-        return dyson_timestep_les<T, GG, SIZE1>(n, G, mu, H, Sigma, I, beta, h);
+        return dyson_timestep_les<T, GG, SIZE1>(n, G, mu, H, Sigma, I, beta, h, ws);
     }
+    ws.reserve(n, G.ntau(), size1, k, omp_num_threads);
     for (int j = 0; j <= n; j++)
         element_set_zero<T, SIZE1>(size1, G.lesptr(j, n));
 ///////////////////////////////////////////////////////////////////////////////////////////
 // get G(j,n), j=0...n-k-1 from d/dt' G(t,t') equation
+    std::vector<int> owner;
 #pragma omp parallel num_threads(omp_num_threads)
     {
-        int j, p, i;
-        int nomp = omp_get_num_threads();
+        int j;
         int tid = omp_get_thread_num();
-        std::vector<bool> mask_les(n + 1, false);
-        cplx w0 = h * I.gregory_omega(0);
-        cplx *diffw = new cplx[k1 + 1];
-        cplx *qq = new cplx[sg];
-        cplx *mm = new cplx[sg];
-        cplx *stemp = new cplx[sg];
+        std::vector<bool> mask_les(n + 1, false), mask_ret, mask_tv;
+        dyson_timestep_masks_omp(n, G.ntau(), k, size1, 0, 0, n - k, owner, mask_ret,
+                                    mask_tv, mask_les);
         // convolution Sigma*G ->> written to G
-        for (i = 0; i < n - k; i++)
-            if (i % nomp == tid)
-                mask_les[i] = true;
         incr_convolution_les<T, GG, SIZE1>(n, mask_les, cplx(1.0, 0.0), G, G, G, NULL, NULL,
                                            Sigma, Sigma, I, beta, h);
-        for (p = 0; p <= k1; p++)
-            diffw[p] = I.bd_weights(p) * cplx_i / h; // use BD(k+1!!)
         for (j = 0; j < n - k; j++) {
-            if (mask_les[j]) {
-                element_set<T, SIZE1>(size1, qq, G.lesptr(j, n)); // << G*Sigma(j,n)
-                // set up mm and qqj for 1x1 problem:
-                for (p = 1; p <= k1; p++)
-                    element_incr<T, SIZE1>(size1, qq, diffw[p], G.lesptr(j, n - p));
-                element_set<T, SIZE1>(size1, mm, -diffw[0] + mu);
-                element_conj<T, SIZE1>(size1, stemp, Sigma.retptr(j, j));
-                element_incr<T, SIZE1>(size1, mm, -w0, stemp);
-                element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), H + n * sg);
-                element_linsolve_left<T, SIZE1>(size1, G.lesptr(j, n), mm, qq);
-            }
+            if (mask_les[j])
+                dyson_timestep_les_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, H, Sigma, I, h, ws);
         }
-        delete[] diffw;
-        delete[] qq;
-        delete[] mm;
-        delete[] stemp;
     }
-    ///////////////////////////////////////////////////////////////////////////////////////////
-    // get G(j,n), j=n-k...n from d/dt G(t,t') equation (old implementation)
-    // currently not paralellized
-    {
-        int j, p, m;
-        cplx *gles = new cplx[(n + 1) * sg];
-        cplx *qq = new cplx[k * sg];
-        cplx *mm = new cplx[k * k * sg];
-        cplx cweight;
-// CONVOLUTION SIGMA*G:  --->  G^les(j,n) j=n-k...n
-// Note: this is only the tv*vt + les*adv part, Gles is not adressed
-// coupld parallelize this:
+    dyson_timestep_les_end_omp<T, GG, SIZE1>(omp_num_threads, n, G, mu, H, Sigma, I, beta, h,
+                                             ws);
+    return;
+}
+//// start les uses d/dt Gles(t,n*h)=... equation ... not OMP paralellized
+/*###########################################################################################
+#   RET, TV AND LES IN ONE PARALLEL REGION: (GG = herm_matrix)
+#
+#   The rows j < n-k of ret and les and all rows of tv only depend on earlier time
+#   steps and on the start values of ret, so they form one pool of work items.
+#   Only the last k+1 rows of les need ret and tv at time step n.
+###########################################################################################*/
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_rtl_omp(int omp_num_threads, int n, GG &G, T mu, std::complex<T> *H,
+                            GG &Sigma, integration::Integrator<T> &I, T beta, T h,
+                            dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k();
+    int size1 = G.size1();
+    int sg = G.element_size();
+    int ntau = G.ntau();
+    assert(k + 1<= n);
+    assert(G.ntau()<= Sigma.ntau());
+    assert(n<= Sigma.nt());
+    assert(n<= G.nt());
+    assert(G.sig()== Sigma.sig());
+    if (n < 2 * k + 1) {
+        dyson_timestep_ret_omp<T, GG, SIZE1>(omp_num_threads, n, G, mu, H, Sigma, I, h, ws);
+        dyson_timestep_tv_omp<T, GG, SIZE1>(omp_num_threads, n, G, mu, H + n * sg, Sigma, I,
+                                            beta, h, ws);
+        dyson_timestep_les_omp<T, GG, SIZE1>(omp_num_threads, n, G, mu, H, Sigma, I, beta, h,
+                                             ws);
+        return;
+    }
+    ws.reserve(n, ntau, size1, k, omp_num_threads);
+    dyson_timestep_ret_start_omp<T, GG, SIZE1>(n, G, mu, H, Sigma, I, h, ws);
+    for (int j = 0; j <= ntau; j++)
+        element_set_zero<T, SIZE1>(size1, G.tvptr(n, j));
+    for (int j = 0; j <= n; j++)
+        element_set_zero<T, SIZE1>(size1, G.lesptr(j, n));
+    std::vector<int> owner;
 #pragma omp parallel num_threads(omp_num_threads)
-        {
-            int j1;
-            int nomp = omp_get_num_threads();
-            int tid = omp_get_thread_num();
-            for (j1 = n - k; j1 <= n; j1++) {
-                if ((n - j1) % nomp == tid) {
-                    element_set_zero<T, SIZE1>(size1, gles + j1 * sg);
-                    convolution_timestep_les_tvvt<T, GG, SIZE1>(n, j1, j1, gles, G, Sigma,
-                                                                Sigma, G, G, I, beta, h);
-                    convolution_timestep_les_lesadv<T, GG, SIZE1>(n, j1, j1, gles, G, Sigma,
-                                                                  Sigma, G, G, I, beta, h);
-                }
-            }
+    {
+        int j;
+        int tid = omp_get_thread_num();
+        std::vector<bool> mask_ret(n + 1, false), mask_tv(ntau + 1, false),
+            mask_les(n + 1, false);
+        dyson_timestep_masks_omp(n, ntau, k, size1, n - k, ntau + 1, n - k, owner,
+                                    mask_ret, mask_tv, mask_les);
+        incr_convolution_ret<T, GG, SIZE1>(n, mask_ret, cplx(1.0, 0.0), G, Sigma, Sigma,
+                                           NULL, G, G, I, h);
+        incr_convolution_tv<T, GG, SIZE1>(n, mask_tv, cplx(1.0, 0.0), G, Sigma, Sigma, NULL,
+                                          NULL, G, G, I, beta, h);
+        incr_convolution_les<T, GG, SIZE1>(n, mask_les, cplx(1.0, 0.0), G, G, G, NULL, NULL,
+                                           Sigma, Sigma, I, beta, h);
+        for (j = 0; j < n - k; j++) {
+            if (mask_ret[j])
+                dyson_timestep_ret_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, H, Sigma, I, h, ws);
         }
-        for (j = n - k; j <= n; j++) {
-            // CONTRIBUTION FROM INTEGRAL tv*vt+les*adv
-            element_set<T, SIZE1>(size1, qq, gles + j * sg);
-            // ACCUMULATE CONTRIBUTION TO id/dt G(j-p,n) p=1...k1 into qq
-            for (p = 1; p <= k1; p++) { // use BD(k+1) !!!
-                cweight = -cplx_i / h * I.bd_weights(p);
-                element_incr<T, SIZE1>(size1, qq, cweight, G.lesptr(j - p, n));
-            }
-            element_set<T, SIZE1>(size1, mm, cplx_i / h * I.bd_weights(0) + mu);
-            element_incr<T, SIZE1>(size1, mm, cplx(-1.0, 0.0), H + sg * j);
-            cweight = -h * I.gregory_weights(j, j);
-            element_incr<T, SIZE1>(size1, mm, cweight, Sigma.retptr(j, j));
-            for (m = 0; m < j; m++) {
-                cweight = h * I.gregory_weights(j, m);
-                element_incr<T, SIZE1>(size1, qq, cweight, Sigma.retptr(j, m),
-                                       G.lesptr(m, n));
-            }
-            element_linsolve_right<T, SIZE1>(size1, G.lesptr(j, n), mm, qq);
+        for (j = 0; j <= ntau; j++) {
+            if (mask_tv[j])
+                dyson_timestep_tv_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, H + n * sg, Sigma, I,
+                                                        h, ws);
+        }
+        for (j = 0; j < n - k; j++) {
+            if (mask_les[j])
+                dyson_timestep_les_row_omp<T, GG, SIZE1>(tid, n, j, G, mu, H, Sigma, I, h, ws);
         }
-        delete[] gles;
-        delete[] qq;
-        delete[] mm;
     }
-    return;
+    dyson_timestep_les_end_omp<T, GG, SIZE1>(omp_num_threads, n, G, mu, H, Sigma, I, beta, h,
+                                             ws);
 }
-//// start les uses d/dt Gles(t,n*h)=... equation ... not OMP paralellized
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 // main implementation:
@@ -427,21 +539,14 @@ void pseudodyson_timestep_omp(int omp_num_threads, int n, herm_pseudo<T> &G, T l
     assert(G.size1()== Sigma.size1());
     assert(G.size1()== H.size1());
     assert(G.ntau()== Sigma.ntau());
-    if (size1 == 1) {
-        dyson_timestep_ret_omp<T, herm_pseudo<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(0),
-                                                     Sigma, I, h);
-        pseudodyson_timestep_tv_omp<T, herm_pseudo<T>, 1>(omp_num_threads1, n, G, lam0,
-                                                          H.ptr(n), Sigma, I, beta, h);
-        dyson_timestep_les_omp<T, herm_pseudo<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(0),
-                                                     Sigma, I, beta, h);
-    } else {
-        dyson_timestep_ret_omp<T, herm_pseudo<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             H.ptr(0), Sigma, I, h);
-        pseudodyson_timestep_tv_omp<T, herm_pseudo<T>, LARGESIZE>(
-            omp_num_threads1, n, G, lam0, H.ptr(n), Sigma, I, beta, h);
-        dyson_timestep_les_omp<T, herm_pseudo<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             H.ptr(0), Sigma, I, beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_timestep_ret_omp<T, herm_pseudo<T>, SIZE1>(omp_num_threads1, n, G, lam0, H.ptr(0),
+                                                         Sigma, I, h);
+        pseudodyson_timestep_tv_omp<T, herm_pseudo<T>, SIZE1>(omp_num_threads1, n, G, lam0, H.ptr(n),
+                                                              Sigma, I, beta, h);
+        dyson_timestep_les_omp<T, herm_pseudo<T>, SIZE1>(omp_num_threads1, n, G, lam0, H.ptr(0),
+                                                         Sigma, I, beta, h);
+    );
 }
 // with raw pointer:
 /// @private
@@ -457,21 +562,14 @@ void pseudodyson_timestep_omp(int omp_num_threads, int n, herm_pseudo<T> &G, T l
     assert(G.sig()== Sigma.sig());
     assert(G.size1()== Sigma.size1());
     assert(G.ntau()== Sigma.ntau());
-    if (size1 == 1) {
-        dyson_timestep_ret_omp<T, herm_pseudo<T>, 1>(omp_num_threads1, n, G, lam0, Ht, Sigma,
-                                                     I, h);
-        pseudodyson_timestep_tv_omp<T, herm_pseudo<T>, 1>(
-            omp_num_threads1, n, G, lam0, Ht + n * size1 * size1, Sigma, I, beta, h);
-        dyson_timestep_les_omp<T, herm_pseudo<T>, 1>(omp_num_threads1, n, G, lam0, Ht, Sigma,
-                                                     I, beta, h);
-    } else {
-        dyson_timestep_ret_omp<T, herm_pseudo<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             Ht, Sigma, I, h);
-        pseudodyson_timestep_tv_omp<T, herm_pseudo<T>, LARGESIZE>(
-            omp_num_threads1, n, G, lam0, Ht + n * size1 * size1, Sigma, I, beta, h);
-        dyson_timestep_les_omp<T, herm_pseudo<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             Ht, Sigma, I, beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_timestep_ret_omp<T, herm_pseudo<T>, SIZE1>(omp_num_threads1, n, G, lam0, Ht, Sigma, I,
+                                                         h);
+        pseudodyson_timestep_tv_omp<T, herm_pseudo<T>, SIZE1>(omp_num_threads1, n, G, lam0,
+                                                              Ht + n * size1 * size1, Sigma, I, beta, h);
+        dyson_timestep_les_omp<T, herm_pseudo<T>, SIZE1>(omp_num_threads1, n, G, lam0, Ht, Sigma, I,
+                                                         beta, h);
+    );
 }
 // only for compatibility, works for size1 only
 /// @private
@@ -505,7 +603,7 @@ void pseudodyson_timestep_omp(int omp_num_threads, int n, herm_pseudo<T> &G, T l
 template <typename T>
 void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
                         function<T> &H, herm_matrix<T> &Sigma, integration::Integrator<T> &I,
-                        T beta, T h) {
+                        T beta, T h, dyson_workspace<T> &ws) {
     int size1 = G.size1(), k = I.k();
     int omp_num_threads1 = (omp_num_threads == -1 ? omp_get_max_threads() : omp_num_threads);
     assert(k + 1<= n);
@@ -516,21 +614,10 @@ void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
     assert(G.size1()== Sigma.size1());
     assert(G.size1()== H.size1());
     assert(G.ntau()== Sigma.ntau());
-    if (size1 == 1) {
-        dyson_timestep_ret_omp<T, herm_matrix<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(0),
-                                                     Sigma, I, h);
-        dyson_timestep_tv_omp<T, herm_matrix<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(n),
-                                                    Sigma, I, beta, h);
-        dyson_timestep_les_omp<T, herm_matrix<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(0),
-                                                     Sigma, I, beta, h);
-    } else {
-        dyson_timestep_ret_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             H.ptr(0), Sigma, I, h);
-        dyson_timestep_tv_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                            H.ptr(n), Sigma, I, beta, h);
-        dyson_timestep_les_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             H.ptr(0), Sigma, I, beta, h);
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        dyson_timestep_rtl_omp<T, herm_matrix<T>, SIZE1>(omp_num_threads1, n, G, lam0, H.ptr(0),
+                                                         Sigma, I, beta, h, ws);
+    );
 }
 
 /** \brief <b> One step Dyson solver (integral-differential form) for a Green's function \f$G\f$ using openMP parallelization</b>
@@ -577,31 +664,55 @@ template <typename T>
 void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
                         function<T> &H, herm_matrix<T> &Sigma,
                         T beta, T h, int SolveOrder) {
-    int size1 = G.size1();
-    int omp_num_threads1 = (omp_num_threads == -1 ? omp_get_max_threads() : omp_num_threads);
+    dyson_timestep_omp(omp_num_threads, n, G, lam0, H, Sigma, beta, h,
+                       dyson_workspace<T>::local(), SolveOrder);
+}
+
+/** \brief <b> One step Dyson solver (integral-differential form) for a Green's function \f$G\f$ using openMP parallelization
+* and a user-provided workspace</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Same as `dyson_timestep_omp` without workspace argument, but all scratch memory
+* > (including one buffer per openMP thread) is taken from `ws`. If `ws` is
+* > allocated for the largest timestep, thread number and integration order of the
+* > propagation, no heap allocation of scratch memory happens in the solver.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param omp_num_threads
+* > [int] The number of openMP threads to be used. Set to the number of threads in the current team.
+* > If omp_num_threads = -1, the maximum available number of threads is used.
+* @param n
+* > [int] time step
+* @param &G
+* > [herm_matrix<T>] solution
+* @param lam0
+* > [T] chemical potential
+* @param &H
+* > [function<T>] time-dependent function
+* @param &Sigma
+* > [herm_matrix<T>] self-energy
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param &ws
+* > [dyson_workspace<T>] scratch memory, enlarged if needed
+* @param SolveOrder
+* > [int] integrator order
+*/
+template <typename T>
+void dyson_timestep_omp(int omp_num_threads, int n, herm_matrix<T> &G, T lam0,
+                        function<T> &H, herm_matrix<T> &Sigma,
+                        T beta, T h, dyson_workspace<T> &ws, int SolveOrder) {
     assert(SolveOrder + 1<= n);
-    assert(n<= Sigma.nt());
-    assert(n<= G.nt());
-    assert(n<= H.nt());
-    assert(G.sig()== Sigma.sig());
-    assert(G.size1()== Sigma.size1());
-    assert(G.size1()== H.size1());
-    assert(G.ntau()== Sigma.ntau());
-    if (size1 == 1) {
-        dyson_timestep_ret_omp<T, herm_matrix<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(0),
-                                                     Sigma, integration::I<T>(SolveOrder), h);
-        dyson_timestep_tv_omp<T, herm_matrix<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(n),
-                                                    Sigma, integration::I<T>(SolveOrder), beta, h);
-        dyson_timestep_les_omp<T, herm_matrix<T>, 1>(omp_num_threads1, n, G, lam0, H.ptr(0),
-                                                     Sigma, integration::I<T>(SolveOrder), beta, h);
-    } else {
-        dyson_timestep_ret_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             H.ptr(0), Sigma, integration::I<T>(SolveOrder), h);
-        dyson_timestep_tv_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                            H.ptr(n), Sigma, integration::I<T>(SolveOrder), beta, h);
-        dyson_timestep_les_omp<T, herm_matrix<T>, LARGESIZE>(omp_num_threads1, n, G, lam0,
-                                                             H.ptr(0), Sigma, integration::I<T>(SolveOrder), beta, h);
-    }
+    dyson_timestep_omp(omp_num_threads, n, G, lam0, H, Sigma,
+                       integration::I<T>(SolveOrder), beta, h, ws);
 }
 
 #endif // CNTR_USE_OMP
@@ -0,0 +1,141 @@
+#ifndef CNTR_DYSON_WORKSPACE_DECL_H
+#define CNTR_DYSON_WORKSPACE_DECL_H
+
+#include "cntr_global_settings.hpp"
+
+namespace cntr {
+
+template <typename T>
+/** \brief <b> Class `dyson_workspace` holds the scratch memory of the timestep
+ * solvers `dyson_timestep`, `dyson_timestep_omp`, `vie2_timestep` and `vie2_timestep_omp`.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The timestep solvers need a number of temporary arrays (linear systems of
+ *  size \f$ k \times k \f$, the history of a timestep, one buffer per OpenMP thread, ...).
+ *  Allocating them on every call is expensive for long propagations. A `dyson_workspace`
+ *  is created once for given (`nt`, `ntau`, `size1`, `order`, `nthreads`) and passed
+ *  to the solvers, which then run without any heap allocation of their own scratch arrays.
+ *
+ *  If the workspace is too small for a call, it is enlarged automatically (it never shrinks).
+ *  The interfaces without a workspace argument use a thread-local instance
+ *  `dyson_workspace<T>::local()`, which grows to the largest problem seen on that thread.
+ *
+ *  The same object can be used for the `vie2` solvers, see `vie2_workspace`.
+ *
+ */
+class dyson_workspace {
+  public:
+    typedef std::complex<T> cplx;
+
+    /* construction, destruction */
+    dyson_workspace();
+    ~dyson_workspace();
+    dyson_workspace(int nt, int ntau, int size1, int order = MAX_SOLVE_ORDER, int nthreads = 1);
+    /* resize */
+    void resize(int nt, int ntau, int size1, int order = MAX_SOLVE_ORDER, int nthreads = 1);
+    void reserve(int nt, int ntau, int size1, int order = MAX_SOLVE_ORDER, int nthreads = 1);
+    void clear(void);
+    /* access size etc ... */
+    int nt(void) const { return nt_; }
+    int ntau(void) const { return ntau_; }
+    int size1(void) const { return size1_; }
+    int order(void) const { return order_; }
+    int nthreads(void) const { return nthreads_; }
+    /// @private
+    static dyson_workspace &local(void);
+
+    // raw pointers to the scratch arrays ... to be used by the solvers only
+    /// @private
+    /** \brief <b> [size1 x size1] </b> */
+    cplx *one(void) { return one_; }
+    /// @private
+    /** \brief <b> [size1 x size1] </b> */
+    cplx *stemp(void) { return stemp_; }
+    /// @private
+    /** \brief <b> [size1 x size1] </b> */
+    cplx *htemp(void) { return htemp_; }
+    /// @private
+    /** \brief <b> [size1 x size1] </b> */
+    cplx *qtemp(void) { return qtemp_; }
+    /// @private
+    /** \brief <b> (order+1) x [size1 x size1] </b> */
+    cplx *gtemp(void) { return gtemp_; }
+    /// @private
+    /** \brief <b> (order+1)^2 x [size1 x size1] </b> */
+    cplx *mm(void) { return mm_; }
+    /// @private
+    /** \brief <b> (nt+1) x [size1 x size1] </b> */
+    cplx *qq(void) { return qq_; }
+    /// @private
+    /** \brief <b> (nt+1) x [size1 x size1] </b> */
+    cplx *gles(void) { return gles_; }
+    /// @private
+    /** \brief <b> (ntau+1) x [size1 x size1] </b> */
+    cplx *tv(void) { return tv_; }
+    /// @private
+    /** \brief <b> order+2 numbers </b> */
+    cplx *diffw(void) { return diffw_; }
+    /// @private
+    cplx *thread_qq(int tid) { return thread_ + tid * thread_stride_; }
+    /// @private
+    cplx *thread_mm(int tid) { return thread_ + tid * thread_stride_ + element_size_; }
+    /// @private
+    cplx *thread_stemp(int tid) { return thread_ + tid * thread_stride_ + 2 * element_size_; }
+    /// @private
+    cplx *thread_diffw(int tid) { return thread_ + tid * thread_stride_ + 3 * element_size_; }
+
+  private:
+    dyson_workspace(const dyson_workspace &ws);
+    dyson_workspace &operator=(const dyson_workspace &ws);
+
+  private:
+    /// @private
+    /** \brief <b> Single allocation holding all shared scratch arrays. </b> */
+    cplx *data_;
+    /// @private
+    /** \brief <b> Single allocation holding the per-thread scratch arrays. </b> */
+    cplx *thread_;
+    cplx *one_;
+    cplx *stemp_;
+    cplx *htemp_;
+    cplx *qtemp_;
+    cplx *gtemp_;
+    cplx *mm_;
+    cplx *qq_;
+    cplx *gles_;
+    cplx *tv_;
+    cplx *diffw_;
+    /// @private
+    /** \brief <b> Number of elements per thread in 'thread_'. </b> */
+    int thread_stride_;
+    /// @private
+    /** \brief <b> Maximum time step the workspace is sized for.</b> */
+    int nt_;
+    /// @private
+    /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
+    int ntau_;
+    /// @private
+    /** \brief <b> Matrix rank of the contour functions.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Size of the Matrix form; size1*size1. </b> */
+    int element_size_;
+    /// @private
+    /** \brief <b> Maximum integration order.</b> */
+    int order_;
+    /// @private
+    /** \brief <b> Number of OpenMP threads.</b> */
+    int nthreads_;
+};
+
+/// The `vie2` timestep solvers share the scratch layout of the Dyson solvers.
+template <typename T>
+using vie2_workspace = dyson_workspace<T>;
+
+}  // namespace cntr
+
+#endif  // CNTR_DYSON_WORKSPACE_DECL_H
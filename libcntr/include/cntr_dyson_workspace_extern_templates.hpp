@@ -0,0 +1,13 @@
+#ifndef CNTR_DYSON_WORKSPACE_EXTERN_TEMPLATES_H
+#define CNTR_DYSON_WORKSPACE_EXTERN_TEMPLATES_H
+
+#include "cntr_dyson_workspace_decl.hpp"
+
+namespace cntr {
+
+extern template class dyson_workspace<double>;
+extern template class dyson_workspace<float>;
+
+}  // namespace cntr
+
+#endif  // CNTR_DYSON_WORKSPACE_EXTERN_TEMPLATES_H
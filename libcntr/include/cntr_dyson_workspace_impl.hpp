@@ -0,0 +1,185 @@
+#ifndef CNTR_DYSON_WORKSPACE_IMPL_H
+#define CNTR_DYSON_WORKSPACE_IMPL_H
+
+#include "cntr_dyson_workspace_decl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   CONSTRUCTION/DESTRUCTION
+#
+########################################################################################*/
+template <typename T>
+dyson_workspace<T>::dyson_workspace() {
+    data_ = 0;
+    thread_ = 0;
+    one_ = stemp_ = htemp_ = qtemp_ = gtemp_ = mm_ = qq_ = gles_ = tv_ = diffw_ = 0;
+    thread_stride_ = 0;
+    nt_ = -1;
+    ntau_ = -1;
+    size1_ = 0;
+    element_size_ = 0;
+    order_ = 0;
+    nthreads_ = 0;
+}
+template <typename T>
+dyson_workspace<T>::~dyson_workspace() {
+    delete[] data_;
+    delete[] thread_;
+}
+
+/** \brief <b> Allocates a `dyson_workspace` for the given problem size.  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Allocates the scratch memory needed by the timestep solvers for all timesteps
+* `n <= nt`, matrix rank `size1`, integration orders up to `order` and
+* up to `nthreads` OpenMP threads.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt
+* > Maximum number of time steps
+* @param ntau
+* > Number of points on Matsubara axis
+* @param size1
+* > Matrix rank of the contour function
+* @param order
+* > Maximum integration order
+* @param nthreads
+* > Maximum number of OpenMP threads
+*/
+template <typename T>
+dyson_workspace<T>::dyson_workspace(int nt, int ntau, int size1, int order, int nthreads) {
+    data_ = 0;
+    thread_ = 0;
+    resize(nt, ntau, size1, order, nthreads);
+}
+
+/** \brief <b> Reallocates the workspace for the given problem size.  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Discards the old scratch memory and allocates new arrays for the given problem size.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt
+* > Maximum number of time steps
+* @param ntau
+* > Number of points on Matsubara axis
+* @param size1
+* > Matrix rank of the contour function
+* @param order
+* > Maximum integration order
+* @param nthreads
+* > Maximum number of OpenMP threads
+*/
+template <typename T>
+void dyson_workspace<T>::resize(int nt, int ntau, int size1, int order, int nthreads) {
+    int sg, k1, n1, len;
+    assert(nt >= -1 && ntau >= 0 && size1 >= 1);
+    assert(order >= 1 && order <= MAX_SOLVE_ORDER && nthreads >= 1);
+    delete[] data_;
+    delete[] thread_;
+    nt_ = nt;
+    ntau_ = ntau;
+    size1_ = size1;
+    element_size_ = size1 * size1;
+    order_ = order;
+    nthreads_ = nthreads;
+    sg = element_size_;
+    k1 = order + 1;
+    n1 = (nt > k1 ? nt : k1);
+    len = 4 * sg + k1 * sg + k1 * k1 * sg + 2 * (n1 + 1) * sg + (ntau + 1) * sg + (k1 + 1);
+    data_ = new cplx[len];
+    one_ = data_;
+    stemp_ = one_ + sg;
+    htemp_ = stemp_ + sg;
+    qtemp_ = htemp_ + sg;
+    gtemp_ = qtemp_ + sg;
+    mm_ = gtemp_ + k1 * sg;
+    qq_ = mm_ + k1 * k1 * sg;
+    gles_ = qq_ + (n1 + 1) * sg;
+    tv_ = gles_ + (n1 + 1) * sg;
+    diffw_ = tv_ + (ntau + 1) * sg;
+    thread_stride_ = 3 * sg + (k1 + 1);
+    thread_ = new cplx[nthreads * thread_stride_];
+}
+
+/** \brief <b> Makes sure the workspace is large enough for the given problem size.  </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* Does nothing if the workspace is already large enough. Otherwise the workspace
+* is reallocated for the maximum of the old and the requested dimensions.
+* Called by the solvers at every timestep; no memory is allocated if the workspace
+* was created with sufficient size.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt
+* > Maximum number of time steps
+* @param ntau
+* > Number of points on Matsubara axis
+* @param size1
+* > Matrix rank of the contour function
+* @param order
+* > Maximum integration order
+* @param nthreads
+* > Maximum number of OpenMP threads
+*/
+template <typename T>
+void dyson_workspace<T>::reserve(int nt, int ntau, int size1, int order, int nthreads) {
+    if (data_ != 0 && nt <= nt_ && ntau <= ntau_ && size1 == size1_ && order <= order_ &&
+        nthreads <= nthreads_)
+        return;
+    if (data_ != 0 && size1 == size1_) {
+        nt = (nt > nt_ ? nt : nt_);
+        ntau = (ntau > ntau_ ? ntau : ntau_);
+        order = (order > order_ ? order : order_);
+        nthreads = (nthreads > nthreads_ ? nthreads : nthreads_);
+    }
+    resize(nt, ntau, size1, order, nthreads);
+}
+
+/** \brief <b> Releases all scratch memory.  </b> */
+template <typename T>
+void dyson_workspace<T>::clear(void) {
+    delete[] data_;
+    delete[] thread_;
+    data_ = 0;
+    thread_ = 0;
+    one_ = stemp_ = htemp_ = qtemp_ = gtemp_ = mm_ = qq_ = gles_ = tv_ = diffw_ = 0;
+    thread_stride_ = 0;
+    nt_ = -1;
+    ntau_ = -1;
+    size1_ = 0;
+    element_size_ = 0;
+    order_ = 0;
+    nthreads_ = 0;
+}
+
+/** \brief <b> Thread-local workspace used by the solvers if no workspace is passed.  </b> */
+template <typename T>
+dyson_workspace<T> &dyson_workspace<T>::local(void) {
+    static thread_local dyson_workspace<T> ws;
+    return ws;
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_DYSON_WORKSPACE_IMPL_H
@@ -1,8 +1,10 @@
 #ifndef CNTR_ELEMENTS_H
 #define CNTR_ELEMENTS_H
 
+#include "cntr_global_settings.hpp"
 #include "eigen_map.hpp"
 #include "linalg.hpp"
+#include "cntr_elements_simd.hpp"
 
 namespace cntr {
 
@@ -11,6 +13,94 @@ namespace cntr {
 #define LARGESIZE (-1) // Fall back to dynamic size
 #define BLAS_SIZE 4    // use blas for larger matrices
 // #define USE_BLAS
+
+// CNTR_SIZE1_DISPATCH(size1, SIZE1, statements) executes the statements with
+// the constant SIZE1 equal to size1 if size1 <= CNTR_MAX_FIXED_SIZE, and equal
+// to LARGESIZE otherwise; e.g.
+//   CNTR_SIZE1_DISPATCH(size1, SIZE1,
+//       convolution_timestep_ret<T, herm_matrix<T>, SIZE1>(n, C, A, Acc, B, Bcc, I, h);
+//   );
+#define CNTR_SIZE1_CASE(N, SIZE1, ...)                                                         \
+    case N: {                                                                                  \
+        const int SIZE1 = N;                                                                   \
+        __VA_ARGS__;                                                                           \
+    } break;
+#if CNTR_MAX_FIXED_SIZE >= 2
+#define CNTR_SIZE1_CASE_2(SIZE1, ...) CNTR_SIZE1_CASE(2, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_2(M) M(2)
+#else
+#define CNTR_SIZE1_CASE_2(SIZE1, ...)
+#define CNTR_SIZE1_EACH_2(M)
+#endif
+#if CNTR_MAX_FIXED_SIZE >= 3
+#define CNTR_SIZE1_CASE_3(SIZE1, ...) CNTR_SIZE1_CASE(3, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_3(M) M(3)
+#else
+#define CNTR_SIZE1_CASE_3(SIZE1, ...)
+#define CNTR_SIZE1_EACH_3(M)
+#endif
+#if CNTR_MAX_FIXED_SIZE >= 4
+#define CNTR_SIZE1_CASE_4(SIZE1, ...) CNTR_SIZE1_CASE(4, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_4(M) M(4)
+#else
+#define CNTR_SIZE1_CASE_4(SIZE1, ...)
+#define CNTR_SIZE1_EACH_4(M)
+#endif
+#if CNTR_MAX_FIXED_SIZE >= 5
+#define CNTR_SIZE1_CASE_5(SIZE1, ...) CNTR_SIZE1_CASE(5, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_5(M) M(5)
+#else
+#define CNTR_SIZE1_CASE_5(SIZE1, ...)
+#define CNTR_SIZE1_EACH_5(M)
+#endif
+#if CNTR_MAX_FIXED_SIZE >= 6
+#define CNTR_SIZE1_CASE_6(SIZE1, ...) CNTR_SIZE1_CASE(6, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_6(M) M(6)
+#else
+#define CNTR_SIZE1_CASE_6(SIZE1, ...)
+#define CNTR_SIZE1_EACH_6(M)
+#endif
+#if CNTR_MAX_FIXED_SIZE >= 7
+#define CNTR_SIZE1_CASE_7(SIZE1, ...) CNTR_SIZE1_CASE(7, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_7(M) M(7)
+#else
+#define CNTR_SIZE1_CASE_7(SIZE1, ...)
+#define CNTR_SIZE1_EACH_7(M)
+#endif
+#if CNTR_MAX_FIXED_SIZE >= 8
+#define CNTR_SIZE1_CASE_8(SIZE1, ...) CNTR_SIZE1_CASE(8, SIZE1, __VA_ARGS__)
+#define CNTR_SIZE1_EACH_8(M) M(8)
+#else
+#define CNTR_SIZE1_CASE_8(SIZE1, ...)
+#define CNTR_SIZE1_EACH_8(M)
+#endif
+#define CNTR_SIZE1_DISPATCH(size1, SIZE1, ...)                                                 \
+    switch (size1) {                                                                           \
+        CNTR_SIZE1_CASE(1, SIZE1, __VA_ARGS__)                                                 \
+        CNTR_SIZE1_CASE_2(SIZE1, __VA_ARGS__)                                                  \
+        CNTR_SIZE1_CASE_3(SIZE1, __VA_ARGS__)                                                  \
+        CNTR_SIZE1_CASE_4(SIZE1, __VA_ARGS__)                                                  \
+        CNTR_SIZE1_CASE_5(SIZE1, __VA_ARGS__)                                                  \
+        CNTR_SIZE1_CASE_6(SIZE1, __VA_ARGS__)                                                  \
+        CNTR_SIZE1_CASE_7(SIZE1, __VA_ARGS__)                                                  \
+        CNTR_SIZE1_CASE_8(SIZE1, __VA_ARGS__)                                                  \
+    default: {                                                                                 \
+        const int SIZE1 = LARGESIZE;                                                           \
+        __VA_ARGS__;                                                                           \
+    } break;                                                                                   \
+    }
+// CNTR_SIZE1_FOR_EACH(M) expands M(SIZE1) for every SIZE1 used by CNTR_SIZE1_DISPATCH,
+// for explicit instantiations of the kernels.
+#define CNTR_SIZE1_FOR_EACH(M)                                                                 \
+    M(1)                                                                                       \
+    CNTR_SIZE1_EACH_2(M)                                                                       \
+    CNTR_SIZE1_EACH_3(M)                                                                       \
+    CNTR_SIZE1_EACH_4(M)                                                                       \
+    CNTR_SIZE1_EACH_5(M)                                                                       \
+    CNTR_SIZE1_EACH_6(M)                                                                       \
+    CNTR_SIZE1_EACH_7(M)                                                                       \
+    CNTR_SIZE1_EACH_8(M)                                                                       \
+    M(LARGESIZE)
 /* #######################################################################################
 #
 #   general matrix operations ...
@@ -315,6 +405,38 @@ template<> inline void element_incr<VALUE_TYPE,1,1,1>(int size1,int size2,int si
    *z=*z+alpha*(*z1)*(*z2);
 }
 
+/* #######################################################################################
+#
+#   vectorized products of small square matrices (2 <= size1 <= CNTR_SIMD_MAXSIZE),
+#   T=double only; the kernels are selected at runtime, see cntr_elements_simd.hpp.
+#   Return false if no kernel applies.
+#
+########################################################################################*/
+/// @private
+template<typename T>
+inline bool element_simd_mult(int size1,std::complex<T> *z,std::complex<T> alpha,std::complex<T> *z1,std::complex<T> *z2){
+  return false;
+}
+/// @private
+template<typename T>
+inline bool element_simd_incr(int size1,std::complex<T> *z,std::complex<T> alpha,std::complex<T> *z1,std::complex<T> *z2){
+  return false;
+}
+#ifdef CNTR_USE_SIMD
+/// @private
+template<> inline bool element_simd_mult<double>(int size1,std::complex<double> *z,std::complex<double> alpha,std::complex<double> *z1,std::complex<double> *z2){
+  if(size1>CNTR_SIMD_MAXSIZE || z==z1 || z==z2 || element_simd_mult_table[size1]==NULL) return false;
+  element_simd_mult_table[size1](z,alpha,z1,z2);
+  return true;
+}
+/// @private
+template<> inline bool element_simd_incr<double>(int size1,std::complex<double> *z,std::complex<double> alpha,std::complex<double> *z1,std::complex<double> *z2){
+  if(size1>CNTR_SIMD_MAXSIZE || z==z1 || z==z2 || element_simd_incr_table[size1]==NULL) return false;
+  element_simd_incr_table[size1](z,alpha,z1,z2);
+  return true;
+}
+#endif // CNTR_USE_SIMD
+
 /* #######################################################################################
 #
 #   square matrix operations ... partly derived from the general ones,
@@ -394,6 +516,7 @@ inline void element_smul(int size1,CPLX *z,CPLX z0) {
 /// @private
 template<typename T,int DIM>
 inline void element_mult(int size1,CPLX *z,CPLX *z1,CPLX *z2){ 
+   if(DIM!=1 && element_simd_mult<T>(size1,z,CPLX(1.0),z1,z2)) return;
    element_mult<T,DIM,DIM,DIM>(size1,size1,size1,z,z1,z2);
 }
 // increment with product etc.
@@ -415,11 +538,13 @@ inline void element_incr(int size1,CPLX *z,CPLX alpha,CPLX *z1) {
 /// @private
 template<typename T,int DIM>
 inline void element_incr(int size1,CPLX *z,CPLX *z1,CPLX *z2){
+    if(DIM!=1 && element_simd_incr<T>(size1,z,CPLX(1.0),z1,z2)) return;
     element_incr<T,DIM,DIM,DIM>(size1,size1,size1,z,z1,z2);
 }
 /// @private
 template<typename T,int DIM>
 inline void element_incr(int size1,CPLX *z,CPLX alpha,CPLX *z1,CPLX *z2){
+    if(DIM!=1 && element_simd_incr<T>(size1,z,alpha,z1,z2)) return;
     element_incr<T,DIM,DIM,DIM>(size1,size1,size1,z,alpha,z1,z2);
 }
 // matrix inverse , use double precision because i am lazy to look
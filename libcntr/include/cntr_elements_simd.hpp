@@ -0,0 +1,70 @@
+#ifndef CNTR_ELEMENTS_SIMD_H
+#define CNTR_ELEMENTS_SIMD_H
+
+#include <complex>
+
+namespace cntr {
+
+#define CNTR_SIMD_NONE 0
+#define CNTR_SIMD_AVX2 1
+#define CNTR_SIMD_AVX512 2
+// largest element size with a vectorized kernel
+#define CNTR_SIMD_MAXSIZE 8
+
+/// @private
+/** \brief <b> Kernel for the product of two square matrices of fixed size.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Computes \f$ z = \alpha z_1 z_2 \f$ (mult) or \f$ z \mathrel{+}= \alpha z_1 z_2 \f$ (incr)
+ *  for row-major square matrices. `z` must not overlap `z1` or `z2`.
+ */
+typedef void (*element_simd_kernel)(std::complex<double> *z, std::complex<double> alpha,
+                                    const std::complex<double> *z1,
+                                    const std::complex<double> *z2);
+
+/// @private
+/** \brief <b> Vectorized kernels indexed by the matrix size, NULL if not available.</b> */
+extern element_simd_kernel element_simd_incr_table[CNTR_SIMD_MAXSIZE + 1];
+/// @private
+extern element_simd_kernel element_simd_mult_table[CNTR_SIMD_MAXSIZE + 1];
+
+/// @private
+/** \brief <b> Returns the instruction set used by the element kernels.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  `CNTR_SIMD_AVX512`, `CNTR_SIMD_AVX2` or `CNTR_SIMD_NONE`. At startup, the widest
+ *  instruction set supported by the CPU is selected.
+ */
+int element_simd_level(void);
+
+/// @private
+/** \brief <b> Selects the instruction set used by the element kernels.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The level is reduced to the widest instruction set supported by the CPU.
+ *  `CNTR_SIMD_NONE` switches back to the generic (Eigen) element routines.
+ *  Returns the selected level.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param level
+ * > `CNTR_SIMD_NONE`, `CNTR_SIMD_AVX2` or `CNTR_SIMD_AVX512`
+ */
+int element_simd_set_level(int level);
+
+}  // namespace cntr
+
+#endif  // CNTR_ELEMENTS_SIMD_H
@@ -58,6 +58,14 @@ namespace cntr {
   void green_equilibrium(herm_matrix<T> &G, dos_function &dos, double beta,
     double h, double mu=0.0, int limit = 100, int nn = 20);
 
+  // user-defined DOS, sampled once on a shared frequency grid
+  template <typename T, class dos_function>
+  void green_equilibrium_spectral(herm_matrix<T> &G, dos_function &dos, double beta,
+    double h, double mu=0.0, int limit = 100, int nn = 20);
+  template <typename T, class dos_function>
+  void green_equilibrium_mat_spectral(herm_matrix<T> &G, dos_function &dos, double beta,
+    double mu=0.0, int limit = 100, int nn = 20);
+
   // other "simple" Greenfunctions: [idt + mu - H(t)]^{-1} and [idt + mu -
   // H0]^{-1} etc
   // template <typename T>
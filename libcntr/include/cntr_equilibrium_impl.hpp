@@ -232,6 +232,51 @@ double distribution_exp_eq(T beta,T tau,T omega,int sign)
 /// @private
 enum flavor { ret, adv, mat, tv, vt, les, gtr };
 
+/// @private
+/** \brief <b> Distribution factor multiplying the density of states for a given component. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Returns the factor \f$F_x(\tau,\omega)\f$ such that the component \f$x\f$ of the equilibrium
+* > propagator is the Fourier integral of \f$A(\omega) F_x(\tau,\omega-\mu)\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param x
+* > component (ret, les, tv or mat)
+* @param beta
+* > inverse temperature
+* @param tau
+* > imaginary time (tv and mat only)
+* @param omega
+* > frequency relative to the chemical potential
+* @param sign
+* > Bose = 1, Fermi = -1
+*/
+inline double dos_kernel(flavor x,double beta,double tau,double omega,int sign){
+  double fm;
+  if(x==ret){
+    fm=1;
+  }else if(x==les){
+    fm=sign*distribution_eq(beta,omega,sign);
+  }else if (x==tv){
+    fm=sign*distribution_exp_eq(beta,tau,omega,sign);
+  }else if(x==mat){
+    if(omega>0){
+      fm=sign*exp(-tau*omega)*distribution_eq(beta,-omega,sign);
+    }else{
+      fm=(-1.0)*exp((beta-tau)*omega)*distribution_eq(beta,omega,sign);
+    }
+  }else{
+    fm=0;
+  }
+  return fm;
+}
+
 template < class dos > struct dos_wrapper{
     flavor x_;
     double beta_;
@@ -248,23 +293,7 @@ template < class dos > struct dos_wrapper{
       sign_=sign;
     }
     double operator()(double omega){
-      double a=A_(omega),fm;
-      if(x_==ret){
-          fm=1;
-      }else if(x_==les){
-        fm=sign_*distribution_eq(beta_,omega-mu_,sign_);
-      }else if (x_==tv){
-        fm=sign_*distribution_exp_eq(beta_,tau_,omega-mu_,sign_);
-      }else if(x_==mat){
-        if(omega-mu_>0){
-           fm=sign_*exp(-tau_*(omega-mu_))*distribution_eq(beta_,-(omega-mu_),sign_);
-        }else{
-           fm=(-1.0)*exp((beta_-tau_)*(omega-mu_))*distribution_eq(beta_,(omega-mu_),sign_);
-        }
-      }else{
-        fm=0;
-      }
-      return a*fm;
+      return A_(omega)*dos_kernel(x_,beta_,tau_,omega-mu_,sign_);
     }
 };
 
@@ -559,6 +588,247 @@ void green_equilibrium(herm_matrix<T> &G,dos_function &dos,double beta,double h,
   green_equilibrium_les(G,dos,beta,h,limit,nn,mu);
 }
 
+/*####################################################################################
+#
+#   Equilibrium propagator from a shared frequency grid: the density of states is
+#   sampled once on an adaptive grid, and all components at all times are obtained
+#   as matrix products of the cubically corrected DFT weights with the spectral data.
+#
+######################################################################################*/
+
+/// @private
+/** \brief <b> Sampling function for the shared frequency grid. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Returns \f$A(\omega)(1+|f(\omega-\mu)|)\f$, so that the adaptive grid resolves
+* > both the density of states and the occupied part of the spectrum.
+*/
+template < class dos > struct dos_grid_wrapper{
+    double beta_;
+    int sign_;
+    double mu_;
+    dos A_;
+    dos_grid_wrapper(const dos& f,double beta,int sign,double mu){
+      A_=f;
+      beta_=beta;
+      sign_=sign;
+      mu_=mu;
+    }
+    double operator()(double omega){
+      return A_(omega)*(1.0+fabs(distribution_eq(beta_,omega-mu_,sign_)));
+    }
+};
+
+/// @private
+/** \brief <b> Density of states on an adaptive frequency grid. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > The frequency grid consists of the intervals determined by `fourier::adft_func::sample`,
+* > each with `len+1` equidistant points. Points shared by adjacent intervals are stored
+* > once per interval. The Fourier integral of a function \f$g\f$ given on the grid is
+* > \f$\sum_k c_k(w) g(\omega_k)\f$ with the weights returned by `weights`.
+*/
+class dos_spectral_grid {
+  public:
+    /** \brief <b> Number of grid points </b> */
+    int nw_;
+    /** \brief <b> Frequencies of the grid points </b> */
+    std::vector<double> omega_;
+    /** \brief <b> Density of states at the grid points </b> */
+    std::vector<double> dos_;
+    /** \brief <b> Index of the first point, bounds and length of each interval </b> */
+    std::vector<int> first_;
+    std::vector<double> lo_;
+    std::vector<double> hi_;
+    std::vector<int> len_;
+
+    dos_spectral_grid() {
+      nw_=0;
+    }
+    /** \brief <b> Samples the density of states once on the adaptive grid. </b> */
+    template <class dos_function>
+    void init(dos_function &dos,double beta,int sign,double mu,int limit,int nn){
+      fourier::adft_func adft;
+      dos_grid_wrapper<dos_function> dos1(dos,beta,sign,mu);
+      int i,j,n,len;
+      double a,b;
+      adft.sample(0.0,dos.lo_,dos.hi_,dos1,nn,limit);
+      n=adft.num_intervals();
+      first_.resize(n);
+      lo_.resize(n);
+      hi_.resize(n);
+      len_.resize(n);
+      nw_=0;
+      for(i=0;i<n;i++){
+        adft.interval(i,a,b,len);
+        first_[i]=nw_;
+        lo_[i]=a;
+        hi_[i]=b;
+        len_[i]=len;
+        nw_+=len+1;
+      }
+      omega_.resize(nw_);
+      dos_.resize(nw_);
+      for(i=0;i<n;i++){
+        for(j=0;j<=len_[i];j++){
+          omega_[first_[i]+j]=lo_[i]+j*(hi_[i]-lo_[i])/len_[i];
+          dos_[first_[i]+j]=dos(omega_[first_[i]+j]);
+        }
+      }
+    }
+    /** \brief <b> DFT weights \f$c_k(w)\f$ of all grid points, `c` has length `nw_`. </b> */
+    void weights(double w,std::complex<double> *c) const {
+      for(int i=0;i<(int)first_.size();i++){
+        fourier::dft_cplx_weights(w,len_[i],lo_[i],hi_[i],c+first_[i]);
+      }
+    }
+};
+
+/// @private
+/** \brief <b> Matsubara component from the density of states on a shared grid. </b> */
+template <typename T>
+void green_equilibrium_mat_grid(herm_matrix<T> &G,const dos_spectral_grid &grid,double beta,double mu)
+{
+  typedef std::complex<double> cplx;
+  int ntau=G.ntau(),size1=G.size1(),sign=G.sig(),nw=grid.nw_,m,k;
+  double dtau=beta/ntau;
+  cdvector c0(nw);
+  grid.weights(0.0,c0.data());
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for private(k) if(ntau >= 64)
+#endif
+  for(m=0;m<=ntau;m++){
+    cplx res=0.0;
+    for(k=0;k<nw;k++) res+=c0(k)*grid.dos_[k]*dos_kernel(mat,beta,m*dtau,grid.omega_[k]-mu,sign);
+    element_set<T,LARGESIZE>(size1,G.matptr(m),(std::complex<T>)(res));
+  }
+}
+
+/** \brief <b> Equilibrium propagator for the given density of states, from a shared frequency grid. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Same as `green_equilibrium`, but the density of states is sampled only once on an
+* > adaptive frequency grid. The Matsubara, retarded, left-mixing and lesser components are
+* > then evaluated at all times as matrix products of the DFT weights
+* > \f$c_k(t_n)\f$ with \f$A(\omega_k) F_x(\tau_m,\omega_k-\mu)\f$, instead of repeating the
+* > adaptive sampling for every \f$\tau\f$. With OpenMP (CNTR_USE_OMP), the time points are
+* > distributed over the threads.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param G
+* > The output Greens function set to the equilibrium free propagator
+* @param dos
+* > density of states
+* @param beta
+* > inverse temperature
+* @param h
+* > timestep
+* @param mu
+* > chemical potential
+* @param limit
+* > max number of intervals in Fourier transform (default: 100)
+* @param nn
+* > number of points in each interval of the Fourier transform (default: 20)
+*/
+template <typename T,class dos_function>
+void green_equilibrium_spectral(herm_matrix<T> &G,dos_function &dos,double beta,double h,double mu,int limit,int nn)
+{
+  typedef std::complex<double> cplx;
+  const int nb=16; // imaginary times per block of the left-mixing product
+  int nt=G.nt(),ntau=G.ntau(),size1=G.size1(),sign=G.sig();
+  int nw,n,m,k,i,ib,nblk;
+  double dtau=beta/ntau;
+  cplx cplx_i=cplx(0,1);
+  dos_spectral_grid grid;
+  grid.init(dos,beta,sign,mu,limit,nn);
+  nw=grid.nw_;
+  green_equilibrium_mat_grid(G,grid,beta,mu);
+  if(nt<0) return;
+  // Ct(k,n) = c_k(-n*h)
+  cdmatrix Ct(nw,nt+1);
+  cdvector gret(nt+1),gles(nt+1),Ales(nw);
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for
+#endif
+  for(n=0;n<=nt;n++) grid.weights(-n*h,Ct.data()+(size_t)n*nw);
+  // retarded and lesser: G^R(n*h) = -i sum_k c_k(-nh) A_k, G^<(-nh) = -i sum_k c_k(nh) A_k F_les
+  for(k=0;k<nw;k++) Ales(k)=grid.dos_[k]*dos_kernel(les,beta,0.0,grid.omega_[k]-mu,sign);
+  gret=-cplx_i*(Ct.transpose()*Eigen::Map<dvector>(grid.dos_.data(),nw).cast<cplx>());
+  gles=-cplx_i*(Ct.adjoint()*Ales);
+  for(n=0;n<=nt;n++){
+    for(i=n;i<=nt;i++){
+      element_set<T,LARGESIZE>(size1,G.retptr(i,i-n),(std::complex<T>)(gret(n)));
+      element_set<T,LARGESIZE>(size1,G.lesptr(i-n,i),(std::complex<T>)(gles(n)));
+    }
+  }
+  // left-mixing: G^tv(nh,tau_m) = -i sum_k c_k(-nh) A_k F_tv(tau_m), in blocks of tau
+  nblk=(ntau+nb)/nb;
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for private(n,m,k) schedule(dynamic)
+#endif
+  for(ib=0;ib<nblk;ib++){
+    int m0=ib*nb,m1=std::min(ntau+1,m0+nb);
+    cdmatrix F(nw,m1-m0),tv1;
+    for(m=m0;m<m1;m++){
+      for(k=0;k<nw;k++) F(k,m-m0)=grid.dos_[k]*dos_kernel(tv,beta,m*dtau,grid.omega_[k]-mu,sign);
+    }
+    tv1.noalias()=Ct.transpose()*F;
+    for(n=0;n<=nt;n++){
+      for(m=m0;m<m1;m++){
+        element_set<T,LARGESIZE>(size1,G.tvptr(n,m),(std::complex<T>)(-cplx_i*tv1(n,m-m0)));
+      }
+    }
+  }
+}
+
+/** \brief <b> Matsubara equilibrium propagator for the given density of states, from a shared frequency grid. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Same as `green_equilibrium_mat`, but the density of states is sampled only once,
+* > see `green_equilibrium_spectral`.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param G
+* > The output Greens function set to the equilibrium free propagator
+* @param dos
+* > density of states
+* @param beta
+* > inverse temperature
+* @param mu
+* > chemical potential
+* @param limit
+* > max number of intervals in Fourier transform (default: 100)
+* @param nn
+* > number of points in each interval of the Fourier transform (default: 20)
+*/
+template <typename T,class dos_function>
+void green_equilibrium_mat_spectral(herm_matrix<T> &G,dos_function &dos,double beta,double mu,int limit,int nn)
+{
+  dos_spectral_grid grid;
+  grid.init(dos,beta,G.sig(),mu,limit,nn);
+  green_equilibrium_mat_grid(G,grid,beta,mu);
+}
+
 
 /** \brief <b> Equilibrium propagator for Bethe semicircular density of states. Matsubara only.  </b>
 *
@@ -10,6 +10,12 @@
 #include "cntr_herm_matrix_extern_templates.hpp"
 
 #include "cntr_herm_pseudo_extern_templates.hpp"
+#include "cntr_herm_matrix_window_extern_templates.hpp"
+#include "cntr_herm_matrix_hodlr_extern_templates.hpp"
+#include "cntr_dlr_extern_templates.hpp"
+#include "cntr_herm_matrix_tti_extern_templates.hpp"
+
+#include "cntr_dyson_workspace_extern_templates.hpp"
 
 #include "cntr_utilities_extern_templates.hpp"
 #include "cntr_differentiation_extern_templates.hpp"
@@ -19,6 +25,12 @@
 #include "cntr_equilibrium_extern_templates.hpp"
 #include "cntr_vie2_extern_templates.hpp"
 #include "cntr_dyson_extern_templates.hpp"
+#include "cntr_window_solvers_extern_templates.hpp"
+#include "cntr_hodlr_convolution_extern_templates.hpp"
+#include "cntr_dlr_solvers_extern_templates.hpp"
+#include "cntr_gkba_extern_templates.hpp"
+#include "cntr_tti_solvers_extern_templates.hpp"
+#include "cntr_herm_matrix_blocks_extern_templates.hpp"
 
 #include "cntr_getset_extern_templates.hpp"
 #ifdef CNTR_USE_MPI
@@ -42,11 +42,14 @@ class function {
     int size1(void) const { return size1_; }
     int size2(void) const { return size2_; }
     int nt(void) const { return nt_; }
+    int nt_capacity(void) const { return nt_capacity_; }
     inline cplx *ptr(int t) { return data_ + (t + 1) * element_size_; }
     inline const cplx *ptr(int t) const {
         return data_ + (t + 1) * element_size_;
     }
     void resize(int nt, int size1);
+    void resize_nt(int nt);
+    void reserve(int nt_capacity);
     void set_zero(void);
     void set_constant(cplx *f0); // f0 must be size*size
     template<class EigenMatrix>
@@ -104,6 +107,9 @@ class function {
     int element_size_;
     /** \brief <b> Size of the data stored for the function on the real-time axis including \f$ t=-1\f$; \f$ (n_t + 2)\f$ * size1 * size2 . </b> */
     int total_size_;
+    /// @private
+    /** \brief <b> Number of the time steps for which `data_` is allocated; \f$ (n_{\rm capacity} + 2)\f$ * size1 * size2 elements. </b> */
+    int nt_capacity_;
 };
 
 }  // namespace cntr
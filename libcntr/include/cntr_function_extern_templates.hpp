@@ -16,6 +16,12 @@ namespace cntr {
   extern template void function<double>::set_matrixelement<Eigen::MatrixXcd>(int tstp,int i1,int i2,Eigen::MatrixXcd &M,int j1,int j2);
   //extern template void function<double>::set_matrixelement(int i1,int i2,function<double> &g,int j1,int j2);
 
+  // single precision
+  extern template class function<float>;
+
+  extern template void function<float>::set_value<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M);
+  extern template void function<float>::get_value<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M) const;
+
 }  // namespace cntr
 
 #endif  // CNTR_FUNCTION_EXTERN_TEMPLATES_H
@@ -5,6 +5,7 @@
 #include "linalg.hpp"
 //#include "cntr_exception.hpp"
 #include "cntr_elements.hpp"
+#include "cntr_profile.hpp"
 
 namespace cntr {
 
@@ -16,6 +17,7 @@ function<T>::function() {
     size2_ = 0;
     element_size_ = 0;
     total_size_ = 0;
+    nt_capacity_ = -2;
 }
 template <typename T>
 function<T>::~function() {
@@ -55,6 +57,7 @@ function<T>::function(int nt, int size1) {
     size2_ = size1;
     element_size_ = size1 * size1_;
     nt_ = nt;
+    nt_capacity_ = nt;
     total_size_ = (nt_ + 2) * size1_ * size2_;
 }
 
@@ -91,6 +94,7 @@ template <typename T> function<T>::function(int nt,int size1,int size2){
    size2_=size2;
    element_size_=size1*size2_;
    nt_=nt;
+   nt_capacity_=nt;
    total_size_ = len;
 }
 /** \brief <b> Initializes the `function` class from an existing function object</b>
@@ -114,6 +118,7 @@ template <typename T>
 function<T>::function(const function &g) {
     int len;
     nt_ = g.nt_;
+    nt_capacity_ = g.nt_;
     size1_ = g.size1_;
     size2_ = g.size2_;
     element_size_ = size1_ * size2_;
@@ -152,13 +157,15 @@ function<T>::function(function &&g) noexcept
       size1_(g.size1_),
       size2_(g.size2_),
       element_size_(g.element_size_),
-      total_size_(g.total_size_) {
+      total_size_(g.total_size_),
+      nt_capacity_(g.nt_capacity_) {
     g.data_ = nullptr;
     g.nt_ = -2;
     g.size1_ = 0;
     g.size2_ = 0;
     g.element_size_ = 0;
     g.total_size_ = 0;
+    g.nt_capacity_ = -2;
 }
 /** \brief <b> Overloaded operator '=', which copies data from an existing `function` object(right-value reference)</b>
 *
@@ -189,6 +196,7 @@ function<T> &function<T>::operator=(function &&g) noexcept {
     size2_ = g.size2_;
     element_size_ = g.element_size_;
     total_size_ = g.total_size_;
+    nt_capacity_ = g.nt_capacity_;
 
     g.data_ = nullptr;
     g.nt_ = -2;
@@ -196,6 +204,7 @@ function<T> &function<T>::operator=(function &&g) noexcept {
     g.size2_ = 0;
     g.element_size_ = 0;
     g.total_size_ = 0;
+    g.nt_capacity_ = -2;
 
     return *this;
 }
@@ -225,6 +234,7 @@ function<T> &function<T>::operator=(const function &g) {
     if (data_ != 0)
         delete[] data_;
     nt_ = g.nt_;
+    nt_capacity_ = g.nt_;
     size1_ = g.size1_;
     size2_ = g.size2_;
     element_size_ = size1_ * size2_;
@@ -271,8 +281,79 @@ void function<T>::resize(int nt, int size1) {
     size2_ = size1;
     element_size_ = size1_ * size1_;
     nt_ = nt;
+    nt_capacity_ = nt;
     total_size_ = len;
 }
+/** \brief <b> Resize the time length of a function, keeping its values</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Resize the number of time steps to `nt`, keeping the values at the times
+* > \f$ t \le \f$ min(`nt`,`nt()`); the values at new times are set to zero.
+* > Within the capacity `nt_capacity()`, no memory is reallocated. Beyond it, the
+* > capacity is increased by at least half, as for `herm_matrix::resize_nt`.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt
+* > the new number of time-steps.
+*/
+
+template <typename T>
+void function<T>::resize_nt(int nt) {
+    int cap = nt_capacity_;
+    cplx *data;
+    assert(nt >= -1 && nt_ >= -1);
+    if (nt > cap) {
+        cap = (nt > cap + cap / 2 ? nt : cap + cap / 2);
+        if (element_size_ > 0) {
+            data = new cplx[(cap + 2) * element_size_];
+            memcpy(data, data_, sizeof(cplx) * total_size_);
+            delete[] data_;
+            data_ = data;
+        }
+        nt_capacity_ = cap;
+    }
+    if (nt > nt_ && element_size_ > 0)
+        memset(data_ + total_size_, 0, sizeof(cplx) * (nt - nt_) * element_size_);
+    nt_ = nt;
+    total_size_ = (nt_ + 2) * element_size_;
+}
+/** \brief <b> Allocate memory for at least `nt_capacity` time steps</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Allocate memory for at least `nt_capacity` time steps, such that `resize_nt(nt)`
+* > with `nt <= nt_capacity` does not reallocate. `nt()` and the values are not changed.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt_capacity
+* > number of time-steps to allocate memory for.
+*/
+
+template <typename T>
+void function<T>::reserve(int nt_capacity) {
+    cplx *data;
+    assert(nt_ >= -1);
+    if (nt_capacity <= nt_capacity_)
+        return;
+    if (element_size_ > 0) {
+        data = new cplx[(nt_capacity + 2) * element_size_];
+        memcpy(data, data_, sizeof(cplx) * total_size_);
+        delete[] data_;
+        data_ = data;
+    }
+    nt_capacity_ = nt_capacity;
+}
 /** \brief <b> Set all data to zero for the `function` class</b>
 *
 * <!-- ====== DOCUMENTATION ====== -->
@@ -843,6 +924,8 @@ void function<T>::read_from_file(int nt1, const char *file) {
 */
 template <typename T>
 void function<T>::write_to_hdf5(hid_t group_id) const {
+    CNTR_PROFILE_SCOPE("function::write_to_hdf5", CNTR_PROFILE_NO_TSTP, 0.0,
+                       (double)sizeof(cplx) * total_size_);
     store_int_attribute_to_hid(group_id, std::string("nt"), nt_);
     store_int_attribute_to_hid(group_id, std::string("size1"), size1_);
     store_int_attribute_to_hid(group_id, std::string("size2"), size2_);
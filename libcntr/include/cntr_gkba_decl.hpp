@@ -0,0 +1,99 @@
+#ifndef CNTR_GKBA_DECL_H
+#define CNTR_GKBA_DECL_H
+
+#include "cntr_global_settings.hpp"
+#include "cntr_function_decl.hpp"
+
+namespace cntr {
+
+template <typename T> class herm_matrix;
+
+template <typename T>
+/** \brief <b> Class `gkba` propagates the one-time density matrix in the generalized
+ * Kadanoff-Baym ansatz (GKBA) with Hartree-Fock propagators.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Instead of solving the Dyson equation for the two-time Green's function, the GKBA
+ *  reconstructs the lesser component from the time-diagonal density matrix
+ *  \f$\rho(t) = i\eta G^<(t,t)\f$,
+ *  \f[ G^<(t,t') = i\left[G^\mathrm{R}(t,t')G^<(t',t') - G^<(t,t)G^\mathrm{A}(t,t')\right], \f]
+ *  where \f$G^\mathrm{R}(t,t') = -i e^{i\mu(t-t')} U(t)U^\dagger(t')\f$ is the propagator of the
+ *  (mean-field) Hamiltonian \f$H(t)\f$, and \f$U(t)\f$ is obtained by commutator-free
+ *  exponentials as in `green_from_H`. The density matrix obeys
+ *  \f[ \frac{d}{dt}\rho(t) = -i[H(t),\rho(t)] + \eta\left[C(t)+C^\dagger(t)\right],\quad
+ *      C(t) = [\Sigma * G]^<(t,t), \f]
+ *  which is integrated in the interaction picture of \f$U(t)\f$, so that the mean-field part
+ *  is treated exactly and the collision integral is integrated with the Gregory weights of the
+ *  `Integrator`. The left-mixing component is propagated as
+ *  \f$G^\rceil(t,\tau) = i G^\mathrm{R}(t,0) G^\rceil(0,\tau)\f$, so that correlated initial states
+ *  from `dyson_mat` enter through the mixing part of \f$C(t)\f$.
+ *
+ *  The self-energy is not computed here: like for `dyson_start` and `dyson_timestep`, the
+ *  caller updates \f$H(t)\f$ and \f$\Sigma\f$ (second Born, GW, ...) from the current time step of
+ *  \f$G\f$ and iterates. One time step costs \f$O(t)\f$ operations instead of \f$O(t^2)\f$
+ *  for `dyson_timestep`.
+ *
+ */
+class gkba {
+  public:
+    typedef std::complex<T> cplx;
+    typedef T scalar_type;
+
+    /* construction, destruction */
+    gkba();
+    gkba(int nt, int size1, int SolveOrder = MAX_SOLVE_ORDER, int cf_order = 4);
+    /* access size etc ... */
+    int nt(void) const { return nt_; }
+    int size1(void) const { return size1_; }
+    int order(void) const { return k_; }
+    int cf_order(void) const { return cf_order_; }
+    /** \brief <b> Propagator \f$U(t)\f$ of the Hamiltonian.</b> */
+    function<T> &propagator(void) { return U_; }
+
+    void start(herm_matrix<T> &G, function<T> &rho, T mu, function<T> &H,
+               herm_matrix<T> &Sigma, T beta, T h);
+    void timestep(int tstp, herm_matrix<T> &G, function<T> &rho, T mu, function<T> &H,
+                  herm_matrix<T> &Sigma, T beta, T h);
+
+  private:
+    /// @private
+    void set_propagator(int tstp, function<T> &H, T h);
+    /// @private
+    void set_ret(int tstp, herm_matrix<T> &G, T mu, T h);
+    /// @private
+    void set_collision(int tstp, herm_matrix<T> &G, herm_matrix<T> &Sigma, T beta, T h);
+    /// @private
+    void set_density(int tstp, function<T> &rho, T h);
+    /// @private
+    void set_les(int tstp, herm_matrix<T> &G, function<T> &rho);
+
+    /// @private
+    /** \brief <b> Propagator \f$U(t)\f$ of the Hamiltonian.</b> */
+    function<T> U_;
+    /// @private
+    /** \brief <b> Collision term \f$\eta U^\dagger(t)[C(t)+C^\dagger(t)]U(t)\f$ in the interaction picture.</b> */
+    function<T> coll_;
+    /// @private
+    /** \brief <b> Density matrix \f$\rho(0)\f$.</b> */
+    cdmatrix rho0_;
+    /// @private
+    /** \brief <b> Maximum number of the time steps.</b> */
+    int nt_;
+    /// @private
+    /** \brief <b> Matrix rank of the contour functions.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Integration order.</b> */
+    int k_;
+    /// @private
+    /** \brief <b> Order of the commutator-free exponentials (2 or 4).</b> */
+    int cf_order_;
+};
+
+}  // namespace cntr
+
+#endif  // CNTR_GKBA_DECL_H
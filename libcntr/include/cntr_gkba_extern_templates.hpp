@@ -0,0 +1,12 @@
+#ifndef CNTR_GKBA_EXTERN_TEMPLATES_H
+#define CNTR_GKBA_EXTERN_TEMPLATES_H
+
+#include "cntr_gkba_decl.hpp"
+
+namespace cntr {
+
+extern template class gkba<double>;
+
+}  // namespace cntr
+
+#endif  // CNTR_GKBA_EXTERN_TEMPLATES_H
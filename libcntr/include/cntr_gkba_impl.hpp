@@ -0,0 +1,260 @@
+#ifndef CNTR_GKBA_IMPL_H
+#define CNTR_GKBA_IMPL_H
+
+#include "cntr_gkba_decl.hpp"
+#include "integration.hpp"
+#include "cntr_function_impl.hpp"
+#include "cntr_herm_matrix_decl.hpp"
+#include "cntr_convolution_decl.hpp"
+#include "cntr_utilities_decl.hpp"
+#include "cntr_equilibrium_impl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   CONSTRUCTION
+#
+########################################################################################*/
+template <typename T>
+gkba<T>::gkba() {
+    nt_ = -2;
+    size1_ = 0;
+    k_ = 0;
+    cf_order_ = 4;
+}
+
+/** \brief <b> Initializes the `gkba` class for a given number of time steps and matrix size. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Allocates the propagator and the collision term for `nt+1` time steps.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param nt
+* > Number of time steps
+* @param size1
+* > Matrix rank of the contour functions
+* @param SolveOrder
+* > [int] integrator order (Gregory weights of the collision integral)
+* @param cf_order
+* > [int] order of the commutator-free exponentials for the propagator, 2 or 4
+*/
+template <typename T>
+gkba<T>::gkba(int nt, int size1, int SolveOrder, int cf_order) {
+    assert(nt >= SolveOrder && size1 > 0);
+    assert(SolveOrder >= 1 && SolveOrder <= MAX_SOLVE_ORDER);
+    assert(cf_order == 2 || cf_order == 4);
+    nt_ = nt;
+    size1_ = size1;
+    k_ = SolveOrder;
+    cf_order_ = cf_order;
+    U_ = function<T>(nt, size1);
+    coll_ = function<T>(nt, size1);
+    rho0_ = cdmatrix::Zero(size1, size1);
+}
+
+/* #######################################################################################
+#
+#   INTERNAL STEPS
+#
+########################################################################################*/
+/// @private
+/** \brief <b> Propagator \f$U(t_n)\f$ of the Hamiltonian \f$H\f$, which is known up to \f$t_{\max(n,k)}\f$. </b> */
+template <typename T>
+void gkba<T>::set_propagator(int tstp, function<T> &H, T h) {
+    propagator_exp(tstp, U_, H, h, cf_order_, k_, true);
+}
+
+/// @private
+/** \brief <b> Sets \f$G^\mathrm{R}(t_n,t_j)=-i e^{i\mu(t_n-t_j)}U(t_n)U^\dagger(t_j)\f$ and
+ * \f$G^\rceil(t_n,\tau) = i G^\mathrm{R}(t_n,0) G^\rceil(0,\tau)\f$. </b> */
+template <typename T>
+void gkba<T>::set_ret(int tstp, herm_matrix<T> &G, T mu, T h) {
+    int j, m, ntau = G.ntau();
+    cplx phase;
+    cdmatrix un(size1_, size1_), uj(size1_, size1_), gr(size1_, size1_);
+    cdmatrix gtv(size1_, size1_), gtv0(size1_, size1_);
+
+    U_.get_value(tstp, un);
+    for (j = 0; j <= tstp; j++) {
+        U_.get_value(j, uj);
+        phase = cplx(cos(mu * h * (tstp - j)), sin(mu * h * (tstp - j)));
+        gr = cplx(0.0, -1.0) * phase * un * uj.adjoint();
+        G.set_ret(tstp, j, gr);
+    }
+    if (tstp > 0) {
+        phase = cplx(cos(mu * h * tstp), sin(mu * h * tstp));
+        for (m = 0; m <= ntau; m++) {
+            G.get_tv(0, m, gtv0);
+            gtv = phase * un * gtv0;
+            G.set_tv(tstp, m, gtv);
+        }
+    }
+}
+
+/// @private
+/** \brief <b> Collision term \f$\eta U^\dagger(t_n)[C(t_n)+C^\dagger(t_n)]U(t_n)\f$ with
+ * \f$C = [\Sigma * G]^<(t_n,t_n)\f$. </b> */
+template <typename T>
+void gkba<T>::set_collision(int tstp, herm_matrix<T> &G, herm_matrix<T> &Sigma, T beta, T h) {
+    cdmatrix cles(size1_, size1_), un(size1_, size1_), d(size1_, size1_);
+
+    convolution_les_timediag<T, herm_matrix<T> >(tstp, cles, Sigma, G, integration::I<T>(k_),
+                                                  beta, h);
+    U_.get_value(tstp, un);
+    d = (1.0 * G.sig()) * un.adjoint() * (cles + cles.adjoint()) * un;
+    coll_.set_value(tstp, d);
+}
+
+/// @private
+/** \brief <b> \f$\rho(t_n) = U(t_n)\left[\rho(0) + \int_0^{t_n} dt\, D(t)\right]U^\dagger(t_n)\f$,
+ * with the Gregory weights for the collision term \f$D\f$. </b> */
+template <typename T>
+void gkba<T>::set_density(int tstp, function<T> &rho, T h) {
+    int j, n1 = (tstp > k_ ? tstp : k_);
+    integration::Integrator<T> &I = integration::I<T>(k_);
+    cdmatrix rhot(size1_, size1_), un(size1_, size1_), d(size1_, size1_);
+
+    rhot = rho0_;
+    if (tstp > 0) {
+        for (j = 0; j <= n1; j++) {
+            coll_.get_value(j, d);
+            rhot += (h * I.gregory_weights(tstp, j)) * d;
+        }
+    }
+    U_.get_value(tstp, un);
+    rhot = un * rhot * un.adjoint();
+    rho.set_value(tstp, rhot);
+}
+
+/// @private
+/** \brief <b> Reconstructs \f$G^<(t_j,t_n) = -\eta\rho(t_j)[G^\mathrm{R}(t_n,t_j)]^\dagger\f$, \f$j \le n\f$. </b> */
+template <typename T>
+void gkba<T>::set_les(int tstp, herm_matrix<T> &G, function<T> &rho) {
+    int j;
+    cdmatrix rhoj(size1_, size1_), gr(size1_, size1_), gles(size1_, size1_);
+
+    for (j = 0; j <= tstp; j++) {
+        rho.get_value(j, rhoj);
+        G.get_ret(tstp, j, gr);
+        gles = (-1.0 * G.sig()) * rhoj * gr.adjoint();
+        G.set_les(j, tstp, gles);
+    }
+}
+
+/* #######################################################################################
+#
+#   TIME STEPPING
+#
+########################################################################################*/
+/** \brief <b> GKBA for the first `k` time steps. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$\rho(t_n)\f$ and the time steps \f$n=0,\dots,k\f$ of \f$G\f$ in the GKBA, for given
+* > \f$H(t_n)\f$ and \f$\Sigma\f$ at \f$n=0,\dots,k\f$ (see class `gkba`). The time step \f$n=0\f$ of
+* > \f$G\f$ is set from its Matsubara component, and \f$\rho(0)\f$ is its density matrix.
+* > Like `dyson_start`, this is iterated together with the update of \f$H\f$ and \f$\Sigma\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param G
+* > [herm_matrix] Green's function; on input, the Matsubara component and the time steps
+* > \f$n=0,\dots,k\f$ of the previous iteration, on return the new time steps
+* @param rho
+* > [function] on return, the density matrix \f$\rho(t_n)\f$, \f$n=0,\dots,k\f$
+* @param mu
+* > [T] chemical potential
+* @param H
+* > [function] (mean-field) Hamiltonian
+* @param Sigma
+* > [herm_matrix] self-energy
+* @param beta
+* > [T] inverse temperature
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void gkba<T>::start(herm_matrix<T> &G, function<T> &rho, T mu, function<T> &H,
+                    herm_matrix<T> &Sigma, T beta, T h) {
+    int n;
+    assert(G.size1() == size1_ && Sigma.size1() == size1_);
+    assert(H.size1_ == size1_ && rho.size1_ == size1_);
+    assert(G.nt() >= k_ && Sigma.nt() >= k_ && H.nt_ >= k_ && rho.nt_ >= k_);
+    assert(G.ntau() == Sigma.ntau());
+
+    set_t0_from_mat(G);
+    G.density_matrix(0, rho0_);
+    for (n = 0; n <= k_; n++) {
+        set_propagator(n, H, h);
+        set_ret(n, G, mu, h);
+    }
+    for (n = 0; n <= k_; n++)
+        set_collision(n, G, Sigma, beta, h);
+    for (n = 0; n <= k_; n++)
+        set_density(n, rho, h);
+    for (n = 0; n <= k_; n++)
+        set_les(n, G, rho);
+}
+
+/** \brief <b> GKBA for one time step. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$\rho(t_n)\f$ and the time step \f$n>k\f$ of \f$G\f$ in the GKBA (see class `gkba`),
+* > for given \f$H(t_n)\f$ and time step \f$n\f$ of \f$\Sigma\f$. The collision integral uses time
+* > step \f$n\f$ of \f$G\f$ from the previous iteration (or extrapolation), so this is iterated
+* > together with the update of \f$H\f$ and \f$\Sigma\f$, like `dyson_timestep`.
+* > The cost is \f$O(n)\f$ matrix products.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param tstp
+* > [int] time step \f$n\f$
+* @param G
+* > [herm_matrix] Green's function; on return, time step \f$n\f$ in the GKBA
+* @param rho
+* > [function] density matrix, given for \f$t < t_n\f$; on return, \f$\rho(t_n)\f$
+* @param mu
+* > [T] chemical potential
+* @param H
+* > [function] (mean-field) Hamiltonian, given up to \f$t_n\f$
+* @param Sigma
+* > [herm_matrix] self-energy, given up to time step \f$n\f$
+* @param beta
+* > [T] inverse temperature
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void gkba<T>::timestep(int tstp, herm_matrix<T> &G, function<T> &rho, T mu, function<T> &H,
+                       herm_matrix<T> &Sigma, T beta, T h) {
+    assert(tstp > k_ && tstp <= nt_);
+    assert(G.size1() == size1_ && Sigma.size1() == size1_);
+    assert(H.size1_ == size1_ && rho.size1_ == size1_);
+    assert(G.nt() >= tstp && Sigma.nt() >= tstp && H.nt_ >= tstp && rho.nt_ >= tstp);
+
+    set_propagator(tstp, H, h);
+    set_ret(tstp, G, mu, h);
+    set_collision(tstp, G, Sigma, beta, h);
+    set_density(tstp, rho, h);
+    set_les(tstp, G, rho);
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_GKBA_IMPL_H
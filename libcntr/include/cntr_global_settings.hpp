@@ -33,6 +33,44 @@
 #define CNTR_MAT_CG 1
 #define CNTR_MAT_FIXPOINT 2
 
+#define CNTR_STORAGE_HEAP 0
+#define CNTR_STORAGE_MMAP 1
+#define CNTR_STORAGE_NUMA 2
+#define CNTR_STORAGE_NUMA_HUGEPAGES 3
+
+// alignment of CNTR_STORAGE_NUMA arrays, and of CNTR_STORAGE_NUMA_HUGEPAGES arrays
+#define CNTR_STORAGE_ALIGNMENT 64
+#define CNTR_HUGEPAGE_SIZE 2097152
+
+// time step argument of CNTR_PROFILE_SCOPE for kernels which do not work on one time step
+#define CNTR_PROFILE_NO_TSTP -2
+
+// element sizes 1 ... CNTR_MAX_FIXED_SIZE (at most 8) are compiled with a fixed size,
+// see CNTR_SIZE1_DISPATCH in cntr_elements.hpp
+#ifndef CNTR_MAX_FIXED_SIZE
+#define CNTR_MAX_FIXED_SIZE 8
+#endif
+
+#define CNTR_HODLR_LEAF_SIZE 32
+#define CNTR_HODLR_TOL 1.0e-10
+
+#define CNTR_DLR_EPS 1.0e-10
+
+// convolution_matsubara uses FFT for ntau >= CNTR_MATSUBARA_FFT_NTAU (0: never)
+#ifndef CNTR_MATSUBARA_FFT_NTAU
+#define CNTR_MATSUBARA_FFT_NTAU 512
+#endif
+
+// convolution_timestep uses matrix-matrix products for size1 >= CNTR_CONVOLUTION_GEMM_SIZE
+// (0: never). Without MKL, Eigen's blockwise products are as fast (see convolution_benchmark)
+#ifndef CNTR_CONVOLUTION_GEMM_SIZE
+#ifdef EIGEN_USE_MKL_ALL
+#define CNTR_CONVOLUTION_GEMM_SIZE 8
+#else
+#define CNTR_CONVOLUTION_GEMM_SIZE 0
+#endif
+#endif
+
 #define GREEN cntr::herm_matrix<double>
 #define GREEN_TSTP cntr::herm_matrix_timestep<double>
 #define CFUNC cntr::function<double>
@@ -0,0 +1,132 @@
+#ifndef CNTR_HERM_MATRIX_BLOCKS_DECL_H
+#define CNTR_HERM_MATRIX_BLOCKS_DECL_H
+
+#include "cntr_global_settings.hpp"
+
+namespace cntr {
+
+template <typename T> class function;
+template <typename T> class herm_matrix;
+
+template <typename T>
+/** \brief <b> Class `herm_matrix_blocks` stores a block-diagonal contour function.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  If the orbitals decouple by spin, symmetry or Nambu sector, the matrix-valued contour
+ *  function \f$ C(t,t') \f$ is block-diagonal. `herm_matrix_blocks` stores only the dense
+ *  diagonal blocks \f$ C_b(t,t') \f$, each as a `herm_matrix` of size `block_size(b)`. Block
+ *  \f$b\f$ covers the orbitals `block_offset(b)`,...,`block_offset(b)+block_size(b)-1` of the
+ *  full matrix of size `size1()`.
+ *
+ *  Memory and the operations of the blockwise `convolution_timestep`, `dyson_timestep` and
+ *  `Bubble1`, `Bubble2` scale with \f$\sum_b\f$ `block_size(b)`\f$^2\f$ instead of `size1()`\f$^2\f$.
+ *  The blocks can be accessed directly by `block(b)`, or copied from and to a dense
+ *  `herm_matrix` by `set_from_herm_matrix` and `get_herm_matrix`.
+ *
+ */
+class herm_matrix_blocks {
+  public:
+    typedef std::complex<T> cplx;
+    typedef T scalar_type;
+
+    /* construction, destruction */
+    herm_matrix_blocks();
+    herm_matrix_blocks(int nt, int ntau, std::vector<int> &block_size, int sig = -1);
+    void clear(void);
+    /* access size etc ... */
+    int size1(void) const { return size1_; }
+    int size2(void) const { return size1_; }
+    int nt(void) const { return nt_; }
+    int ntau(void) const { return ntau_; }
+    int sig(void) const { return sig_; }
+    int nblock(void) const { return (int)blocks_.size(); }
+    int block_size(int b) const { return blocks_[b].size1(); }
+    int block_offset(int b) const { return block_offset_[b]; }
+    int block_index(int i) const { return block_index_[i]; }
+    herm_matrix<T> &block(int b) { return blocks_[b]; }
+    bool same_blocks(const herm_matrix_blocks &g) const;
+    /* timesteps */
+    void set_timestep_zero(int tstp);
+    void set_timestep(int tstp, herm_matrix_blocks &g1);
+    void incr_timestep(int tstp, herm_matrix_blocks &g1, T alpha = 1.0);
+    void smul(int tstp, T weight);
+    template <class Matrix> void density_matrix(int tstp, Matrix &M);
+    /* copy from and to full contour functions */
+    void set_matrixelement(int tstp, int i1, int i2, herm_matrix<T> &g, int j1, int j2);
+    void set_from_herm_matrix(int tstp, herm_matrix<T> &g);
+    void get_herm_matrix(int tstp, herm_matrix<T> &g);
+    void get_block_function(int b, function<T> &f, function<T> &fb);
+
+  private:
+    /// @private
+    /** \brief <b> Dense diagonal blocks.</b> */
+    std::vector<herm_matrix<T> > blocks_;
+    /// @private
+    /** \brief <b> First orbital of each block.</b> */
+    std::vector<int> block_offset_;
+    /// @private
+    /** \brief <b> Block of each orbital.</b> */
+    std::vector<int> block_index_;
+    /// @private
+    /** \brief <b> Number of the time steps.</b> */
+    int nt_;
+    /// @private
+    /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
+    int ntau_;
+    /// @private
+    /** \brief <b> Size of the full matrix; sum of the block sizes.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Bose = +1, Fermi =-1. </b> */
+    int sig_;
+};
+
+/*###########################################################################################
+#
+#   BLOCKWISE SOLVERS
+#
+#   The blocks are independent, so the convolution, the Dyson equation and the bubbles are
+#   solved block by block. The Hamiltonian is given as a dense function and must be
+#   block-diagonal with the same blocks as G.
+#
+###########################################################################################*/
+
+template <typename T>
+void convolution_timestep(int n, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+    herm_matrix_blocks<T> &Acc, herm_matrix_blocks<T> &B, herm_matrix_blocks<T> &Bcc,
+    T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+template <typename T>
+void convolution_timestep(int n, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+    herm_matrix_blocks<T> &B, T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+
+template <typename T>
+void dyson_mat(herm_matrix_blocks<T> &G, T mu, function<T> &H, herm_matrix_blocks<T> &Sigma,
+    T beta, const int SolveOrder=MAX_SOLVE_ORDER, const int method=CNTR_MAT_FIXPOINT,
+    const bool force_hermitian=true);
+template <typename T>
+void dyson_start(herm_matrix_blocks<T> &G, T mu, function<T> &H, herm_matrix_blocks<T> &Sigma,
+    T beta, T h, const int SolveOrder=MAX_SOLVE_ORDER);
+template <typename T>
+void dyson_timestep(int n, herm_matrix_blocks<T> &G, T mu, function<T> &H,
+    herm_matrix_blocks<T> &Sigma, T beta, T h, const int SolveOrder=MAX_SOLVE_ORDER);
+
+template <typename T>
+void Bubble1(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+    herm_matrix_blocks<T> &Acc, herm_matrix_blocks<T> &B, herm_matrix_blocks<T> &Bcc);
+template <typename T>
+void Bubble1(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+    herm_matrix_blocks<T> &B);
+template <typename T>
+void Bubble2(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+    herm_matrix_blocks<T> &Acc, herm_matrix_blocks<T> &B, herm_matrix_blocks<T> &Bcc);
+template <typename T>
+void Bubble2(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+    herm_matrix_blocks<T> &B);
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_BLOCKS_DECL_H
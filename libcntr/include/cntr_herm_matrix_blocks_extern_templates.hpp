@@ -0,0 +1,39 @@
+#ifndef CNTR_HERM_MATRIX_BLOCKS_EXTERN_TEMPLATES_H
+#define CNTR_HERM_MATRIX_BLOCKS_EXTERN_TEMPLATES_H
+
+#include <Eigen/Core>
+#include "cntr_herm_matrix_blocks_decl.hpp"
+
+namespace cntr {
+
+extern template class herm_matrix_blocks<double>;
+extern template void herm_matrix_blocks<double>::density_matrix<Eigen::MatrixXcd>(int tstp, Eigen::MatrixXcd &M);
+
+extern template void convolution_timestep<double>(int n, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &Acc, herm_matrix_blocks<double> &B,
+  herm_matrix_blocks<double> &Bcc, double beta, double h, int SolveOrder);
+extern template void convolution_timestep<double>(int n, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &B, double beta, double h,
+  int SolveOrder);
+extern template void dyson_mat<double>(herm_matrix_blocks<double> &G, double mu, function<double> &H,
+  herm_matrix_blocks<double> &Sigma, double beta, const int SolveOrder, const int method,
+  const bool force_hermitian);
+extern template void dyson_start<double>(herm_matrix_blocks<double> &G, double mu, function<double> &H,
+  herm_matrix_blocks<double> &Sigma, double beta, double h, const int SolveOrder);
+extern template void dyson_timestep<double>(int n, herm_matrix_blocks<double> &G, double mu,
+  function<double> &H, herm_matrix_blocks<double> &Sigma, double beta, double h,
+  const int SolveOrder);
+extern template void Bubble1<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &Acc, herm_matrix_blocks<double> &B,
+  herm_matrix_blocks<double> &Bcc);
+extern template void Bubble1<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &B);
+extern template void Bubble2<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &Acc, herm_matrix_blocks<double> &B,
+  herm_matrix_blocks<double> &Bcc);
+extern template void Bubble2<double>(int tstp, herm_matrix_blocks<double> &C,
+  herm_matrix_blocks<double> &A, herm_matrix_blocks<double> &B);
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_BLOCKS_EXTERN_TEMPLATES_H
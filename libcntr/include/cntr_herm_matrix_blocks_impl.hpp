@@ -0,0 +1,522 @@
+#ifndef CNTR_HERM_MATRIX_BLOCKS_IMPL_H
+#define CNTR_HERM_MATRIX_BLOCKS_IMPL_H
+
+#include "cntr_herm_matrix_blocks_decl.hpp"
+#include "cntr_herm_matrix_impl.hpp"
+#include "cntr_function_impl.hpp"
+#include "cntr_convolution_impl.hpp"
+#include "cntr_dyson_impl.hpp"
+#include "cntr_bubble_impl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   CONSTRUCTION
+#
+########################################################################################*/
+template <typename T>
+herm_matrix_blocks<T>::herm_matrix_blocks() {
+    nt_ = -2;
+    ntau_ = 0;
+    size1_ = 0;
+    sig_ = -1;
+}
+
+/** \brief <b> Initializes the `herm_matrix_blocks` class. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Allocates one `herm_matrix` for each diagonal block, which is set to zero. The blocks
+ * > are placed along the diagonal of the full matrix in the given order.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nt
+ * > Number of the time steps.
+ * @param ntau
+ * > Number of the time grids on the Matsubara axis.
+ * @param block_size
+ * > Matrix ranks of the diagonal blocks.
+ * @param sig
+ * > Set `sig = -1` for fermions or `sig = +1` for bosons.
+ */
+template <typename T>
+herm_matrix_blocks<T>::herm_matrix_blocks(int nt, int ntau, std::vector<int> &block_size,
+                                          int sig) {
+    int b, i, nblock = block_size.size();
+    assert(nt >= -1 && ntau >= 0 && nblock > 0 && sig * sig == 1);
+    nt_ = nt;
+    ntau_ = ntau;
+    sig_ = sig;
+    size1_ = 0;
+    blocks_.resize(nblock);
+    block_offset_.resize(nblock);
+    for (b = 0; b < nblock; b++) {
+        assert(block_size[b] > 0);
+        blocks_[b].resize(nt, ntau, block_size[b]);
+        blocks_[b].set_sig(sig);
+        block_offset_[b] = size1_;
+        size1_ += block_size[b];
+    }
+    block_index_.resize(size1_);
+    for (b = 0; b < nblock; b++)
+        for (i = 0; i < block_size[b]; i++)
+            block_index_[block_offset_[b] + i] = b;
+    clear();
+}
+
+/** \brief <b> Sets all components of all blocks to zero. </b> */
+template <typename T>
+void herm_matrix_blocks<T>::clear(void) {
+    for (int b = 0; b < nblock(); b++)
+        blocks_[b].clear();
+}
+
+/** \brief <b> Returns true if `g` has the same time grids and blocks. </b> */
+template <typename T>
+bool herm_matrix_blocks<T>::same_blocks(const herm_matrix_blocks &g) const {
+    if (g.nt_ != nt_ || g.ntau_ != ntau_ || g.blocks_.size() != blocks_.size())
+        return false;
+    for (int b = 0; b < nblock(); b++)
+        if (g.block_size(b) != block_size(b))
+            return false;
+    return true;
+}
+
+/* #######################################################################################
+#
+#   TIMESTEPS
+#
+########################################################################################*/
+/** \brief <b> Sets all components of all blocks at time step `tstp` to zero. </b> */
+template <typename T>
+void herm_matrix_blocks<T>::set_timestep_zero(int tstp) {
+    for (int b = 0; b < nblock(); b++)
+        blocks_[b].set_timestep_zero(tstp);
+}
+
+/** \brief <b> Copies all blocks at time step `tstp` from `g1`. </b> */
+template <typename T>
+void herm_matrix_blocks<T>::set_timestep(int tstp, herm_matrix_blocks &g1) {
+    assert(same_blocks(g1));
+    for (int b = 0; b < nblock(); b++)
+        blocks_[b].set_timestep(tstp, g1.blocks_[b]);
+}
+
+/** \brief <b> Adds `alpha*g1` to all blocks at time step `tstp`. </b> */
+template <typename T>
+void herm_matrix_blocks<T>::incr_timestep(int tstp, herm_matrix_blocks &g1, T alpha) {
+    assert(same_blocks(g1));
+    for (int b = 0; b < nblock(); b++)
+        blocks_[b].incr_timestep(tstp, g1.blocks_[b], cplx(alpha, 0.0));
+}
+
+/** \brief <b> Multiplies all blocks at time step `tstp` by a real scalar. </b> */
+template <typename T>
+void herm_matrix_blocks<T>::smul(int tstp, T weight) {
+    for (int b = 0; b < nblock(); b++)
+        blocks_[b].smul(tstp, weight);
+}
+
+/** \brief <b> Returns the full (block-diagonal) density matrix at time step `tstp`. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_blocks<T>::density_matrix(int tstp, Matrix &M) {
+    int b, i, j, off;
+    cdmatrix Mb;
+    M.resize(size1_, size1_);
+    M.setZero();
+    for (b = 0; b < nblock(); b++) {
+        off = block_offset_[b];
+        Mb.resize(block_size(b), block_size(b));
+        blocks_[b].density_matrix(tstp, Mb);
+        for (i = 0; i < block_size(b); i++)
+            for (j = 0; j < block_size(b); j++)
+                M(off + i, off + j) = Mb(i, j);
+    }
+}
+
+/* #######################################################################################
+#
+#   CONVERSION FROM AND TO HERM_MATRIX
+#
+########################################################################################*/
+/** \brief <b> Sets the matrix element \f$(i_1,i_2)\f$ to the element \f$(j_1,j_2)\f$ of `g`
+ * at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > The indices \f$i_1,i_2\f$ refer to the full matrix and must belong to the same block.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param i1
+ * > Row index in the full matrix.
+ * @param i2
+ * > Column index in the full matrix.
+ * @param g
+ * > The `herm_matrix` from which the element is copied.
+ * @param j1
+ * > Row index of `g`.
+ * @param j2
+ * > Column index of `g`.
+ */
+template <typename T>
+void herm_matrix_blocks<T>::set_matrixelement(int tstp, int i1, int i2, herm_matrix<T> &g,
+                                              int j1, int j2) {
+    assert(0 <= i1 && i1 < size1_ && 0 <= i2 && i2 < size1_);
+    int b = block_index_[i1];
+    assert(block_index_[i2] == b);
+    blocks_[b].set_matrixelement(tstp, i1 - block_offset_[b], i2 - block_offset_[b], g, j1,
+                                 j2);
+}
+
+/** \brief <b> Copies the diagonal blocks of a dense `herm_matrix` at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Elements of `g` outside the diagonal blocks are ignored.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param g
+ * > The `herm_matrix` of size `size1()`.
+ */
+template <typename T>
+void herm_matrix_blocks<T>::set_from_herm_matrix(int tstp, herm_matrix<T> &g) {
+    int b, i, j, off;
+    assert(g.size1() == size1_ && g.sig() == sig_);
+    assert(tstp <= nt_ && tstp <= g.nt());
+    for (b = 0; b < nblock(); b++) {
+        off = block_offset_[b];
+        for (i = 0; i < block_size(b); i++)
+            for (j = 0; j < block_size(b); j++)
+                blocks_[b].set_matrixelement(tstp, i, j, g, off + i, off + j);
+    }
+}
+
+/** \brief <b> Writes the blocks into a dense `herm_matrix` at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Elements of `g` outside the diagonal blocks are set to zero.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param g
+ * > The `herm_matrix` of size `size1()`.
+ */
+template <typename T>
+void herm_matrix_blocks<T>::get_herm_matrix(int tstp, herm_matrix<T> &g) {
+    int b, i, j, off;
+    assert(g.size1() == size1_ && g.sig() == sig_);
+    assert(tstp <= nt_ && tstp <= g.nt());
+    g.set_timestep_zero(tstp);
+    for (b = 0; b < nblock(); b++) {
+        off = block_offset_[b];
+        for (i = 0; i < block_size(b); i++)
+            for (j = 0; j < block_size(b); j++)
+                g.set_matrixelement(tstp, off + i, off + j, blocks_[b], i, j);
+    }
+}
+
+/** \brief <b> Copies the diagonal block `b` of a dense `function` to `fb`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > `fb` is resized to the time steps of `f` and the size of block `b`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param b
+ * > Index of the block.
+ * @param f
+ * > The `function` of size `size1()`.
+ * @param fb
+ * > The `function` of size `block_size(b)`.
+ */
+template <typename T>
+void herm_matrix_blocks<T>::get_block_function(int b, function<T> &f, function<T> &fb) {
+    int tstp, i, j, off = block_offset_[b], bs = block_size(b);
+    assert(0 <= b && b < nblock());
+    assert(f.size1() == size1_ && f.size2() == size1_);
+    if (fb.nt() != f.nt() || fb.size1() != bs)
+        fb.resize(f.nt(), bs);
+    for (tstp = -1; tstp <= f.nt(); tstp++) {
+        cplx *x = f.ptr(tstp), *xb = fb.ptr(tstp);
+        for (i = 0; i < bs; i++)
+            for (j = 0; j < bs; j++)
+                xb[i * bs + j] = x[(off + i) * size1_ + off + j];
+    }
+}
+
+/* #######################################################################################
+#
+#   BLOCKWISE SOLVERS
+#
+########################################################################################*/
+/** \brief <b> Blockwise convolution \f$C=A*B\f$ at time step `n`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$C_b = A_b*B_b\f$ for every block by `convolution_timestep`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > Time step.
+ * @param C
+ * > The result.
+ * @param A
+ * > The first factor.
+ * @param Acc
+ * > The hermitian conjugate of `A`.
+ * @param B
+ * > The second factor.
+ * @param Bcc
+ * > The hermitian conjugate of `B`.
+ * @param beta
+ * > Inverse temperature.
+ * @param h
+ * > Time step interval.
+ * @param SolveOrder
+ * > Order of the integration rule.
+ */
+template <typename T>
+void convolution_timestep(int n, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+                          herm_matrix_blocks<T> &Acc, herm_matrix_blocks<T> &B,
+                          herm_matrix_blocks<T> &Bcc, T beta, T h, int SolveOrder) {
+    assert(C.same_blocks(A) && C.same_blocks(Acc) && C.same_blocks(B) && C.same_blocks(Bcc));
+    for (int b = 0; b < C.nblock(); b++)
+        convolution_timestep(n, C.block(b), A.block(b), Acc.block(b), B.block(b), Bcc.block(b),
+                             beta, h, SolveOrder);
+}
+/** \brief <b> Blockwise convolution \f$C=A*B\f$ at time step `n` for hermitian `A`, `B`. </b> */
+template <typename T>
+void convolution_timestep(int n, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+                          herm_matrix_blocks<T> &B, T beta, T h, int SolveOrder) {
+    convolution_timestep(n, C, A, A, B, B, beta, h, SolveOrder);
+}
+
+/** \brief <b> Blockwise Matsubara Dyson equation. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Solves `dyson_mat` for every block, with the corresponding diagonal block of `H`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param G
+ * > The solution.
+ * @param mu
+ * > Chemical potential.
+ * @param H
+ * > Block-diagonal Hamiltonian of size `G.size1()`.
+ * @param Sigma
+ * > Self-energy.
+ * @param beta
+ * > Inverse temperature.
+ * @param SolveOrder
+ * > Order of the integration rule.
+ * @param method
+ * > Solution method, see `dyson_mat`.
+ * @param force_hermitian
+ * > Symmetrize the result.
+ */
+template <typename T>
+void dyson_mat(herm_matrix_blocks<T> &G, T mu, function<T> &H, herm_matrix_blocks<T> &Sigma,
+               T beta, const int SolveOrder, const int method, const bool force_hermitian) {
+    function<T> Hb;
+    assert(G.same_blocks(Sigma));
+    for (int b = 0; b < G.nblock(); b++) {
+        G.get_block_function(b, H, Hb);
+        dyson_mat(G.block(b), mu, Hb, Sigma.block(b), beta, SolveOrder, method,
+                  force_hermitian);
+    }
+}
+
+/** \brief <b> Blockwise Dyson equation for the time steps `n`\f$\le\f$`SolveOrder`. </b> */
+template <typename T>
+void dyson_start(herm_matrix_blocks<T> &G, T mu, function<T> &H, herm_matrix_blocks<T> &Sigma,
+                 T beta, T h, const int SolveOrder) {
+    function<T> Hb;
+    assert(G.same_blocks(Sigma));
+    for (int b = 0; b < G.nblock(); b++) {
+        G.get_block_function(b, H, Hb);
+        dyson_start(G.block(b), mu, Hb, Sigma.block(b), beta, h, SolveOrder);
+    }
+}
+
+/** \brief <b> Blockwise Dyson equation at time step `n`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > The blocks are solved as a batch by `dyson_timestep_batch`, i.e. in parallel with
+ * > OpenMP (CNTR_USE_OMP). Time step must be >SolveOrder.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > Time step.
+ * @param G
+ * > The solution.
+ * @param mu
+ * > Chemical potential.
+ * @param H
+ * > Block-diagonal Hamiltonian of size `G.size1()`.
+ * @param Sigma
+ * > Self-energy.
+ * @param beta
+ * > Inverse temperature.
+ * @param h
+ * > Time step interval.
+ * @param SolveOrder
+ * > Order of the integration rule.
+ */
+template <typename T>
+void dyson_timestep(int n, herm_matrix_blocks<T> &G, T mu, function<T> &H,
+                    herm_matrix_blocks<T> &Sigma, T beta, T h, const int SolveOrder) {
+    int b, nblock = G.nblock();
+    std::vector<function<T> > Hb(nblock);
+    std::vector<function<T> *> Hptr(nblock);
+    std::vector<herm_matrix<T> *> Gptr(nblock), Sptr(nblock);
+    assert(G.same_blocks(Sigma));
+    for (b = 0; b < nblock; b++) {
+        G.get_block_function(b, H, Hb[b]);
+        Hptr[b] = &Hb[b];
+        Gptr[b] = &G.block(b);
+        Sptr[b] = &Sigma.block(b);
+    }
+    dyson_timestep_batch(n, Gptr, mu, Hptr, Sptr, beta, h, SolveOrder);
+}
+
+/** \brief <b> Blockwise bubble \f$C_{ij}(t,t') = iA_{ij}(t,t')B_{ji}(t',t)\f$ at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Evaluates `Bubble1` for all elements \f$i,j\f$ within each block. The elements between
+ * > different blocks vanish for block-diagonal `A` and `B`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param C
+ * > The result.
+ * @param A
+ * > Two-time contour object.
+ * @param Acc
+ * > The hermitian conjugate of `A`.
+ * @param B
+ * > Two-time contour object.
+ * @param Bcc
+ * > The hermitian conjugate of `B`.
+ */
+template <typename T>
+void Bubble1(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+             herm_matrix_blocks<T> &Acc, herm_matrix_blocks<T> &B, herm_matrix_blocks<T> &Bcc) {
+    int b, i, j;
+    assert(C.same_blocks(A) && C.same_blocks(Acc) && C.same_blocks(B) && C.same_blocks(Bcc));
+    for (b = 0; b < C.nblock(); b++)
+        for (i = 0; i < C.block_size(b); i++)
+            for (j = 0; j < C.block_size(b); j++)
+                Bubble1(tstp, C.block(b), i, j, A.block(b), Acc.block(b), i, j, B.block(b),
+                        Bcc.block(b), i, j);
+}
+/** \brief <b> Blockwise bubble \f$C_{ij}(t,t') = iA_{ij}(t,t')B_{ji}(t',t)\f$ for hermitian `A`, `B`. </b> */
+template <typename T>
+void Bubble1(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+             herm_matrix_blocks<T> &B) {
+    Bubble1(tstp, C, A, A, B, B);
+}
+
+/** \brief <b> Blockwise bubble \f$C_{ij}(t,t') = iA_{ij}(t,t')B_{ij}(t,t')\f$ at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Evaluates `Bubble2` for all elements \f$i,j\f$ within each block. The elements between
+ * > different blocks vanish for block-diagonal `A` and `B`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param C
+ * > The result.
+ * @param A
+ * > Two-time contour object.
+ * @param Acc
+ * > The hermitian conjugate of `A`.
+ * @param B
+ * > Two-time contour object.
+ * @param Bcc
+ * > The hermitian conjugate of `B`.
+ */
+template <typename T>
+void Bubble2(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+             herm_matrix_blocks<T> &Acc, herm_matrix_blocks<T> &B, herm_matrix_blocks<T> &Bcc) {
+    int b, i, j;
+    assert(C.same_blocks(A) && C.same_blocks(Acc) && C.same_blocks(B) && C.same_blocks(Bcc));
+    for (b = 0; b < C.nblock(); b++)
+        for (i = 0; i < C.block_size(b); i++)
+            for (j = 0; j < C.block_size(b); j++)
+                Bubble2(tstp, C.block(b), i, j, A.block(b), Acc.block(b), i, j, B.block(b),
+                        Bcc.block(b), i, j);
+}
+/** \brief <b> Blockwise bubble \f$C_{ij}(t,t') = iA_{ij}(t,t')B_{ij}(t,t')\f$ for hermitian `A`, `B`. </b> */
+template <typename T>
+void Bubble2(int tstp, herm_matrix_blocks<T> &C, herm_matrix_blocks<T> &A,
+             herm_matrix_blocks<T> &B) {
+    Bubble2(tstp, C, A, A, B, B);
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_BLOCKS_IMPL_H
@@ -40,6 +40,14 @@ template <typename T>
  *
  *  If `nt = 0`, only the Matsubara component is stored.
  *
+ *  The lesser and retarded components can be kept in a memory-mapped file
+ *  instead of the heap, and the real-time components can be placed on the NUMA
+ *  nodes of the OpenMP threads, see `set_storage`.
+ *
+ *  The real-time components can be allocated for more time steps than `nt` by
+ *  `reserve`. The rows of the lesser, retarded and left-mixing components are stored
+ *  one after another, so that `resize_nt` then only appends rows.
+ *
  */
 class herm_matrix {
   public:
@@ -61,7 +69,11 @@ class herm_matrix {
     void resize_discard(int nt, int ntau, int size1);
     void resize_nt(int nt);
     void resize(int nt, int ntau, int size1);
+    void reserve(int nt_capacity);
     void clear(void);
+    /* storage of the real-time components */
+    void set_storage(int storage, const char *dir = NULL);
+    int storage(void) const { return storage_; }
     /* access size etc ... */
     /// @private
     int element_size(void) const { return element_size_; }
@@ -69,6 +81,7 @@ class herm_matrix {
     int size2(void) const { return size2_; }
     int ntau(void) const { return ntau_; }
     int nt(void) const { return nt_; }
+    int nt_capacity(void) const { return nt_capacity_; }
     int sig(void) const { return sig_; }
     void set_sig(int sig) { sig_ = sig; }
     /* conversion from other types */
@@ -194,6 +207,7 @@ class herm_matrix {
     void set_timestep_zero(int tstp);
     void set_timestep(int tstp, herm_matrix &g1);
     void set_timestep(int tstp, herm_matrix_timestep<T> &timestep);
+    template <typename S> void set_timestep(int tstp, herm_matrix<S> &g1);
     void get_timestep(int tstp, herm_matrix_timestep<T> &timestep) const;
     void get_timestep(int tstp, herm_matrix<T> &timestep) const;
     void incr_timestep(int tstp, herm_matrix_timestep<T> &timestep,
@@ -266,6 +280,11 @@ class herm_matrix {
     int ret_offset(int t, int t1) const;
     int tv_offset(int t, int tau) const;
     int mat_offset(int tau) const;
+    cplx *allocate_twotime(int nt);
+    void release_twotime(cplx *ptr, int nt, int storage);
+    cplx *allocate_tv(int nt);
+    void release_tv(cplx *ptr, int storage);
+    void reallocate_nt(int nt_capacity);
 
   private:
     /// @private
@@ -284,6 +303,9 @@ class herm_matrix {
     /** \brief <b> Maximum number of the time steps.</b> */
     int nt_;
     /// @private
+    /** \brief <b> Number of the time steps for which the real-time components are allocated; nt_capacity_ >= nt_.</b> */
+    int nt_capacity_;
+    /// @private
     /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
     int ntau_;
     /// @private
@@ -298,6 +320,12 @@ class herm_matrix {
     /// @private
     /** \brief <b> Bose = +1, Fermi =-1. </b> */
     int sig_; // Bose = +1, Fermi =-1
+    /// @private
+    /** \brief <b> CNTR_STORAGE_HEAP, CNTR_STORAGE_MMAP or CNTR_STORAGE_NUMA(_HUGEPAGES), see set_storage. </b> */
+    int storage_;
+    /// @private
+    /** \brief <b> Directory of the backing file for CNTR_STORAGE_MMAP. </b> */
+    std::string storage_dir_;
 };
 
 }  // namespace cntr
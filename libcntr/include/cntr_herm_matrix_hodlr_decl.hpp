@@ -0,0 +1,231 @@
+#ifndef CNTR_HERM_MATRIX_HODLR_DECL_H
+#define CNTR_HERM_MATRIX_HODLR_DECL_H
+
+#include "cntr_global_settings.hpp"
+
+namespace cntr {
+
+template <typename T> class herm_matrix;
+template <typename T> class herm_matrix_timestep;
+
+template <typename T>
+/** \brief <b> Class `hodlr_triangle` stores a lower-triangular two-time array of
+ * matrix-valued elements in hierarchical off-diagonal low-rank (HODLR) form.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The elements \f$ L(t,t') \f$, \f$ 0 \le t' \le t < n \f$, are partitioned by a
+ *  recursive bisection of the time axis. Blocks on the diagonal of length `<= nleaf`
+ *  are stored densely; each off-diagonal block `[mid,b) x [a,mid)` is stored, for every
+ *  pair of orbital indices, as a truncated singular value decomposition
+ *  \f$ U S V^\dagger \f$ keeping the singular values larger than `tol`.
+ *
+ *  Rows are appended one at a time with `add_row`. The factorizations are updated
+ *  incrementally, such that no off-diagonal block is ever stored densely.
+ *  The member functions `lmul`, `rmul`, `rmul_transpose` and `rmul_adjoint` compute
+ *  products with vectors of matrix-valued elements directly from the factorizations.
+ *
+ */
+class hodlr_triangle {
+  public:
+    typedef std::complex<T> cplx;
+    typedef Eigen::Matrix<cplx, Eigen::Dynamic, Eigen::Dynamic> cmatrix;
+    typedef Eigen::Matrix<T, Eigen::Dynamic, 1> rvector;
+
+    hodlr_triangle();
+    hodlr_triangle(int n, int size1, int nleaf, T tol);
+    void clear(void);
+    /// @private
+    int n(void) const { return n_; }
+    /// @private
+    int nrow(void) const { return nrow_; }
+    /// @private
+    int size1(void) const { return size1_; }
+    void add_row(const cplx *row);
+    void get(int t, int t1, cplx *x) const;
+    void get_row(int t, cplx *row) const;
+    void lmul(int tmax, cplx *a, cplx *y) const;
+    void rmul(int tmax, cplx *x, cplx *y) const;
+    void rmul_transpose(int tmax, cplx *x, cplx *y) const;
+    void rmul_adjoint(int tmax, cplx *x, cplx *y) const;
+    size_t memory_usage(void) const;
+    int max_rank(void) const;
+
+  private:
+    /// @private
+    /** \brief <b> Node of the bisection tree; `U`, `S`, `V` hold the off-diagonal block for each orbital pair.</b> */
+    struct node {
+        int a, mid, b, left, right, leaf_offset;
+        std::vector<cmatrix> U, V;
+        std::vector<rvector> S;
+    };
+    /// @private
+    int build(int a, int b);
+    /// @private
+    void append_row(node &nd, int p, const cmatrix &x);
+    /// @private
+    void lmul_node(int i, int tmax, cplx *a, cplx *y) const;
+    /// @private
+    void rmul_node(int i, int tmax, cplx *x, cplx *y) const;
+    /// @private
+    void rmul_transpose_node(int i, int tmax, cplx *x, cplx *y) const;
+    /// @private
+    void rmul_adjoint_node(int i, int tmax, cplx *x, cplx *y) const;
+    /// @private
+    cplx *leafptr(const node &nd, int t, int t1) const {
+        return const_cast<cplx *>(
+            &diag_[nd.leaf_offset + ((t - nd.a) * (t - nd.a + 1) / 2 + t1 - nd.a) * element_size_]);
+    }
+
+    /// @private
+    /** \brief <b> Nodes of the bisection tree, the root is `nodes_[0]`.</b> */
+    std::vector<node> nodes_;
+    /// @private
+    /** \brief <b> Dense storage of the diagonal leaf blocks.</b> */
+    std::vector<cplx> diag_;
+    /// @private
+    /** \brief <b> Number of rows (time steps).</b> */
+    int n_;
+    /// @private
+    /** \brief <b> Number of rows set so far.</b> */
+    int nrow_;
+    /// @private
+    /** \brief <b> Maximum length of the diagonal leaf blocks.</b> */
+    int nleaf_;
+    /// @private
+    /** \brief <b> Number of the colums in the Matrix form.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Size of the Matrix form; size1*size1. </b> */
+    int element_size_;
+    /// @private
+    /** \brief <b> Truncation threshold for the singular values. </b> */
+    T tol_;
+};
+
+template <typename T>
+/** \brief <b> Class `herm_matrix_hodlr` stores a two-time contour object \f$ C(t,t') \f$
+ * with hermitian symmetry, with the real-time components compressed in HODLR form.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Far from the time diagonal, two-time Green's functions are numerically of low rank.
+ *  `herm_matrix_hodlr` stores the same components as `herm_matrix`:
+ *   - retarded component \f$ C^\mathrm{R}(t_i,t_j) \f$ for \f$ i \ge j \f$,
+ *   - lesser component \f$ C^<(t_j,t_i) \f$ for \f$ j \le i \f$,
+ *   - left-mixing component \f$ C^\rceil(t_i,\tau_k) \f$,
+ *   - Matsubara component \f$ C^\mathrm{M}(\tau_k) \f$,
+ *
+ *  but keeps the retarded and lesser components as `hodlr_triangle`s with the singular
+ *  value threshold `tol`. For smooth functions the memory of the real-time components is
+ *  \f$ O(r\, n_t \log n_t) \f$ instead of \f$ O(n_t^2) \f$, where \f$ r \f$ is the rank.
+ *  The left-mixing and Matsubara components are stored densely.
+ *
+ *  Time steps are written in increasing order with `set_timestep`, typically from the
+ *  `herm_matrix_timestep` computed by `convolution_timestep` or a Dyson solver.
+ *  Once written, a time step cannot be modified.
+ *
+ */
+class herm_matrix_hodlr {
+  public:
+    typedef std::complex<T> cplx;
+    typedef T scalar_type;
+
+    /* construction, destruction */
+    herm_matrix_hodlr();
+    ~herm_matrix_hodlr();
+    herm_matrix_hodlr(int nt, int ntau, int size1 = 1, int sig = -1, T tol = CNTR_HODLR_TOL,
+                      int nleaf = CNTR_HODLR_LEAF_SIZE);
+    herm_matrix_hodlr(const herm_matrix_hodlr &g);
+    herm_matrix_hodlr &operator=(const herm_matrix_hodlr &g);
+    void clear(void);
+    /* access size etc ... */
+    /// @private
+    int element_size(void) const { return element_size_; }
+    int size1(void) const { return size1_; }
+    int size2(void) const { return size2_; }
+    int ntau(void) const { return ntau_; }
+    int nt(void) const { return nt_; }
+    int sig(void) const { return sig_; }
+    T tol(void) const { return tol_; }
+    /** \brief <b> Latest time step written (-1 if only Matsubara is set).</b> */
+    int tstpmax(void) const { return ret_.nrow() - 1; }
+    // raw pointer to elements ... to be used with care
+    /// @private
+    inline cplx *tvptr(int i, int j);
+    /// @private
+    inline cplx *matptr(int i);
+    /// @private
+    hodlr_triangle<T> &ret(void) { return ret_; }
+    /// @private
+    hodlr_triangle<T> &les(void) { return les_; }
+    // reading elements
+    /// @private
+    template <class Matrix>
+    void get_les(int i, int j, Matrix &M);
+    /// @private
+    template <class Matrix>
+    void get_ret(int i, int j, Matrix &M);
+    /// @private
+    template <class Matrix>
+    void get_tv(int i, int j, Matrix &M);
+    /// @private
+    template <class Matrix>
+    void get_mat(int i, Matrix &M);
+    cplx density_matrix(int tstp);
+    template <class Matrix>
+    void density_matrix(int tstp, Matrix &M);
+    /* copy timesteps from and to full contour functions */
+    void set_timestep(int tstp, herm_matrix<T> &g);
+    void set_timestep(int tstp, herm_matrix_timestep<T> &g);
+    void get_timestep(int tstp, herm_matrix<T> &g);
+    void get_timestep(int tstp, herm_matrix_timestep<T> &g);
+    /* compression */
+    size_t memory_usage(void) const;
+    int max_rank(void) const;
+
+  private:
+    /// @private
+    /** \brief <b> Compressed retarded component; row `i` holds \f$ C^\mathrm{R}(t_i,t_j) \f$, j=0...i.</b> */
+    hodlr_triangle<T> ret_;
+    /// @private
+    /** \brief <b> Compressed lesser component; row `i` holds \f$ C^<(t_j,t_i) \f$, j=0...i.</b> */
+    hodlr_triangle<T> les_;
+    /// @private
+    /** \brief <b> Pointer to the left-mixing component.</b> */
+    cplx *tv_;
+    /// @private
+    /** \brief <b> Pointer to the Matsubara component.</b> */
+    cplx *mat_;
+    /// @private
+    /** \brief <b> Maximum number of the time steps.</b> */
+    int nt_;
+    /// @private
+    /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
+    int ntau_;
+    /// @private
+    /** \brief <b> Number of the colums in the Matrix form.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Number of the rows in the Matrix form.</b> */
+    int size2_;
+    /// @private
+    /** \brief <b> Size of the Matrix form; size1*size2. </b> */
+    int element_size_;
+    /// @private
+    /** \brief <b> Bose = +1, Fermi =-1. </b> */
+    int sig_;
+    /// @private
+    /** \brief <b> Truncation threshold for the singular values. </b> */
+    T tol_;
+};
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_HODLR_DECL_H
@@ -0,0 +1,19 @@
+#ifndef CNTR_HERM_MATRIX_HODLR_EXTERN_TEMPLATES_H
+#define CNTR_HERM_MATRIX_HODLR_EXTERN_TEMPLATES_H
+
+#include "cntr_herm_matrix_hodlr_decl.hpp"
+
+namespace cntr {
+
+extern template class hodlr_triangle<double>;
+extern template class herm_matrix_hodlr<double>;
+
+extern template void herm_matrix_hodlr<double>::get_les<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+extern template void herm_matrix_hodlr<double>::get_ret<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+extern template void herm_matrix_hodlr<double>::get_tv<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+extern template void herm_matrix_hodlr<double>::get_mat<Eigen::MatrixXcd>(int i,Eigen::MatrixXcd &M);
+extern template void herm_matrix_hodlr<double>::density_matrix<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M);
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_HODLR_EXTERN_TEMPLATES_H
@@ -0,0 +1,1033 @@
+#ifndef CNTR_HERM_MATRIX_HODLR_IMPL_H
+#define CNTR_HERM_MATRIX_HODLR_IMPL_H
+
+#include "cntr_herm_matrix_hodlr_decl.hpp"
+#include "cntr_herm_matrix_impl.hpp"
+#include "cntr_herm_matrix_timestep_impl.hpp"
+#include "cntr_elements.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   HODLR_TRIANGLE: CONSTRUCTION
+#
+########################################################################################*/
+template <typename T>
+hodlr_triangle<T>::hodlr_triangle() {
+    n_ = 0;
+    nrow_ = 0;
+    nleaf_ = 1;
+    size1_ = 0;
+    element_size_ = 0;
+    tol_ = 0;
+}
+
+/** \brief <b> Initializes an empty `hodlr_triangle` with `n` rows. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Builds the bisection tree of the time axis [0,n) down to diagonal blocks of length
+ * > `<= nleaf`. No rows are set.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > Number of rows (time steps).
+ * @param size1
+ * > Matrix rank of the elements.
+ * @param nleaf
+ * > Maximum length of the dense diagonal blocks.
+ * @param tol
+ * > Singular values `<= tol` are discarded.
+ */
+template <typename T>
+hodlr_triangle<T>::hodlr_triangle(int n, int size1, int nleaf, T tol) {
+    assert(n >= 0 && size1 > 0 && nleaf > 0 && tol >= 0);
+    n_ = n;
+    nrow_ = 0;
+    nleaf_ = nleaf;
+    size1_ = size1;
+    element_size_ = size1 * size1;
+    tol_ = tol;
+    if (n_ > 0)
+        build(0, n_);
+}
+
+/// @private
+template <typename T>
+int hodlr_triangle<T>::build(int a, int b) {
+    int i = nodes_.size(), len = b - a, mid, p, child;
+    nodes_.push_back(node());
+    nodes_[i].a = a;
+    nodes_[i].b = b;
+    if (len <= nleaf_) {
+        nodes_[i].mid = b;
+        nodes_[i].left = -1;
+        nodes_[i].right = -1;
+        nodes_[i].leaf_offset = diag_.size();
+        diag_.resize(diag_.size() + len * (len + 1) / 2 * element_size_, cplx(0.0, 0.0));
+    } else {
+        mid = a + len / 2;
+        nodes_[i].mid = mid;
+        nodes_[i].leaf_offset = -1;
+        nodes_[i].U.resize(element_size_);
+        nodes_[i].V.resize(element_size_);
+        nodes_[i].S.resize(element_size_);
+        for (p = 0; p < element_size_; p++) {
+            nodes_[i].U[p].resize(0, 0);
+            nodes_[i].V[p].resize(mid - a, 0);
+            nodes_[i].S[p].resize(0);
+        }
+        // nodes_ may be reallocated by the recursion
+        child = build(a, mid);
+        nodes_[i].left = child;
+        child = build(mid, b);
+        nodes_[i].right = child;
+    }
+    return i;
+}
+
+/** \brief <b> Removes all rows of the `hodlr_triangle`. </b> */
+template <typename T>
+void hodlr_triangle<T>::clear(void) {
+    int i, p;
+    nrow_ = 0;
+    for (i = 0; i < (int)diag_.size(); i++)
+        diag_[i] = 0;
+    for (i = 0; i < (int)nodes_.size(); i++) {
+        if (nodes_[i].left < 0)
+            continue;
+        for (p = 0; p < element_size_; p++) {
+            nodes_[i].U[p].resize(0, 0);
+            nodes_[i].V[p].resize(nodes_[i].mid - nodes_[i].a, 0);
+            nodes_[i].S[p].resize(0);
+        }
+    }
+}
+
+/* #######################################################################################
+#
+#   HODLR_TRIANGLE: ADDING ROWS
+#
+#   The factorization U S V^dagger of an off-diagonal block is extended by one row x
+#   as in Brand's incremental SVD:  with x = p V^dagger + rho e,
+#
+#      [ U S V^dagger ]   [ U 0 ]  [ S   0   ]  [ V^dagger ]
+#      [      x       ] = [ 0 1 ]  [ p  rho  ]  [    e     ]
+#
+#   and the SVD of the small (r+1)x(r+1) core matrix.
+#
+########################################################################################*/
+/// @private
+template <typename T>
+void hodlr_triangle<T>::append_row(node &nd, int p, const cmatrix &x) {
+    cmatrix &U = nd.U[p], &V = nd.V[p];
+    rvector &S = nd.S[p];
+    int r = S.size(), nr = U.rows(), nc = V.rows(), l, rnew;
+    cmatrix proj, proj2, e, K, Uext, Vext;
+    T rho;
+
+    proj = x * V;
+    e = x - proj * V.adjoint();
+    // second Gram-Schmidt step, keeps V orthonormal
+    proj2 = e * V;
+    e -= proj2 * V.adjoint();
+    proj += proj2;
+    rho = e.norm();
+    K = cmatrix::Zero(r + 1, r + 1);
+    for (l = 0; l < r; l++) {
+        K(l, l) = S(l);
+        K(r, l) = proj(0, l);
+    }
+    K(r, r) = rho;
+    Eigen::JacobiSVD<cmatrix> svd(K, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const rvector &s = svd.singularValues();
+    rnew = 0;
+    while (rnew <= r && s(rnew) > tol_)
+        rnew++;
+    Uext = cmatrix::Zero(nr + 1, r + 1);
+    Uext.topLeftCorner(nr, r) = U;
+    Uext(nr, r) = 1.0;
+    Vext.resize(nc, r + 1);
+    Vext.leftCols(r) = V;
+    if (rho > 0)
+        Vext.col(r) = e.adjoint() / rho;
+    else
+        Vext.col(r).setZero();
+    U = Uext * svd.matrixU().leftCols(rnew);
+    V = Vext * svd.matrixV().leftCols(rnew);
+    S = s.head(rnew);
+}
+
+/** \brief <b> Appends the next row to the `hodlr_triangle`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Sets row `t = nrow()`, i.e., the elements \f$ L(t,t') \f$ for \f$ t'=0,\dots,t \f$.
+ * > The dense diagonal block is copied, the factorizations of all off-diagonal blocks
+ * > containing row `t` are updated.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param row
+ * > Pointer to the elements \f$ L(t,0),\dots,L(t,t) \f$, stored contiguously.
+ */
+template <typename T>
+void hodlr_triangle<T>::add_row(const cplx *row) {
+    int t = nrow_, i = 0, j, p;
+    cmatrix x;
+    assert(t < n_);
+    while (nodes_[i].left >= 0) {
+        node &nd = nodes_[i];
+        if (t >= nd.mid) {
+            x.resize(1, nd.mid - nd.a);
+            for (p = 0; p < element_size_; p++) {
+                for (j = nd.a; j < nd.mid; j++)
+                    x(0, j - nd.a) = row[j * element_size_ + p];
+                append_row(nd, p, x);
+            }
+            i = nd.right;
+        } else {
+            i = nd.left;
+        }
+    }
+    node &nd = nodes_[i];
+    memcpy(&diag_[nd.leaf_offset + (t - nd.a) * (t - nd.a + 1) / 2 * element_size_],
+           row + nd.a * element_size_, sizeof(cplx) * (t - nd.a + 1) * element_size_);
+    nrow_++;
+}
+
+/* #######################################################################################
+#
+#   HODLR_TRIANGLE: READING ELEMENTS
+#
+########################################################################################*/
+/** \brief <b> Reads the element \f$ L(t,t_1) \f$, \f$ t_1 \le t \f$. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Reconstructs a single element. The cost is \f$ O(r) \f$ per orbital pair for elements
+ * > in compressed blocks.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param t
+ * > Row index.
+ * @param t1
+ * > Column index.
+ * @param x
+ * > Pointer to the result (size1*size1 values).
+ */
+template <typename T>
+void hodlr_triangle<T>::get(int t, int t1, cplx *x) const {
+    int i = 0, p, l;
+    assert(0 <= t1 && t1 <= t && t < nrow_);
+    while (nodes_[i].left >= 0) {
+        const node &nd = nodes_[i];
+        if (t >= nd.mid && t1 < nd.mid) {
+            for (p = 0; p < element_size_; p++) {
+                x[p] = 0;
+                for (l = 0; l < nd.S[p].size(); l++)
+                    x[p] += nd.U[p](t - nd.mid, l) * nd.S[p](l) *
+                            std::conj(nd.V[p](t1 - nd.a, l));
+            }
+            return;
+        }
+        i = (t < nd.mid ? nd.left : nd.right);
+    }
+    memcpy(x, leafptr(nodes_[i], t, t1), sizeof(cplx) * element_size_);
+}
+
+/** \brief <b> Reads the row \f$ L(t,t') \f$, \f$ t'=0,\dots,t \f$. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Reconstructs row `t` into contiguous memory, in the same layout as passed to `add_row`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param t
+ * > Row index.
+ * @param row
+ * > Pointer to the result, size (t+1)*size1*size1.
+ */
+template <typename T>
+void hodlr_triangle<T>::get_row(int t, cplx *row) const {
+    int i = 0, j, p, l;
+    cmatrix z, y;
+    assert(0 <= t && t < nrow_);
+    while (nodes_[i].left >= 0) {
+        const node &nd = nodes_[i];
+        if (t >= nd.mid) {
+            for (p = 0; p < element_size_; p++) {
+                z = nd.U[p].row(t - nd.mid);
+                for (l = 0; l < nd.S[p].size(); l++)
+                    z(0, l) *= nd.S[p](l);
+                y = z * nd.V[p].adjoint();
+                for (j = nd.a; j < nd.mid; j++)
+                    row[j * element_size_ + p] = y(0, j - nd.a);
+            }
+            i = nd.right;
+        } else {
+            i = nd.left;
+        }
+    }
+    const node &nd = nodes_[i];
+    memcpy(row + nd.a * element_size_, leafptr(nd, t, nd.a),
+           sizeof(cplx) * (t - nd.a + 1) * element_size_);
+}
+
+/* #######################################################################################
+#
+#   HODLR_TRIANGLE: PRODUCTS WITH VECTORS OF MATRIX ELEMENTS
+#
+#   All vectors are indexed by time, x + t*size1*size1 is the element x(t).
+#   Only rows t <= tmax are taken into account.
+#
+########################################################################################*/
+/// @private
+template <typename T>
+void hodlr_triangle<T>::lmul_node(int i, int tmax, cplx *a, cplx *y) const {
+    const node &nd = nodes_[i];
+    int s = size1_, es = element_size_, m, j, c, b, ai, l, nm, nc, p;
+    cmatrix av, z, yv;
+    if (nd.left < 0) {
+        for (m = nd.a; m <= std::min(nd.b - 1, tmax); m++)
+            for (j = nd.a; j <= m; j++)
+                element_incr<T, LARGESIZE>(s, y + j * es, a + m * es, leafptr(nd, m, j));
+        return;
+    }
+    lmul_node(nd.left, tmax, a, y);
+    if (tmax < nd.mid)
+        return;
+    nm = std::min(nd.b - 1, tmax) - nd.mid + 1;
+    nc = nd.mid - nd.a;
+    av.resize(s, nm);
+    // y(j)_{ai,b} += sum_{m,c} a(m)_{ai,c} L_{c,b}(m,j)
+    for (c = 0; c < s; c++) {
+        for (m = 0; m < nm; m++)
+            for (ai = 0; ai < s; ai++)
+                av(ai, m) = a[(nd.mid + m) * es + ai * s + c];
+        for (b = 0; b < s; b++) {
+            p = c * s + b;
+            if (nd.S[p].size() == 0)
+                continue;
+            z = av * nd.U[p].topRows(nm);
+            for (l = 0; l < nd.S[p].size(); l++)
+                z.col(l) *= nd.S[p](l);
+            yv = z * nd.V[p].adjoint();
+            for (j = 0; j < nc; j++)
+                for (ai = 0; ai < s; ai++)
+                    y[(nd.a + j) * es + ai * s + b] += yv(ai, j);
+        }
+    }
+    lmul_node(nd.right, tmax, a, y);
+}
+
+/// @private
+template <typename T>
+void hodlr_triangle<T>::rmul_node(int i, int tmax, cplx *x, cplx *y) const {
+    const node &nd = nodes_[i];
+    int s = size1_, es = element_size_, m, t, c, b, ai, l, nm, nc, p;
+    cmatrix xv, z, yv;
+    if (nd.left < 0) {
+        for (t = nd.a; t <= std::min(nd.b - 1, tmax); t++)
+            for (m = nd.a; m <= t; m++)
+                element_incr<T, LARGESIZE>(s, y + t * es, leafptr(nd, t, m), x + m * es);
+        return;
+    }
+    rmul_node(nd.left, tmax, x, y);
+    if (tmax < nd.mid)
+        return;
+    nm = std::min(nd.b - 1, tmax) - nd.mid + 1;
+    nc = nd.mid - nd.a;
+    xv.resize(nc, s);
+    // y(t)_{ai,b} += sum_{m,c} L_{ai,c}(t,m) x(m)_{c,b}
+    for (c = 0; c < s; c++) {
+        for (m = 0; m < nc; m++)
+            for (b = 0; b < s; b++)
+                xv(m, b) = x[(nd.a + m) * es + c * s + b];
+        for (ai = 0; ai < s; ai++) {
+            p = ai * s + c;
+            if (nd.S[p].size() == 0)
+                continue;
+            z = nd.V[p].adjoint() * xv;
+            for (l = 0; l < nd.S[p].size(); l++)
+                z.row(l) *= nd.S[p](l);
+            yv = nd.U[p].topRows(nm) * z;
+            for (t = 0; t < nm; t++)
+                for (b = 0; b < s; b++)
+                    y[(nd.mid + t) * es + ai * s + b] += yv(t, b);
+        }
+    }
+    rmul_node(nd.right, tmax, x, y);
+}
+
+/// @private
+template <typename T>
+void hodlr_triangle<T>::rmul_transpose_node(int i, int tmax, cplx *x, cplx *y) const {
+    const node &nd = nodes_[i];
+    int s = size1_, es = element_size_, m, j, c, b, ai, l, nm, nc, p;
+    cmatrix xv, z, yv;
+    if (nd.left < 0) {
+        for (m = nd.a; m <= std::min(nd.b - 1, tmax); m++)
+            for (j = nd.a; j <= m; j++)
+                element_incr<T, LARGESIZE>(s, y + j * es, leafptr(nd, m, j), x + m * es);
+        return;
+    }
+    rmul_transpose_node(nd.left, tmax, x, y);
+    if (tmax < nd.mid)
+        return;
+    nm = std::min(nd.b - 1, tmax) - nd.mid + 1;
+    nc = nd.mid - nd.a;
+    xv.resize(nm, s);
+    // y(j)_{ai,b} += sum_{m,c} L_{ai,c}(m,j) x(m)_{c,b}
+    for (c = 0; c < s; c++) {
+        for (m = 0; m < nm; m++)
+            for (b = 0; b < s; b++)
+                xv(m, b) = x[(nd.mid + m) * es + c * s + b];
+        for (ai = 0; ai < s; ai++) {
+            p = ai * s + c;
+            if (nd.S[p].size() == 0)
+                continue;
+            z = nd.U[p].topRows(nm).transpose() * xv;
+            for (l = 0; l < nd.S[p].size(); l++)
+                z.row(l) *= nd.S[p](l);
+            yv = nd.V[p].conjugate() * z;
+            for (j = 0; j < nc; j++)
+                for (b = 0; b < s; b++)
+                    y[(nd.a + j) * es + ai * s + b] += yv(j, b);
+        }
+    }
+    rmul_transpose_node(nd.right, tmax, x, y);
+}
+
+/// @private
+template <typename T>
+void hodlr_triangle<T>::rmul_adjoint_node(int i, int tmax, cplx *x, cplx *y) const {
+    const node &nd = nodes_[i];
+    int s = size1_, es = element_size_, m, t, c, b, ai, l, nm, nc, p;
+    cmatrix xv, z, yv;
+    cplx *ltemp;
+    if (nd.left < 0) {
+        ltemp = new cplx[es];
+        for (t = nd.a; t <= std::min(nd.b - 1, tmax); t++) {
+            for (m = nd.a; m < t; m++) {
+                element_conj<T, LARGESIZE>(s, ltemp, leafptr(nd, t, m));
+                element_incr<T, LARGESIZE>(s, y + t * es, ltemp, x + m * es);
+            }
+        }
+        delete[] ltemp;
+        return;
+    }
+    rmul_adjoint_node(nd.left, tmax, x, y);
+    if (tmax < nd.mid)
+        return;
+    nm = std::min(nd.b - 1, tmax) - nd.mid + 1;
+    nc = nd.mid - nd.a;
+    xv.resize(nc, s);
+    // y(t)_{ai,b} += sum_{m,c} L_{c,ai}(t,m)^* x(m)_{c,b}
+    for (c = 0; c < s; c++) {
+        for (m = 0; m < nc; m++)
+            for (b = 0; b < s; b++)
+                xv(m, b) = x[(nd.a + m) * es + c * s + b];
+        for (ai = 0; ai < s; ai++) {
+            p = c * s + ai;
+            if (nd.S[p].size() == 0)
+                continue;
+            z = nd.V[p].transpose() * xv;
+            for (l = 0; l < nd.S[p].size(); l++)
+                z.row(l) *= nd.S[p](l);
+            yv = nd.U[p].topRows(nm).conjugate() * z;
+            for (t = 0; t < nm; t++)
+                for (b = 0; b < s; b++)
+                    y[(nd.mid + t) * es + ai * s + b] += yv(t, b);
+        }
+    }
+    rmul_adjoint_node(nd.right, tmax, x, y);
+}
+
+/** \brief <b> Product \f$ y(j) \mathrel{+}= \sum_{m=j}^{t_{max}} a(m) L(m,j) \f$. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Multiplies the vector `a` from the left, for \f$ j=0,\dots,t_{max} \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tmax
+ * > Last row taken into account.
+ * @param a
+ * > Vector a(m), m=0...tmax.
+ * @param y
+ * > Result, y(j) for j=0...tmax is incremented.
+ */
+template <typename T>
+void hodlr_triangle<T>::lmul(int tmax, cplx *a, cplx *y) const {
+    tmax = std::min(tmax, nrow_ - 1);
+    if (tmax >= 0)
+        lmul_node(0, tmax, a, y);
+}
+
+/** \brief <b> Product \f$ y(t) \mathrel{+}= \sum_{m=0}^{t} L(t,m) x(m) \f$. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Multiplies the vector `x` from the right, for \f$ t=0,\dots,t_{max} \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tmax
+ * > Last row taken into account.
+ * @param x
+ * > Vector x(m), m=0...tmax.
+ * @param y
+ * > Result, y(t) for t=0...tmax is incremented.
+ */
+template <typename T>
+void hodlr_triangle<T>::rmul(int tmax, cplx *x, cplx *y) const {
+    tmax = std::min(tmax, nrow_ - 1);
+    if (tmax >= 0)
+        rmul_node(0, tmax, x, y);
+}
+
+/** \brief <b> Product \f$ y(j) \mathrel{+}= \sum_{m=j}^{t_{max}} L(m,j) x(m) \f$. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Multiplies the vector `x` from the right with the time-transposed array (the orbital
+ * > indices are not transposed), for \f$ j=0,\dots,t_{max} \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tmax
+ * > Last row taken into account.
+ * @param x
+ * > Vector x(m), m=0...tmax.
+ * @param y
+ * > Result, y(j) for j=0...tmax is incremented.
+ */
+template <typename T>
+void hodlr_triangle<T>::rmul_transpose(int tmax, cplx *x, cplx *y) const {
+    tmax = std::min(tmax, nrow_ - 1);
+    if (tmax >= 0)
+        rmul_transpose_node(0, tmax, x, y);
+}
+
+/** \brief <b> Product \f$ y(t) \mathrel{+}= \sum_{m=0}^{t-1} L(t,m)^\dagger x(m) \f$. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Multiplies the vector `x` from the right with the hermitian conjugate elements
+ * > (time indices not transposed, diagonal excluded), for \f$ t=0,\dots,t_{max} \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tmax
+ * > Last row taken into account.
+ * @param x
+ * > Vector x(m), m=0...tmax.
+ * @param y
+ * > Result, y(t) for t=0...tmax is incremented.
+ */
+template <typename T>
+void hodlr_triangle<T>::rmul_adjoint(int tmax, cplx *x, cplx *y) const {
+    tmax = std::min(tmax, nrow_ - 1);
+    if (tmax >= 0)
+        rmul_adjoint_node(0, tmax, x, y);
+}
+
+/** \brief <b> Returns the memory (in bytes) used by the `hodlr_triangle`. </b> */
+template <typename T>
+size_t hodlr_triangle<T>::memory_usage(void) const {
+    size_t mem = diag_.size() * sizeof(cplx);
+    int i, p;
+    for (i = 0; i < (int)nodes_.size(); i++) {
+        if (nodes_[i].left < 0)
+            continue;
+        for (p = 0; p < element_size_; p++) {
+            mem += (nodes_[i].U[p].size() + nodes_[i].V[p].size()) * sizeof(cplx);
+            mem += nodes_[i].S[p].size() * sizeof(T);
+        }
+    }
+    return mem;
+}
+
+/** \brief <b> Returns the largest rank of the off-diagonal blocks. </b> */
+template <typename T>
+int hodlr_triangle<T>::max_rank(void) const {
+    int i, p, r = 0;
+    for (i = 0; i < (int)nodes_.size(); i++) {
+        if (nodes_[i].left < 0)
+            continue;
+        for (p = 0; p < element_size_; p++)
+            r = std::max(r, (int)nodes_[i].S[p].size());
+    }
+    return r;
+}
+
+/* #######################################################################################
+#
+#   HERM_MATRIX_HODLR: CONSTRUCTION/DESTRUCTION
+#
+########################################################################################*/
+template <typename T>
+herm_matrix_hodlr<T>::herm_matrix_hodlr() {
+    tv_ = 0;
+    mat_ = 0;
+    nt_ = -2;
+    ntau_ = 0;
+    size1_ = 0;
+    size2_ = 0;
+    element_size_ = 0;
+    sig_ = -1;
+    tol_ = 0;
+}
+template <typename T>
+herm_matrix_hodlr<T>::~herm_matrix_hodlr() {
+    delete[] tv_;
+    delete[] mat_;
+}
+
+/** \brief <b> Initializes the `herm_matrix_hodlr` class. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Sets up the (empty) compressed retarded and lesser components and allocates
+ * > the left-mixing and Matsubara components, which are set to zero.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nt
+ * > Number of time steps
+ * @param ntau
+ * > Number of points on Matsubara axis
+ * @param size1
+ * > Matrix rank of the contour function
+ * @param sig
+ * > Set `sig = -1` for fermions or `sig = +1` for bosons.
+ * @param tol
+ * > Singular values `<= tol` of the off-diagonal blocks are discarded.
+ * @param nleaf
+ * > Maximum length of the dense diagonal blocks.
+ */
+template <typename T>
+herm_matrix_hodlr<T>::herm_matrix_hodlr(int nt, int ntau, int size1, int sig, T tol,
+                                        int nleaf) {
+    assert(nt >= -1 && ntau >= 0 && size1 > 0 && sig * sig == 1 && nleaf > 0);
+    nt_ = nt;
+    ntau_ = ntau;
+    size1_ = size1;
+    size2_ = size1;
+    element_size_ = size1 * size1;
+    sig_ = sig;
+    tol_ = tol;
+    ret_ = hodlr_triangle<T>(nt_ + 1, size1_, nleaf, tol_);
+    les_ = hodlr_triangle<T>(nt_ + 1, size1_, nleaf, tol_);
+    tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+    mat_ = new cplx[(ntau_ + 1) * element_size_];
+    memset(tv_, 0, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
+    memset(mat_, 0, sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+template <typename T>
+herm_matrix_hodlr<T>::herm_matrix_hodlr(const herm_matrix_hodlr &g) {
+    nt_ = g.nt_;
+    ntau_ = g.ntau_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    tol_ = g.tol_;
+    ret_ = g.ret_;
+    les_ = g.les_;
+    if (size1_ > 0) {
+        tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+        mat_ = new cplx[(ntau_ + 1) * element_size_];
+        memcpy(tv_, g.tv_, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        tv_ = 0;
+        mat_ = 0;
+    }
+}
+template <typename T>
+herm_matrix_hodlr<T> &herm_matrix_hodlr<T>::operator=(const herm_matrix_hodlr &g) {
+    if (this == &g)
+        return *this;
+    delete[] tv_;
+    delete[] mat_;
+    nt_ = g.nt_;
+    ntau_ = g.ntau_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    tol_ = g.tol_;
+    ret_ = g.ret_;
+    les_ = g.les_;
+    if (size1_ > 0) {
+        tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+        mat_ = new cplx[(ntau_ + 1) * element_size_];
+        memcpy(tv_, g.tv_, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        tv_ = 0;
+        mat_ = 0;
+    }
+    return *this;
+}
+
+/** \brief <b> Removes all time steps and sets the Matsubara component to zero. </b> */
+template <typename T>
+void herm_matrix_hodlr<T>::clear(void) {
+    if (size1_ == 0)
+        return;
+    ret_.clear();
+    les_.clear();
+    memset(tv_, 0, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
+    memset(mat_, 0, sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/* #######################################################################################
+#
+#   RAW POINTERS TO ELEMENTS
+#
+########################################################################################*/
+/// @private
+template <typename T>
+inline std::complex<T> *herm_matrix_hodlr<T>::tvptr(int i, int j) {
+    assert(0 <= i && i <= nt_ && 0 <= j && j <= ntau_);
+    return tv_ + (i * (ntau_ + 1) + j) * element_size_;
+}
+/// @private
+template <typename T>
+inline std::complex<T> *herm_matrix_hodlr<T>::matptr(int i) {
+    assert(0 <= i && i <= ntau_);
+    return mat_ + i * element_size_;
+}
+
+/* #######################################################################################
+#
+#   READING ELEMENTS TO ANY MATRIX TYPE
+#
+########################################################################################*/
+/// @private
+template <typename T>
+template <class Matrix>
+void herm_matrix_hodlr<T>::get_les(int i, int j, Matrix &M) {
+    int r, s;
+    cplx *x = new cplx[element_size_];
+    M.resize(size1_, size2_);
+    if (i <= j) {
+        les_.get(j, i, x);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = x[r * size2_ + s];
+    } else {
+        les_.get(i, j, x);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = -std::conj(x[s * size2_ + r]);
+    }
+    delete[] x;
+}
+/// @private
+template <typename T>
+template <class Matrix>
+void herm_matrix_hodlr<T>::get_ret(int i, int j, Matrix &M) {
+    int r, s;
+    cplx *x = new cplx[element_size_];
+    M.resize(size1_, size2_);
+    if (i >= j) {
+        ret_.get(i, j, x);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = x[r * size2_ + s];
+    } else {
+        ret_.get(j, i, x);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = -std::conj(x[s * size2_ + r]);
+    }
+    delete[] x;
+}
+/// @private
+template <typename T>
+template <class Matrix>
+void herm_matrix_hodlr<T>::get_tv(int i, int j, Matrix &M) {
+    int r, s;
+    cplx *x = tvptr(i, j);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+/// @private
+template <typename T>
+template <class Matrix>
+void herm_matrix_hodlr<T>::get_mat(int i, Matrix &M) {
+    int r, s;
+    cplx *x = matptr(i);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+
+/** \brief <b> Returns the (0,0) element of the density matrix at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Returns \f$ -C^\mathrm{M}(\beta) \f$ for `tstp=-1`, otherwise
+ * > \f$ i \sigma C^<(t,t) \f$ with \f$ t \f$ = `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ */
+template <typename T>
+std::complex<T> herm_matrix_hodlr<T>::density_matrix(int tstp) {
+    cplx res;
+    cplx *x;
+    if (tstp == -1)
+        return -matptr(ntau_)[0];
+    x = new cplx[element_size_];
+    les_.get(tstp, tstp, x);
+    res = std::complex<T>(0.0, sig_) * x[0];
+    delete[] x;
+    return res;
+}
+
+/** \brief <b> Returns the density matrix at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Returns \f$ -C^\mathrm{M}(\beta) \f$ for `tstp=-1`, otherwise
+ * > \f$ i \sigma C^<(t,t) \f$ with \f$ t \f$ = `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param M
+ * > Matrix to which the density matrix is written.
+ */
+template <typename T>
+template <class Matrix>
+void herm_matrix_hodlr<T>::density_matrix(int tstp, Matrix &M) {
+    if (tstp == -1) {
+        get_mat(ntau_, M);
+        M *= (-1.0);
+    } else {
+        get_les(tstp, tstp, M);
+        M *= std::complex<T>(0.0, 1.0 * sig_);
+    }
+}
+
+/* #######################################################################################
+#
+#   COPYING TIMESTEPS
+#
+########################################################################################*/
+/** \brief <b> Appends time step `tstp` from a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp=-1` the Matsubara component is copied. Otherwise `tstp` must be the next
+ * > time step, `tstp = tstpmax()+1`; its retarded and lesser components are added
+ * > to the compressed storage.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > [herm_matrix] contour function from which the time step is copied
+ */
+template <typename T>
+void herm_matrix_hodlr<T>::set_timestep(int tstp, herm_matrix<T> &g) {
+    assert(tstp >= -1 && tstp <= g.nt() && tstp <= nt_);
+    assert(g.size1() == size1_ && g.ntau() == ntau_);
+    if (tstp == -1) {
+        memcpy(mat_, g.matptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    if (tstp != tstpmax() + 1) {
+        std::cerr << "herm_matrix_hodlr::set_timestep: time step " << tstp
+                  << " cannot follow " << tstpmax() << std::endl;
+        abort();
+    }
+    ret_.add_row(g.retptr(tstp, 0));
+    les_.add_row(g.lesptr(0, tstp));
+    memcpy(tvptr(tstp, 0), g.tvptr(tstp, 0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Appends time step `tstp` from a `herm_matrix_timestep`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp=-1` the Matsubara component is copied. Otherwise `tstp` must be the next
+ * > time step, `tstp = tstpmax()+1`; its retarded and lesser components are added
+ * > to the compressed storage.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > [herm_matrix_timestep] time step to be copied
+ */
+template <typename T>
+void herm_matrix_hodlr<T>::set_timestep(int tstp, herm_matrix_timestep<T> &g) {
+    assert(tstp == g.tstp() && tstp <= nt_);
+    assert(g.size1() == size1_ && g.ntau() == ntau_);
+    if (tstp == -1) {
+        memcpy(mat_, g.matptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    if (tstp != tstpmax() + 1) {
+        std::cerr << "herm_matrix_hodlr::set_timestep: time step " << tstp
+                  << " cannot follow " << tstpmax() << std::endl;
+        abort();
+    }
+    ret_.add_row(g.retptr(0));
+    les_.add_row(g.lesptr(0));
+    memcpy(tvptr(tstp, 0), g.tvptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Copies time step `tstp` to a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Decompresses time step `tstp <= tstpmax()` (or the Matsubara component for `tstp=-1`).
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > [herm_matrix] contour function to which the time step is copied
+ */
+template <typename T>
+void herm_matrix_hodlr<T>::get_timestep(int tstp, herm_matrix<T> &g) {
+    assert(tstp >= -1 && tstp <= g.nt() && tstp <= tstpmax());
+    assert(g.size1() == size1_ && g.ntau() == ntau_);
+    if (tstp == -1) {
+        memcpy(g.matptr(0), mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    ret_.get_row(tstp, g.retptr(tstp, 0));
+    les_.get_row(tstp, g.lesptr(0, tstp));
+    memcpy(g.tvptr(tstp, 0), tvptr(tstp, 0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Copies time step `tstp` to a `herm_matrix_timestep`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Decompresses time step `tstp <= tstpmax()` (or the Matsubara component for `tstp=-1`).
+ * > `g` is resized to time step `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > [herm_matrix_timestep] time step to which the data are copied
+ */
+template <typename T>
+void herm_matrix_hodlr<T>::get_timestep(int tstp, herm_matrix_timestep<T> &g) {
+    assert(tstp >= -1 && tstp <= tstpmax());
+    g.resize(tstp, ntau_, size1_);
+    if (tstp == -1) {
+        memcpy(g.matptr(0), mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    ret_.get_row(tstp, g.retptr(0));
+    les_.get_row(tstp, g.lesptr(0));
+    memcpy(g.tvptr(0), tvptr(tstp, 0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/* #######################################################################################
+#
+#   COMPRESSION
+#
+########################################################################################*/
+/** \brief <b> Returns the memory (in bytes) used by all components. </b> */
+template <typename T>
+size_t herm_matrix_hodlr<T>::memory_usage(void) const {
+    return ret_.memory_usage() + les_.memory_usage() +
+           ((nt_ + 2) * (ntau_ + 1) * element_size_) * sizeof(cplx);
+}
+
+/** \brief <b> Returns the largest rank of the off-diagonal blocks. </b> */
+template <typename T>
+int herm_matrix_hodlr<T>::max_rank(void) const {
+    return std::max(ret_.max_rank(), les_.max_rank());
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_HODLR_IMPL_H
@@ -7,6 +7,9 @@
 #include "cntr_function_decl.hpp"
 #include "cntr_herm_matrix_timestep_decl.hpp"
 #include "cntr_herm_matrix_timestep_view_impl.hpp"
+#include "cntr_mmap_storage.hpp"
+#include "cntr_numa_storage.hpp"
+#include "cntr_profile.hpp"
 
 namespace cntr {
 
@@ -23,16 +26,18 @@ herm_matrix<T>::herm_matrix() {
     mat_ = 0;
     ntau_ = 0;
     nt_ = 0;
+    nt_capacity_ = 0;
     size1_ = 0;
     size2_ = 0;
     element_size_ = 0;
     sig_ = -1;
+    storage_ = CNTR_STORAGE_HEAP;
 }
 template <typename T>
 herm_matrix<T>::~herm_matrix() {
-    delete[] les_;
-    delete[] ret_;
-    delete[] tv_;
+    release_twotime(les_, nt_capacity_, storage_);
+    release_twotime(ret_, nt_capacity_, storage_);
+    release_tv(tv_, storage_);
     delete[] mat_;
 }
 
@@ -62,8 +67,10 @@ template <typename T>
 herm_matrix<T>::herm_matrix(int nt, int ntau, int size1, int sig) {
     assert(size1 >= 0 && nt >= -1 && sig * sig == 1 && ntau >= 0);
     nt_ = nt;
+    nt_capacity_ = nt;
     ntau_ = ntau;
     sig_ = sig;
+    storage_ = CNTR_STORAGE_HEAP;
     size1_ = size1;
     size2_ = size1;
     element_size_ = size1 * size1;
@@ -75,7 +82,7 @@ herm_matrix<T>::herm_matrix(int nt, int ntau, int size1, int sig) {
     if (nt >= 0 && size1 > 0) {
         les_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
         ret_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+        tv_ = allocate_tv(nt_);
     } else {
         les_ = 0;
         tv_ = 0;
@@ -111,8 +118,10 @@ herm_matrix<T>::herm_matrix(int nt, int ntau, int size1, int sig) {
 template <typename T> herm_matrix<T>::herm_matrix(int nt,int ntau,int size1,int size2,int sig){
    assert(size1>=0 && size2>=0 && nt>=-1 && sig*sig==1 && ntau>=0);
    nt_=nt;
+   nt_capacity_=nt;
    ntau_=ntau;
    sig_=sig;
+   storage_=CNTR_STORAGE_HEAP;
    size1_=size1;
    size2_=size2;
    element_size_=size1*size2;
@@ -156,8 +165,11 @@ template <typename T> herm_matrix<T>::herm_matrix(int nt,int ntau,int size1,int
 template <typename T>
 herm_matrix<T>::herm_matrix(const herm_matrix &g) {
     nt_ = g.nt_;
+    nt_capacity_ = g.nt_;
     ntau_ = g.ntau_;
     sig_ = g.sig_;
+    storage_ = g.storage_;
+    storage_dir_ = g.storage_dir_;
     size1_ = g.size1_;
     size2_ = g.size1_;
     element_size_ = size1_ * size1_;
@@ -168,9 +180,9 @@ herm_matrix<T>::herm_matrix(const herm_matrix &g) {
         mat_ = 0;
     }
     if (nt_ >= 0 && size1_ > 0) {
-        les_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        ret_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+        les_ = allocate_twotime(nt_);
+        ret_ = allocate_twotime(nt_);
+        tv_ = allocate_tv(nt_);
         memcpy(les_, g.les_,
                sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
         memcpy(ret_, g.ret_,
@@ -189,11 +201,12 @@ herm_matrix<T> &herm_matrix<T>::operator=(const herm_matrix &g) {
         return *this;
     sig_ = g.sig_;
     if (nt_ != g.nt_ || ntau_ != g.ntau_ || size1_ != g.size1_) {
-        delete[] les_;
-        delete[] ret_;
-        delete[] tv_;
+        release_twotime(les_, nt_capacity_, storage_);
+        release_twotime(ret_, nt_capacity_, storage_);
+        release_tv(tv_, storage_);
         delete[] mat_;
         nt_ = g.nt_;
+        nt_capacity_ = g.nt_;
         ntau_ = g.ntau_;
         size1_ = g.size1_;
         size2_ = g.size1_;
@@ -204,9 +217,9 @@ herm_matrix<T> &herm_matrix<T>::operator=(const herm_matrix &g) {
             mat_ = 0;
         }
         if (size1_ > 0 && nt_ >= 0) {
-            les_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-            ret_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-            tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+            les_ = allocate_twotime(nt_);
+            ret_ = allocate_twotime(nt_);
+            tv_ = allocate_tv(nt_);
         } else {
             les_ = 0;
             ret_ = 0;
@@ -234,36 +247,48 @@ herm_matrix<T>::herm_matrix(herm_matrix &&g) noexcept
       tv_(g.tv_),
       mat_(g.mat_),
       nt_(g.nt_),
+      nt_capacity_(g.nt_capacity_),
       ntau_(g.ntau_),
       size1_(g.size1_),
       size2_(g.size2_),
       element_size_(g.element_size_),
-      sig_(g.sig_) {
+      sig_(g.sig_),
+      storage_(g.storage_),
+      storage_dir_(std::move(g.storage_dir_)) {
     g.les_ = nullptr;
     g.tv_ = nullptr;
     g.ret_ = nullptr;
     g.mat_ = nullptr;
     g.ntau_ = 0;
     g.nt_ = 0;
+    g.nt_capacity_ = 0;
     g.size1_ = 0;
     g.size2_ = 0;
     g.element_size_ = 0;
+    g.storage_ = CNTR_STORAGE_HEAP;
 }
 template <typename T>
 herm_matrix<T> &herm_matrix<T>::operator=(herm_matrix &&g) noexcept {
     if (&g == this)
         return *this;
 
+    release_twotime(les_, nt_capacity_, storage_);
+    release_twotime(ret_, nt_capacity_, storage_);
+    release_tv(tv_, storage_);
+    delete[] mat_;
     les_ = g.les_;
     ret_ = g.ret_;
     tv_ = g.tv_;
     mat_ = g.mat_;
     nt_ = g.nt_;
+    nt_capacity_ = g.nt_capacity_;
     ntau_ = g.ntau_;
     size1_ = g.size1_;
     size2_ = g.size2_;
     element_size_ = g.element_size_;
     sig_ = g.sig_;
+    storage_ = g.storage_;
+    storage_dir_ = std::move(g.storage_dir_);
 
     g.les_ = nullptr;
     g.tv_ = nullptr;
@@ -271,9 +296,11 @@ herm_matrix<T> &herm_matrix<T>::operator=(herm_matrix &&g) noexcept {
     g.mat_ = nullptr;
     g.ntau_ = 0;
     g.nt_ = 0;
+    g.nt_capacity_ = 0;
     g.size1_ = 0;
     g.size2_ = 0;
     g.element_size_ = 0;
+    g.storage_ = CNTR_STORAGE_HEAP;
 
     return *this;
 }
@@ -312,11 +339,12 @@ herm_matrix<T> &herm_matrix<T>::operator=(herm_matrix &&g) noexcept {
 template <typename T>
 void herm_matrix<T>::resize_discard(int nt, int ntau, int size1) {
     assert(ntau >= 0 && nt >= -1 && size1 >= 0);
-    delete[] les_;
-    delete[] ret_;
-    delete[] tv_;
+    release_twotime(les_, nt_capacity_, storage_);
+    release_twotime(ret_, nt_capacity_, storage_);
+    release_tv(tv_, storage_);
     delete[] mat_;
     nt_ = nt;
+    nt_capacity_ = nt;
     ntau_ = ntau;
     size1_ = size1;
     size2_ = size1;
@@ -327,9 +355,9 @@ void herm_matrix<T>::resize_discard(int nt, int ntau, int size1) {
         mat_ = 0;
     }
     if (nt_ >= 0 && size1_ > 0) {
-        les_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        ret_ = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        tv_ = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
+        les_ = allocate_twotime(nt_);
+        ret_ = allocate_twotime(nt_);
+        tv_ = allocate_tv(nt_);
     } else {
         les_ = 0;
         tv_ = 0;
@@ -348,7 +376,13 @@ void herm_matrix<T>::resize_discard(int nt, int ntau, int size1) {
  *
  * > Resizes `herm_matrix` class with respect to number of time steps `nt`. If `nt >= 0`
  * > real-time components are resized, otherwise deallocated (i.e. only the Matsubara
- * > component is kept in memory).
+ * > component is kept in memory). The data at the time steps \f$ \le \f$ min(`nt`,`nt()`)
+ * > are kept, the new time steps are set to zero.
+ * > Within the capacity `nt_capacity()`, the rows of the new time steps are appended to
+ * > the existing arrays without any copy; a smaller `nt` keeps the allocation. Beyond the
+ * > capacity, the arrays are reallocated with the capacity increased by at least half,
+ * > so that extending the time horizon in many small chunks copies the data only
+ * > \f$ \mathcal{O}(\log n_t) \f$ times. Use `reserve` to fix the capacity in advance.
  *
  * <!-- ARGUMENTS
  *      ========= -->
@@ -359,36 +393,214 @@ void herm_matrix<T>::resize_discard(int nt, int ntau, int size1) {
  */
 template <typename T>
 void herm_matrix<T>::resize_nt(int nt) {
-    int nt1 = (nt_ > nt ? nt : nt_);
-    cplx *ret, *les, *tv;
+    std::size_t len0, len1;
     assert(nt >= -1);
+    if (size1_ == 0) {
+        nt_ = nt;
+        nt_capacity_ = (nt > nt_capacity_ ? nt : nt_capacity_);
+        return;
+    }
+    if (nt < 0) {
+        release_twotime(les_, nt_capacity_, storage_);
+        release_twotime(ret_, nt_capacity_, storage_);
+        release_tv(tv_, storage_);
+        les_ = 0;
+        ret_ = 0;
+        tv_ = 0;
+        nt_ = nt;
+        nt_capacity_ = nt;
+        return;
+    }
+    if (nt_ < 0) {
+        // nothing allocated yet: use a capacity reserved before
+        nt_capacity_ = (nt > nt_capacity_ ? nt : nt_capacity_);
+        les_ = allocate_twotime(nt_capacity_);
+        ret_ = allocate_twotime(nt_capacity_);
+        tv_ = allocate_tv(nt_capacity_);
+        nt_ = nt;
+        return;
+    }
+    if (nt > nt_capacity_) {
+        reallocate_nt(nt > nt_capacity_ + nt_capacity_ / 2 ? nt
+                                                          : nt_capacity_ + nt_capacity_ / 2);
+    } else if (nt > nt_) {
+        // rows nt_+1,...,nt may still hold data from before a shrink
+        len0 = ((std::size_t)(nt_ + 1) * (nt_ + 2)) / 2 * element_size_;
+        len1 = ((std::size_t)(nt + 1) * (nt + 2)) / 2 * element_size_;
+        memset(les_ + len0, 0, sizeof(cplx) * (len1 - len0));
+        memset(ret_ + len0, 0, sizeof(cplx) * (len1 - len0));
+        len0 = (std::size_t)(nt_ + 1) * (ntau_ + 1) * element_size_;
+        len1 = (std::size_t)(nt + 1) * (ntau_ + 1) * element_size_;
+        memset(tv_ + len0, 0, sizeof(cplx) * (len1 - len0));
+    }
     nt_ = nt;
-    if (size1_ == 0)
+}
+
+/** \brief <b> Allocates the real-time components for at least `nt_capacity` time steps. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *
+ * > Reallocates the lesser, retarded and left-mixing components such that later calls of
+ * > `resize_nt(nt)` with `nt <= nt_capacity` do not copy any data. `nt()` and the stored
+ * > data are not changed. Nothing is done if the capacity is already large enough.
+ * > In adaptive propagations, reserve the largest expected number of time steps once
+ * > and extend `nt` in chunks as needed.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nt_capacity
+ * > Number of time steps to allocate memory for.
+ *
+ */
+template <typename T>
+void herm_matrix<T>::reserve(int nt_capacity) {
+    if (nt_capacity <= nt_capacity_)
+        return;
+    if (nt_ < 0 || size1_ == 0) {
+        // allocated by the next resize_nt
+        nt_capacity_ = nt_capacity;
         return;
-    if (nt_ >= 0) {
-        les = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        ret = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        tv = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
-        if (nt1 >= 0) {
-            memcpy(les, les_, sizeof(cplx) * ((nt1 + 1) * (nt1 + 2)) / 2 *
-                                  element_size_);
-            memcpy(ret, ret_, sizeof(cplx) * ((nt1 + 1) * (nt1 + 2)) / 2 *
-                                  element_size_);
-            memcpy(tv, tv_,
-                   sizeof(cplx) * (nt1 + 1) * (ntau_ + 1) * element_size_);
-        }
-    } else {
-        les = 0;
-        ret = 0;
-        tv = 0;
     }
-    delete[] les_;
-    delete[] ret_;
-    delete[] tv_;
+    reallocate_nt(nt_capacity);
+}
+/// @private
+template <typename T>
+void herm_matrix<T>::reallocate_nt(int nt_capacity) {
+    cplx *ret, *les, *tv;
+    assert(nt_ >= 0 && nt_capacity >= nt_);
+    les = allocate_twotime(nt_capacity);
+    ret = allocate_twotime(nt_capacity);
+    tv = allocate_tv(nt_capacity);
+    memcpy(les, les_, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
+    memcpy(ret, ret_, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
+    memcpy(tv, tv_, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
+    release_twotime(les_, nt_capacity_, storage_);
+    release_twotime(ret_, nt_capacity_, storage_);
+    release_tv(tv_, storage_);
+    nt_capacity_ = nt_capacity;
     les_ = les;
     ret_ = ret;
     tv_ = tv;
 }
+
+/** \brief <b> Selects where the lesser and retarded components are stored. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *
+ * > With `storage = CNTR_STORAGE_HEAP` (default), the lesser and retarded components
+ * > are stored in ordinary heap memory. With `storage = CNTR_STORAGE_MMAP` they are
+ * > stored in a memory-mapped temporary file in the directory `dir` (if `dir` is NULL:
+ * > `$CNTR_MMAP_DIR`, `$TMPDIR` or `/tmp`). The operating system then keeps only the
+ * > recently used time steps in physical memory and writes older ones back to the file,
+ * > which allows propagations whose two-time data exceed the memory of the node.
+ * > With `storage = CNTR_STORAGE_NUMA`, the lesser, retarded and left-mixing components
+ * > are aligned to `CNTR_STORAGE_ALIGNMENT` bytes and initialized by the OpenMP threads in
+ * > parallel, row \f$t_i\f$ by thread \f$i\f$ mod `nthreads` (CNTR_USE_OMP). By the
+ * > first-touch policy of the operating system, the pages are then spread over the NUMA
+ * > nodes of the threads instead of being placed on the node of the master thread.
+ * > `CNTR_STORAGE_NUMA_HUGEPAGES` in addition requests transparent huge pages, which
+ * > reduces TLB misses for large arrays.
+ * > The memory layout is the same in all cases, so all routines working on `herm_matrix`
+ * > can be used without changes. The current content is kept.
+ * > The policy is kept by all later resizes and is inherited by copies.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param storage
+ * > `CNTR_STORAGE_HEAP`, `CNTR_STORAGE_MMAP`, `CNTR_STORAGE_NUMA` or
+ * > `CNTR_STORAGE_NUMA_HUGEPAGES`
+ * @param dir
+ * > directory for the backing file (only for `CNTR_STORAGE_MMAP`)
+ *
+ */
+template <typename T>
+void herm_matrix<T>::set_storage(int storage, const char *dir) {
+    cplx *les = les_, *ret = ret_, *tv = tv_;
+    int storage0 = storage_;
+    assert(storage == CNTR_STORAGE_HEAP || storage == CNTR_STORAGE_MMAP ||
+           storage == CNTR_STORAGE_NUMA || storage == CNTR_STORAGE_NUMA_HUGEPAGES);
+    storage_ = storage;
+    storage_dir_ = (dir == NULL ? "" : dir);
+    if (les == 0)
+        return;
+    les_ = allocate_twotime(nt_capacity_);
+    ret_ = allocate_twotime(nt_capacity_);
+    tv_ = allocate_tv(nt_capacity_);
+    memcpy(les_, les, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
+    memcpy(ret_, ret, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
+    memcpy(tv_, tv, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
+    release_twotime(les, nt_capacity_, storage0);
+    release_twotime(ret, nt_capacity_, storage0);
+    release_tv(tv, storage0);
+}
+/// @private
+template <typename T>
+std::complex<T> *herm_matrix<T>::allocate_twotime(int nt) {
+    std::size_t len = ((std::size_t)(nt + 1) * (nt + 2)) / 2 * element_size_;
+    if (storage_ == CNTR_STORAGE_MMAP)
+        return (cplx *)mmap_storage_allocate(
+            sizeof(cplx) * len, (storage_dir_.empty() ? NULL : storage_dir_.c_str()));
+    if (storage_ == CNTR_STORAGE_NUMA || storage_ == CNTR_STORAGE_NUMA_HUGEPAGES) {
+        // row i holds the time steps t_j, j <= i, of the triangle
+        std::vector<std::size_t> row(nt + 2);
+        cplx *ptr = (cplx *)numa_storage_allocate(sizeof(cplx) * len,
+                                                  storage_ == CNTR_STORAGE_NUMA_HUGEPAGES);
+        for (int i = 0; i <= nt + 1; i++)
+            row[i] = sizeof(cplx) * ((std::size_t)i * (i + 1)) / 2 * element_size_;
+        numa_storage_first_touch(ptr, row);
+        return ptr;
+    }
+    return new cplx[len];
+}
+/// @private
+template <typename T>
+void herm_matrix<T>::release_twotime(cplx *ptr, int nt, int storage) {
+    if (ptr == 0)
+        return;
+    if (storage == CNTR_STORAGE_MMAP)
+        mmap_storage_release(ptr, sizeof(cplx) * ((std::size_t)(nt + 1) * (nt + 2)) / 2 *
+                                      element_size_);
+    else if (storage == CNTR_STORAGE_NUMA || storage == CNTR_STORAGE_NUMA_HUGEPAGES)
+        numa_storage_release(ptr);
+    else
+        delete[] ptr;
+}
+/// @private
+template <typename T>
+std::complex<T> *herm_matrix<T>::allocate_tv(int nt) {
+    std::size_t len = (std::size_t)(nt + 1) * (ntau_ + 1) * element_size_;
+    if (storage_ == CNTR_STORAGE_NUMA || storage_ == CNTR_STORAGE_NUMA_HUGEPAGES) {
+        std::vector<std::size_t> row(nt + 2);
+        cplx *ptr = (cplx *)numa_storage_allocate(sizeof(cplx) * len,
+                                                  storage_ == CNTR_STORAGE_NUMA_HUGEPAGES);
+        for (int i = 0; i <= nt + 1; i++)
+            row[i] = sizeof(cplx) * (std::size_t)i * (ntau_ + 1) * element_size_;
+        numa_storage_first_touch(ptr, row);
+        return ptr;
+    }
+    // the left-mixing component is kept on the heap by CNTR_STORAGE_MMAP
+    return new cplx[len];
+}
+/// @private
+template <typename T>
+void herm_matrix<T>::release_tv(cplx *ptr, int storage) {
+    if (ptr == 0)
+        return;
+    if (storage == CNTR_STORAGE_NUMA || storage == CNTR_STORAGE_NUMA_HUGEPAGES)
+        numa_storage_release(ptr);
+    else
+        delete[] ptr;
+}
 /** \brief <b> Resizes `herm_matrix` object with respect to the number of
  * time points `nt`, points on the Matsubara branch `ntau` or the matrix size
  * `size1`.  </b>
@@ -1569,6 +1781,8 @@ void herm_matrix<T>::read_from_file(int nt1, const char *file) {
  */
 template <typename T>
 void herm_matrix<T>::write_to_hdf5(hid_t group_id) {
+    CNTR_PROFILE_SCOPE("herm_matrix::write_to_hdf5", CNTR_PROFILE_NO_TSTP, 0.0,
+                       sizeof(cplx) * profile_history_elements(nt_, ntau_, size1_));
     store_int_attribute_to_hid(group_id, std::string("ntau"), ntau_);
     store_int_attribute_to_hid(group_id, std::string("nt"), nt_);
     store_int_attribute_to_hid(group_id, std::string("sig"), sig_);
@@ -2111,6 +2325,58 @@ void herm_matrix<T>::set_timestep(int tstp, herm_matrix<T> &g1) {
     }
 }
 
+/** \brief <b> Sets all components at time step `tstp` to the components of
+ *  a given `herm_matrix` of a different precision. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `set_timestep(tstp,g1)`, where the elements of `g1` are converted
+ * > from `std::complex<S>` to `std::complex<T>` (e.g. between `herm_matrix<double>`
+ * > and `herm_matrix<float>`).
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > The time step at which the components are set.
+ *
+ * @param g1
+ * > The `herm_matrix` from which the time step is copied.
+ *
+ */
+template <typename T>
+template <typename S>
+void herm_matrix<T>::set_timestep(int tstp, herm_matrix<S> &g1) {
+    int l;
+    std::complex<S> *x;
+    cplx *y;
+    assert(tstp >= -1 && tstp <= nt_ && tstp <= g1.nt() && "tstp >= -1 && tstp <= nt_ && tstp <= g1.nt()");
+    assert(g1.size1() == size1_ && "g1.size1() == size1_");
+    assert(g1.ntau() == ntau_ && "g1.ntau() == ntau_");
+    if (tstp == -1) {
+        x = g1.matptr(0);
+        y = matptr(0);
+        for (l = 0; l < (ntau_ + 1) * element_size_; l++)
+            y[l] = cplx(x[l].real(), x[l].imag());
+    } else {
+        x = g1.retptr(tstp, 0);
+        y = retptr(tstp, 0);
+        for (l = 0; l < (tstp + 1) * element_size_; l++)
+            y[l] = cplx(x[l].real(), x[l].imag());
+        x = g1.tvptr(tstp, 0);
+        y = tvptr(tstp, 0);
+        for (l = 0; l < (ntau_ + 1) * element_size_; l++)
+            y[l] = cplx(x[l].real(), x[l].imag());
+        x = g1.lesptr(0, tstp);
+        y = lesptr(0, tstp);
+        for (l = 0; l < (tstp + 1) * element_size_; l++)
+            y[l] = cplx(x[l].real(), x[l].imag());
+    }
+}
+
 /** \brief <b> Sets all components at time step `tstp` to the components of
  *  a given `herm_matrix_timestep`. </b>
  *
@@ -3,6 +3,7 @@
 
 #include "cntr_herm_matrix_timestep_view_decl.hpp"
 #include "cntr_elements.hpp"
+#include "cntr_profile.hpp"
 //#include "cntr_exception.hpp"
 
 namespace cntr {
@@ -1852,6 +1853,8 @@ void herm_matrix_timestep_view<T>::Recv_timestep(int tstp, int root, int tag) {
 #ifdef CNTR_USE_HDF5
 template <typename T>
 void herm_matrix_timestep_view<T>::write_to_hdf5(hid_t group_id) {
+    CNTR_PROFILE_SCOPE("herm_matrix_timestep::write_to_hdf5", tstp_, 0.0,
+                       sizeof(std::complex<T>) * profile_timestep_elements(tstp_, ntau_, size1_));
     store_int_attribute_to_hid(group_id, std::string("ntau"), ntau_);
     store_int_attribute_to_hid(group_id, std::string("tstp"), tstp_);
     store_int_attribute_to_hid(group_id, std::string("sig"), sig_);
@@ -0,0 +1,103 @@
+#ifndef CNTR_HERM_MATRIX_TTI_DECL_H
+#define CNTR_HERM_MATRIX_TTI_DECL_H
+
+#include "cntr_global_settings.hpp"
+
+namespace cntr {
+
+template <typename T> class herm_matrix;
+
+template <typename T>
+/** \brief <b> Class `herm_matrix_tti` stores a time-translation invariant contour function.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  In equilibrium or in a steady state, the real-time components depend only on the time
+ *  difference, \f$C(t,t') = C(t-t')\f$. Instead of the triangles of `herm_matrix`, the
+ *  retarded and lesser components are stored as one-dimensional arrays
+ *  \f[ C^\mathrm{R}(l) = C^\mathrm{R}(t+lh,t), \quad C^<(l) = C^<(t,t+lh), \quad l=0,\dots,n_t, \f]
+ *  together with the Matsubara component \f$C^\mathrm{M}(\tau_m)\f$, \f$m=0,\dots,n_\tau\f$.
+ *  The remaining values follow from hermitian symmetry. The left-mixing component is not
+ *  time-translation invariant and is not stored.
+ *
+ *  Memory is \f$O(n_t+n_\tau)\f$; convolutions and the Dyson equation are solved by FFT in
+ *  \f$O(n_t\log n_t)\f$ operations (see `convolution_tti` and `dyson_tti`). `get_herm_matrix`
+ *  expands the real-time and Matsubara components into a `herm_matrix`.
+ *
+ */
+class herm_matrix_tti {
+  public:
+    typedef std::complex<T> cplx;
+    typedef T scalar_type;
+
+    /* construction, destruction */
+    herm_matrix_tti();
+    ~herm_matrix_tti();
+    herm_matrix_tti(int nt, int ntau, int size1 = 1, int sig = -1);
+    herm_matrix_tti(const herm_matrix_tti &g);
+    herm_matrix_tti &operator=(const herm_matrix_tti &g);
+    void clear(void);
+    /* access size etc ... */
+    /// @private
+    int element_size(void) const { return element_size_; }
+    int size1(void) const { return size1_; }
+    int size2(void) const { return size2_; }
+    int nt(void) const { return nt_; }
+    int ntau(void) const { return ntau_; }
+    int sig(void) const { return sig_; }
+    // raw pointer to elements ... to be used with care
+    /// @private
+    inline cplx *retptr(int l) { return ret_ + l * element_size_; }
+    /// @private
+    inline cplx *lesptr(int l) { return les_ + l * element_size_; }
+    /// @private
+    inline cplx *matptr(int m) { return mat_ + m * element_size_; }
+    /* get and set elements */
+    template <class Matrix> void get_ret(int l, Matrix &M);
+    template <class Matrix> void get_les(int l, Matrix &M);
+    template <class Matrix> void get_mat(int m, Matrix &M);
+    template <class Matrix> void set_ret(int l, Matrix &M);
+    template <class Matrix> void set_les(int l, Matrix &M);
+    template <class Matrix> void set_mat(int m, Matrix &M);
+    void smul(T weight);
+    void smul(cplx weight);
+    /* copy from and to full contour functions */
+    void set_from_herm_matrix(int tstp, herm_matrix<T> &g);
+    void get_herm_matrix(herm_matrix<T> &g);
+
+  private:
+    /// @private
+    /** \brief <b> Retarded component \f$C^\mathrm{R}(t+lh,t)\f$.</b> */
+    cplx *ret_;
+    /// @private
+    /** \brief <b> Lesser component \f$C^<(t,t+lh)\f$.</b> */
+    cplx *les_;
+    /// @private
+    /** \brief <b> Matsubara component.</b> */
+    cplx *mat_;
+    /// @private
+    /** \brief <b> Maximum time difference in units of the time step.</b> */
+    int nt_;
+    /// @private
+    /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
+    int ntau_;
+    /// @private
+    /** \brief <b> Number of the colums in the Matrix form.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Number of the rows in the Matrix form.</b> */
+    int size2_;
+    /// @private
+    /** \brief <b> Size of the Matrix form; size1*size2. </b> */
+    int element_size_;
+    /// @private
+    /** \brief <b> Bose = +1, Fermi =-1. </b> */
+    int sig_;
+};
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_TTI_DECL_H
@@ -0,0 +1,12 @@
+#ifndef CNTR_HERM_MATRIX_TTI_EXTERN_TEMPLATES_H
+#define CNTR_HERM_MATRIX_TTI_EXTERN_TEMPLATES_H
+
+#include "cntr_herm_matrix_tti_decl.hpp"
+
+namespace cntr {
+
+extern template class herm_matrix_tti<double>;
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_TTI_EXTERN_TEMPLATES_H
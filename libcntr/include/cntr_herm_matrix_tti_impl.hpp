@@ -0,0 +1,304 @@
+#ifndef CNTR_HERM_MATRIX_TTI_IMPL_H
+#define CNTR_HERM_MATRIX_TTI_IMPL_H
+
+#include "cntr_herm_matrix_tti_decl.hpp"
+#include "cntr_elements.hpp"
+#include "cntr_herm_matrix_impl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   CONSTRUCTION
+#
+########################################################################################*/
+template <typename T>
+herm_matrix_tti<T>::herm_matrix_tti() {
+    ret_ = 0;
+    les_ = 0;
+    mat_ = 0;
+    nt_ = -2;
+    ntau_ = 0;
+    size1_ = 0;
+    size2_ = 0;
+    element_size_ = 0;
+    sig_ = -1;
+}
+template <typename T>
+herm_matrix_tti<T>::~herm_matrix_tti() {
+    delete[] ret_;
+    delete[] les_;
+    delete[] mat_;
+}
+
+/** \brief <b> Initializes the `herm_matrix_tti` class. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Allocates the retarded and lesser components for the time differences
+ * > \f$l=0,\dots,n_t\f$ and the Matsubara component, which are set to zero.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nt
+ * > Maximum time difference in units of the time step; `nt=-1` stores only the
+ * > Matsubara component.
+ * @param ntau
+ * > Number of the time grids on the Matsubara axis.
+ * @param size1
+ * > Matrix rank of the contour function.
+ * @param sig
+ * > Set `sig = -1` for fermions or `sig = +1` for bosons.
+ */
+template <typename T>
+herm_matrix_tti<T>::herm_matrix_tti(int nt, int ntau, int size1, int sig) {
+    assert(nt >= -1 && ntau >= 0 && size1 > 0 && sig * sig == 1);
+    nt_ = nt;
+    ntau_ = ntau;
+    size1_ = size1;
+    size2_ = size1;
+    element_size_ = size1 * size1;
+    sig_ = sig;
+    ret_ = new cplx[(nt_ + 1) * element_size_];
+    les_ = new cplx[(nt_ + 1) * element_size_];
+    mat_ = new cplx[(ntau_ + 1) * element_size_];
+    clear();
+}
+template <typename T>
+herm_matrix_tti<T>::herm_matrix_tti(const herm_matrix_tti &g) {
+    nt_ = g.nt_;
+    ntau_ = g.ntau_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    if (size1_ > 0) {
+        ret_ = new cplx[(nt_ + 1) * element_size_];
+        les_ = new cplx[(nt_ + 1) * element_size_];
+        mat_ = new cplx[(ntau_ + 1) * element_size_];
+        memcpy(ret_, g.ret_, sizeof(cplx) * (nt_ + 1) * element_size_);
+        memcpy(les_, g.les_, sizeof(cplx) * (nt_ + 1) * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        ret_ = 0;
+        les_ = 0;
+        mat_ = 0;
+    }
+}
+template <typename T>
+herm_matrix_tti<T> &herm_matrix_tti<T>::operator=(const herm_matrix_tti &g) {
+    if (this == &g)
+        return *this;
+    delete[] ret_;
+    delete[] les_;
+    delete[] mat_;
+    nt_ = g.nt_;
+    ntau_ = g.ntau_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    if (size1_ > 0) {
+        ret_ = new cplx[(nt_ + 1) * element_size_];
+        les_ = new cplx[(nt_ + 1) * element_size_];
+        mat_ = new cplx[(ntau_ + 1) * element_size_];
+        memcpy(ret_, g.ret_, sizeof(cplx) * (nt_ + 1) * element_size_);
+        memcpy(les_, g.les_, sizeof(cplx) * (nt_ + 1) * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        ret_ = 0;
+        les_ = 0;
+        mat_ = 0;
+    }
+    return *this;
+}
+
+/** \brief <b> Sets all components to zero. </b> */
+template <typename T>
+void herm_matrix_tti<T>::clear(void) {
+    if (size1_ == 0)
+        return;
+    memset(ret_, 0, sizeof(cplx) * (nt_ + 1) * element_size_);
+    memset(les_, 0, sizeof(cplx) * (nt_ + 1) * element_size_);
+    memset(mat_, 0, sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/* #######################################################################################
+#
+#   GET AND SET ELEMENTS
+#
+########################################################################################*/
+/** \brief <b> Returns \f$C^\mathrm{R}(t+lh,t)\f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_tti<T>::get_ret(int l, Matrix &M) {
+    int r, s;
+    cplx *x = retptr(l);
+    assert(0 <= l && l <= nt_);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+/** \brief <b> Returns \f$C^<(t,t+lh)\f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_tti<T>::get_les(int l, Matrix &M) {
+    int r, s;
+    cplx *x = lesptr(l);
+    assert(0 <= l && l <= nt_);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+/** \brief <b> Returns \f$C^\mathrm{M}(\tau_m)\f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_tti<T>::get_mat(int m, Matrix &M) {
+    int r, s;
+    cplx *x = matptr(m);
+    assert(0 <= m && m <= ntau_);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+/** \brief <b> Sets \f$C^\mathrm{R}(t+lh,t)\f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_tti<T>::set_ret(int l, Matrix &M) {
+    int r, s;
+    cplx *x = retptr(l);
+    assert(0 <= l && l <= nt_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            x[r * size2_ + s] = M(r, s);
+}
+/** \brief <b> Sets \f$C^<(t,t+lh)\f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_tti<T>::set_les(int l, Matrix &M) {
+    int r, s;
+    cplx *x = lesptr(l);
+    assert(0 <= l && l <= nt_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            x[r * size2_ + s] = M(r, s);
+}
+/** \brief <b> Sets \f$C^\mathrm{M}(\tau_m)\f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_tti<T>::set_mat(int m, Matrix &M) {
+    int r, s;
+    cplx *x = matptr(m);
+    assert(0 <= m && m <= ntau_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            x[r * size2_ + s] = M(r, s);
+}
+
+/** \brief <b> Multiplies all components by a real scalar. </b> */
+template <typename T>
+void herm_matrix_tti<T>::smul(T weight) {
+    int l;
+    for (l = 0; l < (nt_ + 1) * element_size_; l++) {
+        ret_[l] *= weight;
+        les_[l] *= weight;
+    }
+    for (l = 0; l < (ntau_ + 1) * element_size_; l++)
+        mat_[l] *= weight;
+}
+/** \brief <b> Multiplies all components by a complex scalar. </b> */
+template <typename T>
+void herm_matrix_tti<T>::smul(cplx weight) {
+    int l;
+    for (l = 0; l < (nt_ + 1) * element_size_; l++) {
+        ret_[l] *= weight;
+        les_[l] *= weight;
+    }
+    for (l = 0; l < (ntau_ + 1) * element_size_; l++)
+        mat_[l] *= weight;
+}
+
+/* #######################################################################################
+#
+#   CONVERSION FROM AND TO HERM_MATRIX
+#
+########################################################################################*/
+
+/** \brief <b> Copies one time step of a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp=-1`, the Matsubara component is copied. Otherwise, the retarded and lesser
+ * > components are read from the time step `tstp` of a time-translation invariant
+ * > `herm_matrix`, \f$C^\mathrm{R}(l) = g^\mathrm{R}(t_{tstp},t_{tstp-l})\f$ and
+ * > \f$C^<(l) = g^<(t_{tstp-l},t_{tstp})\f$, which requires `tstp >= nt`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > Time step.
+ * @param g
+ * > The `herm_matrix`.
+ */
+template <typename T>
+void herm_matrix_tti<T>::set_from_herm_matrix(int tstp, herm_matrix<T> &g) {
+    int l;
+    assert(g.size1() == size1_ && g.sig() == sig_);
+    assert(tstp == -1 || (tstp >= nt_ && tstp <= g.nt()));
+    if (tstp == -1) {
+        assert(g.ntau() == ntau_);
+        memcpy(mat_, g.matptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        for (l = 0; l <= nt_; l++) {
+            element_set<T, LARGESIZE>(size1_, retptr(l), g.retptr(tstp, tstp - l));
+            element_set<T, LARGESIZE>(size1_, lesptr(l), g.lesptr(tstp - l, tstp));
+        }
+    }
+}
+
+/** \brief <b> Expands the real-time and Matsubara components into a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Sets \f$g^\mathrm{R}(t_i,t_j) = C^\mathrm{R}(i-j)\f$ and \f$g^<(t_j,t_i) = C^<(i-j)\f$ for
+ * > \f$0 \le j \le i \le\f$ `g.nt()`, and the Matsubara component if `g.ntau()==ntau`.
+ * > The left-mixing component of `g` is not changed.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param g
+ * > The `herm_matrix`, with `g.nt() <= nt`.
+ */
+template <typename T>
+void herm_matrix_tti<T>::get_herm_matrix(herm_matrix<T> &g) {
+    int i, l;
+    assert(g.size1() == size1_ && g.sig() == sig_);
+    assert(g.nt() <= nt_);
+    if (g.ntau() == ntau_)
+        memcpy(g.matptr(0), mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    for (i = 0; i <= g.nt(); i++) {
+        for (l = 0; l <= i; l++) {
+            element_set<T, LARGESIZE>(size1_, g.retptr(i, i - l), retptr(l));
+            element_set<T, LARGESIZE>(size1_, g.lesptr(i - l, i), lesptr(l));
+        }
+    }
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_TTI_IMPL_H
@@ -0,0 +1,138 @@
+#ifndef CNTR_HERM_MATRIX_WINDOW_DECL_H
+#define CNTR_HERM_MATRIX_WINDOW_DECL_H
+
+#include "cntr_global_settings.hpp"
+
+namespace cntr {
+
+template <typename T> class herm_matrix;
+template <typename T> class herm_matrix_timestep;
+
+template <typename T>
+/** \brief <b> Class `herm_matrix_window` stores the last `nc+1` time steps of a
+ * two-time contour object \f$ C(t,t') \f$ with hermitian symmetry.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  For dissipative systems the memory kernels decay on a time scale \f$ t_c \f$,
+ *  and the contour functions can be truncated to \f$ |t - t'| \le t_c = n_c h \f$.
+ *  The class `herm_matrix_window` keeps only the time steps `tmax()-nc` ... `tmax()`
+ *  in a ring buffer. For each stored time step \f$ t_i \f$ it holds
+ *   - retarded component \f$ C^\mathrm{R}(t_i,t_i - t_j) \f$ for j=0,...,`nc`,
+ *   - lesser component \f$ C^<(t_i - t_j,t_i) \f$ for j=0,...,`nc`,
+ *   - left-mixing component \f$ C^\rceil(t_i,\tau_k) \f$ for k=0,...,`ntau`,
+ *
+ *  and in addition the Matsubara component. The memory is thus \f$ O(n_c^2 + n_c n_\tau) \f$
+ *  independent of the length of the propagation.
+ *
+ *  Writing time step `tmax()+1` (by `set_timestep` or by one of the solvers
+ *  `convolution_timestep_window`, `dyson_timestep_window`, `vie2_timestep_window`)
+ *  overwrites the oldest time step. Elements outside the window are regarded as zero.
+ *
+ */
+class herm_matrix_window {
+  public:
+    typedef std::complex<T> cplx;
+    typedef T scalar_type;
+
+    /* construction, destruction */
+    herm_matrix_window();
+    ~herm_matrix_window();
+    herm_matrix_window(int nc, int ntau, int size1 = 1, int sig = -1);
+    herm_matrix_window(const herm_matrix_window &g);
+    herm_matrix_window &operator=(const herm_matrix_window &g);
+    void clear(void);
+    /* access size etc ... */
+    /// @private
+    int element_size(void) const { return element_size_; }
+    int size1(void) const { return size1_; }
+    int size2(void) const { return size2_; }
+    int ntau(void) const { return ntau_; }
+    int nc(void) const { return nc_; }
+    int sig(void) const { return sig_; }
+    /** \brief <b> Latest time step in the window (-1 if only Matsubara is set).</b> */
+    int tmax(void) const { return tmax_; }
+    /** \brief <b> Earliest time step in the window.</b> */
+    int tmin(void) const { return (tmax_ > nc_ ? tmax_ - nc_ : 0); }
+    /* window */
+    void advance(int tstp);
+    // raw pointer to elements ... to be used with care
+    /// @private
+    inline cplx *lesptr(int i, int j);
+    /// @private
+    inline cplx *retptr(int i, int j);
+    /// @private
+    inline cplx *tvptr(int i, int j);
+    /// @private
+    inline cplx *matptr(int i);
+    // reading elements
+    /// @private
+    template <class Matrix>
+    void get_les(int i, int j, Matrix &M);
+    /// @private
+    template <class Matrix>
+    void get_ret(int i, int j, Matrix &M);
+    /// @private
+    template <class Matrix>
+    void get_tv(int i, int j, Matrix &M);
+    /// @private
+    template <class Matrix>
+    void get_mat(int i, Matrix &M);
+    cplx density_matrix(int tstp);
+    template <class Matrix>
+    void density_matrix(int tstp, Matrix &M);
+    /* copy timesteps from and to full contour functions */
+    void set_timestep(int tstp, herm_matrix<T> &g);
+    void set_timestep(int tstp, herm_matrix_timestep<T> &g);
+    void get_timestep(int tstp, herm_matrix<T> &g);
+    void get_timestep(int tstp, herm_matrix_timestep<T> &g);
+    void set_timestep_zero(int tstp);
+    void smul(int tstp, T weight);
+    void smul(int tstp, cplx weight);
+
+  private:
+    /// @private
+    /** \brief <b> Position of time step `i` in the ring buffer.</b> */
+    int slot(int i) const { return i % (nc_ + 1); }
+
+    /// @private
+    /** \brief <b> Ring buffer of the lesser component; `les_ + (slot(i)*(nc+1)+j)*element_size` is \f$ C^<(t_i - t_j, t_i) \f$.</b> */
+    cplx *les_;
+    /// @private
+    /** \brief <b> Ring buffer of the retarded component; `ret_ + (slot(i)*(nc+1)+j)*element_size` is \f$ C^\mathrm{R}(t_i, t_i - t_j) \f$.</b> */
+    cplx *ret_;
+    /// @private
+    /** \brief <b> Ring buffer of the left-mixing component.</b> */
+    cplx *tv_;
+    /// @private
+    /** \brief <b> Pointer to the Matsubara component.</b> */
+    cplx *mat_;
+    /// @private
+    /** \brief <b> Maximum time difference kept in the window.</b> */
+    int nc_;
+    /// @private
+    /** \brief <b> Latest time step in the window.</b> */
+    int tmax_;
+    /// @private
+    /** \brief <b> Number of the time grids on the Matsubara axis.</b> */
+    int ntau_;
+    /// @private
+    /** \brief <b> Number of the colums in the Matrix form.</b> */
+    int size1_;
+    /// @private
+    /** \brief <b> Number of the rows in the Matrix form.</b> */
+    int size2_;
+    /// @private
+    /** \brief <b> Size of the Matrix form; size1*size2. </b> */
+    int element_size_;
+    /// @private
+    /** \brief <b> Bose = +1, Fermi =-1. </b> */
+    int sig_;
+};
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_WINDOW_DECL_H
@@ -0,0 +1,18 @@
+#ifndef CNTR_HERM_MATRIX_WINDOW_EXTERN_TEMPLATES_H
+#define CNTR_HERM_MATRIX_WINDOW_EXTERN_TEMPLATES_H
+
+#include "cntr_herm_matrix_window_decl.hpp"
+
+namespace cntr {
+
+extern template class herm_matrix_window<double>;
+
+extern template void herm_matrix_window<double>::get_les<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+extern template void herm_matrix_window<double>::get_ret<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+extern template void herm_matrix_window<double>::get_tv<Eigen::MatrixXcd>(int i,int j,Eigen::MatrixXcd &M);
+extern template void herm_matrix_window<double>::get_mat<Eigen::MatrixXcd>(int i,Eigen::MatrixXcd &M);
+extern template void herm_matrix_window<double>::density_matrix<Eigen::MatrixXcd>(int tstp,Eigen::MatrixXcd &M);
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_WINDOW_EXTERN_TEMPLATES_H
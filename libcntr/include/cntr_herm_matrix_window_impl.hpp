@@ -0,0 +1,586 @@
+#ifndef CNTR_HERM_MATRIX_WINDOW_IMPL_H
+#define CNTR_HERM_MATRIX_WINDOW_IMPL_H
+
+#include "cntr_herm_matrix_window_decl.hpp"
+#include "cntr_herm_matrix_impl.hpp"
+#include "cntr_herm_matrix_timestep_impl.hpp"
+#include "cntr_elements.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   CONSTRUCTION/DESTRUCTION
+#
+########################################################################################*/
+template <typename T>
+herm_matrix_window<T>::herm_matrix_window() {
+    les_ = 0;
+    ret_ = 0;
+    tv_ = 0;
+    mat_ = 0;
+    nc_ = 0;
+    tmax_ = -1;
+    ntau_ = 0;
+    size1_ = 0;
+    size2_ = 0;
+    element_size_ = 0;
+    sig_ = -1;
+}
+template <typename T>
+herm_matrix_window<T>::~herm_matrix_window() {
+    delete[] les_;
+    delete[] ret_;
+    delete[] tv_;
+    delete[] mat_;
+}
+
+/** \brief <b> Initializes the `herm_matrix_window` class for a given memory cutoff `nc`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Allocates the ring buffers for the time steps `tmax()-nc` ... `tmax()`,
+ * > each holding the time differences 0 ... `nc`, and the Matsubara component.
+ * > All elements are set to zero and `tmax()` is set to -1.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nc
+ * > Maximum time difference (in time steps) kept in the window.
+ * @param ntau
+ * > Number of points on Matsubara axis
+ * @param size1
+ * > Matrix rank of the contour function
+ * @param sig
+ * > Set `sig = -1` for fermions or `sig = +1` for bosons.
+ */
+template <typename T>
+herm_matrix_window<T>::herm_matrix_window(int nc, int ntau, int size1, int sig) {
+    int len;
+    assert(nc >= 0 && ntau >= 0 && size1 > 0 && sig * sig == 1);
+    nc_ = nc;
+    tmax_ = -1;
+    ntau_ = ntau;
+    size1_ = size1;
+    size2_ = size1;
+    element_size_ = size1 * size1;
+    sig_ = sig;
+    len = (nc_ + 1) * (nc_ + 1) * element_size_;
+    les_ = new cplx[len];
+    ret_ = new cplx[len];
+    tv_ = new cplx[(nc_ + 1) * (ntau_ + 1) * element_size_];
+    mat_ = new cplx[(ntau_ + 1) * element_size_];
+    clear();
+}
+template <typename T>
+herm_matrix_window<T>::herm_matrix_window(const herm_matrix_window &g) {
+    int len;
+    nc_ = g.nc_;
+    tmax_ = g.tmax_;
+    ntau_ = g.ntau_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    if (size1_ > 0) {
+        len = (nc_ + 1) * (nc_ + 1) * element_size_;
+        les_ = new cplx[len];
+        ret_ = new cplx[len];
+        tv_ = new cplx[(nc_ + 1) * (ntau_ + 1) * element_size_];
+        mat_ = new cplx[(ntau_ + 1) * element_size_];
+        memcpy(les_, g.les_, sizeof(cplx) * len);
+        memcpy(ret_, g.ret_, sizeof(cplx) * len);
+        memcpy(tv_, g.tv_, sizeof(cplx) * (nc_ + 1) * (ntau_ + 1) * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        les_ = 0;
+        ret_ = 0;
+        tv_ = 0;
+        mat_ = 0;
+    }
+}
+template <typename T>
+herm_matrix_window<T> &herm_matrix_window<T>::operator=(const herm_matrix_window &g) {
+    int len;
+    if (this == &g)
+        return *this;
+    delete[] les_;
+    delete[] ret_;
+    delete[] tv_;
+    delete[] mat_;
+    nc_ = g.nc_;
+    tmax_ = g.tmax_;
+    ntau_ = g.ntau_;
+    size1_ = g.size1_;
+    size2_ = g.size2_;
+    element_size_ = g.element_size_;
+    sig_ = g.sig_;
+    if (size1_ > 0) {
+        len = (nc_ + 1) * (nc_ + 1) * element_size_;
+        les_ = new cplx[len];
+        ret_ = new cplx[len];
+        tv_ = new cplx[(nc_ + 1) * (ntau_ + 1) * element_size_];
+        mat_ = new cplx[(ntau_ + 1) * element_size_];
+        memcpy(les_, g.les_, sizeof(cplx) * len);
+        memcpy(ret_, g.ret_, sizeof(cplx) * len);
+        memcpy(tv_, g.tv_, sizeof(cplx) * (nc_ + 1) * (ntau_ + 1) * element_size_);
+        memcpy(mat_, g.mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        les_ = 0;
+        ret_ = 0;
+        tv_ = 0;
+        mat_ = 0;
+    }
+    return *this;
+}
+
+/** \brief <b> Sets all elements to zero and empties the window. </b> */
+template <typename T>
+void herm_matrix_window<T>::clear(void) {
+    int len = (nc_ + 1) * (nc_ + 1) * element_size_;
+    if (size1_ == 0)
+        return;
+    memset(les_, 0, sizeof(cplx) * len);
+    memset(ret_, 0, sizeof(cplx) * len);
+    memset(tv_, 0, sizeof(cplx) * (nc_ + 1) * (ntau_ + 1) * element_size_);
+    memset(mat_, 0, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    tmax_ = -1;
+}
+
+/** \brief <b> Moves the window forward such that it ends at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > If `tstp > tmax()`, the time steps `tmax()+1` ... `tstp` are added to the
+ * > window and set to zero, and the oldest time steps are discarded. Nothing is
+ * > done if `tstp <= tmax()`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > New latest time step of the window.
+ */
+template <typename T>
+void herm_matrix_window<T>::advance(int tstp) {
+    while (tmax_ < tstp) {
+        tmax_++;
+        set_timestep_zero(tmax_);
+    }
+}
+
+/* #######################################################################################
+#
+#   RAW POINTERS TO ELEMENTS
+#
+########################################################################################*/
+/// @private
+template <typename T>
+inline std::complex<T> *herm_matrix_window<T>::lesptr(int i, int j) {
+    assert(i <= j && j - i <= nc_ && j <= tmax_ && j >= tmax_ - nc_);
+    return les_ + (slot(j) * (nc_ + 1) + j - i) * element_size_;
+}
+/// @private
+template <typename T>
+inline std::complex<T> *herm_matrix_window<T>::retptr(int i, int j) {
+    assert(j <= i && i - j <= nc_ && i <= tmax_ && i >= tmax_ - nc_);
+    return ret_ + (slot(i) * (nc_ + 1) + i - j) * element_size_;
+}
+/// @private
+template <typename T>
+inline std::complex<T> *herm_matrix_window<T>::tvptr(int i, int j) {
+    assert(i <= tmax_ && i >= tmax_ - nc_ && i >= 0);
+    return tv_ + (slot(i) * (ntau_ + 1) + j) * element_size_;
+}
+/// @private
+template <typename T>
+inline std::complex<T> *herm_matrix_window<T>::matptr(int i) {
+    return mat_ + i * element_size_;
+}
+
+/* #######################################################################################
+#
+#   READING ELEMENTS TO ANY MATRIX TYPE
+#
+########################################################################################*/
+/// @private
+/** \brief <b> Returns the lesser component \f$ C^<(t_i,t_j) \f$ (zero outside the window). </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_window<T>::get_les(int i, int j, Matrix &M) {
+    int r, s;
+    cplx *x;
+    M.resize(size1_, size2_);
+    if ((i <= j ? j - i : i - j) > nc_) {
+        M.setZero();
+        return;
+    }
+    if (i <= j) {
+        x = lesptr(i, j);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = x[r * size2_ + s];
+    } else {
+        x = lesptr(j, i);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = -std::conj(x[s * size2_ + r]);
+    }
+}
+/// @private
+/** \brief <b> Returns the retarded component \f$ C^\mathrm{R}(t_i,t_j) \f$ (zero outside the window). </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_window<T>::get_ret(int i, int j, Matrix &M) {
+    int r, s;
+    cplx *x;
+    M.resize(size1_, size2_);
+    if ((i >= j ? i - j : j - i) > nc_) {
+        M.setZero();
+        return;
+    }
+    if (i >= j) {
+        x = retptr(i, j);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = x[r * size2_ + s];
+    } else {
+        x = retptr(j, i);
+        for (r = 0; r < size1_; r++)
+            for (s = 0; s < size2_; s++)
+                M(r, s) = -std::conj(x[s * size2_ + r]);
+    }
+}
+/// @private
+/** \brief <b> Returns the left-mixing component \f$ C^\rceil(t_i,\tau_j) \f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_window<T>::get_tv(int i, int j, Matrix &M) {
+    int r, s;
+    cplx *x = tvptr(i, j);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+/// @private
+/** \brief <b> Returns the Matsubara component \f$ C^\mathrm{M}(\tau_i) \f$. </b> */
+template <typename T>
+template <class Matrix>
+void herm_matrix_window<T>::get_mat(int i, Matrix &M) {
+    int r, s;
+    cplx *x = matptr(i);
+    M.resize(size1_, size2_);
+    for (r = 0; r < size1_; r++)
+        for (s = 0; s < size2_; s++)
+            M(r, s) = x[r * size2_ + s];
+}
+
+/** \brief <b> Returns the (0,0) component of the density matrix at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Returns \f$ \rho = -C^\mathrm{M}(\beta) \f$ for `tstp = -1` and
+ * > \f$ \rho(t) = i \eta C^<(t,t) \f$ for `tstp` within the window.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ */
+template <typename T>
+std::complex<T> herm_matrix_window<T>::density_matrix(int tstp) {
+    if (tstp == -1)
+        return -matptr(ntau_)[0];
+    return std::complex<T>(0.0, sig_) * lesptr(tstp, tstp)[0];
+}
+
+/** \brief <b> Returns the density matrix at time step `tstp`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Returns \f$ \rho = -C^\mathrm{M}(\beta) \f$ for `tstp = -1` and
+ * > \f$ \rho(t) = i \eta C^<(t,t) \f$ for `tstp` within the window.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param M
+ * > the density matrix
+ */
+template <typename T>
+template <class Matrix>
+void herm_matrix_window<T>::density_matrix(int tstp, Matrix &M) {
+    if (tstp == -1) {
+        get_mat(ntau_, M);
+        M *= (-1.0);
+    } else {
+        get_les(tstp, tstp, M);
+        M *= std::complex<T>(0.0, 1.0 * sig_);
+    }
+}
+
+/* #######################################################################################
+#
+#   COPYING TIMESTEPS
+#
+########################################################################################*/
+/** \brief <b> Sets all components at time step `tstp` to zero. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp = -1` the Matsubara component is set to zero, otherwise `tstp` must be
+ * > within the window.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ */
+template <typename T>
+void herm_matrix_window<T>::set_timestep_zero(int tstp) {
+    if (tstp == -1) {
+        memset(mat_, 0, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    } else {
+        memset(retptr(tstp, tstp), 0, sizeof(cplx) * (nc_ + 1) * element_size_);
+        memset(lesptr(tstp, tstp), 0, sizeof(cplx) * (nc_ + 1) * element_size_);
+        memset(tvptr(tstp, 0), 0, sizeof(cplx) * (ntau_ + 1) * element_size_);
+    }
+}
+
+/** \brief <b> Copies time step `tstp` of a `herm_matrix` into the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp = -1` the Matsubara component is copied. For `tstp >= 0` the window is
+ * > moved forward if `tstp > tmax()` (see `advance`), and the elements
+ * > \f$ C^\mathrm{R}(t,t') \f$, \f$ C^<(t',t) \f$ with \f$ t-t' \le n_c h \f$ and
+ * > \f$ C^\rceil(t,\tau) \f$ at \f$ t = t_{tstp} \f$ are copied.
+ * > This is used to start the propagation from a `herm_matrix` which
+ * > has been computed for the first time steps.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > the `herm_matrix` from which the time step is copied
+ */
+template <typename T>
+void herm_matrix_window<T>::set_timestep(int tstp, herm_matrix<T> &g) {
+    int j, j0;
+    assert(tstp >= -1 && tstp <= g.nt());
+    assert(g.size1() == size1_ && g.ntau() == ntau_);
+    if (tstp == -1) {
+        memcpy(mat_, g.matptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    advance(tstp);
+    assert(tstp >= tmax_ - nc_);
+    set_timestep_zero(tstp);
+    j0 = (tstp > nc_ ? tstp - nc_ : 0);
+    for (j = j0; j <= tstp; j++) {
+        element_set<T, LARGESIZE>(size1_, retptr(tstp, j), g.retptr(tstp, j));
+        element_set<T, LARGESIZE>(size1_, lesptr(j, tstp), g.lesptr(j, tstp));
+    }
+    memcpy(tvptr(tstp, 0), g.tvptr(tstp, 0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Copies a `herm_matrix_timestep` into the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `set_timestep(tstp, herm_matrix)`, with the data taken from a
+ * > `herm_matrix_timestep` at time step `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > the `herm_matrix_timestep` from which the time step is copied
+ */
+template <typename T>
+void herm_matrix_window<T>::set_timestep(int tstp, herm_matrix_timestep<T> &g) {
+    int j, j0;
+    assert(tstp == g.tstp());
+    assert(g.size1() == size1_ && g.ntau() == ntau_);
+    if (tstp == -1) {
+        memcpy(mat_, g.matptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    advance(tstp);
+    assert(tstp >= tmax_ - nc_);
+    set_timestep_zero(tstp);
+    j0 = (tstp > nc_ ? tstp - nc_ : 0);
+    for (j = j0; j <= tstp; j++) {
+        element_set<T, LARGESIZE>(size1_, retptr(tstp, j), g.retptr(j));
+        element_set<T, LARGESIZE>(size1_, lesptr(j, tstp), g.lesptr(j));
+    }
+    memcpy(tvptr(tstp, 0), g.tvptr(0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Copies time step `tstp` of the window into a `herm_matrix`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Writes time step `tstp` (or the Matsubara component for `tstp = -1`) into `g`.
+ * > Elements \f$ C^\mathrm{R}(t,t') \f$, \f$ C^<(t',t) \f$ with \f$ t-t' > n_c h \f$
+ * > are set to zero.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > the `herm_matrix` to which the time step is written
+ */
+template <typename T>
+void herm_matrix_window<T>::get_timestep(int tstp, herm_matrix<T> &g) {
+    int j, j0;
+    assert(tstp >= -1 && tstp <= g.nt());
+    assert(g.size1() == size1_ && g.ntau() == ntau_);
+    if (tstp == -1) {
+        memcpy(g.matptr(0), mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    g.set_timestep_zero(tstp);
+    j0 = (tstp > nc_ ? tstp - nc_ : 0);
+    for (j = j0; j <= tstp; j++) {
+        element_set<T, LARGESIZE>(size1_, g.retptr(tstp, j), retptr(tstp, j));
+        element_set<T, LARGESIZE>(size1_, g.lesptr(j, tstp), lesptr(j, tstp));
+    }
+    memcpy(g.tvptr(tstp, 0), tvptr(tstp, 0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Copies time step `tstp` of the window into a `herm_matrix_timestep`. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `get_timestep(tstp, herm_matrix)`; `g` is resized to time step `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param g
+ * > the `herm_matrix_timestep` to which the time step is written
+ */
+template <typename T>
+void herm_matrix_window<T>::get_timestep(int tstp, herm_matrix_timestep<T> &g) {
+    int j, j0;
+    g.resize(tstp, ntau_, size1_);
+    if (tstp == -1) {
+        memcpy(g.matptr(0), mat_, sizeof(cplx) * (ntau_ + 1) * element_size_);
+        return;
+    }
+    g.set_timestep_zero(tstp);
+    j0 = (tstp > nc_ ? tstp - nc_ : 0);
+    for (j = j0; j <= tstp; j++) {
+        element_set<T, LARGESIZE>(size1_, g.retptr(j), retptr(tstp, j));
+        element_set<T, LARGESIZE>(size1_, g.lesptr(j), lesptr(j, tstp));
+    }
+    memcpy(g.tvptr(0), tvptr(tstp, 0), sizeof(cplx) * (ntau_ + 1) * element_size_);
+}
+
+/** \brief <b> Multiplies all components at time step `tstp` with a real scalar. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp = -1` the Matsubara component is multiplied, otherwise
+ * > the stored elements of time step `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param weight
+ * > the scalar
+ */
+template <typename T>
+void herm_matrix_window<T>::smul(int tstp, T weight) {
+    smul(tstp, cplx(weight, 0.0));
+}
+
+/** \brief <b> Multiplies all components at time step `tstp` with a complex scalar. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > For `tstp = -1` the Matsubara component is multiplied, otherwise
+ * > the stored elements of time step `tstp`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param weight
+ * > the scalar
+ */
+template <typename T>
+void herm_matrix_window<T>::smul(int tstp, cplx weight) {
+    int m;
+    cplx *x0;
+    if (tstp == -1) {
+        x0 = matptr(0);
+        for (m = 0; m < (ntau_ + 1) * element_size_; m++)
+            x0[m] *= weight;
+    } else {
+        x0 = retptr(tstp, tstp);
+        for (m = 0; m < (nc_ + 1) * element_size_; m++)
+            x0[m] *= weight;
+        x0 = lesptr(tstp, tstp);
+        for (m = 0; m < (nc_ + 1) * element_size_; m++)
+            x0[m] *= weight;
+        x0 = tvptr(tstp, 0);
+        for (m = 0; m < (ntau_ + 1) * element_size_; m++)
+            x0[m] *= weight;
+    }
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_HERM_MATRIX_WINDOW_IMPL_H
@@ -30,6 +30,7 @@ template <typename T> class herm_pseudo {
     void resize_discard(int nt, int ntau, int size1);
     void resize_nt(int nt);
     void resize(int nt, int ntau, int size1);
+    void reserve(int nt_capacity);
     void clear(void);
     /* access size etc ... */
     /// @private
@@ -38,6 +39,7 @@ template <typename T> class herm_pseudo {
     int size2(void) const { return size2_; }
     int ntau(void) const { return ntau_; }
     int nt(void) const { return nt_; }
+    int nt_capacity(void) const { return nt_capacity_; }
     int sig(void) const { return sig_; }
     void set_sig(int sig) { sig_ = sig; }
     /* conversion from other types: pseudoparticle GF,
@@ -113,6 +115,9 @@ template <typename T> class herm_pseudo {
     void smul(int tstp, T alpha);
     void smul(int tstp, cplx alpha);
 
+  private:
+    void reallocate_nt(int nt_capacity);
+
   private:
     /// @private
     cplx *les_;
@@ -125,6 +130,8 @@ template <typename T> class herm_pseudo {
     /// @private
     int nt_;
     /// @private
+    int nt_capacity_;
+    /// @private
     int ntau_;
     /// @private
     int size1_;
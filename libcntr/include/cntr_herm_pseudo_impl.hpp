@@ -22,6 +22,7 @@ template <typename T> herm_pseudo<T>::herm_pseudo() {
     mat_ = 0;
     ntau_ = 0;
     nt_ = 0;
+    nt_capacity_ = 0;
     size1_ = 0;
     size2_ = 0;
     element_size_ = 0;
@@ -38,6 +39,7 @@ template <typename T> herm_pseudo<T>::~herm_pseudo() {
 template <typename T> herm_pseudo<T>::herm_pseudo(int nt, int ntau, int size1, int sig) {
     assert(size1 >= 0 && nt >= -1 && sig * sig == 1 && ntau >= 0);
     nt_ = nt;
+    nt_capacity_ = nt;
     ntau_ = ntau;
     sig_ = sig;
     size1_ = size1;
@@ -77,6 +79,7 @@ template <typename T> unsigned long RAM_herm_pseudo(int nt, int ntau, int dim) {
 /// @private
 template <typename T> herm_pseudo<T>::herm_pseudo(const herm_pseudo &g) {
     nt_ = g.nt_;
+    nt_capacity_ = g.nt_;
     ntau_ = g.ntau_;
     sig_ = g.sig_;
     size1_ = g.size1_;
@@ -111,6 +114,7 @@ template <typename T> herm_pseudo<T> &herm_pseudo<T>::operator=(const herm_pseud
         delete[] tv_;
         delete[] mat_;
         nt_ = g.nt_;
+        nt_capacity_ = g.nt_;
         ntau_ = g.ntau_;
         size1_ = g.size1_;
         size2_ = g.size1_;
@@ -153,6 +157,7 @@ template <typename T> void herm_pseudo<T>::resize_discard(int nt, int ntau, int
     delete[] tv_;
     delete[] mat_;
     nt_ = nt;
+    nt_capacity_ = nt;
     ntau_ = ntau;
     size1_ = size1;
     size2_ = size1;
@@ -177,33 +182,82 @@ template <typename T> void herm_pseudo<T>::resize_discard(int nt, int ntau, int
     }
 }
 /// @private
+/** \brief <b> Resizes `herm_pseudo` with respect to `nt`; as `herm_matrix::resize_nt`,
+ *  the rows of the new time steps are appended within the capacity `nt_capacity()`.</b> */
 template <typename T> void herm_pseudo<T>::resize_nt(int nt) {
-    int nt1 = (nt_ > nt ? nt : nt_);
-    cplx *ret, *les, *tv;
+    size_t len0, len1;
     assert(nt >= -1);
+    if (size1_ == 0) {
+        nt_ = nt;
+        nt_capacity_ = (nt > nt_capacity_ ? nt : nt_capacity_);
+        return;
+    }
+    if (nt < 0) {
+        delete[] les_;
+        delete[] ret_;
+        delete[] tv_;
+        les_ = 0;
+        ret_ = 0;
+        tv_ = 0;
+        nt_ = nt;
+        nt_capacity_ = nt;
+        return;
+    }
+    if (nt_ < 0) {
+        nt_capacity_ = (nt > nt_capacity_ ? nt : nt_capacity_);
+        les_ = new cplx[((nt_capacity_ + 1) * (nt_capacity_ + 2)) / 2 * element_size_];
+        ret_ = new cplx[((nt_capacity_ + 1) * (nt_capacity_ + 2)) / 2 * element_size_];
+        tv_ = new cplx[(nt_capacity_ + 1) * (ntau_ + 1) * element_size_];
+        memset(les_, 0, sizeof(cplx) * ((nt_capacity_ + 1) * (nt_capacity_ + 2)) / 2 * element_size_);
+        memset(ret_, 0, sizeof(cplx) * ((nt_capacity_ + 1) * (nt_capacity_ + 2)) / 2 * element_size_);
+        memset(tv_, 0, sizeof(cplx) * (nt_capacity_ + 1) * (ntau_ + 1) * element_size_);
+        nt_ = nt;
+        return;
+    }
+    if (nt > nt_capacity_) {
+        reallocate_nt(nt > nt_capacity_ + nt_capacity_ / 2 ? nt
+                                                          : nt_capacity_ + nt_capacity_ / 2);
+    } else if (nt > nt_) {
+        // rows nt_+1,...,nt may still hold data from before a shrink
+        len0 = ((size_t)(nt_ + 1) * (nt_ + 2)) / 2 * element_size_;
+        len1 = ((size_t)(nt + 1) * (nt + 2)) / 2 * element_size_;
+        memset(les_ + len0, 0, sizeof(cplx) * (len1 - len0));
+        memset(ret_ + len0, 0, sizeof(cplx) * (len1 - len0));
+        len0 = (size_t)(nt_ + 1) * (ntau_ + 1) * element_size_;
+        len1 = (size_t)(nt + 1) * (ntau_ + 1) * element_size_;
+        memset(tv_ + len0, 0, sizeof(cplx) * (len1 - len0));
+    }
     nt_ = nt;
-    if (size1_ == 0)
+}
+/// @private
+/** \brief <b> Allocates the real-time components for at least `nt_capacity` time steps,
+ *  see `herm_matrix::reserve`.</b> */
+template <typename T> void herm_pseudo<T>::reserve(int nt_capacity) {
+    if (nt_capacity <= nt_capacity_)
+        return;
+    if (nt_ < 0 || size1_ == 0) {
+        nt_capacity_ = nt_capacity;
         return;
-    if (nt_ >= 0) {
-        les = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        ret = new cplx[((nt_ + 1) * (nt_ + 2)) / 2 * element_size_];
-        tv = new cplx[(nt_ + 1) * (ntau_ + 1) * element_size_];
-        memset(les, 0, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
-        memset(ret, 0, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
-        memset(tv, 0, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
-        if (nt1 >= 0) {
-            memcpy(les, les_, sizeof(cplx) * ((nt1 + 1) * (nt1 + 2)) / 2 * element_size_);
-            memcpy(ret, ret_, sizeof(cplx) * ((nt1 + 1) * (nt1 + 2)) / 2 * element_size_);
-            memcpy(tv, tv_, sizeof(cplx) * (nt1 + 1) * (ntau_ + 1) * element_size_);
-        }
-    } else {
-        les = 0;
-        ret = 0;
-        tv = 0;
     }
+    reallocate_nt(nt_capacity);
+}
+/// @private
+template <typename T> void herm_pseudo<T>::reallocate_nt(int nt_capacity) {
+    cplx *ret, *les, *tv;
+    assert(nt_ >= 0 && nt_capacity >= nt_);
+    les = new cplx[((nt_capacity + 1) * (nt_capacity + 2)) / 2 * element_size_];
+    ret = new cplx[((nt_capacity + 1) * (nt_capacity + 2)) / 2 * element_size_];
+    tv = new cplx[(nt_capacity + 1) * (ntau_ + 1) * element_size_];
+    memset(les, 0, sizeof(cplx) * ((nt_capacity + 1) * (nt_capacity + 2)) / 2 * element_size_);
+    memset(ret, 0, sizeof(cplx) * ((nt_capacity + 1) * (nt_capacity + 2)) / 2 * element_size_);
+    memset(tv, 0, sizeof(cplx) * (nt_capacity + 1) * (ntau_ + 1) * element_size_);
+    memcpy(les, les_, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
+    memcpy(ret, ret_, sizeof(cplx) * ((nt_ + 1) * (nt_ + 2)) / 2 * element_size_);
+    memcpy(tv, tv_, sizeof(cplx) * (nt_ + 1) * (ntau_ + 1) * element_size_);
     delete[] les_;
     delete[] ret_;
     delete[] tv_;
+    nt_capacity_ = nt_capacity;
     les_ = les;
     ret_ = ret;
     tv_ = tv;
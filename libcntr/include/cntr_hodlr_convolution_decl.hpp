@@ -0,0 +1,35 @@
+#ifndef CNTR_HODLR_CONVOLUTION_DECL_H
+#define CNTR_HODLR_CONVOLUTION_DECL_H
+
+#include "cntr_global_settings.hpp"
+#include "integration.hpp"
+
+namespace cntr {
+
+  template <typename T> class herm_matrix_timestep;
+  template <typename T> class herm_matrix_hodlr;
+
+/*###########################################################################################
+#
+#   CONVOLUTION OF HODLR-COMPRESSED CONTOUR FUNCTIONS
+#
+#   C = A*B at time step n, with A, Acc, B, Bcc stored as herm_matrix_hodlr (time steps
+#   up to max(n,k) must be set). The history integrals are evaluated from the low-rank
+#   factorizations with O(r n log n) operations, plus O(k) Gregory boundary corrections
+#   for each output time. The result is written to a herm_matrix_timestep.
+#
+###########################################################################################*/
+
+  /// @private
+  template <typename T>
+  void convolution_timestep(int n, herm_matrix_timestep<T> &C, herm_matrix_hodlr<T> &A,
+    herm_matrix_hodlr<T> &Acc, herm_matrix_hodlr<T> &B, herm_matrix_hodlr<T> &Bcc,
+    integration::Integrator<T> &I, T beta, T h);
+  template <typename T>
+  void convolution_timestep(int n, herm_matrix_timestep<T> &C, herm_matrix_hodlr<T> &A,
+    herm_matrix_hodlr<T> &Acc, herm_matrix_hodlr<T> &B, herm_matrix_hodlr<T> &Bcc,
+    T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+
+}  // namespace cntr
+
+#endif  // CNTR_HODLR_CONVOLUTION_DECL_H
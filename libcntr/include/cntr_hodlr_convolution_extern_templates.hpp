@@ -0,0 +1,19 @@
+#ifndef CNTR_HODLR_CONVOLUTION_EXTERN_TEMPLATES_H
+#define CNTR_HODLR_CONVOLUTION_EXTERN_TEMPLATES_H
+
+#include "cntr_hodlr_convolution_decl.hpp"
+
+namespace cntr {
+
+  extern template
+  void convolution_timestep<double>(int n, herm_matrix_timestep<double> &C,
+    herm_matrix_hodlr<double> &A, herm_matrix_hodlr<double> &Acc, herm_matrix_hodlr<double> &B,
+    herm_matrix_hodlr<double> &Bcc, integration::Integrator<double> &I, double beta, double h);
+  extern template
+  void convolution_timestep<double>(int n, herm_matrix_timestep<double> &C,
+    herm_matrix_hodlr<double> &A, herm_matrix_hodlr<double> &Acc, herm_matrix_hodlr<double> &B,
+    herm_matrix_hodlr<double> &Bcc, double beta, double h, int SolveOrder);
+
+}  // namespace cntr
+
+#endif  // CNTR_HODLR_CONVOLUTION_EXTERN_TEMPLATES_H
@@ -0,0 +1,414 @@
+#ifndef CNTR_HODLR_CONVOLUTION_IMPL_H
+#define CNTR_HODLR_CONVOLUTION_IMPL_H
+
+#include "cntr_hodlr_convolution_decl.hpp"
+#include "cntr_elements.hpp"
+#include "cntr_herm_matrix_hodlr_impl.hpp"
+#include "cntr_convolution_impl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#  CONVOLUTION  C = A*B  AT TIMESTEP n > k FOR HODLR-COMPRESSED A, B
+#
+#  Each Gregory sum  sum_m w(N,m) f(m)  is split into the plain sum  sum_m f(m), which is
+#  evaluated with the products of hodlr_triangle, and the corrections  (w(N,m)-1) f(m),
+#  which are nonzero only for m <= k and m >= N-k (or, for N < k, also contain the
+#  points N < m <= k continued by hermitian symmetry).
+#
+###########################################################################################*/
+
+/// @private
+/** \brief <b> Nonzero Gregory corrections \f$ w(N,l) - [l \le N] \f$; returns their number. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Writes the indices `l` and the weights \f$ w(N,l) - 1 \f$ (\f$ w(N,l) \f$ for
+ * > \f$ l > N \f$) to `lidx` and `corr`, which must have at least 2k+2 entries.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param N
+ * > [int] length of the integration interval
+ * @param I
+ * > [Integrator] integrator class
+ * @param lidx
+ * > [int] indices of the corrections
+ * @param corr
+ * > [T] corrections
+ */
+template <typename T>
+int hodlr_gregory_corrections(int N, integration::Integrator<T> &I, int *lidx, T *corr) {
+    int k = I.get_k(), lmax = (N > k ? N : k), l, len = 0;
+    T w;
+    for (l = 0; l <= lmax; l++) {
+        if (N >= 2 * k + 1 && l == k + 1)
+            l = N - k;
+        w = I.gregory_weights(N, l) - (l <= N ? 1.0 : 0.0);
+        if (w != 0) {
+            lidx[len] = l;
+            corr[len] = w;
+            len++;
+        }
+    }
+    return len;
+}
+
+/// @private
+/** \brief <b> Retarded convolution at time step `n` from HODLR-compressed functions. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$ C^\mathrm{R}(t_n,t_j) = \int_{t_j}^{t_n} d\bar t A^\mathrm{R}(t_n,\bar t)
+ * > B^\mathrm{R}(\bar t,t_j) \f$ for \f$ j = 0,\dots,n \f$, with
+ * > `cret + j*element_size` corresponding to \f$ C^\mathrm{R}(t_n,t_j) \f$.
+ * > `arow` must contain \f$ h A^\mathrm{R}(t_n,t_m) \f$, m=0...n.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param cret
+ * > [complex] result, size (n+1)*element_size
+ * @param arow
+ * > [complex] retarded component of A at time step n, times h
+ * @param B
+ * > [herm_matrix_hodlr] contour function
+ * @param Bcc
+ * > [herm_matrix_hodlr] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ */
+template <typename T, int SIZE1>
+void convolution_timestep_hodlr_ret(int n, std::complex<T> *cret, std::complex<T> *arow,
+                                    herm_matrix_hodlr<T> &B, herm_matrix_hodlr<T> &Bcc,
+                                    integration::Integrator<T> &I) {
+    typedef std::complex<T> cplx;
+    int size1 = B.size1(), sb = B.element_size(), sc = sb, j, l, m, len;
+    int *lidx = new int[2 * I.get_k() + 2];
+    T *corr = new T[2 * I.get_k() + 2], weight;
+    cplx *btemp, *bcc;
+
+    btemp = new cplx[sb];
+    bcc = new cplx[sb];
+    for (l = 0; l < (n + 1) * sc; l++)
+        cret[l] = 0;
+    B.ret().lmul(n, arow, cret);
+    for (j = 0; j <= n; j++) {
+        len = hodlr_gregory_corrections(n - j, I, lidx, corr);
+        for (l = 0; l < len; l++) {
+            m = n - lidx[l];
+            if (m >= j) {
+                B.ret().get(m, j, btemp);
+                weight = corr[l];
+            } else {
+                Bcc.ret().get(j, m, bcc);
+                element_conj<T, SIZE1>(size1, btemp, bcc);
+                weight = -corr[l];
+            }
+            element_incr<T, SIZE1>(size1, cret + j * sc, weight, arow + m * sc, btemp);
+        }
+    }
+    delete[] btemp;
+    delete[] bcc;
+    delete[] lidx;
+    delete[] corr;
+}
+
+/// @private
+/** \brief <b> Left-mixing convolution at time step `n` from HODLR-compressed functions. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$ C^\rceil(t_n,\tau_m) \f$ for \f$ m=0,\dots,n_\tau \f$. The left-mixing and
+ * > Matsubara components are stored densely, so this is the same sum as in
+ * > `convolution_timestep`. `arow` must contain \f$ h A^\mathrm{R}(t_n,t_j) \f$, j=0...n.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param ctv
+ * > [complex] result, size (ntau+1)*element_size
+ * @param arow
+ * > [complex] retarded component of A at time step n, times h
+ * @param A
+ * > [herm_matrix_hodlr] contour function
+ * @param B
+ * > [herm_matrix_hodlr] contour function
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ */
+template <typename T, int SIZE1>
+void convolution_timestep_hodlr_tv(int n, std::complex<T> *ctv, std::complex<T> *arow,
+                                   herm_matrix_hodlr<T> &A, herm_matrix_hodlr<T> &B,
+                                   integration::Integrator<T> &I, T beta) {
+    typedef std::complex<T> cplx;
+    int size1 = A.size1(), ntau = A.ntau(), sc = A.element_size(), j, m, l;
+    T dtau = beta / ntau, weight;
+    cplx *ctemp;
+
+    ctemp = new cplx[sc];
+    for (m = 0; m <= ntau; m++) {
+        matsubara_integral_2<T, SIZE1>(size1, m, ntau, ctemp, A.tvptr(n, 0), B.matptr(0), I,
+                                       B.sig());
+        for (l = 0; l < sc; l++)
+            ctv[m * sc + l] = dtau * ctemp[l];
+    }
+    for (j = 0; j <= n; j++) {
+        weight = I.gregory_weights(n, j);
+        for (m = 0; m <= ntau; m++)
+            element_incr<T, SIZE1>(size1, ctv + m * sc, weight, arow + j * sc, B.tvptr(j, m));
+    }
+    delete[] ctemp;
+}
+
+/// @private
+/** \brief <b> Lesser convolution at time step `n` from HODLR-compressed functions. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$ C^<(t_j,t_n) \f$ for \f$ j=0,\dots,n \f$, with
+ * > `cles + j*element_size` corresponding to \f$ C^<(t_j,t_n) \f$.
+ * > The contributions \f$ A^< * B^\mathrm{A} \f$ and \f$ A^\mathrm{R} * B^< \f$ are
+ * > evaluated from the factorizations of \f$ A^< \f$ and \f$ A^\mathrm{R} \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param cles
+ * > [complex] result, size (n+1)*element_size
+ * @param A
+ * > [herm_matrix_hodlr] contour function
+ * @param Acc
+ * > [herm_matrix_hodlr] complex conjugate to A
+ * @param B
+ * > [herm_matrix_hodlr] contour function
+ * @param Bcc
+ * > [herm_matrix_hodlr] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step interval
+ */
+template <typename T, int SIZE1>
+void convolution_timestep_hodlr_les(int n, std::complex<T> *cles, herm_matrix_hodlr<T> &A,
+                                    herm_matrix_hodlr<T> &Acc, herm_matrix_hodlr<T> &B,
+                                    herm_matrix_hodlr<T> &Bcc, integration::Integrator<T> &I,
+                                    T beta, T h) {
+    typedef std::complex<T> cplx;
+    int size1 = A.size1(), ntau = A.ntau(), sig = A.sig(), sc = A.element_size(), j, m, l, len;
+    int *lidx = new int[2 * I.get_k() + 2];
+    T dtau = beta / ntau, weight, *corr = new T[2 * I.get_k() + 2];
+    cplx *btemp, *x, *atemp, *acc, idtau = cplx(0, -dtau);
+
+    btemp = new cplx[((ntau > n ? ntau : n) + 1) * sc];
+    x = new cplx[(n + 1) * sc];
+    atemp = new cplx[sc];
+    acc = new cplx[sc];
+    for (l = 0; l < (n + 1) * sc; l++)
+        cles[l] = 0;
+    // A^tv * B^vt
+    for (m = 0; m <= ntau; m++)
+        element_conj<T, SIZE1>(size1, btemp + m * sc, Bcc.tvptr(n, ntau - m));
+    for (l = 0; l < (ntau + 1) * sc; l++)
+        btemp[l] *= idtau * (-(T)sig);
+    for (j = 0; j <= n; j++) {
+        for (m = 0; m <= ntau; m++)
+            element_incr<T, SIZE1>(size1, cles + j * sc, I.gregory_weights(ntau, m),
+                                   A.tvptr(j, m), btemp + m * sc);
+    }
+    // A^les * B^adv: A^les(j,m) = -A^les(m,j)^dagger for m < j
+    Bcc.ret().get_row(n, btemp);
+    for (m = 0; m <= n; m++) {
+        weight = h * I.gregory_weights(n, m);
+        element_conj<T, SIZE1>(size1, x + m * sc, btemp + m * sc);
+        for (l = 0; l < sc; l++)
+            x[m * sc + l] *= weight;
+    }
+    A.les().rmul_transpose(n, x, cles);
+    for (l = 0; l < (n + 1) * sc; l++)
+        x[l] = -x[l];
+    Acc.les().rmul_adjoint(n, x, cles);
+    // A^ret * B^les
+    B.les().get_row(n, x);
+    for (l = 0; l < (n + 1) * sc; l++)
+        x[l] *= h;
+    A.ret().rmul(n, x, cles);
+    for (j = 0; j <= n; j++) {
+        len = hodlr_gregory_corrections(j, I, lidx, corr);
+        for (l = 0; l < len; l++) {
+            m = lidx[l];
+            if (m <= j) {
+                A.ret().get(j, m, atemp);
+                weight = corr[l];
+            } else {
+                Acc.ret().get(m, j, acc);
+                element_conj<T, SIZE1>(size1, atemp, acc);
+                weight = -corr[l];
+            }
+            element_incr<T, SIZE1>(size1, cles + j * sc, weight, atemp, x + m * sc);
+        }
+    }
+    delete[] lidx;
+    delete[] corr;
+    delete[] btemp;
+    delete[] x;
+    delete[] atemp;
+    delete[] acc;
+}
+
+/// @private
+template <typename T, int SIZE1>
+void convolution_timestep_hodlr_dispatch(int n, herm_matrix_timestep<T> &C,
+                                         herm_matrix_hodlr<T> &A, herm_matrix_hodlr<T> &Acc,
+                                         herm_matrix_hodlr<T> &B, herm_matrix_hodlr<T> &Bcc,
+                                         integration::Integrator<T> &I, T beta, T h) {
+    typedef std::complex<T> cplx;
+    int sc = A.element_size(), l;
+    cplx *arow;
+
+    arow = new cplx[(n + 1) * sc];
+    A.ret().get_row(n, arow);
+    for (l = 0; l < (n + 1) * sc; l++)
+        arow[l] *= h;
+    convolution_timestep_hodlr_ret<T, SIZE1>(n, C.retptr(0), arow, B, Bcc, I);
+    convolution_timestep_hodlr_tv<T, SIZE1>(n, C.tvptr(0), arow, A, B, I, beta);
+    convolution_timestep_hodlr_les<T, SIZE1>(n, C.lesptr(0), A, Acc, B, Bcc, I, beta, h);
+    delete[] arow;
+}
+
+/** \brief <b> Convolution \f$ C = A*B \f$ of HODLR-compressed contour functions at a given time step. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes the contour convolution \f$ C = A*B \f$ at time step `n` (the Matsubara
+ * > component for `n=-1`), where \f$ A, B \f$ are stored in `herm_matrix_hodlr`.
+ * > The result is the same as `convolution_timestep` on the decompressed functions, up to
+ * > the compression tolerance. For `n > k`, the history integrals cost
+ * > \f$ O(r\, n \log n) \f$ instead of \f$ O(n^2) \f$. For `n <= k` the time steps
+ * > `-1...k` are decompressed and the dense `convolution_timestep` is used.
+ * > The time steps up to `max(n,k)` of all inputs must be set. `C` must be a timestep
+ * > of time `n` with the same size as the inputs.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param C
+ * > [herm_matrix_timestep] result
+ * @param A
+ * > [herm_matrix_hodlr] contour function
+ * @param Acc
+ * > [herm_matrix_hodlr] complex conjugate to A
+ * @param B
+ * > [herm_matrix_hodlr] contour function
+ * @param Bcc
+ * > [herm_matrix_hodlr] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step interval
+ */
+template <typename T>
+void convolution_timestep(int n, herm_matrix_timestep<T> &C, herm_matrix_hodlr<T> &A,
+                          herm_matrix_hodlr<T> &Acc, herm_matrix_hodlr<T> &B,
+                          herm_matrix_hodlr<T> &Bcc, integration::Integrator<T> &I, T beta,
+                          T h) {
+    int size1 = C.size1(), ntau = C.ntau(), k = I.get_k(), n1 = (n > k ? n : k), t;
+    assert(C.tstp() == n);
+    assert(A.size1() == size1 && Acc.size1() == size1);
+    assert(B.size1() == size1 && Bcc.size1() == size1);
+    assert(A.ntau() == ntau && Acc.ntau() == ntau && B.ntau() == ntau && Bcc.ntau() == ntau);
+    if (n <= k) {
+        herm_matrix<T> Ad(k, ntau, size1, A.sig()), Accd(k, ntau, size1, Acc.sig());
+        herm_matrix<T> Bd(k, ntau, size1, B.sig()), Bccd(k, ntau, size1, Bcc.sig());
+        herm_matrix<T> Cd(k, ntau, size1, C.sig());
+        for (t = -1; t <= (n == -1 ? -1 : k); t++) {
+            A.get_timestep(t, Ad);
+            Acc.get_timestep(t, Accd);
+            B.get_timestep(t, Bd);
+            Bcc.get_timestep(t, Bccd);
+        }
+        convolution_timestep(n, Cd, Ad, Accd, Bd, Bccd, I, beta, h);
+        Cd.get_timestep(n, C);
+        return;
+    }
+    assert(A.tstpmax() >= n1 && Acc.tstpmax() >= n1);
+    assert(B.tstpmax() >= n1 && Bcc.tstpmax() >= n1);
+    if (size1 == 1)
+        convolution_timestep_hodlr_dispatch<T, 1>(n, C, A, Acc, B, Bcc, I, beta, h);
+    else
+        convolution_timestep_hodlr_dispatch<T, LARGESIZE>(n, C, A, Acc, B, Bcc, I, beta, h);
+}
+
+/** \brief <b> Convolution \f$ C = A*B \f$ of HODLR-compressed contour functions at a given time step. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `convolution_timestep` for `herm_matrix_hodlr` with an `Integrator`,
+ * > for given integration order.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param C
+ * > [herm_matrix_timestep] result
+ * @param A
+ * > [herm_matrix_hodlr] contour function
+ * @param Acc
+ * > [herm_matrix_hodlr] complex conjugate to A
+ * @param B
+ * > [herm_matrix_hodlr] contour function
+ * @param Bcc
+ * > [herm_matrix_hodlr] complex conjugate to B
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step interval
+ * @param SolveOrder
+ * > [int] integration order
+ */
+template <typename T>
+void convolution_timestep(int n, herm_matrix_timestep<T> &C, herm_matrix_hodlr<T> &A,
+                          herm_matrix_hodlr<T> &Acc, herm_matrix_hodlr<T> &B,
+                          herm_matrix_hodlr<T> &Bcc, T beta, T h, int SolveOrder) {
+    convolution_timestep(n, C, A, Acc, B, Bcc, integration::I<T>(SolveOrder), beta, h);
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_HODLR_CONVOLUTION_IMPL_H
@@ -18,6 +18,12 @@
 #include "cntr_herm_matrix_impl.hpp"
 
 #include "cntr_herm_pseudo_impl.hpp"
+#include "cntr_herm_matrix_window_impl.hpp"
+#include "cntr_herm_matrix_hodlr_impl.hpp"
+#include "cntr_dlr_impl.hpp"
+#include "cntr_herm_matrix_tti_impl.hpp"
+
+#include "cntr_dyson_workspace_impl.hpp"
 
 #include "cntr_utilities_impl.hpp"
 #include "cntr_differentiation_impl.hpp"
@@ -30,6 +36,12 @@
 #include "cntr_pseudo_vie2_impl.hpp"
 #include "cntr_dyson_impl.hpp"
 #include "cntr_pseudodyson_impl.hpp"
+#include "cntr_window_solvers_impl.hpp"
+#include "cntr_hodlr_convolution_impl.hpp"
+#include "cntr_dlr_solvers_impl.hpp"
+#include "cntr_gkba_impl.hpp"
+#include "cntr_tti_solvers_impl.hpp"
+#include "cntr_herm_matrix_blocks_impl.hpp"
 
 #include "cntr_bubble_impl.hpp"
 #include "cntr_distributed_array_impl.hpp"
@@ -26,6 +26,8 @@ void set_first_order_tail(std::complex<T> *xmat, std::complex<T> *coeff, T beta,
 
 template <typename T, class GG, int SIZE1>
 void matsubara_dft(std::complex<T> *mdft, GG &G, int sig);
+template <typename T>
+void matsubara_idft(std::complex<T> *x, int ntau, int sig, int sg);
 template <typename T, class GG, int SIZE1>
 void matsubara_ft(std::complex<T> *result, int m, GG &G, std::complex<T> *mdft, int sig,
                   T beta, int order);
@@ -97,7 +97,7 @@ void set_first_order_tail(std::complex<T> *xmat, std::complex<T> *coeff, T beta,
 // ----------------------------------------------------------------------
 
 /*-------------------------------------------------------
-compute (WITHOUT FFT)
+compute (BY FFT)
 I=sum_{r=0}^m ftau[r] exp(i omega_n tau_r)
 for n=0...m
 tau_r=r*dtau,tau=beta/m
@@ -105,10 +105,12 @@ omega_n= (2n+1)pi/beta, (sgn=-1)
 omega_n= 2n*pi/beta,    (sgn=+1)
 
 I=sum_{r=0}^m ftau[r] exp(i pi (2n+1)r/m)
+ =sum_{r=0}^{m-1} ftau'[r] exp(i pi r/m) exp(2 pi i n r/m),
+ftau'[0]=ftau[0]+sgn*ftau[m], ftau'[r]=ftau[r] otherwise
 -------------------------------------------------------*/
 
 
-/** \brief <b> Computes the Fourier series coefficients of a Matsubara function by plain DFT. </b>
+/** \brief <b> Computes the Fourier series coefficients of a Matsubara function by FFT. </b>
 *
 * <!-- ====== DOCUMENTATION ====== -->
 *
@@ -118,6 +120,8 @@ I=sum_{r=0}^m ftau[r] exp(i pi (2n+1)r/m)
 * > Computes \f$ I = \sum_{r=0}^m f(\tau_r) e^{i \omega_n \tau_r}\f$ for \f$n=0,\dot,m\f$, assuming
 * > \f$\tau_r = r \beta/m\f$. The Matsubara frequencies are given by \f$\omega_n= (2n+1)\pi/\beta\f$ 
 * > for fermions, while \f$\omega_n= 2n*\pi/\beta\f$ for bosons.
+* > The sum is evaluated for all \f$n\f$ by one FFT of length \f$m\f$ (see `fourier::fft_cplx`),
+* > in \f$O(m\log m)\f$ operations.
 *
 *
 * <!-- ARGUMENTS
@@ -133,27 +137,74 @@ I=sum_{r=0}^m ftau[r] exp(i pi (2n+1)r/m)
 template <typename T, class GG, int SIZE1>
 void matsubara_dft(std::complex<T> *mdft, GG &G, int sig) {
     typedef std::complex<T> cplx;
-    int ntau, r, m, sg, size1 = G.size1();
+    int ntau, r, l, sg;
     double arg, one;
-    cplx *z, *z1, expfac;
+    cplx expfac, *gr;
     sg = G.element_size();
     ntau = G.ntau();
-    z = new cplx[sg];
-    z1 = new cplx[sg];
     one = (sig == -1 ? 1.0 : 0.0);
-    for (m = 0; m <= ntau; m++) {
-        element_set_zero<T, SIZE1>(size1, z);
-        for (r = 0; r <= ntau; r++) {
-            arg = ((2 * m + one) * r * PI) / ntau;
-            expfac = cplx(cos(arg), sin(arg));
-            element_set<T, SIZE1>(size1, z1, G.matptr(r));
-            element_smul<T, SIZE1>(size1, z1, expfac);
-            element_incr<T, SIZE1>(size1, z, z1);
+    // exp(i omega_n beta) = sig: fold tau=beta onto tau=0
+    for (l = 0; l < sg; l++)
+        mdft[l] = G.matptr(0)[l] + (1.0 * sig) * G.matptr(ntau)[l];
+    for (r = 1; r < ntau; r++) {
+        arg = (one * r * PI) / ntau;
+        expfac = cplx(cos(arg), sin(arg));
+        gr = G.matptr(r);
+        for (l = 0; l < sg; l++)
+            mdft[r * sg + l] = expfac * gr[l];
+    }
+    fourier::fft_cplx(ntau, sg, mdft, 1);
+    // n=ntau is equivalent to n=0
+    for (l = 0; l < sg; l++)
+        mdft[ntau * sg + l] = mdft[l];
+}
+
+/** \brief <b> Evaluates a Matsubara sum on the imaginary-time grid by FFT. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$ g(\tau_r) = \sum_n e^{-i \omega_n \tau_r} z_n\f$ for \f$\tau_r = r \beta/m\f$,
+* > \f$r=0,\dots,m\f$. On the grid, \f$e^{-i \omega_n \tau_r}\f$ depends on \f$n\f$ only
+* > modulo \f$m\f$, so the coefficients of all frequencies \f$n = n_0 + p\,m\f$ are summed into
+* > `x[n0*sg]` by the caller, \f$n_0=0,\dots,m-1\f$. The sum is then one FFT of length \f$m\f$,
+* > instead of \f$O(m)\f$ operations per frequency.
+*
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param x
+* > [complex] on input, the summed coefficients \f$z_{n_0}\f$, \f$n_0=0,\dots,m-1\f$;
+* > on return, \f$g(\tau_r)\f$, \f$r=0,\dots,m\f$ (`(m+1)*sg` elements)
+* @param ntau
+* > [int] number of points \f$m\f$ on Matsubara track
+* @param sig
+* > [int] `sig=-1` for fermions, `sig=+1` for bosons
+* @param sg
+* > [int] element size
+*/
+template <typename T>
+void matsubara_idft(std::complex<T> *x, int ntau, int sig, int sg) {
+    typedef std::complex<T> cplx;
+    int r, l;
+    double arg, one;
+    cplx expfac;
+    one = (sig == -1 ? 1.0 : 0.0);
+    fourier::fft_cplx(ntau, sg, x, -1);
+    if (sig == -1) {
+        for (r = 1; r < ntau; r++) {
+            arg = (one * r * PI) / ntau;
+            expfac = cplx(cos(arg), -sin(arg));
+            for (l = 0; l < sg; l++)
+                x[r * sg + l] *= expfac;
         }
-        element_set<T, SIZE1>(size1, mdft + m * sg, z);
     }
-    delete[] z;
-    delete[] z1;
+    // exp(-i omega_n beta) = sig
+    for (l = 0; l < sg; l++)
+        x[ntau * sg + l] = (1.0 * sig) * x[l];
 }
 
 /** \brief <b> Computes the Fourier series coefficients of a Matsubara 
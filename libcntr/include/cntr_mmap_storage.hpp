@@ -0,0 +1,39 @@
+#ifndef CNTR_MMAP_STORAGE_H
+#define CNTR_MMAP_STORAGE_H
+
+#include <cstddef>
+
+namespace cntr {
+
+/// @private
+/** \brief <b> Allocates `nbytes` of zero-initialized memory backed by a temporary file.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The file is created in `dir` (or, if `dir` is NULL, in `$CNTR_MMAP_DIR`, `$TMPDIR`
+ *  or `/tmp`), mapped shared into memory and removed from the file system immediately,
+ *  so it disappears when the mapping is released or the program ends.
+ *  Pages which have not been used recently can be written back to the file by the
+ *  operating system, which allows arrays larger than the physical memory.
+ *  Used by the `CNTR_STORAGE_MMAP` storage of `herm_matrix`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nbytes
+ * > Size of the array in bytes
+ * @param dir
+ * > Directory in which the backing file is created
+ */
+void *mmap_storage_allocate(std::size_t nbytes, const char *dir = NULL);
+
+/// @private
+/** \brief <b> Releases memory obtained from `mmap_storage_allocate`.</b> */
+void mmap_storage_release(void *ptr, std::size_t nbytes);
+
+}  // namespace cntr
+
+#endif  // CNTR_MMAP_STORAGE_H
@@ -0,0 +1,63 @@
+#ifndef CNTR_NUMA_STORAGE_H
+#define CNTR_NUMA_STORAGE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace cntr {
+
+/// @private
+/** \brief <b> Allocates `nbytes` of aligned memory which is not yet touched.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ *
+ * <!-- ========= -->
+ *
+ *  The memory is aligned to `CNTR_STORAGE_ALIGNMENT` bytes. With `hugepages`, it is
+ *  aligned to `CNTR_HUGEPAGE_SIZE` and the kernel is advised to back it by transparent
+ *  huge pages. No page is touched, so that the pages are placed on the NUMA node of the
+ *  thread which writes them first, see `numa_storage_first_touch`.
+ *  Used by the `CNTR_STORAGE_NUMA` storage of `herm_matrix`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nbytes
+ * > Size of the array in bytes
+ * @param hugepages
+ * > Request transparent huge pages
+ */
+void *numa_storage_allocate(std::size_t nbytes, bool hugepages);
+
+/// @private
+/** \brief <b> Sets the rows of an array to zero, distributed over the OpenMP threads.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Row `r` occupies the bytes `row[r]`,...,`row[r+1]-1`. With OpenMP (CNTR_USE_OMP), the
+ *  rows are zeroed by the threads in turn, row `r` by thread `r % nthreads`. The first
+ *  touch thus spreads the pages of each component over the NUMA nodes of the threads
+ *  which later work on its rows.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param ptr
+ * > The array
+ * @param row
+ * > Byte offsets of the rows and of the end of the array
+ */
+void numa_storage_first_touch(void *ptr, const std::vector<std::size_t> &row);
+
+/// @private
+/** \brief <b> Releases memory obtained from `numa_storage_allocate`.</b> */
+void numa_storage_release(void *ptr);
+
+}  // namespace cntr
+
+#endif  // CNTR_NUMA_STORAGE_H
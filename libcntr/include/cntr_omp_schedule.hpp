@@ -0,0 +1,143 @@
+#ifndef CNTR_OMP_SCHEDULE_H
+#define CNTR_OMP_SCHEDULE_H
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   Distribution of the work items (component, row) of one time step over OpenMP threads.
+#   The work for a row of the history integrals is proportional to its length, so a
+#   round-robin distribution of the rows leaves some threads with much more work than
+#   others. The items are instead assigned by a cost model, largest item first, to the
+#   thread with the smallest load.
+#
+########################################################################################*/
+
+/// @private
+/** \brief <b> Distributes weighted work items over threads.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  The items are taken in the order of decreasing cost and assigned to the thread
+ *  with the smallest accumulated cost (longest-processing-time rule). The largest
+ *  load is at most 4/3 of the optimum. On return, `owner[i]` is the thread of item `i`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param nthreads
+ * > number of threads
+ * @param cost
+ * > estimated cost of the items
+ * @param owner
+ * > [std::vector<int>] on return, the thread of each item
+ */
+inline void omp_balance_work(int nthreads, const std::vector<double> &cost,
+                             std::vector<int> &owner) {
+    typedef std::pair<double, int> load_t;
+    int nitems = cost.size(), i;
+    std::vector<std::pair<double, int> > items(nitems);
+    std::priority_queue<load_t, std::vector<load_t>, std::greater<load_t> > load;
+    owner.resize(nitems);
+    for (i = 0; i < nitems; i++)
+        items[i] = std::make_pair(-cost[i], i); // decreasing cost, then increasing index
+    std::sort(items.begin(), items.end());
+    for (i = 0; i < nthreads; i++)
+        load.push(load_t(0.0, i));
+    for (i = 0; i < nitems; i++) {
+        load_t l = load.top();
+        load.pop();
+        owner[items[i].second] = l.second;
+        l.first -= items[i].first;
+        load.push(l);
+    }
+}
+
+/// @private
+/** \brief <b> Cost model for the rows of a convolution at time step `tstp`.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Appends the number of element products in the rows of `incr_convolution_ret`
+ *  (rows 0 ... nret-1), `incr_convolution_tv` (rows 0 ... ntv-1) and
+ *  `incr_convolution_les` (rows 0 ... nles-1) to `cost`, in this order. `extra` is
+ *  added to every row, e.g., for a linear solve after the convolution.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param tstp
+ * > time step
+ * @param ntau
+ * > number of points on the Matsubara axis
+ * @param k
+ * > integration order
+ * @param nret
+ * > number of retarded rows
+ * @param ntv
+ * > number of left-mixing rows
+ * @param nles
+ * > number of lesser rows
+ * @param extra
+ * > cost added to each row
+ * @param cost
+ * > [std::vector<double>] costs of the rows
+ */
+inline void omp_convolution_cost(int tstp, int ntau, int k, int nret, int ntv, int nles,
+                                 double extra, std::vector<double> &cost) {
+    int n1 = (tstp > k ? tstp : k), i;
+    for (i = 0; i < nret; i++)
+        cost.push_back(extra + 1.0 + (tstp - i > k ? tstp - i : k));
+    for (i = 0; i < ntv; i++)
+        cost.push_back(extra + 2.0 + ntau + n1);
+    for (i = 0; i < nles; i++)
+        cost.push_back(extra + 3.0 + (i > k ? i : k) + ntau + n1);
+}
+
+/// @private
+/** \brief <b> Mask of the items `first ... first+len-1` owned by a thread.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Sets `mask[i] = (owner[first+i] == tid)` for `i < len`. The entries `i >= len` are
+ *  false, so that `mask` can be longer than the number of items.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param owner
+ * > thread of each item, see `omp_balance_work`
+ * @param first
+ * > first item
+ * @param len
+ * > number of items
+ * @param tid
+ * > thread
+ * @param mask
+ * > [std::vector<bool>] on return, the mask of the thread
+ */
+inline void omp_owner_mask(const std::vector<int> &owner, int first, int len, int tid,
+                           std::vector<bool> &mask) {
+    int i;
+    for (i = 0; i < (int)mask.size(); i++)
+        mask[i] = (i < len && owner[first + i] == tid);
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_OMP_SCHEDULE_H
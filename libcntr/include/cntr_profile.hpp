@@ -0,0 +1,127 @@
+#ifndef CNTR_PROFILE_H
+#define CNTR_PROFILE_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include "cntr_global_settings.hpp"
+
+/* #######################################################################################
+#
+#   Timers and counters for the libcntr kernels.
+#
+#   With the CMake option CNTR_PROFILE (which defines CNTR_USE_PROFILE), the main kernels
+#   (convolution_timestep, dyson_timestep, vie2_timestep, Bubble1/2, extrapolate_timestep,
+#   mpi_bcast_all and the HDF5 writers) open a profile_scope via CNTR_PROFILE_SCOPE. Each
+#   scope records the number of calls, the wall time and estimated flops and bytes, in
+#   total and per time step. Scopes nested on the same thread are recorded under the path
+#   "outer/inner". Without CNTR_USE_PROFILE, CNTR_PROFILE_SCOPE expands to nothing and its
+#   arguments are not evaluated.
+#
+########################################################################################*/
+
+#ifdef CNTR_USE_PROFILE
+#define CNTR_PROFILE_SCOPE(name, tstp, flops, bytes)                                       \
+    cntr::profile_scope cntr_profile_scope_(name, tstp, flops, bytes)
+#else
+#define CNTR_PROFILE_SCOPE(name, tstp, flops, bytes)
+#endif
+
+namespace cntr {
+
+/// @private
+/** \brief <b> Counters of one kernel, in total or at one time step.</b> */
+struct profile_entry {
+    /** \brief <b> Number of calls.</b> */
+    long calls;
+    /** \brief <b> Wall time in seconds, summed over threads and ranks.</b> */
+    double time;
+    /** \brief <b> Largest wall time of a single rank.</b> */
+    double time_max;
+    /** \brief <b> Estimated floating point operations.</b> */
+    double flops;
+    /** \brief <b> Estimated bytes read and written.</b> */
+    double bytes;
+};
+
+/// @private
+/** \brief <b> Records the time spent between its construction and destruction.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ *  Usually created by `CNTR_PROFILE_SCOPE` at the top of a kernel. The record is added to
+ *  the kernel `name`, prefixed by the names of the scopes which are open on the same
+ *  thread. The records of all threads are collected in one report; threads started
+ *  inside a scope begin a new path.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param name
+ * > Name of the kernel (a string literal)
+ * @param tstp
+ * > Time step, or `CNTR_PROFILE_NO_TSTP`
+ * @param flops
+ * > Estimated floating point operations of the call
+ * @param bytes
+ * > Estimated bytes moved by the call
+ */
+class profile_scope {
+  public:
+    profile_scope(const char *name, int tstp, double flops, double bytes);
+    ~profile_scope();
+
+  private:
+    profile_scope(const profile_scope &);
+    profile_scope &operator=(const profile_scope &);
+    std::size_t parent_length_;
+    int tstp_;
+    double flops_;
+    double bytes_;
+    double start_;
+};
+
+double profile_wtime(void);
+void profile_record(const std::string &name, int tstp, double time, double flops,
+                    double bytes);
+void profile_reset(void);
+profile_entry profile_get(const std::string &name, int tstp = CNTR_PROFILE_NO_TSTP);
+void profile_write_json(std::ostream &os);
+void profile_write_json(const char *filename);
+#ifdef CNTR_USE_HDF5
+void profile_write_to_hdf5(hid_t group_id);
+void profile_write_to_hdf5(hid_t group_id, const char *groupname);
+#endif
+#ifdef CNTR_USE_MPI
+void profile_mpi_reduce(void);
+#endif
+
+/// @private
+/** \brief <b> Number of matrix elements of one time step of a `herm_matrix`.</b> */
+inline double profile_timestep_elements(int tstp, int ntau, int size) {
+    return (double)size * size * (tstp == -1 ? ntau + 1 : 2 * (tstp + 1) + ntau + 1);
+}
+/// @private
+/** \brief <b> Number of matrix elements of a `herm_matrix` up to time step `tstp`.</b> */
+inline double profile_history_elements(int tstp, int ntau, int size) {
+    return (double)size * size *
+           ((double)(tstp + 1) * (tstp + 2) + (double)(tstp + 1) * (ntau + 1) + ntau + 1);
+}
+/// @private
+/** \brief <b> Estimated flops of a convolution (or a Dyson/VIE step) at time step `tstp`.</b>
+ *
+ *  One complex matrix product costs `8 size^3` flops. The retarded component needs
+ *  \f$ (n+1)(n+2)/2 \f$ products, the left-mixing and lesser components about
+ *  \f$ (n + n_\tau + 2)^2 \f$.
+ */
+inline double profile_convolution_flops(int tstp, int ntau, int size) {
+    double m = tstp + ntau + 2;
+    return 8.0 * size * size * size * ((double)(tstp + 1) * (tstp + 2) / 2 + m * m);
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_PROFILE_H
@@ -0,0 +1,55 @@
+#ifndef CNTR_TTI_SOLVERS_DECL_H
+#define CNTR_TTI_SOLVERS_DECL_H
+
+#include "cntr_global_settings.hpp"
+#include "integration.hpp"
+
+namespace cntr {
+
+  template <typename T> class herm_matrix_tti;
+
+/*###########################################################################################
+#
+#   CONVOLUTIONS AND SOLVERS FOR TIME-TRANSLATION INVARIANT FUNCTIONS
+#
+#   The real-time integrals of herm_matrix_tti are convolutions in the time difference,
+#   which are evaluated by FFT with the Gregory weights of the Integrator applied as
+#   endpoint corrections, in O(nt log nt) instead of O(nt^2) operations. The lesser
+#   component is that of a steady state, i.e. the integrals run over the past of the window
+#   [-nt h, nt h] instead of the Matsubara branch.
+#
+###########################################################################################*/
+
+  template <typename T>
+  void green_from_H_tti(herm_matrix_tti<T> &G, T mu, cdmatrix &H0, T beta, T h);
+  template <typename T, class dos_function>
+  void green_equilibrium_tti(herm_matrix_tti<T> &G, dos_function &dos, double beta,
+    double h, double mu=0.0, int limit = 100, int nn = 20);
+
+  /// @private
+  template <typename T>
+  void convolution_tti_ret(int n, int size1, std::complex<T> *c, std::complex<T> *a,
+    std::complex<T> *b, integration::Integrator<T> &I, T h);
+  /// @private
+  template <typename T>
+  void convolution_tti_les_ret(int n, int size1, std::complex<T> *c, std::complex<T> *aret,
+    std::complex<T> *bles, integration::Integrator<T> &I, T h);
+  /// @private
+  template <typename T>
+  void convolution_tti_les_adv(int n, int size1, std::complex<T> *c, std::complex<T> *ales,
+    std::complex<T> *bret, integration::Integrator<T> &I, T h);
+  template <typename T>
+  void convolution_tti(herm_matrix_tti<T> &C, herm_matrix_tti<T> &A, herm_matrix_tti<T> &B,
+    T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+
+  /// @private
+  template <typename T>
+  void dyson_tti_ret(int n, int size1, std::complex<T> *g, std::complex<T> *g0,
+    std::complex<T> *q, integration::Integrator<T> &I, T h);
+  template <typename T>
+  void dyson_tti(herm_matrix_tti<T> &G, T mu, cdmatrix &H0, herm_matrix_tti<T> &Sigma,
+    T h, int SolveOrder=MAX_SOLVE_ORDER);
+
+}  // namespace cntr
+
+#endif  // CNTR_TTI_SOLVERS_DECL_H
@@ -0,0 +1,689 @@
+#ifndef CNTR_TTI_SOLVERS_IMPL_H
+#define CNTR_TTI_SOLVERS_IMPL_H
+
+#include "cntr_tti_solvers_decl.hpp"
+#include "fourier.hpp"
+#include "cntr_elements.hpp"
+#include "cntr_herm_matrix_tti_impl.hpp"
+#include "cntr_convolution_impl.hpp"
+#include "cntr_equilibrium_impl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#   FREE PROPAGATORS
+#
+########################################################################################*/
+
+/** \brief <b> Time-translation invariant propagator of a constant Hamiltonian. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Same as `green_from_H` for a constant Hamiltonian \f$H_0\f$, for the retarded, lesser and
+* > Matsubara components of a `herm_matrix_tti`:
+* > \f$G^\mathrm{R}(l) = -i U^l\f$ and \f$G^<(l) = G^<(0) (U^l)^\dagger\f$ with
+* > \f$U = e^{i(\mu-H_0)h}\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param G
+* > [herm_matrix_tti] the Green's function
+* @param mu
+* > [T] chemical potential
+* @param H0
+* > [cdmatrix] Hamiltonian
+* @param beta
+* > [T] inverse temperature
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void green_from_H_tti(herm_matrix_tti<T> &G, T mu, cdmatrix &H0, T beta, T h) {
+    std::complex<T> iu = std::complex<T>(0.0, 1.0);
+    int nt = G.nt(), ntau = G.ntau(), size = G.size1(), sign = G.sig(), l, m;
+    double tau, dtau = beta / ntau;
+    cdmatrix idm(size, size), Hmu(size, size), Udt(size, size), Ul(size, size);
+    cdmatrix evec0(size, size), value(size, size), gles0(size, size);
+    dvector eval0(size), eval0m(size);
+
+    assert(H0.rows() == size && H0.cols() == size);
+    idm = MatrixXcd::Identity(size, size);
+    Hmu = -H0 + mu * idm;
+    Eigen::SelfAdjointEigenSolver<cdmatrix> eigensolver(Hmu);
+    evec0 = eigensolver.eigenvectors();
+    eval0 = eigensolver.eigenvalues();
+    eval0m = (-1.0) * eval0;
+
+    for (m = 0; m <= ntau; m++) {
+        tau = m * dtau;
+        if (sign == -1) {
+            value = (-1.0) * evec0 * fermi_exp(beta, tau, eval0).asDiagonal() * evec0.adjoint();
+        } else {
+            value = (1.0) * evec0 * bose_exp(beta, tau, eval0).asDiagonal() * evec0.adjoint();
+        }
+        G.set_mat(m, value);
+    }
+    if (nt < 0)
+        return;
+
+    if (sign == -1) {
+        gles0 = iu * evec0 * fermi(beta, eval0m).asDiagonal() * evec0.adjoint();
+    } else {
+        gles0 = -iu * evec0 * bose(beta, eval0m).asDiagonal() * evec0.adjoint();
+    }
+    Udt = (iu * h * Hmu).exp();
+    Ul = idm;
+    for (l = 0; l <= nt; l++) {
+        value = -iu * Ul;
+        G.set_ret(l, value);
+        value = gles0 * Ul.adjoint();
+        G.set_les(l, value);
+        Ul = Ul * Udt;
+    }
+}
+
+/** \brief <b> Time-translation invariant equilibrium propagator for a density of states. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Same as `green_equilibrium_spectral`, for the retarded, lesser and Matsubara components
+* > of a `herm_matrix_tti`. The density of states is sampled once on an adaptive frequency
+* > grid, and each time difference is evaluated once, so that the cost is \f$O(n_t)\f$
+* > instead of \f$O(n_t^2)\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param G
+* > [herm_matrix_tti] the Green's function
+* @param dos
+* > density of states
+* @param beta
+* > inverse temperature
+* @param h
+* > timestep
+* @param mu
+* > chemical potential
+* @param limit
+* > max number of intervals in Fourier transform (default: 100)
+* @param nn
+* > number of points in each interval of the Fourier transform (default: 20)
+*/
+template <typename T, class dos_function>
+void green_equilibrium_tti(herm_matrix_tti<T> &G, dos_function &dos, double beta, double h,
+                           double mu, int limit, int nn) {
+    typedef std::complex<double> cplx;
+    int nt = G.nt(), ntau = G.ntau(), size1 = G.size1(), sign = G.sig(), nw, n, k;
+    cplx cplx_i = cplx(0, 1);
+    dos_spectral_grid grid;
+    herm_matrix<T> Gmat(-1, ntau, size1, sign);
+
+    grid.init(dos, beta, sign, mu, limit, nn);
+    nw = grid.nw_;
+    green_equilibrium_mat_grid(Gmat, grid, beta, mu);
+    G.set_from_herm_matrix(-1, Gmat);
+    if (nt < 0)
+        return;
+    // Ct(k,n) = c_k(-n*h)
+    cdmatrix Ct(nw, nt + 1);
+    cdvector gret(nt + 1), gles(nt + 1), Ales(nw);
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for
+#endif
+    for (n = 0; n <= nt; n++)
+        grid.weights(-n * h, Ct.data() + (size_t)n * nw);
+    for (k = 0; k < nw; k++)
+        Ales(k) = grid.dos_[k] * dos_kernel(les, beta, 0.0, grid.omega_[k] - mu, sign);
+    gret = -cplx_i * (Ct.transpose() * Eigen::Map<dvector>(grid.dos_.data(), nw).cast<cplx>());
+    gles = -cplx_i * (Ct.adjoint() * Ales);
+    for (n = 0; n <= nt; n++) {
+        element_set<T, LARGESIZE>(size1, G.retptr(n), (std::complex<T>)(gret(n)));
+        element_set<T, LARGESIZE>(size1, G.lesptr(n), (std::complex<T>)(gles(n)));
+    }
+}
+
+/* #######################################################################################
+#
+#   CONVOLUTIONS
+#
+########################################################################################*/
+
+/// @private
+/** \brief <b> Linear convolution \f$c_l = \sum_i a_i b_{l-i}\f$, \f$0 \le l < n_c\f$, of sequences of
+ * matrices by FFT; \f$a_i\f$ (\f$b_i\f$) vanishes outside \f$0 \le i < n_a\f$ (\f$n_b\f$). </b> */
+template <typename T>
+void convolution_tti_fft(int size1, int na, std::complex<T> *a, int nb, std::complex<T> *b,
+                         int nc, std::complex<T> *c) {
+    typedef std::complex<T> cplx;
+    int es = size1 * size1, nfft, i, l;
+    cplx *afft, *bfft, *cfft;
+
+    nfft = 1;
+    while (nfft < na + nb - 1 || nfft < nc)
+        nfft *= 2;
+    afft = new cplx[nfft * es];
+    bfft = new cplx[nfft * es];
+    cfft = new cplx[nfft * es];
+    memset(afft, 0, sizeof(cplx) * nfft * es);
+    memset(bfft, 0, sizeof(cplx) * nfft * es);
+    memcpy(afft, a, sizeof(cplx) * na * es);
+    memcpy(bfft, b, sizeof(cplx) * nb * es);
+    fourier::fft_cplx(nfft, es, afft, -1);
+    fourier::fft_cplx(nfft, es, bfft, -1);
+    for (i = 0; i < nfft; i++)
+        element_mult<T, LARGESIZE>(size1, cfft + i * es, afft + i * es, bfft + i * es);
+    fourier::fft_cplx(nfft, es, cfft, 1);
+    for (l = 0; l < nc * es; l++)
+        c[l] = cfft[l] / (1.0 * nfft);
+    delete[] afft;
+    delete[] bfft;
+    delete[] cfft;
+}
+
+/// @private
+/** \brief <b> Retarded convolution of time-translation invariant functions. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$c_l = h\sum_{i=0}^{\max(l,k)} w_{l,i}\, a_i b_{l-i}\f$, \f$l=0,\dots,n\f$, with the
+* > Gregory weights \f$w_{l,i}\f$ and \f$b_{-p} = -b_p^\dagger\f$, i.e. the same quadrature as
+* > `convolution_timestep_ret`. For \f$l \ge 2k+2\f$, the sum with unit weights is done by FFT
+* > and corrected at the \f$k+1\f$ points next to either boundary. \f$c\f$ may coincide with
+* > \f$a\f$ or \f$b\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] maximum time difference, \f$n \ge k\f$
+* @param size1
+* > [int] matrix rank
+* @param c
+* > [complex] result, \f$n+1\f$ elements
+* @param a
+* > [complex] \f$a^\mathrm{R}(l)\f$, \f$n+1\f$ elements
+* @param b
+* > [complex] \f$b^\mathrm{R}(l)\f$, \f$n+1\f$ elements
+* @param I
+* > [Integrator] integrator class
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void convolution_tti_ret(int n, int size1, std::complex<T> *c, std::complex<T> *a,
+                         std::complex<T> *b, integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), k2 = 2 * (k + 1), es = size1 * size1, i, l;
+    cplx *result, *btemp, *cl;
+    T weight;
+
+    assert(n >= k);
+    result = new cplx[(n + 1) * es];
+    btemp = new cplx[es];
+    if (n >= k2)
+        convolution_tti_fft(size1, n + 1, a, n + 1, b, n + 1, result);
+    for (l = 0; l <= n; l++) {
+        cl = result + l * es;
+        if (l < k2) {
+            element_set_zero<T, LARGESIZE>(size1, cl);
+            for (i = 0; i <= (l > k ? l : k); i++) {
+                weight = I.gregory_weights(l, i);
+                if (i <= l) {
+                    element_incr<T, LARGESIZE>(size1, cl, weight, a + i * es, b + (l - i) * es);
+                } else {
+                    element_conj<T, LARGESIZE>(size1, btemp, b + (i - l) * es);
+                    element_incr<T, LARGESIZE>(size1, cl, -weight, a + i * es, btemp);
+                }
+            }
+        } else {
+            for (i = 0; i <= k; i++) {
+                weight = I.gregory_omega(i) - 1.0;
+                element_incr<T, LARGESIZE>(size1, cl, weight, a + i * es, b + (l - i) * es);
+                element_incr<T, LARGESIZE>(size1, cl, weight, a + (l - i) * es, b + i * es);
+            }
+        }
+        element_smul<T, LARGESIZE>(size1, cl, h);
+    }
+    memcpy(c, result, sizeof(cplx) * (n + 1) * es);
+    delete[] result;
+    delete[] btemp;
+}
+
+/// @private
+/** \brief <b> Weight of point \f$j\f$ for \f$\int_0^{mh}\f$ in the steady-state lesser convolution. </b>
+ *
+ * The Gregory weights for \f$m \ge k\f$, the trapezoidal rule for the short intervals
+ * \f$m < k\f$ at the end of the window, where the Gregory weights would need points
+ * outside of the window. */
+template <typename T>
+T convolution_tti_weight(int m, int j, integration::Integrator<T> &I) {
+    if (m >= I.get_k())
+        return I.gregory_weights(m, j);
+    else if (m == 0)
+        return 0.0;
+    else
+        return (j == 0 || j == m ? 0.5 : 1.0);
+}
+
+/// @private
+/** \brief <b> Steady-state lesser convolution, retarded-lesser part. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$[a^\mathrm{R} * b^<](0,lh) = \int_0^{(n-l)h} ds\, a^\mathrm{R}(s)\, b^<(l h+s)\f$,
+* > where the integral over the infinite past is truncated at the beginning of the window.
+* > The correlation with unit weights is done by FFT.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] maximum time difference, \f$n \ge k\f$
+* @param size1
+* > [int] matrix rank
+* @param c
+* > [complex] result, \f$n+1\f$ elements
+* @param aret
+* > [complex] \f$a^\mathrm{R}(l)\f$, \f$n+1\f$ elements
+* @param bles
+* > [complex] \f$b^<(0,lh)\f$, \f$n+1\f$ elements
+* @param I
+* > [Integrator] integrator class
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void convolution_tti_les_ret(int n, int size1, std::complex<T> *c, std::complex<T> *aret,
+                             std::complex<T> *bles, integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), k2 = 2 * (k + 1), es = size1 * size1, j, l, m;
+    cplx *result, *arev, *cl;
+    T weight;
+
+    assert(n >= k);
+    result = new cplx[(2 * n + 1) * es];
+    if (n >= k2) {
+        // sum_j a_j b_{l+j} = (arev*b)_{n+l} with arev_m = a_{n-m}
+        arev = new cplx[(n + 1) * es];
+        for (m = 0; m <= n; m++)
+            element_set<T, LARGESIZE>(size1, arev + m * es, aret + (n - m) * es);
+        convolution_tti_fft(size1, n + 1, arev, n + 1, bles, 2 * n + 1, result);
+        delete[] arev;
+    }
+    for (l = 0; l <= n; l++) {
+        m = n - l;
+        cl = result + (n + l) * es;
+        if (m < k2) {
+            element_set_zero<T, LARGESIZE>(size1, cl);
+            for (j = 0; j <= m; j++) {
+                weight = convolution_tti_weight(m, j, I);
+                element_incr<T, LARGESIZE>(size1, cl, weight, aret + j * es, bles + (l + j) * es);
+            }
+        } else {
+            for (j = 0; j <= k; j++) {
+                weight = I.gregory_omega(j) - 1.0;
+                element_incr<T, LARGESIZE>(size1, cl, weight, aret + j * es, bles + (l + j) * es);
+                element_incr<T, LARGESIZE>(size1, cl, weight, aret + (m - j) * es, bles + (n - j) * es);
+            }
+        }
+        element_smul<T, LARGESIZE>(size1, cl, h);
+    }
+    memcpy(c, result + n * es, sizeof(cplx) * (n + 1) * es);
+    delete[] result;
+}
+
+/// @private
+/** \brief <b> Steady-state lesser convolution, lesser-advanced part. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes \f$[a^< * b^\mathrm{A}](0,lh) = \int_0^{nh} ds\, a^<(lh-s)\, b^\mathrm{R}(s)^\dagger\f$,
+* > with \f$a^<(-p) = -a^<(p)^\dagger\f$, where the integral over the infinite past is
+* > truncated at the beginning of the window. The convolution with unit weights is done by FFT.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] maximum time difference, \f$n \ge k\f$
+* @param size1
+* > [int] matrix rank
+* @param c
+* > [complex] result, \f$n+1\f$ elements
+* @param ales
+* > [complex] \f$a^<(0,lh)\f$, \f$n+1\f$ elements
+* @param bret
+* > [complex] \f$b^\mathrm{R}(l)\f$, \f$n+1\f$ elements
+* @param I
+* > [Integrator] integrator class
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void convolution_tti_les_adv(int n, int size1, std::complex<T> *c, std::complex<T> *ales,
+                             std::complex<T> *bret, integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), k2 = 2 * (k + 1), es = size1 * size1, j, l, m;
+    cplx *result, *aext, *badv, *cl;
+    T weight;
+
+    assert(n >= k);
+    result = new cplx[(2 * n + 1) * es];
+    // aext_m = a^<(m-n), m=0..2n
+    aext = new cplx[(2 * n + 1) * es];
+    badv = new cplx[(n + 1) * es];
+    for (m = 0; m <= n; m++) {
+        element_set<T, LARGESIZE>(size1, aext + (n + m) * es, ales + m * es);
+        element_minusconj<T, LARGESIZE>(size1, aext + (n - m) * es, ales + m * es);
+        element_conj<T, LARGESIZE>(size1, badv + m * es, bret + m * es);
+    }
+    if (n >= k2)
+        convolution_tti_fft(size1, 2 * n + 1, aext, n + 1, badv, 2 * n + 1, result);
+    for (l = 0; l <= n; l++) {
+        cl = result + (n + l) * es;
+        if (n < k2) {
+            element_set_zero<T, LARGESIZE>(size1, cl);
+            for (j = 0; j <= n; j++) {
+                weight = I.gregory_weights(n, j);
+                element_incr<T, LARGESIZE>(size1, cl, weight, aext + (n + l - j) * es, badv + j * es);
+            }
+        } else {
+            for (j = 0; j <= k; j++) {
+                weight = I.gregory_omega(j) - 1.0;
+                element_incr<T, LARGESIZE>(size1, cl, weight, aext + (n + l - j) * es, badv + j * es);
+                element_incr<T, LARGESIZE>(size1, cl, weight, aext + (l + j) * es, badv + (n - j) * es);
+            }
+        }
+        element_smul<T, LARGESIZE>(size1, cl, h);
+    }
+    memcpy(c, result + n * es, sizeof(cplx) * (n + 1) * es);
+    delete[] result;
+    delete[] aext;
+    delete[] badv;
+}
+
+/** \brief <b> Convolution \f$C = A*B\f$ of time-translation invariant functions. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Computes the retarded, lesser and Matsubara components of \f$C=A*B\f$ by FFT.
+* > The retarded and Matsubara components use the same quadrature as `convolution`.
+* > The lesser component is that of a steady state,
+* > \f$C^< = A^\mathrm{R}*B^< + A^<*B^\mathrm{A}\f$, where the integrals over the past are
+* > truncated at the beginning of the window \f$[-n_t h, n_t h]\f$; this requires that the
+* > functions have decayed within the window, and the error grows towards \f$l = n_t\f$.
+* > The cost is \f$O(n_t \log n_t)\f$.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param C
+* > [herm_matrix_tti] result
+* @param A
+* > [herm_matrix_tti] first factor
+* @param B
+* > [herm_matrix_tti] second factor
+* @param beta
+* > [T] inverse temperature
+* @param h
+* > [T] time step interval
+* @param SolveOrder
+* > [int] integration order
+*/
+template <typename T>
+void convolution_tti(herm_matrix_tti<T> &C, herm_matrix_tti<T> &A, herm_matrix_tti<T> &B,
+                     T beta, T h, int SolveOrder) {
+    typedef std::complex<T> cplx;
+    int nt = C.nt(), size1 = C.size1(), es = C.element_size(), l;
+    integration::Integrator<T> &I = integration::I<T>(SolveOrder);
+    cplx *cles;
+
+    assert(A.size1() == size1 && B.size1() == size1);
+    assert(A.nt() == nt && B.nt() == nt);
+    assert(A.ntau() == C.ntau() && B.ntau() == C.ntau());
+    assert(nt == -1 || nt >= SolveOrder);
+    convolution_matsubara(C, A, B, I, beta);
+    if (nt < 0)
+        return;
+    cles = new cplx[(nt + 1) * es];
+    convolution_tti_les_adv(nt, size1, cles, A.lesptr(0), B.retptr(0), I, h);
+    convolution_tti_les_ret(nt, size1, C.lesptr(0), A.retptr(0), B.lesptr(0), I, h);
+    for (l = 0; l < (nt + 1) * es; l++)
+        C.lesptr(0)[l] += cles[l];
+    convolution_tti_ret(nt, size1, C.retptr(0), A.retptr(0), B.retptr(0), I, h);
+    delete[] cles;
+}
+
+/* #######################################################################################
+#
+#   DYSON EQUATION
+#
+########################################################################################*/
+
+/// @private
+/** \brief <b> Block size below which `dyson_tti_ret` sums the history directly. </b> */
+#define CNTR_TTI_DIRECT_BLOCK 32
+
+/// @private
+/** \brief <b> Recursive step of `dyson_tti_ret` for \f$lo \le l < hi\f$. </b>
+ *
+ * On entry, \f$s_l\f$ contains \f$\sum_{j<lo} q_{l-j} g_j\f$ for \f$lo \le l < hi\f$.
+ * The first half is solved, its contribution to the second half is added by one FFT,
+ * and the second half is solved, so that the total cost is \f$O(n\log^2 n)\f$. */
+template <typename T>
+void dyson_tti_ret_block(int lo, int hi, int size1, std::complex<T> *g, std::complex<T> *g0,
+                         std::complex<T> *q, std::complex<T> *s, integration::Integrator<T> &I,
+                         T h) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), es = size1 * size1, i, j, l, mid;
+    cplx *sl, *tmp;
+    T weight;
+
+    if (hi - lo <= CNTR_TTI_DIRECT_BLOCK) {
+        for (l = lo; l < hi; l++) {
+            sl = s + l * es;
+            for (j = lo; j < l; j++)
+                element_incr<T, LARGESIZE>(size1, sl, q + (l - j) * es, g + j * es);
+            // Gregory corrections at both ends of [0,l]
+            for (i = 1; i <= k; i++) {
+                weight = I.gregory_omega(i) - 1.0;
+                element_incr<T, LARGESIZE>(size1, sl, weight, q + i * es, g + (l - i) * es);
+            }
+            for (j = 0; j <= k; j++) {
+                weight = I.gregory_omega(j) - 1.0;
+                element_incr<T, LARGESIZE>(size1, sl, weight, q + (l - j) * es, g + j * es);
+            }
+            element_set<T, LARGESIZE>(size1, g + l * es, g0 + l * es);
+            element_incr<T, LARGESIZE>(size1, g + l * es, h, sl);
+        }
+        return;
+    }
+    mid = (lo + hi) / 2;
+    dyson_tti_ret_block(lo, mid, size1, g, g0, q, s, I, h);
+    tmp = new cplx[(hi - lo) * es];
+    convolution_tti_fft(size1, hi - lo, q, mid - lo, g + lo * es, hi - lo, tmp);
+    for (l = mid; l < hi; l++)
+        element_incr<T, LARGESIZE>(size1, s + l * es, tmp + (l - lo) * es);
+    delete[] tmp;
+    dyson_tti_ret_block(mid, hi, size1, g, g0, q, s, I, h);
+}
+
+/// @private
+/** \brief <b> Solves \f$g = g_0 + q*g\f$ for retarded time-translation invariant functions. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Solves \f$g_l = g_{0,l} + h\sum_{i=0}^{\max(l,k)} w_{l,i}\, q_i g_{l-i}\f$ with the quadrature
+* > of `convolution_tti_ret`, for a kernel with \f$q_0=0\f$ (such as \f$q = g_0*\Sigma\f$).
+* > The first \f$k+1\f$ points are coupled through \f$g_{-p}=-g_p^\dagger\f$ and are solved by
+* > iteration, the next \f$k+1\f$ points directly, and the remaining ones with the history
+* > sums done by FFT in \f$O(n\log^2 n)\f$ operations.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] maximum time difference, \f$n \ge k\f$
+* @param size1
+* > [int] matrix rank
+* @param g
+* > [complex] solution, \f$n+1\f$ elements
+* @param g0
+* > [complex] \f$g_0\f$, \f$n+1\f$ elements
+* @param q
+* > [complex] kernel, \f$n+1\f$ elements
+* @param I
+* > [Integrator] integrator class
+* @param h
+* > [T] time step interval
+*/
+template <typename T>
+void dyson_tti_ret(int n, int size1, std::complex<T> *g, std::complex<T> *g0,
+                   std::complex<T> *q, integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    const int maxiter = 100;
+    const T tol = 1e-15;
+    int k = I.get_k(), k2 = 2 * (k + 1), es = size1 * size1, i, l, iter, n1;
+    cplx *gl, *gtemp, *s;
+    T weight, err, norm;
+
+    assert(n >= k);
+    gl = new cplx[es];
+    gtemp = new cplx[es];
+    // l = 0..k: fixed point iteration
+    memcpy(g, g0, sizeof(cplx) * (k + 1) * es);
+    for (iter = 0; iter < maxiter; iter++) {
+        err = 0.0;
+        norm = 0.0;
+        for (l = 0; l <= k; l++) {
+            element_set<T, LARGESIZE>(size1, gl, g0 + l * es);
+            for (i = 1; i <= k; i++) {
+                weight = h * I.gregory_weights(l, i);
+                if (i <= l) {
+                    element_incr<T, LARGESIZE>(size1, gl, weight, q + i * es, g + (l - i) * es);
+                } else {
+                    element_conj<T, LARGESIZE>(size1, gtemp, g + (i - l) * es);
+                    element_incr<T, LARGESIZE>(size1, gl, -weight, q + i * es, gtemp);
+                }
+            }
+            for (i = 0; i < es; i++) {
+                err += std::abs(gl[i] - g[l * es + i]);
+                norm += std::abs(gl[i]);
+            }
+            element_set<T, LARGESIZE>(size1, g + l * es, gl);
+        }
+        if (err <= tol * norm)
+            break;
+    }
+    // l = k+1..2k+1: direct
+    n1 = (n < k2 - 1 ? n : k2 - 1);
+    for (l = k + 1; l <= n1; l++) {
+        element_set<T, LARGESIZE>(size1, g + l * es, g0 + l * es);
+        for (i = 1; i <= l; i++) {
+            weight = h * I.gregory_weights(l, i);
+            element_incr<T, LARGESIZE>(size1, g + l * es, weight, q + i * es, g + (l - i) * es);
+        }
+    }
+    // l >= 2k+2: history sums by FFT
+    if (n >= k2) {
+        s = new cplx[(n + 1) * es];
+        convolution_tti_fft(size1, n + 1, q, k2, g, n + 1, s);
+        dyson_tti_ret_block(k2, n + 1, size1, g, g0, q, s, I, h);
+        delete[] s;
+    }
+    delete[] gl;
+    delete[] gtemp;
+}
+
+/** \brief <b> Dyson equation for time-translation invariant functions. </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*  \par Purpose
+* <!-- ========= -->
+*
+* > Solves \f$[i\partial_t + \mu - H_0 - \Sigma]*G = \delta\f$ for the retarded and lesser
+* > components of a `herm_matrix_tti` with a constant Hamiltonian \f$H_0\f$. The retarded
+* > component is obtained from the integral form \f$G = G_0 + (G_0*\Sigma)*G\f$ with
+* > \f$G_0^\mathrm{R}(t) = -ie^{i(\mu-H_0)t}\f$, where all history sums are done by FFT
+* > (\f$O(n_t\log^2 n_t)\f$). The lesser component is that of a steady state,
+* > \f$G^< = G^\mathrm{R}*\Sigma^<*G^\mathrm{A}\f$ (see `convolution_tti`), which requires that
+* > \f$G^\mathrm{R}\f$ and \f$\Sigma\f$ decay within the window. The Matsubara component is not
+* > changed; it is obtained with `dyson_mat` and `herm_matrix_tti::set_from_herm_matrix`.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param G
+* > [herm_matrix_tti] solution
+* @param mu
+* > [T] chemical potential
+* @param H0
+* > [cdmatrix] Hamiltonian
+* @param Sigma
+* > [herm_matrix_tti] self-energy
+* @param h
+* > [T] time step interval
+* @param SolveOrder
+* > [int] integration order
+*/
+template <typename T>
+void dyson_tti(herm_matrix_tti<T> &G, T mu, cdmatrix &H0, herm_matrix_tti<T> &Sigma, T h,
+               int SolveOrder) {
+    typedef std::complex<T> cplx;
+    std::complex<T> iu = std::complex<T>(0.0, 1.0);
+    int nt = G.nt(), size1 = G.size1(), es = G.element_size(), l, r, s;
+    integration::Integrator<T> &I = integration::I<T>(SolveOrder);
+    cplx *g0, *q;
+    cdmatrix Udt(size1, size1), Ul(size1, size1), Hmu(size1, size1);
+
+    assert(Sigma.size1() == size1 && Sigma.nt() == nt);
+    assert(H0.rows() == size1 && H0.cols() == size1);
+    assert(nt >= SolveOrder);
+    g0 = new cplx[(nt + 1) * es];
+    q = new cplx[(nt + 1) * es];
+    Hmu = -H0 + mu * MatrixXcd::Identity(size1, size1);
+    Udt = (iu * h * Hmu).exp();
+    Ul = MatrixXcd::Identity(size1, size1);
+    for (l = 0; l <= nt; l++) {
+        for (r = 0; r < size1; r++)
+            for (s = 0; s < size1; s++)
+                g0[l * es + r * size1 + s] = -iu * Ul(r, s);
+        Ul = Ul * Udt;
+    }
+    // retarded: G = G0 + (G0*Sigma)*G
+    convolution_tti_ret(nt, size1, q, g0, Sigma.retptr(0), I, h);
+    dyson_tti_ret(nt, size1, G.retptr(0), g0, q, I, h);
+    // lesser: G^< = G^R*(Sigma^<*G^A)
+    convolution_tti_les_adv(nt, size1, q, Sigma.lesptr(0), G.retptr(0), I, h);
+    convolution_tti_les_ret(nt, size1, G.lesptr(0), G.retptr(0), q, I, h);
+    delete[] g0;
+    delete[] q;
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_TTI_SOLVERS_IMPL_H
@@ -4,6 +4,7 @@
 #include "cntr_utilities_decl.hpp"
 //#include "cntr_exception.hpp"
 #include "cntr_elements.hpp"
+#include "cntr_profile.hpp"
 #include "cntr_herm_matrix_decl.hpp"
 #include "cntr_herm_matrix_timestep_view_decl.hpp"
 #include "cntr_herm_matrix_timestep_view_impl.hpp"
@@ -30,6 +31,9 @@ void extrapolate_timestep_dispatch(int n, GG &G,
     n1 = n + 1;
     k = I.k();
     sg = G.element_size();
+    CNTR_PROFILE_SCOPE("extrapolate_timestep", n + 1,
+                       4.0 * (k + 1) * profile_timestep_elements(n + 1, ntau, size1),
+                       (k + 2.0) * sizeof(cplx) * profile_timestep_elements(n + 1, ntau, size1));
     gtemp = new cplx[sg];
     gtemp1 = new cplx[sg];
     if (n1 > nt || n < k) {
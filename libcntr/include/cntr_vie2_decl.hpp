@@ -3,11 +3,13 @@
 
 #include "cntr_global_settings.hpp"
 #include "integration.hpp"
+#include <vector>
 
 namespace cntr {
 
   template <typename T> class herm_matrix;
   template <typename T> class function;
+  template <typename T> class dyson_workspace;
 
 /* #######################################################################################
 #
@@ -49,6 +51,12 @@ namespace cntr {
          herm_matrix<T> &Q, integration::Integrator<T> &I, T beta, T h,
          const int matsubara_method=CNTR_MAT_FIXPOINT);
 
+  /// @private
+  template <typename T>
+  void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
+         herm_matrix<T> &Q, integration::Integrator<T> &I, T beta, T h,
+         dyson_workspace<T> &ws, const int matsubara_method=CNTR_MAT_FIXPOINT);
+
   /// @private
   template <typename T>
   void vie2(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_matrix<T> &Q,
@@ -58,6 +66,12 @@ namespace cntr {
   void vie2_timestep_sin(int n,herm_matrix<T> &G,function<T> &Gsin,herm_matrix<T> &F,herm_matrix<T> &Fcc, function<T> &Fsin ,
       herm_matrix<T> &Q,function<T> &Qsin,T beta,T h,int SolveOrder=MAX_SOLVE_ORDER);
 
+  template <typename T>
+  void vie2_timestep_sin_batch(int n, std::vector<herm_matrix<T> *> &G, std::vector<function<T> *> &Gsin,
+      std::vector<herm_matrix<T> *> &F, std::vector<herm_matrix<T> *> &Fcc, std::vector<function<T> *> &Fsin,
+      std::vector<herm_matrix<T> *> &Q, std::vector<function<T> *> &Qsin, T beta, T h,
+      int SolveOrder=MAX_SOLVE_ORDER);
+
 // documented user interfaces
   template <typename T>
   void vie2_mat(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_matrix<T> &Q,
@@ -71,6 +85,16 @@ namespace cntr {
   template <typename T>
   void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
                    herm_matrix<T> &Q, T beta, T h, const int SolveOrder=MAX_SOLVE_ORDER,  const int matsubara_method=CNTR_MAT_FIXPOINT);
+
+  template <typename T>
+  void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
+                   herm_matrix<T> &Q, T beta, T h, dyson_workspace<T> &ws,
+                   const int SolveOrder=MAX_SOLVE_ORDER,  const int matsubara_method=CNTR_MAT_FIXPOINT);
+
+  template <typename T>
+  void vie2_timestep_batch(int n, std::vector<herm_matrix<T> *> &G, std::vector<herm_matrix<T> *> &F,
+                   std::vector<herm_matrix<T> *> &Fcc, std::vector<herm_matrix<T> *> &Q, T beta, T h,
+                   const int SolveOrder=MAX_SOLVE_ORDER,  const int matsubara_method=CNTR_MAT_FIXPOINT);
   
   template <typename T>
   void vie2(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_matrix<T> &Q,
@@ -86,10 +110,19 @@ namespace cntr {
   void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
 			 herm_matrix<T> &Fcc, herm_matrix<T> &Q, integration::Integrator<T> &I,
 			 T beta, T h, const int matsubara_method=CNTR_MAT_FIXPOINT);
+  /// @private
+  template <typename T>
+  void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
+			 herm_matrix<T> &Fcc, herm_matrix<T> &Q, integration::Integrator<T> &I,
+			 T beta, T h, dyson_workspace<T> &ws, const int matsubara_method=CNTR_MAT_FIXPOINT);
   template <typename T>
   void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
        herm_matrix<T> &Fcc, herm_matrix<T> &Q, T beta, T h, const int SolveOrder=MAX_SOLVE_ORDER,
        const int matsubara_method=CNTR_MAT_FIXPOINT);
+  template <typename T>
+  void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
+       herm_matrix<T> &Fcc, herm_matrix<T> &Q, T beta, T h, dyson_workspace<T> &ws,
+       const int SolveOrder=MAX_SOLVE_ORDER, const int matsubara_method=CNTR_MAT_FIXPOINT);
 
   /// @private
   template <typename T>
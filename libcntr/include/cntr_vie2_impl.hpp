@@ -4,10 +4,12 @@
 #include "cntr_vie2_decl.hpp"
 #include "fourier.hpp"
 #include "cntr_elements.hpp"
+#include "cntr_profile.hpp"
 #include "cntr_herm_matrix_timestep_decl.hpp"
 #include "cntr_herm_matrix_decl.hpp"
 #include "cntr_matsubara_impl.hpp"
 #include "cntr_convolution_impl.hpp"
+#include "cntr_dyson_workspace_decl.hpp"
 
 namespace cntr {
 
@@ -58,7 +60,7 @@ namespace cntr {
 */
 template <typename T, class GG, int SIZE1>
 void vie2_timestep_ret(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
-                       T h) {
+                       T h, dyson_workspace<T> &ws = dyson_workspace<T>::local()) {
     typedef std::complex<T> cplx;
     int k = I.get_k(), k1 = k + 1, k2 = 2 * k1;
     int ss, sg, n1, l, j, i, p, q, m, j1, j2, size1 = G.size1();
@@ -69,12 +71,13 @@ void vie2_timestep_ret(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integra
 
     ss = F.element_size();
     sg = G.element_size();
-    gtemp = new cplx[k * sg];
-    diffw = new cplx[k1 + 1];
-    qq = new cplx[(n + 1) * sg];
-    one = new cplx[sg];
-    mm = new cplx[k * k * sg];
-    stemp = new cplx[sg]; // sic
+    ws.reserve(n, G.ntau(), G.size1(), k);
+    gtemp = ws.gtemp();
+    diffw = ws.diffw();
+    qq = ws.qq();
+    one = ws.one();
+    mm = ws.mm();
+    stemp = ws.stemp(); // sic
     element_set<T, SIZE1>(size1, one, 1);
     // check consistency:
     assert(n > k);
@@ -171,12 +174,6 @@ void vie2_timestep_ret(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integra
             sret += ss;
         }
     }
-    delete[] diffw;
-    delete[] stemp;
-    delete[] qq;
-    delete[] mm;
-    delete[] gtemp;
-    delete[] one;
     return;
 }
 /// @private
@@ -305,8 +302,8 @@ template <typename T, class GG, int SIZE1>
 void vie2_mat_fourier_dispatch(GG &G, GG &F, GG &Fcc, GG &Q, T beta, int pcf = 20, int order = 3) {
     typedef std::complex<T> cplx;
     cplx *fmdft, *fiomn, *qiomn, *qiomn1, *qmdft, *qmasy, *z1, *z2, *z3, *zinv, *one;
-    cplx *expfac, *xmat;
-    int ntau, m, r, p, m2, sig, size1 = G.size1(), l, sg, ss, matsub_one;
+    cplx *expfac, *xmat, *gomn;
+    int ntau, m, m1, r, p, m2, sig, size1 = G.size1(), l, sg, ss, matsub_one;
     T dtau, omn;
     // T arg;
 
@@ -328,6 +325,7 @@ void vie2_mat_fourier_dispatch(GG &G, GG &F, GG &Fcc, GG &Q, T beta, int pcf = 2
     }
     m2 = ntau / 2;
     xmat = new cplx[(ntau + 1) * sg];
+    gomn = new cplx[(ntau + 1) * sg];
     fmdft = new cplx[(ntau + 1) * sg];
     qmdft = new cplx[(ntau + 1) * sg];
     expfac = new cplx[ntau + 1];
@@ -359,6 +357,8 @@ void vie2_mat_fourier_dispatch(GG &G, GG &F, GG &Fcc, GG &Q, T beta, int pcf = 2
     // element_smul<T,SIZE1>(size1,qmasy,-1.0);
 
     set_first_order_tail<T, SIZE1>(xmat, qmasy, beta, sg, ntau, sig, size1);
+    for (l = 0; l < (ntau + 1) * sg; l++)
+        gomn[l] = 0.0;
 
     // Raw Discrete Fourier Transform of F(\tau) & G(\tau)
     // Sig determines whether the Matsubara frequencies are Fermionic or Bosonic
@@ -424,22 +424,22 @@ void vie2_mat_fourier_dispatch(GG &G, GG &F, GG &Fcc, GG &Q, T beta, int pcf = 2
             // So actually we could simplify this to
             // z1 = 1/beta * [ (1+f)^{-1} * q - qmasy/(i*omn) ] ?
 
-            for (r = 0; r <= ntau; r++) { // Loop over tau
-
-                double arg = omn * r * dtau;
-                std::complex<double> expfactor = cplx(cos(arg), -sin(arg));
-                element_set<T, SIZE1>(size1, z2, z1);
-                element_smul<T, SIZE1>(size1, z2, expfactor);
-                element_incr<T, SIZE1>(size1, xmat + r * sg, z2);
-
-            } // End tau loop
+            // exp(-i omn tau_r) depends on m+p*ntau only modulo ntau: sum up the
+            // frequencies here and transform back to tau by one FFT below
+            m1 = ((m + p * ntau) % ntau + ntau) % ntau;
+            for (l = 0; l < sg; l++)
+                gomn[m1 * sg + l] += z1[l];
         }     // End matsubara freq loop
     }         // End oversampling loop
 
-    for (r = 0; r <= ntau; r++)
+    matsubara_idft<T>(gomn, ntau, sig, sg);
+    for (r = 0; r <= ntau; r++) {
+        element_incr<T, SIZE1>(size1, xmat + r * sg, gomn + r * sg);
         element_set<T, SIZE1>(size1, G.matptr(r), xmat + r * sg);
+    }
 
     delete[] xmat;
+    delete[] gomn;
     delete[] fmdft;
     delete[] qmdft;
     delete[] expfac;
@@ -643,7 +643,7 @@ void vie2_mat_steep_dispatch(GG &G, GG &F, GG &Fcc, GG &Q, T beta,
 */
 template <typename T, class GG, int SIZE1>
 void vie2_timestep_tv(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
-                      T beta, T h) {
+                      T beta, T h, dyson_workspace<T> &ws = dyson_workspace<T>::local()) {
     typedef std::complex<T> cplx;
     int k = I.get_k();
     int sg, n1, l, j, ntau, size1 = G.size1();
@@ -658,10 +658,11 @@ void vie2_timestep_tv(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrat
     assert(G.nt() >= n);
     assert(G.sig() == F.sig());
 
-    one = new cplx[sg];
-    qq = new cplx[sg];
-    mm = new cplx[sg];
-    stemp = new cplx[sg]; // sic
+    ws.reserve(n, ntau, size1, k);
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    stemp = ws.stemp(); // sic
     element_set<T, SIZE1>(size1, one, 1.0);
     // SET ENTRIES IN TIMESTEP(TV) TO 0
     gtv = G.tvptr(n, 0);
@@ -669,24 +670,20 @@ void vie2_timestep_tv(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrat
     for (l = 0; l < n1; l++)
         gtv[l] = 0;
     // CONVOLUTION SIGMA*G:  --->  Gtv(n,m)
-    convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, G, F, Fcc, G, G, I, beta,
+    convolution_timestep_tv<T, herm_matrix<T>, SIZE1>(n, ws.tv(), G, F, Fcc, G, G, I, beta,
                                                       h); // note: this sets only tv
     // Now solve
     // [ 1 - h w(n,0) Sigma(n,n) ] G(n,m)  = Q(m),
-    // where Q is initially stored in G(n,m)
+    // where Q is initially stored in ws.tv()
     element_set<T, SIZE1>(size1, stemp, F.retptr(n, n));
     weight = h * I.gregory_weights(n, 0);
     for (l = 0; l < sg; l++)
         mm[l] = one[l] + weight * stemp[l];
     for (j = 0; j <= ntau; j++) {
         for (l = 0; l < sg; l++)
-            qq[l] = -G.tvptr(n, j)[l] + Q.tvptr(n, j)[l];
+            qq[l] = -ws.tv()[j * sg + l] + Q.tvptr(n, j)[l];
         element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
     }
-    delete[] stemp;
-    delete[] qq;
-    delete[] mm;
-    delete[] one;
     return;
 }
 /// @private
@@ -845,7 +842,7 @@ void vie2_start_tv(GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
 */
 template <typename T, class GG, int SIZE1>
 void vie2_timestep_les(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
-                       T beta, T h) {
+                       T beta, T h, dyson_workspace<T> &ws = dyson_workspace<T>::local()) {
     typedef std::complex<T> cplx;
     int k = I.get_k(), k1 = k + 1;
     int sg, n1, l, m, j, ntau, p, q, sig, size1 = G.size1();
@@ -860,13 +857,14 @@ void vie2_timestep_les(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integra
     assert(G.nt() >= n1);
     assert(G.sig() == F.sig());
 
-    one = new cplx[sg];
-    qq = new cplx[k1 * sg];
-    mm = new cplx[k1 * k1 * sg];
-    gtemp = new cplx[sg];
-    qtemp = new cplx[sg];
-    stemp = new cplx[sg]; // sic
-    gles = new cplx[(n1 + 1) * sg];
+    ws.reserve(n1, ntau, size1, k);
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    gtemp = ws.htemp();
+    qtemp = ws.qtemp();
+    stemp = ws.stemp(); // sic
+    gles = ws.gles();
     for (j = 0; j <= n1; j++)
         element_set_zero<T, SIZE1>(size1, gles + j * sg);
     element_set<T, SIZE1>(size1, one, 1.0);
@@ -946,13 +944,6 @@ void vie2_timestep_les(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integra
     // write elements into Gles
     for (j = 0; j <= n; j++)
         element_set<T, SIZE1>(size1, G.lesptr(j, n), gles + j * sg);
-    delete[] stemp;
-    delete[] gtemp;
-    delete[] qtemp;
-    delete[] gles;
-    delete[] qq;
-    delete[] mm;
-    delete[] one;
     return;
 }
 /// @private
@@ -1032,29 +1023,9 @@ void vie2_mat_fourier(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
     int size1 = G.size1(), pcf = 20;
     assert(G.size1() == F.size1());
     assert(G.ntau() == F.ntau());
-    switch (size1) {
-    case 1:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, 1>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    case 2:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, 2>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    case 3:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, 3>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    case 4:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, 4>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    case 5:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, 5>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    case 8:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, 8>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    default:
-        vie2_mat_fourier_dispatch<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, beta, pcf, order);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        vie2_mat_fourier_dispatch<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, beta, pcf, order);
+    );
 }
 /// @private
 /** \brief <b> VIE solver \f$(1+F)*G=Q\f$ using fixpoint iteration method on matsubara axis</b>
@@ -1093,36 +1064,10 @@ void vie2_mat_fixpoint(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc
     int size1 = G.size1(), pcf = 5, order = 3;
     assert(G.size1() == F.size1());
     assert(G.ntau() == F.ntau());
-    switch (size1) {
-    case 1:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, 1>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
-                                                      order);
-        break;
-    case 2:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, 2>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
-                                                      order);
-        break;
-    case 3:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, 3>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
-                                                      order);
-        break;
-    case 4:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, 4>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
-                                                      order);
-        break;
-    case 5:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, 5>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
-                                                      order);
-        break;
-    case 8:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, 8>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
-                                                      order);
-        break;
-    default:
-        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, beta, I, nfixpoint,
-                                                              pcf, order);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        vie2_mat_fixpoint_dispatch<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, beta, I, nfixpoint, pcf,
+                                                             order);
+    );
 }
 /// @private
 /** \brief <b> VIE solver \f$(1+F)*G=Q\f$ using steepest descent minimization on matsubara axis</b>
@@ -1163,36 +1108,10 @@ void vie2_mat_steep(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
     int size1 = G.size1(), pcf = 3, order = 3;
     assert(G.size1() == F.size1());
     assert(G.ntau() == F.ntau());
-    switch (size1) {
-    case 1:
-      vie2_mat_steep_dispatch<T, herm_matrix<T>, 1>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
-						 order);
-      break;
-    case 2:
-        vie2_mat_steep_dispatch<T, herm_matrix<T>, 2>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
-                                                      order);
-        break;
-    case 3:
-        vie2_mat_steep_dispatch<T, herm_matrix<T>, 3>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
-                                                      order);
-        break;
-    case 4:
-        vie2_mat_steep_dispatch<T, herm_matrix<T>, 4>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
-                                                      order);
-        break;
-    case 5:
-        vie2_mat_steep_dispatch<T, herm_matrix<T>, 5>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
-                                                      order);
-        break;
-    case 8:
-        vie2_mat_steep_dispatch<T, herm_matrix<T>, 8>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
-                                                      order);
-        break;
-    default:
-        vie2_mat_steep_dispatch<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, beta, I, maxiter, tol,
-                                                              pcf, order);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        vie2_mat_steep_dispatch<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, beta, I, maxiter, tol, pcf,
+                                                          order);
+    );
 }
 /// @private
 /** \brief <b> VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$ on the Matsubara axis</b>
@@ -1346,43 +1265,11 @@ void vie2_start(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_
     assert(G.ntau() == Fcc.ntau());
     assert(Fcc.nt() >= k);
 
-    switch (size1) {
-    case 1:
-        vie2_start_ret<T, herm_matrix<T>, 1>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, 1>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, 1>(G, F, Fcc, Q, I, beta, h);
-        break;
-    case 2:
-        vie2_start_ret<T, herm_matrix<T>, 2>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, 2>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, 2>(G, F, Fcc, Q, I, beta, h);
-        break;
-    case 3:
-        vie2_start_ret<T, herm_matrix<T>, 3>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, 3>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, 3>(G, F, Fcc, Q, I, beta, h);
-        break;
-    case 4:
-        vie2_start_ret<T, herm_matrix<T>, 4>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, 4>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, 4>(G, F, Fcc, Q, I, beta, h);
-        break;
-    case 5:
-        vie2_start_ret<T, herm_matrix<T>, 5>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, 5>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, 5>(G, F, Fcc, Q, I, beta, h);
-        break;
-    case 8:
-        vie2_start_ret<T, herm_matrix<T>, 8>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, 8>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, 8>(G, F, Fcc, Q, I, beta, h);
-        break;
-    default:
-        vie2_start_ret<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, I, h);
-        vie2_start_tv<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, I, beta, h);
-        vie2_start_les<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, I, beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        vie2_start_ret<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, I, h);
+        vie2_start_tv<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, I, beta, h);
+        vie2_start_les<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, I, beta, h);
+    );
 }
 
 /** \brief <b> VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$ for the first k timesteps</b>
@@ -1428,43 +1315,13 @@ void vie2_start(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_
     assert(G.ntau() == Fcc.ntau());
     assert(Fcc.nt() >= SolveOrder);
 
-    switch (size1) {
-    case 1:
-        vie2_start_ret<T, herm_matrix<T>, 1>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, 1>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, 1>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 2:
-        vie2_start_ret<T, herm_matrix<T>, 2>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, 2>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, 2>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 3:
-        vie2_start_ret<T, herm_matrix<T>, 3>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, 3>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, 3>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 4:
-        vie2_start_ret<T, herm_matrix<T>, 4>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, 4>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, 4>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 5:
-        vie2_start_ret<T, herm_matrix<T>, 5>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, 5>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, 5>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    case 8:
-        vie2_start_ret<T, herm_matrix<T>, 8>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, 8>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, 8>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    default:
-        vie2_start_ret<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
-        vie2_start_tv<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        vie2_start_les<T, herm_matrix<T>, LARGESIZE>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-    }
+    CNTR_SIZE1_DISPATCH(size1, SIZE1,
+        vie2_start_ret<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, integration::I<T>(SolveOrder), h);
+        vie2_start_tv<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta,
+                                                h);
+        vie2_start_les<T, herm_matrix<T>, SIZE1>(G, F, Fcc, Q, integration::I<T>(SolveOrder), beta,
+                                                 h);
+    );
 }
 /// @private
 /** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$ at a given timestep</b>
@@ -1504,7 +1361,52 @@ void vie2_start(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_
 template <typename T>
 void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
                    herm_matrix<T> &Q, integration::Integrator<T> &I, T beta, T h, const int matsubara_method) {
+    vie2_timestep(n, G, F, Fcc, Q, I, beta, h, vie2_workspace<T>::local(), matsubara_method);
+}
+/// @private
+/** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$ at a given timestep
+* with a user-provided workspace</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Same as `vie2_timestep` without workspace argument, but the scratch arrays of the
+* > solver are taken from `ws`.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] time step
+* @param &G
+* > [herm_matrix<T>] solution
+* @param &F
+* > [herm_matrix<T>] green's function  on left-hand side
+* @param &Fcc
+* > [herm_matrix<T>] Complex conjugate of F
+* @param &Q
+* > [herm_matrix<T>] green's function  on right-hand side
+* @param I
+* > [Integrator] integrator class
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param &ws
+* > [vie2_workspace<T>] scratch memory, enlarged if needed
+* @param matsubara_method
+* > [const] Solution method on the Matsubara axis with 0: Fourier, 1: steep, 2: fixpoint
+*/
+template <typename T>
+void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
+                   herm_matrix<T> &Q, integration::Integrator<T> &I, T beta, T h,
+                   vie2_workspace<T> &ws, const int matsubara_method) {
     int size1 = G.size1(), k = I.k();
+    CNTR_PROFILE_SCOPE("vie2_timestep", n, profile_convolution_flops(n, G.ntau(), size1),
+                       sizeof(std::complex<T>) * (3.0 * profile_history_elements(n, G.ntau(), size1) +
+                                                  2.0 * profile_timestep_elements(n, G.ntau(), size1)));
     assert(G.size1() == F.size1());
     assert(G.size1() == Fcc.size1());
     assert(G.ntau() == F.ntau());
@@ -1518,43 +1420,11 @@ void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &
     }else if(n<=k){
         vie2_start(G,F,Fcc,Q,integration::I<T>(n),beta,h);
     }else{
-        switch (size1) {
-        case 1:
-            vie2_timestep_ret<T, herm_matrix<T>, 1>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, 1>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 1>(n, G, F, Fcc, Q, I, beta, h);
-            break;
-        case 2:
-            vie2_timestep_ret<T, herm_matrix<T>, 2>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, 2>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 2>(n, G, F, Fcc, Q, I, beta, h);
-            break;
-        case 3:
-            vie2_timestep_ret<T, herm_matrix<T>, 3>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, 3>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 3>(n, G, F, Fcc, Q, I, beta, h);
-            break;
-        case 4:
-            vie2_timestep_ret<T, herm_matrix<T>, 4>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, 4>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 4>(n, G, F, Fcc, Q, I, beta, h);
-            break;
-        case 5:
-            vie2_timestep_ret<T, herm_matrix<T>, 5>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, 5>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 5>(n, G, F, Fcc, Q, I, beta, h);
-            break;
-        case 8:
-            vie2_timestep_ret<T, herm_matrix<T>, 8>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, 8>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 8>(n, G, F, Fcc, Q, I, beta, h);
-            break;
-        default:
-            vie2_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, G, Fcc, F, Q, I, h);
-            vie2_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, G, F, Fcc, Q, I, beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, LARGESIZE>(n, G, F, Fcc, Q, I, beta, h);
-        break;
-        }
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            vie2_timestep_ret<T, herm_matrix<T>, SIZE1>(n, G, Fcc, F, Q, I, h, ws);
+            vie2_timestep_tv<T, herm_matrix<T>, SIZE1>(n, G, F, Fcc, Q, I, beta, h, ws);
+            vie2_timestep_les<T, herm_matrix<T>, SIZE1>(n, G, F, Fcc, Q, I, beta, h, ws);
+        );
     }
 }
 
@@ -1596,58 +1466,104 @@ void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &
 template <typename T>
 void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
                    herm_matrix<T> &Q, T beta, T h, const int SolveOrder, const int matsubara_method) {
-    int size1 = G.size1();
-    assert(G.size1() == F.size1());
-    assert(G.size1() == Fcc.size1());
-    assert(G.ntau() == F.ntau());
-    assert(G.ntau() == Fcc.ntau());
-    assert(G.nt() >= n);
-    assert(F.nt() >= n);
-    assert(Fcc.nt() >= n);
+    vie2_timestep(n, G, F, Fcc, Q, beta, h, vie2_workspace<T>::local(), SolveOrder,
+                  matsubara_method);
+}
 
-    if (n==-1){
-        vie2_mat(G, F, Fcc, Q, beta, integration::I<T>(SolveOrder), matsubara_method);
-    }else if(n<=SolveOrder){
-        vie2_start(G,F,Fcc,Q,integration::I<T>(n),beta,h);
-    }else{
-        switch (size1) {
-        case 1:
-            vie2_timestep_ret<T, herm_matrix<T>, 1>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, 1>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 1>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            break;
-        case 2:
-            vie2_timestep_ret<T, herm_matrix<T>, 2>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, 2>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 2>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            break;
-        case 3:
-            vie2_timestep_ret<T, herm_matrix<T>, 3>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, 3>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 3>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            break;
-        case 4:
-            vie2_timestep_ret<T, herm_matrix<T>, 4>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, 4>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 4>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            break;
-        case 5:
-            vie2_timestep_ret<T, herm_matrix<T>, 5>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, 5>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 5>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            break;
-        case 8:
-            vie2_timestep_ret<T, herm_matrix<T>, 8>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, 8>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, 8>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            break;
-        default:
-            vie2_timestep_ret<T, herm_matrix<T>, LARGESIZE>(n, G, Fcc, F, Q, integration::I<T>(SolveOrder), h);
-            vie2_timestep_tv<T, herm_matrix<T>, LARGESIZE>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-            vie2_timestep_les<T, herm_matrix<T>, LARGESIZE>(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-        }
-    }
+/** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$ at a given timestep
+* with a user-provided workspace</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Same as `vie2_timestep` without workspace argument, but all scratch arrays of the
+* > solver are taken from `ws`. If `ws` is created for the largest timestep of the
+* > propagation, the solver does not allocate its scratch memory at every timestep.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] time step
+* @param &G
+* > [herm_matrix<T>] solution
+* @param &F
+* > [herm_matrix<T>] green's function  on left-hand side
+* @param &Fcc
+* > [herm_matrix<T>] Complex conjugate of F
+* @param &Q
+* > [herm_matrix<T>] green's function  on right-hand side
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param &ws
+* > [vie2_workspace<T>] scratch memory, enlarged if needed
+* @param SolveOrder
+* > [int] integrator order
+* @param matsubara_method
+* > [const] Solution method on the Matsubara axis with 0: Fourier, 1: steep, 2: fixpoint
+*/
+template <typename T>
+void vie2_timestep(int n, herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc,
+                   herm_matrix<T> &Q, T beta, T h, vie2_workspace<T> &ws, const int SolveOrder,
+                   const int matsubara_method) {
+    vie2_timestep(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h, ws, matsubara_method);
+}
+
+/** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for a batch of independent Green's functions</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Solves \f$(1+F_i)*G_i=Q_i\f$ at timestep `n` for each `i`, e.g., for all momenta of a
+* > lattice model. With OpenMP (CNTR_USE_OMP), the problems of a timestep `n>=0` are
+* > distributed over the threads, each with its own workspace and with shared integration
+* > weights. The Matsubara step `n=-1` is solved sequentially. The result is the same
+* > as calling `vie2_timestep` for each problem.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] time step
+* @param &G
+* > [std::vector<herm_matrix<T>*>] solutions
+* @param &F
+* > [std::vector<herm_matrix<T>*>] green's functions on left-hand side
+* @param &Fcc
+* > [std::vector<herm_matrix<T>*>] Complex conjugates of F
+* @param &Q
+* > [std::vector<herm_matrix<T>*>] green's functions on right-hand side
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param SolveOrder
+* > [int] integrator order
+* @param matsubara_method
+* > [const] Solution method on the Matsubara axis with 0: Fourier, 1: steep, 2: fixpoint
+*/
+template <typename T>
+void vie2_timestep_batch(int n, std::vector<herm_matrix<T> *> &G, std::vector<herm_matrix<T> *> &F,
+                         std::vector<herm_matrix<T> *> &Fcc, std::vector<herm_matrix<T> *> &Q,
+                         T beta, T h, const int SolveOrder, const int matsubara_method) {
+    int nbatch = G.size(), i;
+    assert((int)F.size() == nbatch);
+    assert((int)Fcc.size() == nbatch);
+    assert((int)Q.size() == nbatch);
+    // initializes the integration weights before they are shared by the threads
+    integration::Integrator<T> &I = integration::I<T>(SolveOrder);
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (n >= 0)
+#endif
+    for (i = 0; i < nbatch; i++)
+        vie2_timestep(n, *G[i], *F[i], *Fcc[i], *Q[i], I, beta, h, vie2_workspace<T>::local(),
+                      matsubara_method);
 }
 /// @private
 /** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$</b>
@@ -1689,8 +1605,11 @@ void vie2(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_matrix
     vie2_mat(G, F, Fcc, Q, beta, I, matsubara_method);
     if (G.nt() >= 0)
         vie2_start(G, F, Fcc, Q, I, beta, h);
+    if (G.nt() <= k)
+        return;
+    vie2_workspace<T> ws(G.nt(), G.ntau(), G.size1(), k);
     for (tstp = k + 1; tstp <= G.nt(); tstp++)
-        vie2_timestep(tstp, G, F, Fcc, Q, I, beta, h);
+        vie2_timestep(tstp, G, F, Fcc, Q, I, beta, h, ws);
 }
 
 /** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for a Green's function \f$G\f$</b>
@@ -1732,8 +1651,11 @@ void vie2(herm_matrix<T> &G, herm_matrix<T> &F, herm_matrix<T> &Fcc, herm_matrix
     vie2_mat(G, F, Fcc, Q, beta, SolveOrder, matsubara_method);
     if (G.nt() >= 0)
         vie2_start(G, F, Fcc, Q, beta, h, SolveOrder);
+    if (G.nt() <= SolveOrder)
+        return;
+    vie2_workspace<T> ws(G.nt(), G.ntau(), G.size1(), SolveOrder);
     for (tstp = SolveOrder + 1; tstp <= G.nt(); tstp++)
-        vie2_timestep(tstp, G, F, Fcc, Q, beta, h, SolveOrder);
+        vie2_timestep(tstp, G, F, Fcc, Q, beta, h, ws, SolveOrder);
 }
 
 /** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for Green's function with instantaneous contributions for given integration order. </b>
@@ -1843,6 +1765,66 @@ void vie2_timestep_sin(int n,herm_matrix<T> &G,function<T> &Gsin,herm_matrix<T>
     vie2_timestep(n,G,tmpF,tmpFcc,tmpQ,integration::I<T>(SolveOrder),beta,h);
   }
 
+/** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ with instantaneous contributions for a batch
+* of independent Green's functions</b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Calls `vie2_timestep_sin` at timestep `n` for each problem `i`, e.g., for all momenta of
+* > a lattice model. With OpenMP (CNTR_USE_OMP), the problems of a timestep `n>=0` are
+* > distributed over the threads. The Matsubara step `n=-1` is solved sequentially.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param n
+* > [int] time step
+* @param &G
+* > [std::vector<herm_matrix<T>*>] solutions
+* @param &Gsin
+* > [std::vector<function<T>*>] singular components of G
+* @param &F
+* > [std::vector<herm_matrix<T>*>] green's functions on left-hand side
+* @param &Fcc
+* > [std::vector<herm_matrix<T>*>] Complex conjugates of F
+* @param &Fsin
+* > [std::vector<function<T>*>] singular components of F
+* @param &Q
+* > [std::vector<herm_matrix<T>*>] green's functions on right-hand side
+* @param &Qsin
+* > [std::vector<function<T>*>] singular components of Q
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param SolveOrder
+* > [int] integration order
+*/
+template <typename T>
+void vie2_timestep_sin_batch(int n, std::vector<herm_matrix<T> *> &G, std::vector<function<T> *> &Gsin,
+                             std::vector<herm_matrix<T> *> &F, std::vector<herm_matrix<T> *> &Fcc,
+                             std::vector<function<T> *> &Fsin, std::vector<herm_matrix<T> *> &Q,
+                             std::vector<function<T> *> &Qsin, T beta, T h, int SolveOrder) {
+    int nbatch = G.size(), i;
+    assert((int)Gsin.size() == nbatch);
+    assert((int)F.size() == nbatch);
+    assert((int)Fcc.size() == nbatch);
+    assert((int)Fsin.size() == nbatch);
+    assert((int)Q.size() == nbatch);
+    assert((int)Qsin.size() == nbatch);
+    // initializes the integration weights before they are shared by the threads
+    integration::I<T>(SolveOrder);
+#ifdef CNTR_USE_OMP
+#pragma omp parallel for schedule(dynamic) if (n >= 0)
+#endif
+    for (i = 0; i < nbatch; i++)
+        vie2_timestep_sin(n, *G[i], *Gsin[i], *F[i], *Fcc[i], *Fsin[i], *Q[i], *Qsin[i], beta, h,
+                          SolveOrder);
+}
+
 
 /// @private
 // function calls with alpha and possibly function
@@ -1850,17 +1832,23 @@ void vie2_timestep_sin(int n,herm_matrix<T> &G,function<T> &Gsin,herm_matrix<T>
 template <typename T, class GG, int SIZE1>
 void vie2_timestep_omp_dispatch(int omp_num_threads, int tstp, GG &B, CPLX alpha, GG &A,
                                 GG &Acc, CPLX *f0, CPLX *ft, GG &Q,
-                                integration::Integrator<T> &I, T beta, T h) {
+                                integration::Integrator<T> &I, T beta, T h,
+                                dyson_workspace<T> &ws = dyson_workspace<T>::local()) {
     int kt = I.get_k();
     int ntau = A.ntau();
     int size1 = A.size1();
     int sc = size1 * size1;
     bool func = (ft == NULL ? false : true);
     int n1 = (tstp == -1 || tstp > kt ? tstp : kt);
-    CPLX *ftcc, *f0cc;
-    herm_matrix_timestep<T> Qtstp(tstp, ntau, size1);
+    CPLX *ftcc, *f0cc, *qret, *qtv, *qles;
+    ws.reserve(tstp, ntau, size1, kt, omp_num_threads);
     // save Q
-    Q.get_timestep(tstp, Qtstp);
+    qret = ws.qq();
+    qtv = ws.tv();
+    qles = ws.gles();
+    memcpy(qret, Q.retptr(tstp, 0), sizeof(CPLX) * (tstp + 1) * sc);
+    memcpy(qtv, Q.tvptr(tstp, 0), sizeof(CPLX) * (ntau + 1) * sc);
+    memcpy(qles, Q.lesptr(0, tstp), sizeof(CPLX) * (tstp + 1) * sc);
     B.set_timestep_zero(tstp);
     if (func) {
         ftcc = new CPLX[sc * n1];
@@ -1873,8 +1861,8 @@ void vie2_timestep_omp_dispatch(int omp_num_threads, int tstp, GG &B, CPLX alpha
         f0cc = NULL;
     }
     {
-        CPLX *mtemp = new CPLX[sc];
-        CPLX *one = new CPLX[sc];
+        CPLX *mtemp = ws.stemp();
+        CPLX *one = ws.one();
         // mtemp= A.retptr(tstp,tstp)*ft(tstp)*alpha*h  [NB1 x NB1]
         if (func) {
             element_mult<T, SIZE1>(size1, mtemp, A.retptr(tstp, tstp), ft + sc * tstp);
@@ -1890,7 +1878,7 @@ void vie2_timestep_omp_dispatch(int omp_num_threads, int tstp, GG &B, CPLX alpha
             int nomp = omp_get_num_threads();
             int tid = omp_get_thread_num();
             int i, n, m;
-            CPLX *mm = new CPLX[sc];
+            CPLX *mm = ws.thread_mm(tid);
             T wt;
             std::vector<bool> mask_tv, mask_les, mask_ret;
             mask_tv = std::vector<bool>(ntau + 1, false);
@@ -1953,7 +1941,7 @@ void vie2_timestep_omp_dispatch(int omp_num_threads, int tstp, GG &B, CPLX alpha
         // Bles(tstp,tstp) (Bles(n<tstp,tstp) etc. enters the convolution!)
         {
             int n;
-            CPLX *mm = new CPLX[sc];
+            CPLX *mm = ws.mm();
             std::vector<bool> mask_les;
             T wt;
             n = tstp;
@@ -1967,16 +1955,15 @@ void vie2_timestep_omp_dispatch(int omp_num_threads, int tstp, GG &B, CPLX alpha
             element_conj<T, SIZE1>(size1, mm);
             element_linsolve_left<T, SIZE1>(size1, 1, B.lesptr(n, tstp), mm,
                                             Q.lesptr(n, tstp));
-            delete[] mm;
         }
-        delete[] one;
-        delete[] mtemp;
         if (func) {
             delete[] f0cc;
             delete[] ftcc;
         }
         // restore Q
-        Q.set_timestep(tstp, Qtstp);
+        memcpy(Q.retptr(tstp, 0), qret, sizeof(CPLX) * (tstp + 1) * sc);
+        memcpy(Q.tvptr(tstp, 0), qtv, sizeof(CPLX) * (ntau + 1) * sc);
+        memcpy(Q.lesptr(0, tstp), qles, sizeof(CPLX) * (tstp + 1) * sc);
     }
 }
 // same function call as above: anyway, only for  timestep
@@ -2022,6 +2009,51 @@ template <typename T>
 void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
                        herm_matrix<T> &Fcc, herm_matrix<T> &Q, integration::Integrator<T> &I,
                        T beta, T h, const int matsubara_method) {
+    vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, I, beta, h,
+                      vie2_workspace<T>::local(), matsubara_method);
+}
+/// @private
+/** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for Green's function for given timestep
+* with a user-provided workspace. OpenMP parallelized </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Same as `vie2_timestep_omp` without workspace argument, but the scratch arrays
+* > (including one buffer per openMP thread) are taken from `ws`.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param omp_num_threads
+* > [int] The number of openMP threads to be used. Set to the number of threads in the current team. 
+* @param tstp
+* > [int] time step
+* @param &G
+* > [herm_matrix<T>] solution
+* @param &F
+* > [herm_matrix<T>] green's function  on left-hand side
+* @param &Fcc
+* > [herm_matrix<T>] Complex conjugate of F
+* @param &Q
+* > [herm_matrix<T>] green's function  on right-hand side
+* @param I
+* > [Integrator] integrator class
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param &ws
+* > [vie2_workspace<T>] scratch memory, enlarged if needed
+* @param matsubara_method
+* > [const] Solution method on the Matsubara axis with 0: Fourier, 1: steep, 2: Newton iteration
+*/
+template <typename T>
+void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
+                       herm_matrix<T> &Fcc, herm_matrix<T> &Q, integration::Integrator<T> &I,
+                       T beta, T h, vie2_workspace<T> &ws, const int matsubara_method) {
     int ntau = G.ntau();
     int size1 = G.size1(), kt = I.k();
     int n1 = (tstp >= kt ? tstp : kt);
@@ -2052,32 +2084,11 @@ void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_ma
     }else if(tstp<=kt){
         cntr::vie2_start(G,F,Fcc,Q,integration::I<double>(tstp),beta,h);
     }else{
-        switch (size1){
-        case 1:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 1>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, I, beta, h);
-	break;
-        case 2:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 2>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, I, beta, h);
-        break;
-        case 3:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 3>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, I, beta, h);
-        break;
-        case 4:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 4>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, I, beta, h);
-        break;
-        case 5:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 5>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, I, beta, h);
-        break;
-        case 8:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 8>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, I, beta, h);
-        break;
-        }
+        CNTR_SIZE1_DISPATCH(size1, SIZE1,
+            vie2_timestep_omp_dispatch<T, herm_matrix<T>, SIZE1>(omp_num_threads, tstp, G, CPLX(1, 0),
+                                                                 F, Fcc, NULL, NULL, Q, I, beta, h,
+                                                                 ws);
+        );
 
     }
 }
@@ -2126,64 +2137,56 @@ template <typename T>
 void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
                        herm_matrix<T> &Fcc, herm_matrix<T> &Q,
                        T beta, T h, const int SolveOrder, const int matsubara_method) {
-    int ntau = G.ntau();
-    int size1 = G.size1();
-    int n1 = (tstp >= SolveOrder ? tstp : SolveOrder);
+    vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, beta, h, vie2_workspace<T>::local(),
+                      SolveOrder, matsubara_method);
+}
 
-    assert(tstp >= 0);
-    assert(ntau > 0);
+/** \brief <b> One step VIE solver \f$(1+F)*G=Q\f$ for Green's function for given timestep
+* with a user-provided workspace. OpenMP parallelized </b>
+*
+* <!-- ====== DOCUMENTATION ====== -->
+*
+*   \par Purpose
+* <!-- ========= -->
+*
+* > Same as `vie2_timestep_omp` without workspace argument, but all scratch arrays
+* > (including one buffer per openMP thread) are taken from `ws`. If `ws` is created
+* > for the largest timestep and thread number of the propagation, the solver does not
+* > allocate its scratch memory at every timestep.
+*
+* <!-- ARGUMENTS
+*      ========= -->
+*
+* @param omp_num_threads
+* > [int] The number of openMP threads to be used. Set to the number of threads in the current team. 
+* @param tstp
+* > [int] time step
+* @param &G
+* > [herm_matrix<T>] solution
+* @param &F
+* > [herm_matrix<T>] green's function  on left-hand side
+* @param &Fcc
+* > [herm_matrix<T>] Complex conjugate of F
+* @param &Q
+* > [herm_matrix<T>] green's function  on right-hand side
+* @param beta
+* > [double] inverse temperature
+* @param h
+* > [double] time interval
+* @param &ws
+* > [vie2_workspace<T>] scratch memory, enlarged if needed
+* @param SolveOrder
+* > [int] integrator order
+* @param matsubara_method
+* > [const] Solution method on the Matsubara axis with 0: Fourier, 1: steep, 2: fixpoint
+*/
+template <typename T>
+void vie2_timestep_omp(int omp_num_threads, int tstp, herm_matrix<T> &G, herm_matrix<T> &F,
+                       herm_matrix<T> &Fcc, herm_matrix<T> &Q, T beta, T h,
+                       vie2_workspace<T> &ws, const int SolveOrder, const int matsubara_method) {
     assert(SolveOrder > 0 && SolveOrder <= 5);
-    assert(SolveOrder <= 2 * ntau + 2);
-    assert(ntau == Fcc.ntau());
-    assert(ntau == F.ntau());
-    assert(ntau == Q.ntau());
-    assert(F.sig()== G.sig());
-    assert(Fcc.sig()== G.sig());
-    assert(Q.sig()== G.sig());
-    assert(F.size1()== size1);
-    assert(F.size2()== size1);
-    assert(Fcc.size1()== size1);
-    assert(Fcc.size2()== size1);
-    assert(Q.size1()== size1);
-    assert(Q.size2()== size1);
-    assert(n1 <= F.nt());
-    assert(n1 <= Fcc.nt());
-    assert(n1 <= G.nt());
-    assert(n1 <= Q.nt());
-
-    if (tstp==-1){
-        vie2_mat(G, F, Fcc, Q, beta, integration::I<T>(SolveOrder), matsubara_method);
-    }else if(tstp<=SolveOrder){
-        cntr::vie2_start(G,F,Fcc,Q,integration::I<T>(tstp),beta,h);
-    }else{
-        switch (size1){
-        case 1:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 1>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, integration::I<T>(SolveOrder), beta, h);
-    break;
-        case 2:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 2>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-        case 3:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 3>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-        case 4:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 4>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-        case 5:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 5>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-        case 8:
-            vie2_timestep_omp_dispatch<T, herm_matrix<T>, 8>(
-            omp_num_threads, tstp, G, CPLX(1, 0), F, Fcc, NULL, NULL, Q, integration::I<T>(SolveOrder), beta, h);
-        break;
-        }
-
-    }
+    vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta,
+                      h, ws, matsubara_method);
 }
 
 
@@ -2463,8 +2466,9 @@ void vie2_omp(int omp_num_threads, herm_matrix<T> &G, herm_matrix<T> &F, herm_ma
     // vie2_mat(G,F,Fcc,Q,beta,3);
     if (G.nt() >= 0)
         vie2_start(G, F, Fcc, Q, I, beta, h);
+    vie2_workspace<T> ws;
     for (tstp = k + 1; tstp <= G.nt(); tstp++)
-        vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, I, beta, h);
+        vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, I, beta, h, ws);
 }
 
 
@@ -2511,8 +2515,9 @@ void vie2_omp(int omp_num_threads, herm_matrix<T> &G, herm_matrix<T> &F, herm_ma
     vie2_mat(G, F, Fcc, Q, beta, SolveOrder, matsubara_method);
     if (G.nt() >= 0)
         vie2_start(G, F, Fcc, Q, beta, h, SolveOrder);
+    vie2_workspace<T> ws;
     for (tstp = SolveOrder + 1; tstp <= G.nt(); tstp++)
-        vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, beta, h, SolveOrder);
+        vie2_timestep_omp(omp_num_threads, tstp, G, F, Fcc, Q, beta, h, ws, SolveOrder);
 }
 
 #endif // CNTR_USE_OMP
@@ -0,0 +1,56 @@
+#ifndef CNTR_WINDOW_SOLVERS_DECL_H
+#define CNTR_WINDOW_SOLVERS_DECL_H
+
+#include "cntr_global_settings.hpp"
+#include "integration.hpp"
+
+namespace cntr {
+
+  template <typename T> class function;
+  template <typename T> class herm_matrix_window;
+  template <typename T> class dyson_workspace;
+
+/*###########################################################################################
+#
+#   MEMORY-TRUNCATED SOLVERS ON A herm_matrix_window
+#
+#   The convolution, Dyson and VIE2 timestep solvers for contour functions which are
+#   truncated to |t-t'| <= nc*h. All integrals over the real-time branch are restricted to
+#   the window [max(0,n-nc),n]; if n <= nc, the results agree with the full solvers.
+#   The cost per time step is O(nc^2), independent of n.
+#   All windows must have the same nc > k, and must contain the time steps
+#   max(0,n-nc) ... n of the input functions. The output is moved forward to time step n.
+#
+###########################################################################################*/
+
+  template <typename T>
+  void convolution_timestep_window(int n, herm_matrix_window<T> &C, herm_matrix_window<T> &A,
+    herm_matrix_window<T> &Acc, herm_matrix_window<T> &B, herm_matrix_window<T> &Bcc,
+    integration::Integrator<T> &I, T beta, T h);
+  template <typename T>
+  void convolution_timestep_window(int n, herm_matrix_window<T> &C, herm_matrix_window<T> &A,
+    herm_matrix_window<T> &Acc, herm_matrix_window<T> &B, herm_matrix_window<T> &Bcc,
+    T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+
+  /// @private
+  template <typename T>
+  void dyson_timestep_window(int n, herm_matrix_window<T> &G, T mu, function<T> &H,
+    herm_matrix_window<T> &Sigma, integration::Integrator<T> &I, T beta, T h,
+    dyson_workspace<T> &ws);
+  template <typename T>
+  void dyson_timestep_window(int n, herm_matrix_window<T> &G, T mu, function<T> &H,
+    herm_matrix_window<T> &Sigma, T beta, T h, int SolveOrder=MAX_SOLVE_ORDER);
+
+  /// @private
+  template <typename T>
+  void vie2_timestep_window(int n, herm_matrix_window<T> &G, herm_matrix_window<T> &F,
+    herm_matrix_window<T> &Fcc, herm_matrix_window<T> &Q, integration::Integrator<T> &I,
+    T beta, T h, dyson_workspace<T> &ws);
+  template <typename T>
+  void vie2_timestep_window(int n, herm_matrix_window<T> &G, herm_matrix_window<T> &F,
+    herm_matrix_window<T> &Fcc, herm_matrix_window<T> &Q, T beta, T h,
+    int SolveOrder=MAX_SOLVE_ORDER);
+
+}  // namespace cntr
+
+#endif  // CNTR_WINDOW_SOLVERS_DECL_H
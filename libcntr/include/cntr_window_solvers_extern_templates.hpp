@@ -0,0 +1,36 @@
+#ifndef CNTR_WINDOW_SOLVERS_EXTERN_TEMPLATES_H
+#define CNTR_WINDOW_SOLVERS_EXTERN_TEMPLATES_H
+
+#include "cntr_window_solvers_decl.hpp"
+
+namespace cntr {
+
+  extern template
+  void convolution_timestep_window<double>(int n, herm_matrix_window<double> &C,
+    herm_matrix_window<double> &A, herm_matrix_window<double> &Acc, herm_matrix_window<double> &B,
+    herm_matrix_window<double> &Bcc, integration::Integrator<double> &I, double beta, double h);
+  extern template
+  void convolution_timestep_window<double>(int n, herm_matrix_window<double> &C,
+    herm_matrix_window<double> &A, herm_matrix_window<double> &Acc, herm_matrix_window<double> &B,
+    herm_matrix_window<double> &Bcc, double beta, double h, int SolveOrder);
+
+  extern template
+  void dyson_timestep_window<double>(int n, herm_matrix_window<double> &G, double mu,
+    function<double> &H, herm_matrix_window<double> &Sigma, integration::Integrator<double> &I,
+    double beta, double h, dyson_workspace<double> &ws);
+  extern template
+  void dyson_timestep_window<double>(int n, herm_matrix_window<double> &G, double mu,
+    function<double> &H, herm_matrix_window<double> &Sigma, double beta, double h, int SolveOrder);
+
+  extern template
+  void vie2_timestep_window<double>(int n, herm_matrix_window<double> &G,
+    herm_matrix_window<double> &F, herm_matrix_window<double> &Fcc, herm_matrix_window<double> &Q,
+    integration::Integrator<double> &I, double beta, double h, dyson_workspace<double> &ws);
+  extern template
+  void vie2_timestep_window<double>(int n, herm_matrix_window<double> &G,
+    herm_matrix_window<double> &F, herm_matrix_window<double> &Fcc, herm_matrix_window<double> &Q,
+    double beta, double h, int SolveOrder);
+
+}  // namespace cntr
+
+#endif  // CNTR_WINDOW_SOLVERS_EXTERN_TEMPLATES_H
@@ -0,0 +1,1151 @@
+#ifndef CNTR_WINDOW_SOLVERS_IMPL_H
+#define CNTR_WINDOW_SOLVERS_IMPL_H
+
+#include "cntr_window_solvers_decl.hpp"
+#include "cntr_elements.hpp"
+#include "cntr_function_decl.hpp"
+#include "cntr_herm_matrix_window_impl.hpp"
+#include "cntr_convolution_impl.hpp"
+#include "cntr_dyson_workspace_decl.hpp"
+
+namespace cntr {
+
+/* #######################################################################################
+#
+#  MEMORY-TRUNCATED CONVOLUTION  C = A*B  AT TIMESTEP n
+#
+#  With j0 = max(0,n-nc) the integrals are restricted to the window [j0,n]:
+#
+#    C^ret(n,j) = int_j^n ds A^ret(n,s) B^ret(s,j)                   (exact)
+#    C^tv(n,tau) = A^tv(n,.) * B^mat + int_j0^n ds A^ret(n,s) B^tv(s,tau)
+#    C^les(j,n) = A^tv(j,.) * B^vt(.,n) + int_j0^n ds A^les(j,s) B^adv(s,n)
+#                 + int_j0^j ds A^ret(j,s) B^les(s,n)
+#
+#  for j = j0 ... n.
+#
+###########################################################################################*/
+
+/// @private
+/** \brief <b> Window index of the first time step in the integrals at time step `n`. </b> */
+inline int window_start(int n, int nc) {
+    return (n > nc ? n - nc : 0);
+}
+
+/// @private
+/** \brief <b> Retarded convolution at time step `n` within the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$ C^\mathrm{R}(t_n,t_j) = \int_{t_j}^{t_n} d\bar t A^\mathrm{R}(t_n,\bar t)
+ * > B^\mathrm{R}(\bar t,t_j) \f$ for \f$ j = j_0,\dots,n \f$. The result is written to `cret`,
+ * > `cret + (j-j0)*element_size` corresponds to \f$ C^\mathrm{R}(t_n,t_j) \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param cret
+ * > [complex] result, size (n-j0+1)*element_size
+ * @param A
+ * > [GG] contour function
+ * @param Acc
+ * > [GG] complex conjugate to A
+ * @param B
+ * > [GG] contour function
+ * @param Bcc
+ * > [GG] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param h
+ * > time step interval
+ */
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_window_ret(int n, std::complex<T> *cret, GG &A, GG &Acc, GG &B,
+                                     GG &Bcc, integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), size1 = A.size1();
+    int sa = A.element_size(), sb = B.element_size(), sc = sa;
+    int j0 = window_start(n, A.nc()), j, m, l;
+    cplx *atemp, *btemp;
+    T weight;
+
+    atemp = new cplx[sa];
+    btemp = new cplx[sb];
+    for (l = 0; l < (n - j0 + 1) * sc; l++)
+        cret[l] = 0;
+    // contribution from Bret(m,j), j <= m
+    for (m = j0; m <= n; m++) {
+        element_set<T, SIZE1>(size1, atemp, A.retptr(n, m));
+        element_smul<T, SIZE1>(size1, atemp, h);
+        for (j = j0; j <= m; j++) {
+            weight = I.gregory_weights(n - j, n - m);
+            element_incr<T, SIZE1>(size1, cret + (j - j0) * sc, weight, atemp, B.retptr(m, j));
+        }
+    }
+    // short intervals n-j < k: B(m,j), m < j, continued to -Bcc(j,m)*
+    for (m = n - k; m < n; m++) {
+        element_set<T, SIZE1>(size1, atemp, A.retptr(n, m));
+        element_smul<T, SIZE1>(size1, atemp, h);
+        for (j = m + 1; j <= n; j++) {
+            weight = I.gregory_weights(n - j, n - m);
+            element_conj<T, SIZE1>(size1, btemp, Bcc.retptr(j, m));
+            element_incr<T, SIZE1>(size1, cret + (j - j0) * sc, -weight, atemp, btemp);
+        }
+    }
+    delete[] atemp;
+    delete[] btemp;
+}
+
+/// @private
+/** \brief <b> Left-mixing convolution at time step `n` within the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes \f$ C^\rceil(t_n,\tau) = \int_0^\beta ds A^\rceil(t_n,s) B^\mathrm{M}(s-\tau)
+ * > + \int_{t_{j_0}}^{t_n} ds A^\mathrm{R}(t_n,s) B^\rceil(s,\tau) \f$ and writes it to `ctv`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param ctv
+ * > [complex] result, size (ntau+1)*element_size
+ * @param A
+ * > [GG] contour function
+ * @param B
+ * > [GG] contour function
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step interval
+ */
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_window_tv(int n, std::complex<T> *ctv, GG &A, GG &B,
+                                    integration::Integrator<T> &I, T beta, T h) {
+    typedef std::complex<T> cplx;
+    int size1 = A.size1(), ntau = A.ntau();
+    int sa = A.element_size(), sb = B.element_size(), sc = sa;
+    int j0 = window_start(n, A.nc()), j, m, l;
+    T dtau = beta / ntau, weight;
+    cplx *ctemp, *atemp;
+
+    ctemp = new cplx[sc];
+    atemp = new cplx[sa];
+    for (m = 0; m <= ntau; m++) {
+        matsubara_integral_2<T, SIZE1>(size1, m, ntau, ctemp, A.tvptr(n, 0), B.matptr(0), I,
+                                       B.sig());
+        for (l = 0; l < sc; l++)
+            ctv[m * sc + l] = dtau * ctemp[l];
+    }
+    for (j = j0; j <= n; j++) {
+        weight = h * I.gregory_weights(n - j0, j - j0);
+        element_set<T, SIZE1>(size1, atemp, A.retptr(n, j));
+        for (m = 0; m <= ntau; m++)
+            element_incr<T, SIZE1>(size1, ctv + m * sc, weight, atemp, B.tvptr(j, m));
+    }
+    delete[] ctemp;
+    delete[] atemp;
+}
+
+/// @private
+/** \brief <b> Contribution \f$ A^\rceil * B^\lceil \f$ to the lesser convolution within the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Adds \f$ -i \int_0^\beta d\tau A^\rceil(t_j,\tau) B^\lceil(\tau,t_n) \f$ to
+ * > `cles + (j-j1)*element_size` for \f$ j = j_1,\dots,j_2 \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param j1
+ * > [int] first row
+ * @param j2
+ * > [int] last row
+ * @param cles
+ * > [complex] result, size (j2-j1+1)*element_size
+ * @param A
+ * > [GG] contour function
+ * @param Bcc
+ * > [GG] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ */
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_window_les_tvvt(int n, int j1, int j2, std::complex<T> *cles, GG &A,
+                                          GG &Bcc, integration::Integrator<T> &I, T beta) {
+    typedef std::complex<T> cplx;
+    int size1 = A.size1(), ntau = A.ntau(), sig = A.sig();
+    int sa = A.element_size(), sb = Bcc.element_size(), sc = sa, j, m, l;
+    T dtau = beta / ntau;
+    cplx *btemp, idtau = cplx(0, -dtau);
+
+    btemp = new cplx[(ntau + 1) * sb];
+    for (m = 0; m <= ntau; m++)
+        element_conj<T, SIZE1>(size1, btemp + m * sb, Bcc.tvptr(n, ntau - m));
+    for (l = 0; l < (ntau + 1) * sb; l++)
+        btemp[l] *= idtau * (-(T)sig);
+    for (j = j1; j <= j2; j++) {
+        for (m = 0; m <= ntau; m++)
+            element_incr<T, SIZE1>(size1, cles + (j - j1) * sc, I.gregory_weights(ntau, m),
+                                   A.tvptr(j, m), btemp + m * sb);
+    }
+    delete[] btemp;
+}
+
+/// @private
+/** \brief <b> Contribution \f$ A^< * B^\mathrm{A} \f$ to the lesser convolution within the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Adds \f$ \int_{t_{j_0}}^{t_n} ds A^<(t_j,s) B^\mathrm{A}(s,t_n) \f$ to
+ * > `cles + (j-j1)*element_size` for \f$ j = j_1,\dots,j_2 \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param j1
+ * > [int] first row
+ * @param j2
+ * > [int] last row
+ * @param cles
+ * > [complex] result, size (j2-j1+1)*element_size
+ * @param A
+ * > [GG] contour function
+ * @param Acc
+ * > [GG] complex conjugate to A
+ * @param Bcc
+ * > [GG] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param h
+ * > time step interval
+ */
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_window_les_lesadv(int n, int j1, int j2, std::complex<T> *cles,
+                                            GG &A, GG &Acc, GG &Bcc,
+                                            integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    int size1 = A.size1(), sa = A.element_size(), sb = Bcc.element_size(), sc = sa;
+    int j0 = window_start(n, A.nc()), j, m, l;
+    T weight;
+    cplx *ales, *badv;
+
+    ales = new cplx[sa];
+    badv = new cplx[(n - j0 + 1) * sb];
+    for (m = j0; m <= n; m++) {
+        weight = h * I.gregory_weights(n - j0, m - j0);
+        element_conj<T, SIZE1>(size1, badv + (m - j0) * sb, Bcc.retptr(n, m));
+        for (l = 0; l < sb; l++)
+            badv[(m - j0) * sb + l] *= weight;
+    }
+    for (j = j1; j <= j2; j++) {
+        for (m = j0; m < j; m++) {
+            element_minusconj<T, SIZE1>(size1, ales, Acc.lesptr(m, j));
+            element_incr<T, SIZE1>(size1, cles + (j - j1) * sc, ales, badv + (m - j0) * sb);
+        }
+        for (m = j; m <= n; m++)
+            element_incr<T, SIZE1>(size1, cles + (j - j1) * sc, A.lesptr(j, m),
+                                   badv + (m - j0) * sb);
+    }
+    delete[] ales;
+    delete[] badv;
+}
+
+/// @private
+/** \brief <b> Contribution \f$ A^\mathrm{R} * B^< \f$ to the lesser convolution within the window. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *   \par Purpose
+ * <!-- ========= -->
+ *
+ * > Adds \f$ \int_{t_{j_0}}^{t_j} ds A^\mathrm{R}(t_j,s) B^<(s,t_n) \f$ to
+ * > `cles + (j-j0)*element_size` for \f$ j = j_0,\dots,n \f$.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param cles
+ * > [complex] result, size (n-j0+1)*element_size
+ * @param A
+ * > [GG] contour function
+ * @param Acc
+ * > [GG] complex conjugate to A
+ * @param B
+ * > [GG] contour function
+ * @param I
+ * > [Integrator] integrator class
+ * @param h
+ * > time step interval
+ */
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_window_les_retles(int n, std::complex<T> *cles, GG &A, GG &Acc,
+                                            GG &B, integration::Integrator<T> &I, T h) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), size1 = A.size1(), sa = A.element_size(), sb = B.element_size();
+    int sc = sa, j0 = window_start(n, A.nc()), j, m, l, jw;
+    T weight;
+    cplx *atemp, *bles;
+
+    atemp = new cplx[sa];
+    bles = new cplx[(n - j0 + 1) * sb];
+    for (m = j0; m <= n; m++) {
+        for (l = 0; l < sb; l++)
+            bles[(m - j0) * sb + l] = h * B.lesptr(m, n)[l];
+    }
+    for (j = j0; j <= n; j++) {
+        jw = j - j0;
+        if (jw >= k) {
+            for (m = j0; m <= j; m++)
+                element_incr<T, SIZE1>(size1, cles + jw * sc, I.gregory_weights(jw, m - j0),
+                                       A.retptr(j, m), bles + (m - j0) * sb);
+        } else {
+            // short interval: A(j,m), m > j, continued to -Acc(m,j)*
+            for (m = j0; m <= j0 + k; m++) {
+                weight = I.gregory_weights(jw, m - j0);
+                if (m <= j) {
+                    element_incr<T, SIZE1>(size1, cles + jw * sc, weight, A.retptr(j, m),
+                                           bles + (m - j0) * sb);
+                } else {
+                    element_conj<T, SIZE1>(size1, atemp, Acc.retptr(m, j));
+                    element_incr<T, SIZE1>(size1, cles + jw * sc, -weight, atemp,
+                                           bles + (m - j0) * sb);
+                }
+            }
+        }
+    }
+    delete[] atemp;
+    delete[] bles;
+}
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void convolution_timestep_window_dispatch(int n, GG &C, GG &A, GG &Acc, GG &B, GG &Bcc,
+                                          integration::Integrator<T> &I, T beta, T h) {
+    typedef std::complex<T> cplx;
+    int size1 = C.size1(), ntau = C.ntau(), sc = C.element_size();
+    int j0 = window_start(n, C.nc()), j, m;
+    cplx *cret, *ctv, *cles;
+
+    cret = new cplx[(n - j0 + 1) * sc];
+    ctv = new cplx[(ntau + 1) * sc];
+    cles = new cplx[(n - j0 + 1) * sc];
+    for (m = 0; m < (n - j0 + 1) * sc; m++)
+        cles[m] = 0;
+    convolution_timestep_window_ret<T, GG, SIZE1>(n, cret, A, Acc, B, Bcc, I, h);
+    convolution_timestep_window_tv<T, GG, SIZE1>(n, ctv, A, B, I, beta, h);
+    convolution_timestep_window_les_tvvt<T, GG, SIZE1>(n, j0, n, cles, A, Bcc, I, beta);
+    convolution_timestep_window_les_lesadv<T, GG, SIZE1>(n, j0, n, cles, A, Acc, Bcc, I, h);
+    convolution_timestep_window_les_retles<T, GG, SIZE1>(n, cles, A, Acc, B, I, h);
+    C.advance(n);
+    for (j = j0; j <= n; j++) {
+        element_set<T, SIZE1>(size1, C.retptr(n, j), cret + (j - j0) * sc);
+        element_set<T, SIZE1>(size1, C.lesptr(j, n), cles + (j - j0) * sc);
+    }
+    for (m = 0; m <= ntau; m++)
+        element_set<T, SIZE1>(size1, C.tvptr(n, m), ctv + m * sc);
+    delete[] cret;
+    delete[] ctv;
+    delete[] cles;
+}
+
+/** \brief <b> Memory-truncated convolution \f$ C = A*B \f$ at a given time step. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Computes the contour convolution \f$ C = A*B \f$ at time step `n` for contour
+ * > functions stored in a `herm_matrix_window`. The real-time integrals are restricted
+ * > to the window \f$ [\max(0,n-n_c),n] \f$, so the cost does not grow with `n`.
+ * > For `n <= nc` the result agrees with `convolution_timestep`.
+ * > `C` is moved forward to time step `n`. Requires `n > k` and `nc > k`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param C
+ * > [herm_matrix_window] result
+ * @param A
+ * > [herm_matrix_window] contour function
+ * @param Acc
+ * > [herm_matrix_window] complex conjugate to A
+ * @param B
+ * > [herm_matrix_window] contour function
+ * @param Bcc
+ * > [herm_matrix_window] complex conjugate to B
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step interval
+ */
+template <typename T>
+void convolution_timestep_window(int n, herm_matrix_window<T> &C, herm_matrix_window<T> &A,
+                                 herm_matrix_window<T> &Acc, herm_matrix_window<T> &B,
+                                 herm_matrix_window<T> &Bcc, integration::Integrator<T> &I,
+                                 T beta, T h) {
+    int size1 = C.size1(), nc = C.nc(), ntau = C.ntau(), j0 = window_start(n, C.nc());
+    assert(n > I.k() && nc > I.k());
+    assert(A.size1() == size1 && B.size1() == size1);
+    assert(A.ntau() == ntau && B.ntau() == ntau);
+    assert(A.nc() == nc && Acc.nc() == nc && B.nc() == nc && Bcc.nc() == nc);
+    assert(A.tmax() >= n && A.tmin() <= j0 && Acc.tmax() >= n && Acc.tmin() <= j0);
+    assert(B.tmax() >= n && B.tmin() <= j0 && Bcc.tmax() >= n && Bcc.tmin() <= j0);
+    assert(C.tmax() <= n);
+    if (size1 == 1)
+        convolution_timestep_window_dispatch<T, herm_matrix_window<T>, 1>(n, C, A, Acc, B, Bcc,
+                                                                         I, beta, h);
+    else
+        convolution_timestep_window_dispatch<T, herm_matrix_window<T>, LARGESIZE>(
+            n, C, A, Acc, B, Bcc, I, beta, h);
+}
+
+/** \brief <b> Memory-truncated convolution \f$ C = A*B \f$ at a given time step. </b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `convolution_timestep_window` with an `Integrator`, for given integration order.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param C
+ * > [herm_matrix_window] result
+ * @param A
+ * > [herm_matrix_window] contour function
+ * @param Acc
+ * > [herm_matrix_window] complex conjugate to A
+ * @param B
+ * > [herm_matrix_window] contour function
+ * @param Bcc
+ * > [herm_matrix_window] complex conjugate to B
+ * @param beta
+ * > inverse temperature
+ * @param h
+ * > time step interval
+ * @param SolveOrder
+ * > [int] integration order
+ */
+template <typename T>
+void convolution_timestep_window(int n, herm_matrix_window<T> &C, herm_matrix_window<T> &A,
+                                 herm_matrix_window<T> &Acc, herm_matrix_window<T> &B,
+                                 herm_matrix_window<T> &Bcc, T beta, T h, int SolveOrder) {
+    convolution_timestep_window(n, C, A, Acc, B, Bcc, integration::I<T>(SolveOrder), beta, h);
+}
+
+/* #######################################################################################
+#
+#  MEMORY-TRUNCATED DYSON EQUATION
+#
+#      [ id/dt + mu - H(t) ] G(t,t') - [Sigma*G](t,t') = 1(t,t')
+#
+#  Same scheme as dyson_timestep, with the integrals restricted to [j0,n]. For j0 > 0
+#  the lesser component G^les(j,n) is started at j=j0 from the conjugate equation
+#  (derivative with respect to the second time), then propagated in j as usual.
+#
+###########################################################################################*/
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_window_ret(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
+                               integration::Integrator<T> &I, T h, dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), k1 = k + 1;
+    int sg, l, j, i, p, q, m, j2, j0, size1 = G.size1();
+    cplx *gret, *gtemp, *mm, *qq, *qqj, *stemp, *one, cplx_i, cweight, *diffw, *hj, w0;
+    T weight;
+    cplx_i = cplx(0, 1);
+
+    sg = G.element_size();
+    j0 = window_start(n, G.nc());
+    gtemp = ws.gtemp();
+    diffw = ws.diffw();
+    qq = ws.qq();
+    one = ws.one();
+    mm = ws.mm();
+    hj = ws.htemp();
+    stemp = ws.stemp();
+    element_set<T, SIZE1>(size1, one, 1);
+    // SET ENTRIES IN TIMESTEP TO 0
+    gret = G.retptr(n, n);
+    for (i = 0; i < (n - j0 + 1) * sg; i++)
+        gret[i] = 0;
+    // INITIAL VALUE t' = n
+    element_set<T, SIZE1>(size1, G.retptr(n, n), -cplx_i);
+    // START VALUES  t' = n-j, j = 1...k: solve a kxk problem
+    for (i = 0; i < k * k * sg; i++)
+        mm[i] = 0;
+    for (i = 0; i < k * sg; i++)
+        qq[i] = 0;
+    for (j = 1; j <= k; j++) {
+        p = j - 1;
+        for (l = 0; l <= k; l++) {
+            cweight = cplx_i / h * I.poly_differentiation(j, l);
+            if (l == 0) {
+                element_incr<T, SIZE1>(size1, qq + p * sg, -cweight, G.retptr(n, n));
+            } else {
+                q = l - 1;
+                element_incr<T, SIZE1>(size1, mm + sg * (p * k + q), cweight);
+            }
+        }
+        element_set<T, SIZE1>(size1, gtemp, H + (n - j) * sg);
+        element_smul<T, SIZE1>(size1, gtemp, -1);
+        for (i = 0; i < sg; i++)
+            gtemp[i] += mu * one[i];
+        element_incr<T, SIZE1>(size1, mm + sg * (p + k * p), gtemp);
+        for (l = 0; l <= k; l++) {
+            weight = h * I.gregory_weights(j, l);
+            if (n - l >= n - j) {
+                element_set<T, SIZE1>(size1, stemp, Sigma.retptr(n - l, n - j));
+            } else {
+                element_set<T, SIZE1>(size1, stemp, Sigma.retptr(n - j, n - l));
+                element_conj<T, SIZE1>(size1, stemp);
+                weight *= -1;
+            }
+            if (l == 0) {
+                element_incr<T, SIZE1>(size1, qq + p * sg, weight, G.retptr(n, n), stemp);
+            } else {
+                q = l - 1;
+                element_incr<T, SIZE1>(size1, mm + sg * (p * k + q), -weight, stemp);
+            }
+        }
+    }
+    element_linsolve_left<T, SIZE1>(size1, k, gtemp, mm, qq);
+    for (j = 1; j <= k; j++)
+        element_set<T, SIZE1>(size1, G.retptr(n, n - j), gtemp + (j - 1) * sg);
+    // contribution of G(n,m=n-k..n) to int dm G(n,m)Sigma(m,j), j=j0..n-k-1,
+    // stored into qq(j-j0) without factor h
+    for (i = 0; i < sg * (n - j0 + 1); i++)
+        qq[i] = 0;
+    for (m = n - k; m <= n; m++) {
+        for (j = j0; j < n - k; j++)
+            element_incr<T, SIZE1>(size1, qq + (j - j0) * sg, I.gregory_weights(n - j, n - m),
+                                   G.retptr(n, m), Sigma.retptr(m, j));
+    }
+    // t' = n-l, l = k+1 ... n-j0:
+    for (p = 0; p <= k1; p++)
+        diffw[p] = I.bd_weights(p) * cplx_i / h;
+    w0 = h * I.gregory_omega(0);
+    for (l = k + 1; l <= n - j0; l++) {
+        j = n - l;
+        element_set<T, SIZE1>(size1, hj, H + j * sg);
+        element_conj<T, SIZE1>(size1, hj);
+        qqj = qq + (j - j0) * sg;
+        for (i = 0; i < sg; i++) {
+            qqj[i] *= h;
+            for (p = 1; p <= k1; p++)
+                qqj[i] += -diffw[p] * G.retptr(n, n - l + p)[i];
+        }
+        element_set<T, SIZE1>(size1, stemp, Sigma.retptr(j, j));
+        for (i = 0; i < sg; i++)
+            mm[i] = diffw[0] * one[i] + mu * one[i] - hj[i] - w0 * stemp[i];
+        element_linsolve_left<T, SIZE1>(size1, G.retptr(n, j), mm, qqj);
+        gret = G.retptr(n, j);
+        for (j2 = j0; j2 < j; j2++)
+            element_incr<T, SIZE1>(size1, qq + (j2 - j0) * sg, I.gregory_weights(n - j2, n - j),
+                                   gret, Sigma.retptr(j, j2));
+    }
+}
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_window_tv(int n, GG &G, T mu, std::complex<T> *Hn, GG &Sigma,
+                              integration::Integrator<T> &I, T beta, T h,
+                              dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), sg, l, m, j, j0, ntau, size1 = G.size1();
+    cplx *gtv, *gtv1, cweight, ih, *mm, *qq, *stemp, *one, *htemp;
+    T weight;
+
+    sg = G.element_size();
+    ntau = G.ntau();
+    j0 = window_start(n, G.nc());
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    stemp = ws.stemp();
+    htemp = ws.htemp();
+    element_set<T, SIZE1>(size1, one, 1.0);
+    gtv = G.tvptr(n, 0);
+    for (l = 0; l < (ntau + 1) * sg; l++)
+        gtv[l] = 0;
+    // CONVOLUTION SIGMA*G:  --->  Gtv(n,m)
+    convolution_timestep_window_tv<T, GG, SIZE1>(n, ws.tv(), Sigma, G, I, beta, h);
+    for (l = 0; l < (ntau + 1) * sg; l++)
+        gtv[l] = ws.tv()[l];
+    // ACCUMULATE CONTRIBUTION TO id/dt G(t,t') FROM t=mh, m=n-k-1..n-1
+    ih = cplx(0, 1 / h);
+    for (m = n - k - 1; m < n; m++) {
+        cweight = ih * I.bd_weights(n - m);
+        gtv1 = G.tvptr(m, 0);
+        for (l = 0; l < (ntau + 1) * sg; l++)
+            gtv[l] -= cweight * gtv1[l];
+    }
+    // [ i/h bd(0) - H - h w(n,n) Sigma(n,n) ] G(n,m)  = Q(m)
+    element_set<T, SIZE1>(size1, stemp, Sigma.retptr(n, n));
+    weight = -h * I.gregory_weights(n - j0, 0);
+    element_set<T, SIZE1>(size1, htemp, Hn);
+    for (l = 0; l < sg; l++)
+        mm[l] = ih * I.bd_weights(0) * one[l] + weight * stemp[l] + mu * one[l] - htemp[l];
+    for (j = 0; j <= ntau; j++) {
+        for (l = 0; l < sg; l++)
+            qq[l] = G.tvptr(n, j)[l];
+        element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
+    }
+}
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void dyson_timestep_window_les(int n, GG &G, T mu, std::complex<T> *H, GG &Sigma,
+                               integration::Integrator<T> &I, T beta, T h,
+                               dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), k1 = k + 1;
+    int sg, l, m, j, jw, j0, nw, p, q, size1 = G.size1();
+    cplx *gles, cweight, *mm, *qq, *stemp, cplx_i = cplx(0, 1), *one, *gtemp, *qtemp;
+
+    sg = G.element_size();
+    j0 = window_start(n, G.nc());
+    nw = n - j0;
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    gtemp = ws.htemp();
+    qtemp = ws.qtemp();
+    stemp = ws.stemp();
+    gles = ws.gles();
+    for (jw = 0; jw <= nw; jw++)
+        element_set_zero<T, SIZE1>(size1, gles + jw * sg);
+    for (j = j0; j <= n; j++)
+        element_set_zero<T, SIZE1>(size1, G.lesptr(j, n));
+    element_set<T, SIZE1>(size1, one, 1.0);
+
+    // CONVOLUTION SIGMA*G:  --->  G^les(j,n), only the tv*vt + les*adv part
+    convolution_timestep_window_les_tvvt<T, GG, SIZE1>(n, j0, n, gles, Sigma, G, I, beta);
+    convolution_timestep_window_les_lesadv<T, GG, SIZE1>(n, j0, n, gles, Sigma, Sigma, G, I, h);
+    // INITIAL VALUE G^les(j0,n)
+    if (j0 == 0) {
+        // G^les(0,n) = -G^tv(n,0)^*
+        element_conj<T, SIZE1>(size1, gles, G.tvptr(n, 0));
+        element_smul<T, SIZE1>(size1, gles, -1);
+    } else {
+        // G^les(j0,t)[-id/dt + mu - H(t)] = [G*Sigma]^les(j0,t) at t = n:
+        // G^les(j0,n) * mm = qtemp
+        element_set_zero<T, SIZE1>(size1, qtemp);
+        convolution_timestep_window_les_tvvt<T, GG, SIZE1>(n, j0, j0, qtemp, G, Sigma, I, beta);
+        convolution_timestep_window_les_lesadv<T, GG, SIZE1>(n, j0, j0, qtemp, G, G, Sigma, I,
+                                                             h);
+        for (p = 1; p <= k1; p++)
+            element_incr<T, SIZE1>(size1, qtemp, cplx_i / h * I.bd_weights(p),
+                                   G.lesptr(j0, n - p));
+        element_conj<T, SIZE1>(size1, stemp, Sigma.retptr(n, n));
+        element_set<T, SIZE1>(size1, gtemp, H + n * sg);
+        for (l = 0; l < sg; l++)
+            mm[l] = (-cplx_i / h * I.bd_weights(0) + mu) * one[l] - gtemp[l] -
+                    h * I.gregory_weights(nw, nw) * stemp[l];
+        element_linsolve_left<T, SIZE1>(size1, gles, mm, qtemp);
+    }
+    // Start for integrodifferential equation: j=j0+1...j0+k
+    for (l = 0; l < k * k * sg; l++)
+        mm[l] = 0;
+    for (l = 0; l < k * sg; l++)
+        qq[l] = 0;
+    for (jw = 1; jw <= k; jw++) {
+        j = j0 + jw;
+        p = jw - 1;
+        element_incr<T, SIZE1>(size1, qq + p * sg, gles + jw * sg);
+        for (m = 0; m <= k; m++) {
+            cweight = cplx_i / h * I.poly_differentiation(jw, m);
+            if (m == 0) {
+                for (l = 0; l < sg; l++)
+                    qq[p * sg + l] -= cweight * gles[l];
+            } else {
+                q = m - 1;
+                for (l = 0; l < sg; l++)
+                    mm[sg * (p * k + q) + l] += cweight * one[l];
+            }
+        }
+        element_set<T, SIZE1>(size1, gtemp, H + sg * j);
+        element_smul<T, SIZE1>(size1, gtemp, -1);
+        for (l = 0; l < sg; l++)
+            gtemp[l] += mu * one[l];
+        element_incr<T, SIZE1>(size1, mm + sg * (p * k + p), gtemp);
+        for (m = 0; m <= k; m++) {
+            cweight = h * I.gregory_weights(jw, m);
+            if (m == 0) {
+                element_incr<T, SIZE1>(size1, qq + p * sg, cweight, Sigma.retptr(j, j0), gles);
+            } else {
+                q = m - 1;
+                if (jw >= m) {
+                    element_set<T, SIZE1>(size1, stemp, Sigma.retptr(j, j0 + m));
+                } else {
+                    element_set<T, SIZE1>(size1, stemp, Sigma.retptr(j0 + m, j));
+                    element_conj<T, SIZE1>(size1, stemp);
+                    element_smul<T, SIZE1>(size1, stemp, -1);
+                }
+                for (l = 0; l < sg; l++)
+                    mm[sg * (p * k + q) + l] += -cweight * stemp[l];
+            }
+        }
+    }
+    element_linsolve_right<T, SIZE1>(size1, k, gles + 1 * sg, mm, qq);
+    // integrodifferential equation j0+k+1...n
+    for (jw = k + 1; jw <= nw; jw++) {
+        j = j0 + jw;
+        element_set_zero<T, SIZE1>(size1, mm);
+        element_set<T, SIZE1>(size1, qq, gles + jw * sg);
+        for (p = 1; p <= k1; p++) {
+            cweight = -cplx_i / h * I.bd_weights(p);
+            for (l = 0; l < sg; l++)
+                qq[l] += cweight * gles[sg * (jw - p) + l];
+        }
+        for (l = 0; l < sg; l++)
+            mm[l] += cplx_i / h * I.bd_weights(0) * one[l];
+        element_set<T, SIZE1>(size1, gtemp, H + sg * j);
+        element_smul<T, SIZE1>(size1, gtemp, -1);
+        for (l = 0; l < sg; l++)
+            gtemp[l] += mu * one[l];
+        element_incr<T, SIZE1>(size1, mm, gtemp);
+        element_set<T, SIZE1>(size1, stemp, Sigma.retptr(j, j));
+        for (l = 0; l < sg; l++)
+            mm[l] += -h * stemp[l] * I.gregory_weights(jw, jw);
+        for (m = 0; m < jw; m++) {
+            cweight = h * I.gregory_weights(jw, m);
+            element_incr<T, SIZE1>(size1, qq, cweight, Sigma.retptr(j, j0 + m), gles + m * sg);
+        }
+        element_linsolve_right<T, SIZE1>(size1, gles + jw * sg, mm, qq);
+    }
+    for (j = j0; j <= n; j++)
+        element_set<T, SIZE1>(size1, G.lesptr(j, n), gles + (j - j0) * sg);
+}
+
+/** \brief <b> Memory-truncated Dyson solver (integral-differential form) at a given time step.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Solves \f$ [ i\partial_t + \mu - H(t) ] G(t,t') - [\Sigma*G](t,t') = \delta_\mathcal{C}(t,t') \f$
+ * > at time step `n` for `G` and `Sigma` stored in a `herm_matrix_window`. All real-time
+ * > integrals are restricted to \f$ [\max(0,n-n_c),n] \f$, which gives a cost
+ * > \f$ O(n_c^2) \f$ per time step. For `n <= nc` the result agrees with `dyson_timestep`.
+ * > `G` is moved forward to time step `n` and must contain the time steps
+ * > `max(0,n-nc)` ... `n-1`; the first `k+1` time steps are typically computed with
+ * > `dyson_start` and copied into the window with `set_timestep`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param &G
+ * > [herm_matrix_window<T>] solution
+ * @param mu
+ * > [T] chemical potential
+ * @param &H
+ * > [function<T>] time-dependent function
+ * @param &Sigma
+ * > [herm_matrix_window<T>] self-energy
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > [double] inverse temperature
+ * @param h
+ * > [double] time interval
+ * @param &ws
+ * > [dyson_workspace<T>] scratch memory, enlarged if needed
+ */
+template <typename T>
+void dyson_timestep_window(int n, herm_matrix_window<T> &G, T mu, function<T> &H,
+                           herm_matrix_window<T> &Sigma, integration::Integrator<T> &I, T beta,
+                           T h, dyson_workspace<T> &ws) {
+    int size1 = G.size1(), k = I.k(), nc = G.nc(), j0 = window_start(n, G.nc());
+    assert(n > k && nc > k);
+    assert(Sigma.size1() == size1 && Sigma.ntau() == G.ntau() && Sigma.nc() == nc);
+    assert(Sigma.sig() == G.sig());
+    assert(Sigma.tmax() >= n && Sigma.tmin() <= j0);
+    assert(G.tmax() >= n - 1 && G.tmax() <= n && G.tmin() <= j0);
+    assert(H.nt() >= n);
+    G.advance(n);
+    ws.reserve(nc, G.ntau(), size1, k);
+    if (size1 == 1) {
+        dyson_timestep_window_ret<T, herm_matrix_window<T>, 1>(n, G, mu, H.ptr(0), Sigma, I, h,
+                                                              ws);
+        dyson_timestep_window_tv<T, herm_matrix_window<T>, 1>(n, G, mu, H.ptr(n), Sigma, I,
+                                                             beta, h, ws);
+        dyson_timestep_window_les<T, herm_matrix_window<T>, 1>(n, G, mu, H.ptr(0), Sigma, I,
+                                                              beta, h, ws);
+    } else {
+        dyson_timestep_window_ret<T, herm_matrix_window<T>, LARGESIZE>(n, G, mu, H.ptr(0),
+                                                                      Sigma, I, h, ws);
+        dyson_timestep_window_tv<T, herm_matrix_window<T>, LARGESIZE>(n, G, mu, H.ptr(n),
+                                                                     Sigma, I, beta, h, ws);
+        dyson_timestep_window_les<T, herm_matrix_window<T>, LARGESIZE>(n, G, mu, H.ptr(0),
+                                                                      Sigma, I, beta, h, ws);
+    }
+}
+
+/** \brief <b> Memory-truncated Dyson solver (integral-differential form) at a given time step.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `dyson_timestep_window` with an `Integrator`, for given integration order.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param &G
+ * > [herm_matrix_window<T>] solution
+ * @param mu
+ * > [T] chemical potential
+ * @param &H
+ * > [function<T>] time-dependent function
+ * @param &Sigma
+ * > [herm_matrix_window<T>] self-energy
+ * @param beta
+ * > [double] inverse temperature
+ * @param h
+ * > [double] time interval
+ * @param SolveOrder
+ * > [int] integrator order
+ */
+template <typename T>
+void dyson_timestep_window(int n, herm_matrix_window<T> &G, T mu, function<T> &H,
+                           herm_matrix_window<T> &Sigma, T beta, T h, int SolveOrder) {
+    dyson_timestep_window(n, G, mu, H, Sigma, integration::I<T>(SolveOrder), beta, h,
+                          dyson_workspace<T>::local());
+}
+
+/* #######################################################################################
+#
+#  MEMORY-TRUNCATED VIE2:  [1+F]*G = Q,  G,Q hermitian
+#
+###########################################################################################*/
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void vie2_timestep_window_ret(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
+                              T h, dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k();
+    int sg, l, j, i, p, q, m, j2, j0, size1 = G.size1();
+    cplx *gret, *gtemp, *mm, *qq, *qqj, *stemp, *one, w0;
+    T weight;
+
+    sg = G.element_size();
+    j0 = window_start(n, G.nc());
+    gtemp = ws.gtemp();
+    qq = ws.qq();
+    one = ws.one();
+    mm = ws.mm();
+    stemp = ws.stemp();
+    element_set<T, SIZE1>(size1, one, 1);
+    gret = G.retptr(n, n);
+    for (i = 0; i < (n - j0 + 1) * sg; i++)
+        gret[i] = 0;
+    // INITIAL VALUE t' = n
+    element_set<T, SIZE1>(size1, G.retptr(n, n), Q.retptr(n, n));
+    // START VALUES  t' = n-j, j = 1...k: solve a kxk problem
+    for (i = 0; i < k * k * sg; i++)
+        mm[i] = 0;
+    for (i = 0; i < k * sg; i++)
+        qq[i] = 0;
+    for (j = 1; j <= k; j++) {
+        p = j - 1;
+        element_incr<T, SIZE1>(size1, qq + p * sg, Q.retptr(n, n - j));
+        element_incr<T, SIZE1>(size1, mm + sg * (p + k * p), one);
+        for (l = 0; l <= k; l++) {
+            weight = -h * I.gregory_weights(j, l);
+            if (n - l >= n - j) {
+                element_set<T, SIZE1>(size1, stemp, F.retptr(n - l, n - j));
+            } else {
+                element_set<T, SIZE1>(size1, stemp, Fcc.retptr(n - j, n - l));
+                element_conj<T, SIZE1>(size1, stemp);
+                weight *= -1;
+            }
+            if (l == 0) {
+                element_incr<T, SIZE1>(size1, qq + p * sg, weight, G.retptr(n, n), stemp);
+            } else {
+                q = l - 1;
+                element_incr<T, SIZE1>(size1, mm + sg * (p * k + q), -weight, stemp);
+            }
+        }
+    }
+    element_linsolve_left<T, SIZE1>(size1, k, gtemp, mm, qq);
+    for (j = 1; j <= k; j++)
+        element_set<T, SIZE1>(size1, G.retptr(n, n - j), gtemp + (j - 1) * sg);
+    // contribution of G(n,m=n-k..n) to int dm G(n,m)F(m,j), j=j0..n-k-1
+    for (i = 0; i < sg * (n - j0 + 1); i++)
+        qq[i] = 0;
+    for (m = n - k; m <= n; m++) {
+        for (j = j0; j < n - k; j++)
+            element_incr<T, SIZE1>(size1, qq + (j - j0) * sg, -I.gregory_weights(n - j, n - m),
+                                   G.retptr(n, m), F.retptr(m, j));
+    }
+    // t' = n-l, l = k+1 ... n-j0:
+    w0 = -h * I.gregory_omega(0);
+    for (l = k + 1; l <= n - j0; l++) {
+        j = n - l;
+        qqj = qq + (j - j0) * sg;
+        for (i = 0; i < sg; i++)
+            qqj[i] *= h;
+        element_set<T, SIZE1>(size1, stemp, F.retptr(j, j));
+        for (i = 0; i < sg; i++)
+            mm[i] = one[i] - w0 * stemp[i];
+        element_incr<T, SIZE1>(size1, qqj, Q.retptr(n, j));
+        element_linsolve_left<T, SIZE1>(size1, G.retptr(n, j), mm, qqj);
+        gret = G.retptr(n, j);
+        for (j2 = j0; j2 < j; j2++)
+            element_incr<T, SIZE1>(size1, qq + (j2 - j0) * sg,
+                                   -I.gregory_weights(n - j2, n - j), gret, F.retptr(j, j2));
+    }
+}
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void vie2_timestep_window_tv(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
+                             T beta, T h, dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int sg, l, j, j0, ntau, size1 = G.size1();
+    cplx *gtv, *mm, *qq, *stemp, *one;
+    T weight;
+
+    sg = G.element_size();
+    ntau = G.ntau();
+    j0 = window_start(n, G.nc());
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    stemp = ws.stemp();
+    element_set<T, SIZE1>(size1, one, 1.0);
+    gtv = G.tvptr(n, 0);
+    for (l = 0; l < (ntau + 1) * sg; l++)
+        gtv[l] = 0;
+    convolution_timestep_window_tv<T, GG, SIZE1>(n, ws.tv(), F, G, I, beta, h);
+    // [ 1 + h w(n,n) F(n,n) ] G(n,m)  = Q(m) - [F*G](n,m)
+    element_set<T, SIZE1>(size1, stemp, F.retptr(n, n));
+    weight = h * I.gregory_weights(n - j0, 0);
+    for (l = 0; l < sg; l++)
+        mm[l] = one[l] + weight * stemp[l];
+    for (j = 0; j <= ntau; j++) {
+        for (l = 0; l < sg; l++)
+            qq[l] = -ws.tv()[j * sg + l] + Q.tvptr(n, j)[l];
+        element_linsolve_right<T, SIZE1>(size1, G.tvptr(n, j), mm, qq);
+    }
+}
+
+/// @private
+template <typename T, class GG, int SIZE1>
+void vie2_timestep_window_les(int n, GG &G, GG &F, GG &Fcc, GG &Q, integration::Integrator<T> &I,
+                              T beta, T h, dyson_workspace<T> &ws) {
+    typedef std::complex<T> cplx;
+    int k = I.get_k(), k1 = k + 1;
+    int sg, l, m, j, jw, j0, nw, p, q, size1 = G.size1();
+    cplx *gles, cweight, *mm, *qq, *stemp, *one;
+
+    sg = G.element_size();
+    j0 = window_start(n, G.nc());
+    nw = n - j0;
+    one = ws.one();
+    qq = ws.qq();
+    mm = ws.mm();
+    stemp = ws.stemp();
+    gles = ws.gles();
+    for (jw = 0; jw <= nw; jw++)
+        element_set_zero<T, SIZE1>(size1, gles + jw * sg);
+    element_set<T, SIZE1>(size1, one, 1.0);
+    // CONVOLUTION F*G:  --->  G^les(j,n), only the tv*vt + les*adv part
+    convolution_timestep_window_les_tvvt<T, GG, SIZE1>(n, j0, n, gles, F, G, I, beta);
+    convolution_timestep_window_les_lesadv<T, GG, SIZE1>(n, j0, n, gles, F, Fcc, G, I, h);
+    for (jw = 0; jw <= nw; jw++)
+        element_smul<T, SIZE1>(size1, gles + jw * sg, -1.0);
+    // Start: j=j0...j0+k, solve a (k+1)x(k+1) problem
+    for (l = 0; l < k1 * k1 * sg; l++)
+        mm[l] = 0;
+    for (l = 0; l < k1 * sg; l++)
+        qq[l] = 0;
+    for (jw = 0; jw <= k; jw++) {
+        j = j0 + jw;
+        p = jw;
+        element_incr<T, SIZE1>(size1, qq + p * sg, Q.lesptr(j, n));
+        element_incr<T, SIZE1>(size1, qq + p * sg, gles + jw * sg);
+        element_incr<T, SIZE1>(size1, mm + sg * (p * k1 + p), one);
+        for (m = 0; m <= k; m++) {
+            cweight = -h * I.gregory_weights(jw, m);
+            q = m;
+            if (jw >= m) {
+                element_set<T, SIZE1>(size1, stemp, F.retptr(j, j0 + m));
+            } else {
+                element_set<T, SIZE1>(size1, stemp, Fcc.retptr(j0 + m, j));
+                element_conj<T, SIZE1>(size1, stemp);
+                element_smul<T, SIZE1>(size1, stemp, -1);
+            }
+            for (l = 0; l < sg; l++)
+                mm[sg * (p * k1 + q) + l] += -cweight * stemp[l];
+        }
+    }
+    element_linsolve_right<T, SIZE1>(size1, k1, gles, mm, qq);
+    // j0+k+1...n
+    for (jw = k + 1; jw <= nw; jw++) {
+        j = j0 + jw;
+        element_set_zero<T, SIZE1>(size1, mm);
+        element_set<T, SIZE1>(size1, qq, gles + jw * sg);
+        element_incr<T, SIZE1>(size1, qq, Q.lesptr(j, n));
+        element_incr<T, SIZE1>(size1, mm, one);
+        element_set<T, SIZE1>(size1, stemp, F.retptr(j, j));
+        for (l = 0; l < sg; l++)
+            mm[l] += h * stemp[l] * I.gregory_weights(jw, jw);
+        for (m = 0; m < jw; m++) {
+            cweight = -h * I.gregory_weights(jw, m);
+            element_incr<T, SIZE1>(size1, qq, cweight, F.retptr(j, j0 + m), gles + m * sg);
+        }
+        element_linsolve_right<T, SIZE1>(size1, gles + jw * sg, mm, qq);
+    }
+    for (j = j0; j <= n; j++)
+        element_set<T, SIZE1>(size1, G.lesptr(j, n), gles + (j - j0) * sg);
+}
+
+/** \brief <b> Memory-truncated VIE2 solver \f$(1+F)*G=Q\f$ at a given time step.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Solves the linear equation \f$(1+F)*G=Q\f$ at time step `n` for contour functions
+ * > stored in a `herm_matrix_window`. All real-time integrals are restricted to
+ * > \f$ [\max(0,n-n_c),n] \f$. For `n <= nc` the result agrees with `vie2_timestep`.
+ * > `G` is moved forward to time step `n` and must contain the time steps
+ * > `max(0,n-nc)` ... `n-1`.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param &G
+ * > [herm_matrix_window<T>] solution
+ * @param &F
+ * > [herm_matrix_window<T>] kernel on the left-hand side
+ * @param &Fcc
+ * > [herm_matrix_window<T>] hermitian conjugate of F
+ * @param &Q
+ * > [herm_matrix_window<T>] source term
+ * @param I
+ * > [Integrator] integrator class
+ * @param beta
+ * > [double] inverse temperature
+ * @param h
+ * > [double] time interval
+ * @param &ws
+ * > [dyson_workspace<T>] scratch memory, enlarged if needed
+ */
+template <typename T>
+void vie2_timestep_window(int n, herm_matrix_window<T> &G, herm_matrix_window<T> &F,
+                          herm_matrix_window<T> &Fcc, herm_matrix_window<T> &Q,
+                          integration::Integrator<T> &I, T beta, T h, dyson_workspace<T> &ws) {
+    int size1 = G.size1(), k = I.k(), nc = G.nc(), j0 = window_start(n, G.nc());
+    assert(n > k && nc > k);
+    assert(F.size1() == size1 && Fcc.size1() == size1 && Q.size1() == size1);
+    assert(F.ntau() == G.ntau() && Fcc.ntau() == G.ntau() && Q.ntau() == G.ntau());
+    assert(F.nc() == nc && Fcc.nc() == nc && Q.nc() == nc);
+    assert(F.tmax() >= n && F.tmin() <= j0 && Fcc.tmax() >= n && Fcc.tmin() <= j0);
+    assert(Q.tmax() >= n && Q.tmin() <= j0);
+    assert(G.tmax() >= n - 1 && G.tmax() <= n && G.tmin() <= j0);
+    G.advance(n);
+    ws.reserve(nc, G.ntau(), size1, k);
+    if (size1 == 1) {
+        vie2_timestep_window_ret<T, herm_matrix_window<T>, 1>(n, G, F, Fcc, Q, I, h, ws);
+        vie2_timestep_window_tv<T, herm_matrix_window<T>, 1>(n, G, F, Fcc, Q, I, beta, h, ws);
+        vie2_timestep_window_les<T, herm_matrix_window<T>, 1>(n, G, F, Fcc, Q, I, beta, h, ws);
+    } else {
+        vie2_timestep_window_ret<T, herm_matrix_window<T>, LARGESIZE>(n, G, F, Fcc, Q, I, h,
+                                                                     ws);
+        vie2_timestep_window_tv<T, herm_matrix_window<T>, LARGESIZE>(n, G, F, Fcc, Q, I, beta,
+                                                                    h, ws);
+        vie2_timestep_window_les<T, herm_matrix_window<T>, LARGESIZE>(n, G, F, Fcc, Q, I, beta,
+                                                                     h, ws);
+    }
+}
+
+/** \brief <b> Memory-truncated VIE2 solver \f$(1+F)*G=Q\f$ at a given time step.</b>
+ *
+ * <!-- ====== DOCUMENTATION ====== -->
+ *
+ *  \par Purpose
+ * <!-- ========= -->
+ *
+ * > Same as `vie2_timestep_window` with an `Integrator`, for given integration order.
+ *
+ * <!-- ARGUMENTS
+ *      ========= -->
+ *
+ * @param n
+ * > [int] time step
+ * @param &G
+ * > [herm_matrix_window<T>] solution
+ * @param &F
+ * > [herm_matrix_window<T>] kernel on the left-hand side
+ * @param &Fcc
+ * > [herm_matrix_window<T>] hermitian conjugate of F
+ * @param &Q
+ * > [herm_matrix_window<T>] source term
+ * @param beta
+ * > [double] inverse temperature
+ * @param h
+ * > [double] time interval
+ * @param SolveOrder
+ * > [int] integrator order
+ */
+template <typename T>
+void vie2_timestep_window(int n, herm_matrix_window<T> &G, herm_matrix_window<T> &F,
+                          herm_matrix_window<T> &Fcc, herm_matrix_window<T> &Q, T beta, T h,
+                          int SolveOrder) {
+    vie2_timestep_window(n, G, F, Fcc, Q, integration::I<T>(SolveOrder), beta, h,
+                         dyson_workspace<T>::local());
+}
+
+}  // namespace cntr
+
+#endif  // CNTR_WINDOW_SOLVERS_IMPL_H
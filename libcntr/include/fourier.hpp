@@ -20,6 +20,8 @@ void complex_dftcor_cubic(double w, double delta,double a,double b,
   std::complex<double> *endpts,std::complex<double> *endcor,double *corfac);
 void dft_cplx(double w,int n,double a,double b,std::complex<double> *f,
   std::complex<double> &res, std::complex<double> &err);
+void dft_cplx_weights(double w,int n,double a,double b,std::complex<double> *c);
+void fft_cplx(int n,int howmany,std::complex<double> *x,int isign);
 
 
 #define PI 3.14159265358979323846
@@ -157,6 +159,37 @@ class adft_func{
      return f_[i]; 
    }
    /// @private
+   /** \brief <b> Returns the number of intervals. </b> */
+   int num_intervals(void) const {return n_;}
+   /// @private
+   /** \brief <b> Returns the bounds and the number of points of interval `i`. </b>
+    *
+    * <!-- ====== DOCUMENTATION ====== -->
+    *
+    *  \par Purpose
+    * <!-- ========= -->
+    *
+    * The function is sampled at `a+j*(b-a)/len`, `j=0,...,len`, on interval `i`.
+    *
+    * <!-- ARGUMENTS
+    *      ========= -->
+    *
+    * @param i
+    * > index of interval
+    * @param a
+    * > on return, lower interval bound
+    * @param b
+    * > on return, upper interval bound
+    * @param len
+    * > on return, number of points minus one
+    */
+   void interval(int i,double &a,double &b,int &len) const {
+     if(i>=n_)  {std::cerr << "interval i="<<i<<" >n="<< n_<<" in adft" << std::endl;abort();}
+     a=a_[i];
+     b=b_[i];
+     len=len_[i];
+   }
+   /// @private
    /** \brief <b> Initializes the internal interval data and function values. </b>
     *
     * <!-- ====== DOCUMENTATION ====== -->
@@ -39,6 +39,10 @@ void store_attribute_to_hid(hid_t file_id, std::string label,
 void store_cplx_array_to_hid(
   hid_t file_id, std::string label, 
   std::complex<double> * data_ptr, hsize_t * shape, hsize_t len_shape);
+
+void store_cplx_array_to_hid(
+  hid_t file_id, std::string label, 
+  std::complex<float> * data_ptr, hsize_t * shape, hsize_t len_shape);
   
 void store_cplx_data_to_hid(hid_t file_id, std::string label, 
   std::complex<double> * data_ptr, size_t data_size);
@@ -28,6 +28,9 @@ namespace integration{
   void read_gregory_weights(int k,double *w);
   void read_bd_weights(int k,double *w);
   void read_rcorr(int k,double *w);
+  void read_gregory_weights(int k,float *w);
+  void read_bd_weights(int k,float *w);
+  void read_rcorr(int k,float *w);
 
   /* #######################################################################################
      #
@@ -516,6 +519,8 @@ private:
 #ifndef CNTR_NO_EXTERN_TEMPLATES
   extern template class Integrator<double>;
   extern template Integrator<double> &I<double>(int k);
+  extern template class Integrator<float>;
+  extern template Integrator<float> &I<float>(int k);
 #endif
 
 } //namespace
@@ -6,6 +6,7 @@
 namespace integration {
 
 extern template class Integrator<double>;
+extern template class Integrator<float>;
 
 }  // namespace integration
 
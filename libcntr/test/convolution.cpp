@@ -980,3 +980,73 @@ TEST_CASE("convolution: size2x2","[convolution: size2x2]"){
   }
 #endif // CNTR_USE_OMP
 }
+
+TEST_CASE("convolution: matrix-product path","[convolution: gemm]"){
+  // for size1 >= CNTR_CONVOLUTION_GEMM_SIZE convolution_timestep uses matrix-matrix
+  // products; compare to the elementwise sums
+  const int size1=9;
+  const int nt=25, ntau=50, kt=5;
+  const double beta=5.0, h=0.02, mu=0.0, eps=1.0e-10;
+  int tstp, i, j;
+  double err;
+  cdmatrix eps_a(size1,size1), eps_b(size1,size1);
+  std::complex<double> I(0.0,1.0);
+  GREEN A(nt,ntau,size1,-1), B(nt,ntau,size1,-1), C(nt,ntau,size1,-1), C_ref(nt,ntau,size1,-1);
+  integration::Integrator<double> Integ(kt);
+
+  for(i=0; i<size1; i++){
+    for(j=0; j<size1; j++){
+      eps_a(i,j) = (i==j ? 0.3*i-1.0 : 0.1/(1.0+i+j) + I*0.05*(double)(i-j));
+      eps_b(i,j) = (i==j ? 0.5-0.2*i : 0.2/(1.0+i*j) - I*0.03*(double)(i-j));
+    }
+  }
+  cntr::green_from_H(A,mu,eps_a,beta,h);
+  cntr::green_from_H(B,mu,eps_b,beta,h);
+
+  err=0.0;
+  for(tstp=0; tstp<=nt; tstp++){
+    cntr::convolution_timestep_ret_gemm<double,GREEN>(tstp,C,A,A,B,B,Integ,h);
+    cntr::convolution_timestep_tv_gemm<double,GREEN>(tstp,C,A,A,B,B,Integ,beta,h);
+    cntr::convolution_timestep_les_gemm<double,GREEN>(tstp,C,A,A,B,B,Integ,beta,h);
+    cntr::convolution_timestep_ret<double,GREEN,LARGESIZE>(tstp,C_ref,A,A,B,B,Integ,h);
+    cntr::convolution_timestep_tv<double,GREEN,LARGESIZE>(tstp,C_ref,A,A,B,B,Integ,beta,h);
+    cntr::convolution_timestep_les<double,GREEN,LARGESIZE>(tstp,C_ref,A,A,B,B,Integ,beta,h);
+    err += cntr::distance_norm2(tstp,C,C_ref);
+  }
+  REQUIRE(err<eps);
+}
+
+TEST_CASE("convolution: fixed-size kernels","[convolution: fixed size]"){
+  // convolution_timestep dispatches size1 <= CNTR_MAX_FIXED_SIZE to kernels compiled
+  // with a fixed element size; compare to the kernels with dynamic size
+  const int sizes[]={3,6,7};
+  const int nt=15, ntau=40, kt=5;
+  const double beta=5.0, h=0.02, mu=0.0, eps=1.0e-10;
+  int is, size1, tstp, i, j;
+  double err;
+  std::complex<double> I(0.0,1.0);
+  integration::Integrator<double> Integ(kt);
+
+  err=0.0;
+  for(is=0; is<3; is++){
+    size1=sizes[is];
+    cdmatrix eps_a(size1,size1), eps_b(size1,size1);
+    GREEN A(nt,ntau,size1,-1), B(nt,ntau,size1,-1), C(nt,ntau,size1,-1), C_ref(nt,ntau,size1,-1);
+    for(i=0; i<size1; i++){
+      for(j=0; j<size1; j++){
+        eps_a(i,j) = (i==j ? 0.3*i-1.0 : 0.1/(1.0+i+j) + I*0.05*(double)(i-j));
+        eps_b(i,j) = (i==j ? 0.5-0.2*i : 0.2/(1.0+i*j) - I*0.03*(double)(i-j));
+      }
+    }
+    cntr::green_from_H(A,mu,eps_a,beta,h);
+    cntr::green_from_H(B,mu,eps_b,beta,h);
+    for(tstp=0; tstp<=nt; tstp++){
+      cntr::convolution_timestep(tstp,C,A,A,B,B,Integ,beta,h);
+      cntr::convolution_timestep_ret<double,GREEN,LARGESIZE>(tstp,C_ref,A,A,B,B,Integ,h);
+      cntr::convolution_timestep_tv<double,GREEN,LARGESIZE>(tstp,C_ref,A,A,B,B,Integ,beta,h);
+      cntr::convolution_timestep_les<double,GREEN,LARGESIZE>(tstp,C_ref,A,A,B,B,Integ,beta,h);
+      err += cntr::distance_norm2(tstp,C,C_ref);
+    }
+  }
+  REQUIRE(err<eps);
+}
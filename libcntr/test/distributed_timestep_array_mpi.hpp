@@ -62,4 +62,27 @@ TEST_CASE("distributed_timestep_array MPI","[distributed_timestep_array_mpi]"){
     }
     REQUIRE(err<eps);
   }
+
+  SECTION("BcastAll non-blocking"){
+    cntr::distributed_timestep_array<double> Gall(npoints,nt,ntau,size,-1,true);
+    std::vector<int> mpi_pid=Gall.data().tid_map();
+
+    for(int tstp=-1;tstp<=nt;tstp++){
+      Gall.reset_tstp(tstp);
+      for(int i=0;i<npoints;i++){
+        if(taskid==mpi_pid[i]){
+          Gall.G()[i].get_data(Gvec[i]);
+        }
+      }
+
+      Gall.mpi_start_bcast_all();
+      // work which does not touch Gall can be done here
+      Gall.mpi_wait();
+
+      for(int i=0;i<npoints;i++){
+          err+=distance_norm2(tstp,Gall.G()[i],Gvec[i]);
+      }
+    }
+    REQUIRE(err<eps);
+  }
 }
\ No newline at end of file
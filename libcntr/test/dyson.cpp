@@ -4,6 +4,7 @@
 #include <complex>
 #include <cmath>
 #include <cstring>
+#include <vector>
 
 #include "cntr.hpp"
 
@@ -95,6 +96,30 @@ TEST_CASE("Kadanoff-Baym equations (Dyson)","[Kadanoff-Baym equations]"){
     REQUIRE(err/Nt<tol_coarse);
   }
 
+#ifdef CNTR_USE_OMP
+  SECTION("Integro-differential form (omp)"){
+    int nthreads;
+
+    #pragma omp parallel
+    {
+      nthreads = omp_get_num_threads();
+    }
+
+    cntr::dyson_start(G_approx,mu,hfunc,Sigma,integration::I<double>(SolverOrder),beta,dt);
+
+    for(tstp=SolverOrder+1;tstp<=Nt;tstp++){
+      cntr::dyson_timestep_omp(nthreads,tstp,G_approx,mu,hfunc,Sigma,integration::I<double>(SolverOrder),beta,dt);
+    }
+
+    err=0.0;
+    for(tstp=0; tstp<=Nt; tstp++){
+      err += cntr::distance_norm2(tstp,G_exact,G_approx);
+    }
+    //cout << "Error [Dyson (omp)] : " << err << endl;
+    REQUIRE(err/Nt<tol_coarse);
+  }
+#endif // CNTR_USE_OMP
+
   SECTION("Integral form"){
     GREEN G0(Nt,Ntau,1,fermion);
     GREEN G0xSGM(Nt,Ntau,1,fermion);
@@ -158,3 +183,126 @@ TEST_CASE("Kadanoff-Baym equations (Dyson)","[Kadanoff-Baym equations]"){
   }
 #endif // CNTR_USE_OMP
 }
+
+TEST_CASE("Batched time steps","[batch]"){
+  const int fermion = -1;
+  const int nbatch = 3;
+  const double mu = -0.1;
+  const double beta = 10.0;
+  const int Ntau = 100;
+  const int Nt = 40;
+  const double dt=0.05;
+  const int SolverOrder=5;
+  const double eps=1.0e-12;
+  int tstp, k;
+  double err;
+  cdmatrix h2x2(2,2);
+  std::complex<double> I(0.0,1.0);
+  std::vector<CFUNC> hfunc(nbatch);
+  std::vector<GREEN> Sigma(nbatch), G(nbatch), G_batch(nbatch), F(nbatch), Fcc(nbatch), Q(nbatch);
+  std::vector<CFUNC *> hptr(nbatch);
+  std::vector<GREEN *> Sptr(nbatch), Gptr(nbatch), Fptr(nbatch), Fccptr(nbatch), Qptr(nbatch);
+
+  // independent 2x2 problems, e.g., different momenta
+  for(k=0; k<nbatch; k++){
+    h2x2(0,0) = -1.0+0.3*k;
+    h2x2(1,1) = 0.5-0.2*k;
+    h2x2(0,1) = I*0.2;
+    h2x2(1,0) = -I*0.2;
+    hfunc[k] = CFUNC(Nt,2);
+    hfunc[k].set_constant(h2x2);
+    Sigma[k] = GREEN(Nt,Ntau,2,fermion);
+    cntr::green_from_H(Sigma[k],mu,h2x2,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++) Sigma[k].smul(tstp,0.04*(k+1));
+    G[k] = GREEN(Nt,Ntau,2,fermion);
+    cntr::dyson_mat(G[k],mu,hfunc[k],Sigma[k],beta,SolverOrder);
+    cntr::dyson_start(G[k],mu,hfunc[k],Sigma[k],beta,dt,SolverOrder);
+    G_batch[k] = G[k];
+    hptr[k] = &hfunc[k];
+    Sptr[k] = &Sigma[k];
+    Gptr[k] = &G_batch[k];
+  }
+
+  SECTION("Dyson"){
+    for(tstp=SolverOrder+1; tstp<=Nt; tstp++){
+      for(k=0; k<nbatch; k++)
+        cntr::dyson_timestep(tstp,G[k],mu,hfunc[k],Sigma[k],beta,dt,SolverOrder);
+      cntr::dyson_timestep_batch(tstp,Gptr,mu,hptr,Sptr,beta,dt,SolverOrder);
+    }
+    err=0.0;
+    for(k=0; k<nbatch; k++){
+      for(tstp=-1; tstp<=Nt; tstp++){
+        err += cntr::distance_norm2(tstp,G[k],G_batch[k]);
+      }
+    }
+    REQUIRE(err<eps);
+  }
+
+  SECTION("VIE2"){
+    // (1+F)*G=Q with F=-G0*Sigma, Q=G0
+    for(k=0; k<nbatch; k++){
+      F[k] = GREEN(Nt,Ntau,2,fermion);
+      Fcc[k] = GREEN(Nt,Ntau,2,fermion);
+      Q[k] = G[k];
+      for(tstp=-1; tstp<=Nt; tstp++){
+        cntr::convolution_timestep(tstp,F[k],Q[k],Sigma[k],integration::I<double>(SolverOrder),beta,dt);
+        cntr::convolution_timestep(tstp,Fcc[k],Sigma[k],Q[k],integration::I<double>(SolverOrder),beta,dt);
+        F[k].smul(tstp,-1);
+        Fcc[k].smul(tstp,-1);
+      }
+      G[k] = GREEN(Nt,Ntau,2,fermion);
+      G_batch[k] = GREEN(Nt,Ntau,2,fermion);
+      Fptr[k] = &F[k];
+      Fccptr[k] = &Fcc[k];
+      Qptr[k] = &Q[k];
+    }
+    for(tstp=-1; tstp<=Nt; tstp++){
+      if(tstp>=0 && tstp<SolverOrder) continue; // tstp=SolverOrder solves all starting steps
+      for(k=0; k<nbatch; k++)
+        cntr::vie2_timestep(tstp,G[k],F[k],Fcc[k],Q[k],beta,dt,SolverOrder);
+      cntr::vie2_timestep_batch(tstp,Gptr,Fptr,Fccptr,Qptr,beta,dt,SolverOrder);
+    }
+    err=0.0;
+    for(k=0; k<nbatch; k++){
+      for(tstp=-1; tstp<=Nt; tstp++){
+        err += cntr::distance_norm2(tstp,G[k],G_batch[k]);
+      }
+    }
+    REQUIRE(err<eps);
+  }
+}
+
+TEST_CASE("Distribution of work items over threads","[omp schedule]"){
+  const int nthreads=8;
+  const int tstp=300, ntau=100, k=5;
+  std::vector<double> cost, load(nthreads,0.0);
+  std::vector<int> owner;
+  double total=0.0, maxcost=0.0, maxload=0.0;
+  int i, nbad=0;
+
+  // rows of ret, tv and les of one time step
+  cntr::omp_convolution_cost(tstp,ntau,k,tstp+1,ntau+1,tstp+1,0.0,cost);
+  cntr::omp_balance_work(nthreads,cost,owner);
+  REQUIRE(owner.size()==cost.size());
+  for(i=0; i<(int)cost.size(); i++){
+    if(owner[i]<0 || owner[i]>=nthreads){
+      nbad++;
+      continue;
+    }
+    load[owner[i]] += cost[i];
+    total += cost[i];
+    maxcost=std::max(maxcost,cost[i]);
+  }
+  REQUIRE(nbad==0);
+  for(i=0; i<nthreads; i++) maxload=std::max(maxload,load[i]);
+  // the largest load exceeds the average by at most one item
+  REQUIRE(maxload <= total/nthreads + maxcost);
+
+  std::vector<bool> mask(tstp+1);
+  int nrows=0;
+  for(i=0; i<nthreads; i++){
+    cntr::omp_owner_mask(owner,0,tstp+1,i,mask);
+    nrows += std::count(mask.begin(),mask.end(),true);
+  }
+  REQUIRE(nrows==tstp+1);
+}
@@ -154,3 +154,74 @@ TEST_CASE("Dyson, new interface","[Dyson, new interface]"){
   }
 #endif // CNTR_USE_OMP
 }
+
+TEST_CASE("Dyson, workspace","[Dyson, workspace]"){
+  const int fermion = -1;
+  const int Nst=2;
+  const double beta = 10.0;
+  const double mu = 0.0;
+  const int SolveOrder = 5;
+  const int Ntau = 100;
+  const int Nt = 40;
+  const double dt=0.05;
+  const double tol=1.0e-12;
+  int tstp;
+  cdmatrix h2x2(Nst,Nst);
+  CFUNC hfunc(Nt,Nst);
+  GREEN Sigma(Nt,Ntau,Nst,fermion);
+  GREEN G_ref(Nt,Ntau,Nst,fermion), G_ws(Nt,Ntau,Nst,fermion);
+  double err;
+  std::complex<double> I(0.0,1.0);
+
+  h2x2(0,0) = -1.0;
+  h2x2(1,1) = 0.5;
+  h2x2(0,1) = I*0.3;
+  h2x2(1,0) = -I*0.3;
+  hfunc.set_constant(h2x2);
+  cntr::green_from_H(Sigma,mu,h2x2,beta,dt);
+  for(tstp=-1; tstp<=Nt; tstp++){
+    Sigma.smul(tstp,0.04);
+  }
+
+  cntr::dyson_mat(G_ref, mu, hfunc, Sigma, beta, SolveOrder);
+  cntr::dyson_start(G_ref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+  G_ws = G_ref;
+
+  SECTION("dyson_timestep"){
+    // workspace too small on purpose: must grow on demand
+    cntr::dyson_workspace<double> ws(SolveOrder+1,Ntau,Nst,SolveOrder);
+    for(tstp=SolveOrder+1;tstp<=Nt;tstp++){
+      cntr::dyson_timestep(tstp,G_ref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+      cntr::dyson_timestep(tstp,G_ws,mu,hfunc,Sigma,beta,dt,ws,SolveOrder);
+    }
+    REQUIRE(ws.nt()>=Nt);
+    err=0.0;
+    for(tstp=0; tstp<=Nt; tstp++){
+      err += cntr::distance_norm2(tstp,G_ref,G_ws);
+    }
+    REQUIRE(err<tol);
+  }
+
+  SECTION("vie2_timestep"){
+    GREEN G0xSGM(Nt,Ntau,Nst,fermion);
+    GREEN SGMxG0(Nt,Ntau,Nst,fermion);
+    cntr::vie2_workspace<double> ws(Nt,Ntau,Nst,SolveOrder);
+    for(tstp=-1;tstp<=Nt;tstp++){
+      cntr::convolution_timestep(tstp,G0xSGM,G_ref,Sigma,beta,dt);
+      cntr::convolution_timestep(tstp,SGMxG0,Sigma,G_ref,beta,dt);
+      G0xSGM.smul(tstp,-1);
+      SGMxG0.smul(tstp,-1);
+    }
+    cntr::vie2_start(G_ws,G0xSGM,SGMxG0,G_ref,beta,dt);
+    GREEN G_vie(G_ws);
+    for(tstp=SolveOrder+1;tstp<=Nt;tstp++){
+      cntr::vie2_timestep(tstp,G_vie,G0xSGM,SGMxG0,G_ref,beta,dt);
+      cntr::vie2_timestep(tstp,G_ws,G0xSGM,SGMxG0,G_ref,beta,dt,ws);
+    }
+    err=0.0;
+    for(tstp=0; tstp<=Nt; tstp++){
+      err += cntr::distance_norm2(tstp,G_vie,G_ws);
+    }
+    REQUIRE(err<tol);
+  }
+}
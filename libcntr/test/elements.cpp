@@ -0,0 +1,59 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define CPLX std::complex<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of the vectorized element kernels (cntr_elements_simd.hpp) against the
+  generic element routines.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+TEST_CASE("Element kernels","[elements]"){
+  const int maxsize=CNTR_SIMD_MAXSIZE;
+  const double eps=1e-12;
+  const int level0=cntr::element_simd_level();
+  CPLX alpha(0.3,-0.7);
+  CPLX z1[maxsize*maxsize], z2[maxsize*maxsize], z[maxsize*maxsize], zref[maxsize*maxsize];
+  int size1, level, i, sc;
+  double err;
+
+  err=0.0;
+  for(level=CNTR_SIMD_AVX2; level<=CNTR_SIMD_AVX512; level++){
+    if(cntr::element_simd_set_level(level)!=level) continue;
+    for(size1=2; size1<=maxsize; size1++){
+      sc=size1*size1;
+      for(i=0; i<sc; i++){
+        z1[i]=CPLX(sin(1.3*i+size1),cos(0.7*i));
+        z2[i]=CPLX(cos(0.4*i*size1),sin(2.1*i+1.0));
+        z[i]=CPLX(0.1*i,-0.2*i);
+        zref[i]=z[i];
+      }
+      // z += alpha*z1*z2
+      cntr::element_incr<double,LARGESIZE>(size1,z,alpha,z1,z2);
+      cntr::element_incr<double,LARGESIZE,LARGESIZE,LARGESIZE>(size1,size1,size1,zref,alpha,z1,z2);
+      for(i=0; i<sc; i++) err=std::max(err,abs(z[i]-zref[i]));
+      // z += z1*z2
+      cntr::element_incr<double,LARGESIZE>(size1,z,z1,z2);
+      cntr::element_incr<double,LARGESIZE,LARGESIZE,LARGESIZE>(size1,size1,size1,zref,z1,z2);
+      for(i=0; i<sc; i++) err=std::max(err,abs(z[i]-zref[i]));
+      // z = z1*z2
+      cntr::element_mult<double,LARGESIZE>(size1,z,z1,z2);
+      cntr::element_mult<double,LARGESIZE,LARGESIZE,LARGESIZE>(size1,size1,size1,zref,z1,z2);
+      for(i=0; i<sc; i++) err=std::max(err,abs(z[i]-zref[i]));
+      // z = z*z2 falls back to the generic routine
+      for(i=0; i<sc; i++) zref[i]=z[i];
+      cntr::element_mult<double,LARGESIZE>(size1,z,z,z2);
+      cntr::element_mult<double,LARGESIZE,LARGESIZE,LARGESIZE>(size1,size1,size1,zref,zref,z2);
+      for(i=0; i<sc; i++) err=std::max(err,abs(z[i]-zref[i]));
+    }
+  }
+  cntr::element_simd_set_level(level0);
+  REQUIRE(err<eps);
+}
@@ -451,3 +451,32 @@ TEST_CASE("Non-interacting","[Herm_matrix_noniteracting]"){
 
 
 
+
+TEST_CASE("Equilibrium from density of states","[equilibrium_dos]"){
+  int nt=40,ntau=200,size=2;
+  double beta=5.0,h=0.05,mu=0.3,eps=1e-6,err;
+  GREEN G(nt,ntau,size,-1),Gspec(nt,ntau,size,-1),Gmat(-1,ntau,size,-1);
+
+  SECTION ("Bethe"){
+    cntr::bethedos dos;
+    cntr::green_equilibrium(G,dos,beta,h,mu);
+    cntr::green_equilibrium_spectral(Gspec,dos,beta,h,mu);
+    cntr::green_equilibrium_mat_spectral(Gmat,dos,beta,mu);
+    err=cntr::distance_norm2(-1,Gmat,G);
+    for(int tstp=-1;tstp<=nt;tstp++){
+      err+=cntr::distance_norm2(tstp,Gspec,G);
+    }
+    REQUIRE(err<eps);
+  }
+
+  SECTION ("Smooth box"){
+    cntr::smooth_box dos(-1.0,1.5,10.0);
+    cntr::green_equilibrium(G,dos,beta,h,mu);
+    cntr::green_equilibrium_spectral(Gspec,dos,beta,h,mu);
+    err=0.0;
+    for(int tstp=-1;tstp<=nt;tstp++){
+      err+=cntr::distance_norm2(tstp,Gspec,G);
+    }
+    REQUIRE(err<eps);
+  }
+}
@@ -0,0 +1,174 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define CPLX std::complex<double>
+#define CFUNC cntr::function<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of the generalized Kadanoff-Baym ansatz: without self-energy, the GKBA is exact
+  and must reproduce green_from_H; in second Born, particle number must be conserved and
+  the density must follow the full solution of the Kadanoff-Baym equations closely.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+// second-Born self-energy of a Hubbard model with local interaction U (per spin)
+void gkba_test_sigma_2b(int tstp, GREEN &G, double U, GREEN &Pol, GREEN &Sigma){
+  int i, j, nst=G.size1();
+  for(i=0; i<nst; i++){
+    for(j=0; j<nst; j++){
+      cntr::Bubble1(tstp,Pol,i,j,G,i,j,G,i,j);
+    }
+  }
+  Pol.smul(tstp,-U*U);
+  for(i=0; i<nst; i++){
+    for(j=0; j<nst; j++){
+      cntr::Bubble2(tstp,Sigma,i,j,G,i,j,Pol,i,j);
+    }
+  }
+}
+
+// Hartree mean field
+void gkba_test_ham_mf(int tstp, GREEN &G, double U, cdmatrix &h0, CFUNC &hmf){
+  int i, nst=G.size1();
+  cdmatrix rho(nst,nst), hval(nst,nst);
+  G.density_matrix(tstp,rho);
+  hval=h0;
+  for(i=0; i<nst; i++) hval(i,i) += U*rho(i,i);
+  hmf.set_value(tstp,hval);
+}
+
+TEST_CASE("GKBA","[GKBA]"){
+  const int fermion = -1;
+  const int Nst=2;
+  const double beta = 5.0;
+  const int SolveOrder = 5;
+  const int Ntau = 200;
+  const double dt=0.02;
+  int tstp, iter;
+  std::complex<double> I(0.0,1.0);
+
+  SECTION ("Mean field"){
+    const int Nt = 100;
+    const double mu = 0.2;
+    double err;
+    cdmatrix h0(Nst,Nst), h1(Nst,Nst), ht(Nst,Nst);
+    CFUNC hfunc(Nt,Nst), rho(Nt,Nst);
+    GREEN G(Nt,Ntau,Nst,fermion), Gref(Nt,Ntau,Nst,fermion), Sigma(Nt,Ntau,Nst,fermion);
+    cntr::gkba<double> gk(Nt,Nst,SolveOrder);
+
+    h0(0,0) = -1.0;
+    h0(1,1) = 0.5;
+    h0(0,1) = I*0.3;
+    h0(1,0) = -I*0.3;
+    h1(0,0) = 0.0;
+    h1(1,1) = 0.0;
+    h1(0,1) = 0.4;
+    h1(1,0) = 0.4;
+    hfunc.set_value(-1,h0);
+    for(tstp=0; tstp<=Nt; tstp++){
+      ht = h0 + sin(1.3*tstp*dt)*h1;
+      hfunc.set_value(tstp,ht);
+    }
+    cntr::green_from_H(Gref,mu,hfunc,beta,dt,SolveOrder,4);
+    G.set_timestep(-1,Gref);
+
+    gk.start(G,rho,mu,hfunc,Sigma,beta,dt);
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      gk.timestep(tstp,G,rho,mu,hfunc,Sigma,beta,dt);
+    }
+    err=0.0;
+    for(tstp=0; tstp<=Nt; tstp++){
+      err += cntr::distance_norm2(tstp,G,Gref);
+    }
+    REQUIRE(err<1e-10);
+  }
+
+  SECTION ("Second Born"){
+    const int Nt = 60;
+    const double HubbardU = 1.0;
+    const double mu = 0.5;
+    double err, dn, N0, n0;
+    cdmatrix h0(Nst,Nst), rhot(Nst,Nst), rhog(Nst,Nst);
+    CFUNC hmf(Nt,Nst), hmf1(Nt,Nst), rho(Nt,Nst);
+    GREEN G(Nt,Ntau,Nst,fermion), G1(Nt,Ntau,Nst,fermion);
+    GREEN Sigma(Nt,Ntau,Nst,fermion), Pol(Nt,Ntau,Nst,-fermion);
+    cntr::gkba<double> gk(Nt,Nst,SolveOrder);
+
+    h0.setZero();
+    h0(0,1) = -1.0;
+    h0(1,0) = -1.0;
+
+    // correlated equilibrium state
+    tstp=-1;
+    cntr::green_from_H(G,mu,h0,beta,dt);
+    for(iter=0; iter<20; iter++){
+      gkba_test_ham_mf(tstp,G,HubbardU,h0,hmf);
+      gkba_test_sigma_2b(tstp,G,HubbardU,Pol,Sigma);
+      cntr::dyson_mat(G,mu,hmf,Sigma,beta,SolveOrder);
+    }
+    G.density_matrix(-1,rhot);
+    N0=rhot.trace().real();
+    G1=G;
+
+    // quench of the on-site potential
+    h0(0,0) = 0.5;
+
+    // GKBA
+    for(iter=0; iter<6; iter++){
+      for(tstp=0; tstp<=SolveOrder; tstp++){
+        gkba_test_ham_mf(tstp,G,HubbardU,h0,hmf);
+        gkba_test_sigma_2b(tstp,G,HubbardU,Pol,Sigma);
+      }
+      gk.start(G,rho,mu,hmf,Sigma,beta,dt);
+    }
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::extrapolate_timestep(tstp-1,G,SolveOrder);
+      cntr::extrapolate_timestep(tstp-1,hmf,SolveOrder);
+      for(iter=0; iter<4; iter++){
+        gkba_test_sigma_2b(tstp,G,HubbardU,Pol,Sigma);
+        gk.timestep(tstp,G,rho,mu,hmf,Sigma,beta,dt);
+        gkba_test_ham_mf(tstp,G,HubbardU,h0,hmf);
+      }
+    }
+
+    // full Kadanoff-Baym equations
+    for(iter=0; iter<6; iter++){
+      for(tstp=0; tstp<=SolveOrder; tstp++){
+        gkba_test_ham_mf(tstp,G1,HubbardU,h0,hmf1);
+        gkba_test_sigma_2b(tstp,G1,HubbardU,Pol,Sigma);
+      }
+      cntr::dyson_start(G1,mu,hmf1,Sigma,beta,dt,SolveOrder);
+    }
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::extrapolate_timestep(tstp-1,G1,SolveOrder);
+      for(iter=0; iter<4; iter++){
+        gkba_test_ham_mf(tstp,G1,HubbardU,h0,hmf1);
+        gkba_test_sigma_2b(tstp,G1,HubbardU,Pol,Sigma);
+        cntr::dyson_timestep(tstp,G1,mu,hmf1,Sigma,beta,dt,SolveOrder);
+      }
+    }
+
+    dn=0.0;
+    err=0.0;
+    for(tstp=0; tstp<=Nt; tstp++){
+      rho.get_value(tstp,rhot);
+      dn += fabs(rhot.trace().real()-N0);
+      n0=rhot(0,0).real();
+      G1.density_matrix(tstp,rhot);
+      err += fabs(n0-rhot(0,0).real());
+      // the lesser component on the time diagonal is the density matrix
+      G.density_matrix(tstp,rhog);
+      rho.get_value(tstp,rhot);
+      dn += (rhog-rhot).norm();
+    }
+    REQUIRE(dn/Nt<1e-8);
+    REQUIRE(err/Nt<1e-2);
+  }
+}
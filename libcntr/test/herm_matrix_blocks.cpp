@@ -0,0 +1,165 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define BLOCKS cntr::herm_matrix_blocks<double>
+#define CFUNC cntr::function<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of the block-sparse herm_matrix_blocks: the blockwise convolution, Dyson solver
+  and bubbles must agree with the dense herm_matrix routines for block-diagonal functions.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+// max over time steps of the distance of the blocks, embedded into a dense herm_matrix, to G
+double blocks_test_distance(BLOCKS &A, GREEN &G){
+  int tstp;
+  double err=0.0;
+  GREEN Ad(G.nt(),G.ntau(),G.size1(),G.sig());
+  for(tstp=-1; tstp<=G.nt(); tstp++){
+    A.get_herm_matrix(tstp,Ad);
+    err=std::max(err,cntr::distance_norm2(tstp,Ad,G));
+  }
+  return err;
+}
+
+TEST_CASE("Herm_matrix_blocks","[Herm_matrix_blocks]"){
+  const int fermion = -1;
+  const int SolveOrder = 5;
+  const int Ntau = 100;
+  const int Nt = 50;
+  const int Nst = 5;
+  const double dt = 0.02;
+  const double beta = 5.0;
+  const double mu = 0.1;
+  int tstp;
+  double err;
+  std::complex<double> I(0.0,1.0);
+  std::vector<int> block_size(2);
+  cdmatrix h0(Nst,Nst), h1(Nst,Nst);
+
+  // blocks {0,1} and {2,3,4}
+  block_size[0] = 2;
+  block_size[1] = 3;
+  h0.setZero();
+  h1.setZero();
+  h0(0,0) = -1.0;
+  h0(1,1) = 0.5;
+  h0(0,1) = I*0.3;
+  h0(1,0) = -I*0.3;
+  h0(2,2) = 0.2;
+  h0(3,3) = -0.4;
+  h0(4,4) = 1.0;
+  h0(2,3) = 0.7;
+  h0(3,2) = 0.7;
+  h0(3,4) = -0.2*I;
+  h0(4,3) = 0.2*I;
+  h1(0,0) = 0.3;
+  h1(1,1) = -0.3;
+  h1(2,4) = 0.5;
+  h1(4,2) = 0.5;
+
+  SECTION ("Set and get"){
+    GREEN A(Nt,Ntau,Nst,fermion), A1(Nt,Ntau,Nst,fermion);
+    BLOCKS Ab(Nt,Ntau,block_size,fermion);
+    cdmatrix rho(Nst,Nst), rho1;
+
+    REQUIRE(Ab.size1()==Nst);
+    REQUIRE(Ab.block_offset(1)==2);
+    REQUIRE(Ab.block_index(3)==1);
+    cntr::green_from_H(A,mu,h0,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++) Ab.set_from_herm_matrix(tstp,A);
+    REQUIRE(blocks_test_distance(Ab,A)<1e-14);
+    A.density_matrix(Nt,rho);
+    Ab.density_matrix(Nt,rho1);
+    REQUIRE((rho-rho1).norm()<1e-14);
+
+    // off-block elements are dropped
+    A1=A;
+    for(tstp=-1; tstp<=Nt; tstp++) A1.set_matrixelement(tstp,0,3,A,2,2);
+    for(tstp=-1; tstp<=Nt; tstp++) Ab.set_from_herm_matrix(tstp,A1);
+    REQUIRE(blocks_test_distance(Ab,A)<1e-14);
+  }
+
+  SECTION ("Convolution"){
+    GREEN A(Nt,Ntau,Nst,fermion), B(Nt,Ntau,Nst,fermion), C(Nt,Ntau,Nst,fermion);
+    BLOCKS Ab(Nt,Ntau,block_size,fermion), Bb(Nt,Ntau,block_size,fermion);
+    BLOCKS Cb(Nt,Ntau,block_size,fermion);
+
+    cntr::green_from_H(A,mu,h0,beta,dt);
+    cntr::green_from_H(B,mu,h1,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Ab.set_from_herm_matrix(tstp,A);
+      Bb.set_from_herm_matrix(tstp,B);
+    }
+    for(tstp=-1; tstp<=Nt; tstp++){
+      cntr::convolution_timestep(tstp,C,A,B,beta,dt,SolveOrder);
+      cntr::convolution_timestep(tstp,Cb,Ab,Bb,beta,dt,SolveOrder);
+    }
+    err=blocks_test_distance(Cb,C);
+    REQUIRE(err<1e-10);
+  }
+
+  SECTION ("Dyson"){
+    const double lam = 0.5;
+    CFUNC hfunc(Nt,Nst);
+    GREEN G(Nt,Ntau,Nst,fermion), Sigma(Nt,Ntau,Nst,fermion);
+    BLOCKS Gb(Nt,Ntau,block_size,fermion), Sigmab(Nt,Ntau,block_size,fermion);
+
+    cntr::green_from_H(Sigma,mu,h1,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Sigma.smul(tstp,lam*lam);
+      Sigmab.set_from_herm_matrix(tstp,Sigma);
+    }
+    hfunc.set_value(-1,h0);
+    for(tstp=0; tstp<=Nt; tstp++){
+      cdmatrix ht = h0 + sin(2.0*tstp*dt)*h1;
+      hfunc.set_value(tstp,ht);
+    }
+    cntr::dyson_mat(G,mu,hfunc,Sigma,beta,SolveOrder);
+    cntr::dyson_start(G,mu,hfunc,Sigma,beta,dt,SolveOrder);
+    cntr::dyson_mat(Gb,mu,hfunc,Sigmab,beta,SolveOrder);
+    cntr::dyson_start(Gb,mu,hfunc,Sigmab,beta,dt,SolveOrder);
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::dyson_timestep(tstp,G,mu,hfunc,Sigma,beta,dt,SolveOrder);
+      cntr::dyson_timestep(tstp,Gb,mu,hfunc,Sigmab,beta,dt,SolveOrder);
+    }
+    err=blocks_test_distance(Gb,G);
+    REQUIRE(err<1e-10);
+  }
+
+  SECTION ("Bubble"){
+    int i, j, b, off;
+    GREEN A(Nt,Ntau,Nst,fermion), B(Nt,Ntau,Nst,fermion);
+    GREEN C1(Nt,Ntau,Nst,-fermion), C2(Nt,Ntau,Nst,fermion);
+    BLOCKS Ab(Nt,Ntau,block_size,fermion), Bb(Nt,Ntau,block_size,fermion);
+    BLOCKS C1b(Nt,Ntau,block_size,-fermion), C2b(Nt,Ntau,block_size,fermion);
+
+    cntr::green_from_H(A,mu,h0,beta,dt);
+    cntr::green_from_H(B,mu,h1,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Ab.set_from_herm_matrix(tstp,A);
+      Bb.set_from_herm_matrix(tstp,B);
+      cntr::Bubble1(tstp,C1b,Ab,Bb);
+      cntr::Bubble2(tstp,C2b,Ab,Bb);
+      // dense reference: only the elements within the blocks
+      for(b=0; b<2; b++){
+        off=Ab.block_offset(b);
+        for(i=off; i<off+block_size[b]; i++){
+          for(j=off; j<off+block_size[b]; j++){
+            cntr::Bubble1(tstp,C1,i,j,A,A,i,j,B,B,i,j);
+            cntr::Bubble2(tstp,C2,i,j,A,A,i,j,B,B,i,j);
+          }
+        }
+      }
+    }
+    REQUIRE(blocks_test_distance(C1b,C1)<1e-14);
+    REQUIRE(blocks_test_distance(C2b,C2)<1e-14);
+  }
+}
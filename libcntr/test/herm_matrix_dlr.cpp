@@ -0,0 +1,150 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define DLR cntr::herm_matrix_dlr<double>
+#define CPLX std::complex<double>
+#define CFUNC cntr::function<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of herm_matrix_dlr: compression of the Matsubara and left-mixing components,
+  and the DLR convolutions and Matsubara solvers compared to the equidistant grid.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+TEST_CASE("Herm_matrix_dlr","[Herm_matrix_dlr]"){
+  const int fermion = -1;
+  const int Nst=2;
+  const double beta = 10.0;
+  const double mu = 0.0;
+  const int SolveOrder = 5;
+  const int Ntau = 400;
+  const int Nt = 20;
+  const double dt=0.02;
+  const double lambda=beta*6.0;
+  const double dlreps=1.0e-12;
+  int tstp, j;
+  cdmatrix h1(Nst,Nst), h2(Nst,Nst);
+  CFUNC hfunc(Nt,Nst);
+  GREEN A(Nt,Ntau,Nst,fermion), B(Nt,Ntau,Nst,fermion), C(Nt,Ntau,Nst,fermion), G2(Nt,Ntau,Nst,fermion);
+  cntr::dlr_basis<double> basis(beta,lambda,Ntau,fermion,dlreps);
+  int r=basis.r();
+  DLR Ad(Nt,r,Nst,fermion), Bd(Nt,r,Nst,fermion), Cd(Nt,r,Nst,fermion);
+  double err;
+  std::complex<double> I(0.0,1.0);
+
+  h1(0,0) = -1.0;
+  h1(1,1) = 0.5;
+  h1(0,1) = I*0.3;
+  h1(1,0) = -I*0.3;
+  h2(0,0) = 0.7;
+  h2(1,1) = -1.3;
+  h2(0,1) = 0.2;
+  h2(1,0) = 0.2;
+  hfunc.set_constant(h1);
+  cntr::green_from_H(A,mu,h1,beta,dt);
+  cntr::green_from_H(B,mu,h2,beta,dt);
+  for(tstp=-1; tstp<=Nt; tstp++){
+    B.smul(tstp,0.2);
+    Ad.set_timestep(tstp,A,basis);
+    Bd.set_timestep(tstp,B,basis);
+  }
+  REQUIRE(r < Ntau/10);
+
+  SECTION ("Compression"){
+    // G2 differs from A only in the expanded Matsubara and left-mixing components
+    err=0.0;
+    G2=A;
+    for(tstp=-1; tstp<=Nt; tstp++){
+      G2.set_timestep_zero(tstp);
+      G2.set_timestep(tstp,A);
+      if(tstp==-1){
+        for(j=0; j<=Ntau; j++) G2.set_mat(j,h1);
+      }else{
+        for(j=0; j<=Ntau; j++) G2.set_tv(tstp,j,h1);
+      }
+      Ad.get_timestep(tstp,G2,basis);
+      err += cntr::distance_norm2(tstp,G2,A);
+    }
+    // from and to herm_matrix_timestep
+    for(tstp=-1; tstp<=Nt; tstp++){
+      cntr::herm_matrix_timestep<double> Gt(tstp,Ntau,Nst,fermion);
+      A.get_timestep(tstp,Gt);
+      Cd.set_timestep(tstp,Gt,basis);
+      Gt.set_timestep_zero(tstp);
+      Cd.get_timestep(tstp,Gt,basis);
+      if(tstp>=0){
+        for(j=0; j<=tstp; j++){
+          A.get_ret(tstp,j,h2);
+          Gt.set_ret(tstp,j,h2);
+          A.get_les(j,tstp,h2);
+          Gt.set_les(j,tstp,h2);
+        }
+      }
+      err += cntr::distance_norm2(tstp,Gt,A);
+    }
+    REQUIRE(err<1e-9);
+  }
+
+  SECTION ("Convolution"){
+    cntr::convolution(C,A,A,B,B,beta,dt,SolveOrder);
+    // Matsubara
+    cntr::convolution_mat_dlr(Cd,Ad,Bd,basis);
+    Cd.get_timestep(-1,G2,basis);
+    err=cntr::distance_norm2(-1,G2,C);
+    // left-mixing
+    for(tstp=0; tstp<=Nt; tstp++){
+      cntr::convolution_timestep_tv_dlr(tstp,Cd,A,A,Ad,Bd,dt,basis,SolveOrder);
+      Cd.get_timestep(tstp,G2,basis);
+      for(j=0; j<=Ntau; j++){
+        cdmatrix M1, M2;
+        G2.get_tv(tstp,j,M1);
+        C.get_tv(tstp,j,M2);
+        err += (M1-M2).norm();
+      }
+    }
+    REQUIRE(err<1e-6);
+  }
+
+  SECTION ("Lesser tv-vt"){
+    integration::Integrator<double> &In=integration::I<double>(SolveOrder);
+    int n, es=Nst*Nst;
+    err=0.0;
+    for(n=0; n<=Nt; n++){
+      int n1=(n<SolveOrder ? SolveOrder : n);
+      CPLX *cles1=new CPLX[(n1+1)*es], *cles2=new CPLX[(n1+1)*es];
+      for(j=0; j<(n1+1)*es; j++){
+        cles1[j]=0.0;
+        cles2[j]=0.0;
+      }
+      cntr::convolution_timestep_les_tvvt<double,GREEN,LARGESIZE>(n,0,n1,cles1,C,A,A,B,B,In,beta,dt);
+      cntr::convolution_timestep_les_tvvt_dlr(n,0,n1,cles2,Ad,Bd,basis);
+      for(j=0; j<(n1+1)*es; j++) err += abs(cles1[j]-cles2[j]);
+      delete [] cles1;
+      delete [] cles2;
+    }
+    REQUIRE(err<1e-6);
+  }
+
+  SECTION ("Dyson and VIE2"){
+    DLR Gd(-1,r,Nst,fermion);
+    GREEN G(-1,Ntau,Nst,fermion), Gm(-1,Ntau,Nst,fermion);
+    // Dyson equation with self-energy B
+    cntr::dyson_mat(G,mu,hfunc,B,beta,SolveOrder);
+    cntr::dyson_mat_dlr(Gd,mu,hfunc,Bd,basis);
+    Gd.get_timestep(-1,Gm,basis);
+    err=cntr::distance_norm2(-1,G,Gm);
+    // (1+B)*G = A
+    cntr::vie2_mat(G,B,B,A,beta,SolveOrder);
+    cntr::vie2_mat_dlr(Gd,Bd,Ad,basis);
+    Gd.get_timestep(-1,Gm,basis);
+    err+=cntr::distance_norm2(-1,G,Gm);
+    REQUIRE(err<1e-6);
+  }
+}
@@ -0,0 +1,105 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define GREEN_TSTP cntr::herm_matrix_timestep<double>
+#define HODLR cntr::herm_matrix_hodlr<double>
+#define CPLX std::complex<double>
+#define CFUNC cntr::function<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of herm_matrix_hodlr: compression of a Green's function and the convolution
+  from the compressed representation, compared to the dense herm_matrix.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+TEST_CASE("Herm_matrix_hodlr","[Herm_matrix_hodlr]"){
+  const int fermion = -1;
+  const int Nst=2;
+  const double beta = 10.0;
+  const double mu = 0.0;
+  const int SolveOrder = 5;
+  const int Ntau = 50;
+  const int Nt = 300;
+  const double dt=0.02;
+  const double svdtol=1.0e-12;
+  const double tol=1.0e-8;
+  const int nleaf=16;
+  int tstp, j;
+  cdmatrix h2x2(Nst,Nst), M1(Nst,Nst), M2(Nst,Nst);
+  CFUNC hfunc(Nt,Nst);
+  GREEN Sigma(Nt,Ntau,Nst,fermion), G(Nt,Ntau,Nst,fermion);
+  GREEN_TSTP Gtstp, Ctstp;
+  HODLR Gc(Nt,Ntau,Nst,fermion,svdtol,nleaf), Sc(Nt,Ntau,Nst,fermion,svdtol,nleaf);
+  double err;
+  std::complex<double> I(0.0,1.0);
+
+  h2x2(0,0) = -1.0;
+  h2x2(1,1) = 0.5;
+  h2x2(0,1) = I*0.3;
+  h2x2(1,0) = -I*0.3;
+  cntr::green_from_H(Sigma,mu,h2x2,beta,dt);
+  for(tstp=-1; tstp<=Nt; tstp++){
+    Sigma.smul(tstp,0.04);
+  }
+  // driven two-level system
+  hfunc.set_value(-1,h2x2);
+  for(tstp=0; tstp<=Nt; tstp++){
+    M1 = h2x2;
+    M1(0,1) += 0.5*sin(tstp*dt);
+    M1(1,0) += 0.5*sin(tstp*dt);
+    hfunc.set_value(tstp,M1);
+  }
+  cntr::green_from_H(G,mu,hfunc,beta,dt,false,SolveOrder,4);
+  for(tstp=-1; tstp<=Nt; tstp++){
+    Gc.set_timestep(tstp,G);
+    Sc.set_timestep(tstp,Sigma);
+  }
+
+  SECTION("compression"){
+    REQUIRE(Gc.tstpmax()==Nt);
+    err=0.0;
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Gc.get_timestep(tstp,Gtstp);
+      err=std::max(err,cntr::distance_norm2(tstp,Gtstp,G));
+    }
+    for(j=0; j<=Nt; j+=37){
+      Gc.get_ret(Nt,j,M1);
+      G.get_ret(Nt,j,M2);
+      err=std::max(err,(M1-M2).norm());
+      Gc.get_les(j,Nt,M1);
+      G.get_les(j,Nt,M2);
+      err=std::max(err,(M1-M2).norm());
+      Gc.get_les(Nt,j,M1);
+      G.get_les(Nt,j,M2);
+      err=std::max(err,(M1-M2).norm());
+    }
+    Gc.density_matrix(Nt,M1);
+    G.density_matrix(Nt,M2);
+    err=std::max(err,(M1-M2).norm());
+    REQUIRE(err<tol);
+    // the real-time components are of low rank away from the diagonal
+    REQUIRE(Gc.memory_usage() < 0.5*(Nt+1)*(Nt+2)*Nst*Nst*sizeof(CPLX));
+    REQUIRE(Gc.max_rank() < 40);
+  }
+
+  SECTION("convolution_timestep"){
+    GREEN C(Nt,Ntau,Nst,fermion);
+    const int nlist[] = {-1, 2, SolveOrder, SolveOrder+1, 2*SolveOrder+2, 97, Nt};
+    err=0.0;
+    for(int i=0; i<7; i++){
+      tstp=nlist[i];
+      cntr::convolution_timestep(tstp,C,G,G,Sigma,Sigma,beta,dt,SolveOrder);
+      Ctstp = GREEN_TSTP(tstp,Ntau,Nst,fermion);
+      cntr::convolution_timestep(tstp,Ctstp,Gc,Gc,Sc,Sc,beta,dt,SolveOrder);
+      err=std::max(err,cntr::distance_norm2(tstp,Ctstp,C));
+    }
+    REQUIRE(err<tol);
+  }
+}
@@ -463,6 +463,160 @@ TEST_CASE("Herm matrix","[Herm_matrix]"){
     }
     REQUIRE(err<eps);
 
+  }
+  ///////////////////////////////////
+  //Herm Matrix memory-mapped storage
+  ////////////////////////////////////
+  SECTION("mmap storage"){
+
+    h0(0,0) = eps1;
+    h0(1,1) = eps2;
+    h0(0,1) = I*lam1;
+    h0(1,0) = -I*lam1;
+
+    GREEN G3(-1,ntau,size,-1);
+    G3.set_storage(CNTR_STORAGE_MMAP);
+    G3.resize(nt/2,ntau,size);
+    REQUIRE(G3.storage()==CNTR_STORAGE_MMAP);
+
+    cntr::green_from_H(G1,mu,h0,beta,h);
+    for(int tstp=-1; tstp<=nt/2; tstp++){
+      GREEN_TSTP A(tstp,ntau,size);
+      G1.get_timestep(tstp,A);
+      G3.set_timestep(tstp,A);
+    }
+    // growing keeps the storage and the data
+    G3.resize(nt,ntau,size);
+    for(int tstp=nt/2+1; tstp<=nt; tstp++){
+      GREEN_TSTP A(tstp,ntau,size);
+      G1.get_timestep(tstp,A);
+      G3.set_timestep(tstp,A);
+    }
+    double err=0.0;
+    for(int tstp=-1; tstp<=nt; tstp++){
+      err += cntr::distance_norm2(tstp,G1,G3);
+    }
+    REQUIRE(err<eps);
+
+    // copies inherit the storage, set_storage migrates the data
+    GREEN G4(G3);
+    REQUIRE(G4.storage()==CNTR_STORAGE_MMAP);
+    G3.set_storage(CNTR_STORAGE_HEAP);
+    REQUIRE(G3.storage()==CNTR_STORAGE_HEAP);
+    err=0.0;
+    for(int tstp=-1; tstp<=nt; tstp++){
+      err += cntr::distance_norm2(tstp,G1,G3);
+      err += cntr::distance_norm2(tstp,G1,G4);
+    }
+    REQUIRE(err<eps);
+
+  }
+
+  ///////////////////////////////////
+  //Herm Matrix NUMA first-touch storage
+  ////////////////////////////////////
+  SECTION("numa storage"){
+
+    h0(0,0) = eps1;
+    h0(1,1) = eps2;
+    h0(0,1) = I*lam1;
+    h0(1,0) = -I*lam1;
+
+    GREEN G3(nt/2,ntau,size,-1);
+    cntr::green_from_H(G1,mu,h0,beta,h);
+    for(int tstp=-1; tstp<=nt/2; tstp++){
+      GREEN_TSTP A(tstp,ntau,size);
+      G1.get_timestep(tstp,A);
+      G3.set_timestep(tstp,A);
+    }
+    // set_storage migrates the data, the arrays are aligned
+    G3.set_storage(CNTR_STORAGE_NUMA_HUGEPAGES);
+    REQUIRE(G3.storage()==CNTR_STORAGE_NUMA_HUGEPAGES);
+    REQUIRE((size_t)G3.retptr(0,0)%CNTR_STORAGE_ALIGNMENT==0);
+    REQUIRE((size_t)G3.tvptr(0,0)%CNTR_STORAGE_ALIGNMENT==0);
+    G3.set_storage(CNTR_STORAGE_NUMA);
+    // growing keeps the storage and the data, new time steps are zero
+    G3.resize(nt,ntau,size);
+    REQUIRE(G3.storage()==CNTR_STORAGE_NUMA);
+    REQUIRE(std::abs(G3.retptr(nt,0)[0])==0.0);
+    REQUIRE(std::abs(G3.tvptr(nt,ntau)[0])==0.0);
+    for(int tstp=nt/2+1; tstp<=nt; tstp++){
+      GREEN_TSTP A(tstp,ntau,size);
+      G1.get_timestep(tstp,A);
+      G3.set_timestep(tstp,A);
+    }
+    GREEN G4(G3);
+    REQUIRE(G4.storage()==CNTR_STORAGE_NUMA);
+    double err=0.0;
+    for(int tstp=-1; tstp<=nt; tstp++){
+      err += cntr::distance_norm2(tstp,G1,G3);
+      err += cntr::distance_norm2(tstp,G1,G4);
+    }
+    REQUIRE(err<eps);
+
+  }
+
+  ///////////////////////////////////
+  //Herm Matrix reserve/resize_nt
+  ////////////////////////////////////
+  SECTION("reserve and resize_nt"){
+
+    h0(0,0) = eps1;
+    h0(1,1) = eps2;
+    h0(0,1) = I*lam1;
+    h0(1,0) = -I*lam1;
+
+    GREEN G3(nt/4,ntau,size,-1);
+    cfunction f(nt/4,size);
+    cntr::green_from_H(G1,mu,h0,beta,h);
+    for(int tstp=-1; tstp<=nt/4; tstp++){
+      GREEN_TSTP A(tstp,ntau,size);
+      G1.get_timestep(tstp,A);
+      G3.set_timestep(tstp,A);
+      f.set_value(tstp,h0);
+    }
+    // within the capacity, the rows are appended in place
+    G3.reserve(nt/2);
+    f.reserve(nt/2);
+    REQUIRE(G3.nt()==nt/4);
+    REQUIRE(G3.nt_capacity()==nt/2);
+    CPLX *les=G3.lesptr(0,0);
+    CPLX *fptr=f.ptr(-1);
+    G3.resize_nt(nt/2);
+    f.resize_nt(nt/2);
+    REQUIRE(G3.lesptr(0,0)==les);
+    REQUIRE(f.ptr(-1)==fptr);
+    // shrinking keeps the allocation, growing again clears the new rows
+    G3.resize_nt(nt/4);
+    G3.resize_nt(nt/2);
+    REQUIRE(G3.lesptr(0,0)==les);
+    REQUIRE(std::abs(G3.retptr(nt/2,0)[0])==0.0);
+    REQUIRE(std::abs(G3.lesptr(0,nt/2)[0])==0.0);
+    REQUIRE(std::abs(G3.tvptr(nt/2,ntau)[0])==0.0);
+    REQUIRE(std::abs(f[nt/2])==0.0);
+    // beyond the capacity, the capacity grows at least geometrically
+    G3.resize_nt(nt/2+1);
+    f.resize_nt(nt/2+1);
+    REQUIRE(G3.nt_capacity()>=nt/2+nt/4);
+    REQUIRE(f.nt_capacity()>=nt/2+nt/4);
+    G3.resize_nt(nt);
+    f.resize_nt(nt);
+    for(int tstp=nt/4+1; tstp<=nt; tstp++){
+      GREEN_TSTP A(tstp,ntau,size);
+      G1.get_timestep(tstp,A);
+      G3.set_timestep(tstp,A);
+    }
+    double err=0.0;
+    cdmatrix ft(size,size);
+    for(int tstp=-1; tstp<=nt; tstp++){
+      err += cntr::distance_norm2(tstp,G1,G3);
+    }
+    for(int tstp=-1; tstp<=nt/4; tstp++){
+      f.get_value(tstp,ft);
+      err += (ft-h0).norm();
+    }
+    REQUIRE(err<eps);
+
   }
 
   ///////////////////////////////////
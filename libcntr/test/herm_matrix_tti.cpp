@@ -0,0 +1,158 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define TTI cntr::herm_matrix_tti<double>
+#define CPLX std::complex<double>
+#define CFUNC cntr::function<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of the time-translation invariant herm_matrix_tti: the free and equilibrium
+  propagators and the retarded and Matsubara convolutions must agree with the herm_matrix
+  routines to roundoff; the steady-state lesser convolution and the Dyson equation must
+  agree with the full solution for functions which decay within the window.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+// max_l |A(l)-B(t_nt,t_nt-l)| for the retarded and the lesser component, l <= lmax
+double tti_test_distance(TTI &A, GREEN &B, int lmax, double &err_les){
+  int l, nt=B.nt();
+  double err_ret=0.0;
+  cdmatrix M1, M2;
+  err_les=0.0;
+  for(l=0; l<=lmax; l++){
+    A.get_ret(l,M1);
+    B.get_ret(nt,nt-l,M2);
+    err_ret=std::max(err_ret,(M1-M2).norm());
+    A.get_les(l,M1);
+    B.get_les(nt-l,nt,M2);
+    err_les=std::max(err_les,(M1-M2).norm());
+  }
+  return err_ret;
+}
+
+double tti_test_distance_mat(TTI &A, GREEN &B){
+  int m;
+  double err=0.0;
+  cdmatrix M1, M2;
+  for(m=0; m<=B.ntau(); m++){
+    A.get_mat(m,M1);
+    B.get_mat(m,M2);
+    err=std::max(err,(M1-M2).norm());
+  }
+  return err;
+}
+
+TEST_CASE("Herm_matrix_tti","[Herm_matrix_tti]"){
+  const int fermion = -1;
+  const int SolveOrder = 5;
+  const int Ntau = 200;
+  const int Nt = 200;
+  const double dt = 0.05;
+  const double beta = 2.0;
+  const double mu = 0.0;
+  double err, err_les;
+  std::complex<double> I(0.0,1.0);
+
+  SECTION ("Free propagator"){
+    const int Nst = 2;
+    cdmatrix h0(Nst,Nst);
+    GREEN Gref(Nt,Ntau,Nst,fermion), G1;
+    TTI G(Nt,Ntau,Nst,fermion);
+
+    h0(0,0) = -1.0;
+    h0(1,1) = 0.5;
+    h0(0,1) = I*0.3;
+    h0(1,0) = -I*0.3;
+    cntr::green_from_H(Gref,mu,h0,beta,dt);
+    cntr::green_from_H_tti(G,mu,h0,beta,dt);
+    err=tti_test_distance(G,Gref,Nt,err_les);
+    REQUIRE(err<1e-10);
+    REQUIRE(err_les<1e-10);
+    REQUIRE(tti_test_distance_mat(G,Gref)<1e-10);
+
+    // expansion into a herm_matrix and back
+    G1=Gref;
+    G.get_herm_matrix(G1);
+    err=0.0;
+    for(int tstp=-1; tstp<=Nt; tstp++) err=std::max(err,cntr::distance_norm2(tstp,G1,Gref));
+    REQUIRE(err<1e-10);
+    G.clear();
+    G.set_from_herm_matrix(-1,Gref);
+    G.set_from_herm_matrix(Nt,Gref);
+    err=tti_test_distance(G,Gref,Nt,err_les);
+    REQUIRE(err<1e-14);
+    REQUIRE(err_les<1e-14);
+  }
+
+  SECTION ("Equilibrium propagator"){
+    cntr::smooth_box dos(-2.0,2.0,2.0);
+    GREEN Gref(Nt,Ntau,1,fermion);
+    TTI G(Nt,Ntau,1,fermion);
+
+    cntr::green_equilibrium_spectral(Gref,dos,beta,dt,mu);
+    cntr::green_equilibrium_tti(G,dos,beta,dt,mu);
+    err=tti_test_distance(G,Gref,Nt,err_les);
+    REQUIRE(err<1e-12);
+    REQUIRE(err_les<1e-12);
+    REQUIRE(tti_test_distance_mat(G,Gref)<1e-12);
+  }
+
+  SECTION ("Convolution"){
+    cntr::smooth_box dos1(-2.0,2.0,2.0), dos2(-1.0,1.5,1.0);
+    GREEN A(Nt,Ntau,1,fermion), B(Nt,Ntau,1,fermion), Cref(Nt,Ntau,1,fermion);
+    TTI At(Nt,Ntau,1,fermion), Bt(Nt,Ntau,1,fermion), Ct(Nt,Ntau,1,fermion);
+
+    cntr::green_equilibrium_spectral(A,dos1,beta,dt,mu);
+    cntr::green_equilibrium_spectral(B,dos2,beta,dt,mu);
+    At.set_from_herm_matrix(-1,A);
+    At.set_from_herm_matrix(Nt,A);
+    Bt.set_from_herm_matrix(-1,B);
+    Bt.set_from_herm_matrix(Nt,B);
+    cntr::convolution(Cref,A,A,B,B,beta,dt,SolveOrder);
+    cntr::convolution_tti(Ct,At,Bt,beta,dt,SolveOrder);
+    err=tti_test_distance(Ct,Cref,Nt/2,err_les);
+    REQUIRE(err<1e-10);
+    REQUIRE(err_les<1e-8);
+    REQUIRE(tti_test_distance_mat(Ct,Cref)<1e-10);
+
+    // the output may coincide with an input
+    cntr::convolution_tti(At,At,Bt,beta,dt,SolveOrder);
+    err=tti_test_distance(At,Cref,Nt/2,err_les);
+    REQUIRE(err<1e-10);
+    REQUIRE(err_les<1e-8);
+  }
+
+  SECTION ("Dyson"){
+    const double lam = 1.0;
+    cntr::smooth_box dos(-2.0,2.0,2.0);
+    cdmatrix h0(1,1);
+    CFUNC hfunc(Nt,1);
+    GREEN Sigma(Nt,Ntau,1,fermion), Gref(Nt,Ntau,1,fermion);
+    TTI St(Nt,Ntau,1,fermion), Gt(Nt,Ntau,1,fermion);
+    int tstp;
+
+    h0(0,0) = 0.3;
+    hfunc.set_constant(h0);
+    cntr::green_equilibrium(Sigma,dos,beta,dt,mu);
+    for(tstp=-1; tstp<=Nt; tstp++) Sigma.smul(tstp,lam*lam);
+    cntr::dyson_mat(Gref,mu,hfunc,Sigma,beta,SolveOrder);
+    cntr::dyson_start(Gref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::dyson_timestep(tstp,Gref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+    }
+
+    St.set_from_herm_matrix(Nt,Sigma);
+    cntr::dyson_tti(Gt,mu,h0,St,dt,SolveOrder);
+    err=tti_test_distance(Gt,Gref,Nt,err_les);
+    REQUIRE(err<1e-6);
+    err=tti_test_distance(Gt,Gref,Nt/2,err_les);
+    REQUIRE(err_les<1e-6);
+  }
+}
@@ -0,0 +1,208 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define GREEN_TSTP cntr::herm_matrix_timestep<double>
+#define WINDOW cntr::herm_matrix_window<double>
+#define CPLX std::complex<double>
+#define CFUNC cntr::function<double>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of herm_matrix_window and the memory-truncated solvers. If the window covers
+  the whole propagation (nc >= Nt) the results must agree with the full solvers.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+TEST_CASE("Herm_matrix_window","[Herm_matrix_window]"){
+  const int fermion = -1;
+  const int Nst=2;
+  const double beta = 10.0;
+  const double mu = 0.0;
+  const int SolveOrder = 5;
+  const int Ntau = 100;
+  const int Nt = 40;
+  const double dt=0.05;
+  const double tol=1.0e-10;
+  int tstp, j;
+  cdmatrix h2x2(Nst,Nst), M1(Nst,Nst), M2(Nst,Nst);
+  CFUNC hfunc(Nt,Nst);
+  GREEN Sigma(Nt,Ntau,Nst,fermion), G_ref(Nt,Ntau,Nst,fermion);
+  GREEN_TSTP Gtstp;
+  double err;
+  std::complex<double> I(0.0,1.0);
+
+  h2x2(0,0) = -1.0;
+  h2x2(1,1) = 0.5;
+  h2x2(0,1) = I*0.3;
+  h2x2(1,0) = -I*0.3;
+  hfunc.set_constant(h2x2);
+  cntr::green_from_H(Sigma,mu,h2x2,beta,dt);
+  for(tstp=-1; tstp<=Nt; tstp++){
+    Sigma.smul(tstp,0.04);
+  }
+
+  cntr::dyson_mat(G_ref, mu, hfunc, Sigma, beta, SolveOrder);
+  cntr::dyson_start(G_ref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+  for(tstp=SolveOrder+1;tstp<=Nt;tstp++){
+    cntr::dyson_timestep(tstp,G_ref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+  }
+
+  SECTION("set_timestep / get_timestep"){
+    const int nc=10;
+    WINDOW Gw(nc,Ntau,Nst,fermion);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Gw.set_timestep(tstp,G_ref);
+    }
+    REQUIRE(Gw.tmax()==Nt);
+    REQUIRE(Gw.tmin()==Nt-nc);
+    err=0.0;
+    for(j=Nt-nc; j<=Nt; j++){
+      Gw.get_ret(Nt,j,M1);
+      G_ref.get_ret(Nt,j,M2);
+      err += (M1-M2).norm();
+      Gw.get_les(j,Nt,M1);
+      G_ref.get_les(j,Nt,M2);
+      err += (M1-M2).norm();
+    }
+    Gw.density_matrix(Nt,M1);
+    G_ref.density_matrix(Nt,M2);
+    err += (M1-M2).norm();
+    REQUIRE(err<tol);
+    // elements outside the window are zero
+    Gw.get_ret(Nt,Nt-nc-1,M1);
+    REQUIRE(M1.norm()==0.0);
+    // the latest time step is complete if nc >= tstp
+    Gtstp = GREEN_TSTP(nc,Ntau,Nst,fermion);
+    WINDOW Gw2(Nt,Ntau,Nst,fermion);
+    for(tstp=-1; tstp<=nc; tstp++){
+      Gw2.set_timestep(tstp,G_ref);
+    }
+    Gw2.get_timestep(nc,Gtstp);
+    REQUIRE(cntr::distance_norm2(nc,Gtstp,G_ref)<tol);
+  }
+
+  SECTION("convolution_timestep_window"){
+    GREEN C_ref(Nt,Ntau,Nst,fermion);
+    WINDOW Gw(Nt,Ntau,Nst,fermion), Sw(Nt,Ntau,Nst,fermion), Cw(Nt,Ntau,Nst,fermion);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Gw.set_timestep(tstp,G_ref);
+      Sw.set_timestep(tstp,Sigma);
+    }
+    err=0.0;
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::convolution_timestep(tstp,C_ref,G_ref,G_ref,Sigma,Sigma,beta,dt,SolveOrder);
+      cntr::convolution_timestep_window(tstp,Cw,Gw,Gw,Sw,Sw,beta,dt,SolveOrder);
+      Gtstp = GREEN_TSTP(tstp,Ntau,Nst,fermion);
+      Cw.get_timestep(tstp,Gtstp);
+      err += cntr::distance_norm2(tstp,Gtstp,C_ref);
+    }
+    REQUIRE(err<tol);
+  }
+
+  SECTION("dyson_timestep_window"){
+    WINDOW Gw(Nt,Ntau,Nst,fermion), Sw(Nt,Ntau,Nst,fermion);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Sw.set_timestep(tstp,Sigma);
+    }
+    for(tstp=-1; tstp<=SolveOrder; tstp++){
+      Gw.set_timestep(tstp,G_ref);
+    }
+    err=0.0;
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::dyson_timestep_window(tstp,Gw,mu,hfunc,Sw,beta,dt,SolveOrder);
+      Gtstp = GREEN_TSTP(tstp,Ntau,Nst,fermion);
+      Gw.get_timestep(tstp,Gtstp);
+      err += cntr::distance_norm2(tstp,Gtstp,G_ref);
+    }
+    REQUIRE(err<tol);
+  }
+
+  SECTION("vie2_timestep_window"){
+    GREEN G_vie(Nt,Ntau,Nst,fermion);
+    WINDOW Gw(Nt,Ntau,Nst,fermion), Sw(Nt,Ntau,Nst,fermion), Qw(Nt,Ntau,Nst,fermion);
+    cntr::vie2_mat(G_vie,Sigma,Sigma,G_ref,beta,SolveOrder);
+    cntr::vie2_start(G_vie,Sigma,Sigma,G_ref,beta,dt,SolveOrder);
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::vie2_timestep(tstp,G_vie,Sigma,Sigma,G_ref,beta,dt,SolveOrder);
+    }
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Sw.set_timestep(tstp,Sigma);
+      Qw.set_timestep(tstp,G_ref);
+    }
+    for(tstp=-1; tstp<=SolveOrder; tstp++){
+      Gw.set_timestep(tstp,G_vie);
+    }
+    err=0.0;
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::vie2_timestep_window(tstp,Gw,Sw,Sw,Qw,beta,dt,SolveOrder);
+      Gtstp = GREEN_TSTP(tstp,Ntau,Nst,fermion);
+      Gw.get_timestep(tstp,Gtstp);
+      err += cntr::distance_norm2(tstp,Gtstp,G_vie);
+    }
+    REQUIRE(err<tol);
+  }
+}
+
+TEST_CASE("Herm_matrix_window, truncated memory","[Herm_matrix_window]"){
+  // Dyson equation with a hybridization to a wide smooth band, which decays
+  // exponentially: truncating the memory at nc*dt must approximate the full solution
+  const int fermion = -1;
+  const double beta = 5.0;
+  const double mu = 0.0;
+  const double lam = 1.5;
+  const int SolveOrder = 5;
+  const int Ntau = 200;
+  const int Nt = 300;
+  const int nc = 150;
+  const double dt = 0.05;
+  const double tol = 5.0e-3;
+  int tstp, j;
+  cdmatrix h1x1(1,1), M1(1,1), M2(1,1);
+  CFUNC hfunc(Nt,1);
+  GREEN Sigma(Nt,Ntau,1,fermion), G_ref(Nt,Ntau,1,fermion);
+  WINDOW Gw(nc,Ntau,1,fermion), Sw(nc,Ntau,1,fermion);
+  double err;
+
+  h1x1(0,0) = 0.3;
+  hfunc.set_constant(h1x1);
+  cntr::smooth_box dos(-2.0,2.0,2.0);
+  cntr::green_equilibrium(Sigma,dos,beta,dt,mu);
+  for(tstp=-1; tstp<=Nt; tstp++){
+    Sigma.smul(tstp,lam*lam);
+  }
+
+  cntr::dyson_mat(G_ref, mu, hfunc, Sigma, beta, SolveOrder);
+  cntr::dyson_start(G_ref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+  for(tstp=SolveOrder+1;tstp<=Nt;tstp++){
+    cntr::dyson_timestep(tstp,G_ref,mu,hfunc,Sigma,beta,dt,SolveOrder);
+  }
+
+  for(tstp=-1; tstp<=SolveOrder; tstp++){
+    Gw.set_timestep(tstp,G_ref);
+    Sw.set_timestep(tstp,Sigma);
+  }
+  err=0.0;
+  for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+    Sw.set_timestep(tstp,Sigma);
+    cntr::dyson_timestep_window(tstp,Gw,mu,hfunc,Sw,beta,dt,SolveOrder);
+    Gw.density_matrix(tstp,M1);
+    G_ref.density_matrix(tstp,M2);
+    err = std::max(err,(M1-M2).norm());
+  }
+  for(j=Nt-nc; j<=Nt; j++){
+    Gw.get_ret(Nt,j,M1);
+    G_ref.get_ret(Nt,j,M2);
+    err = std::max(err,(M1-M2).norm());
+    Gw.get_les(j,Nt,M1);
+    G_ref.get_les(j,Nt,M2);
+    err = std::max(err,(M1-M2).norm());
+  }
+  //cout << "Error [truncated Dyson] : " << err << endl;
+  REQUIRE(err<tol);
+}
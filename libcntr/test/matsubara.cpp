@@ -104,3 +104,58 @@ TEST_CASE("Matsubara Dyson equation","[Matsubara Dyson equation]"){
   }
 
 }
+
+TEST_CASE("Matsubara FFT","[Matsubara FFT]"){
+  // Ntau=2*199 uses the Bluestein FFT; compare to the direct sums
+  const int Nst=2;
+  const int Ntau = 398;
+  const int SolverOrder=5;
+  const double beta = 10.0;
+  const double mu = 0.0;
+  const double eps=1.0e-11;
+  int sig, m, r, l, sg=Nst*Nst;
+  cdmatrix h1(Nst,Nst), h2(Nst,Nst);
+  double err, arg;
+  std::complex<double> I(0.0,1.0);
+
+  h1(0,0) = -1.0;
+  h1(1,1) = 0.5;
+  h1(0,1) = I*0.3;
+  h1(1,0) = -I*0.3;
+  h2(0,0) = 0.7;
+  h2(1,1) = 1.3;
+  h2(0,1) = 0.2;
+  h2(1,0) = 0.2;
+
+  for(sig=-1; sig<=1; sig+=2){
+    GREEN A(-1,Ntau,Nst,sig), B(-1,Ntau,Nst,sig), C(-1,Ntau,Nst,sig), C_ref(-1,Ntau,Nst,sig);
+    cntr::green_from_H(A,mu,h1,beta,1.0);
+    cntr::green_from_H(B,mu,h2,beta,1.0);
+
+    SECTION("DFT sig="+std::to_string(sig)){
+      CPLX *mdft=new CPLX[(Ntau+1)*sg];
+      double one=(sig==-1 ? 1.0 : 0.0);
+      cntr::matsubara_dft<double,GREEN,LARGESIZE>(mdft,A,sig);
+      err=0.0;
+      for(m=0; m<=Ntau; m++){
+        for(l=0; l<sg; l++){
+          CPLX z=0.0;
+          for(r=0; r<=Ntau; r++){
+            arg=((2*m+one)*r*M_PI)/Ntau;
+            z += CPLX(cos(arg),sin(arg))*A.matptr(r)[l];
+          }
+          err += abs(z-mdft[m*sg+l]);
+        }
+      }
+      delete [] mdft;
+      REQUIRE(err<eps*Ntau);
+    }
+
+    SECTION("Convolution sig="+std::to_string(sig)){
+      cntr::convolution_matsubara_dispatch<double,GREEN,LARGESIZE>(C_ref,A,B,integration::I<double>(SolverOrder),beta);
+      cntr::convolution_matsubara_fft_dispatch<double,GREEN,LARGESIZE>(C,A,B,integration::I<double>(SolverOrder),beta);
+      err=cntr::distance_norm2(-1,C,C_ref);
+      REQUIRE(err<eps);
+    }
+  }
+}
@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include <iostream>
+#include <complex>
+#include <cmath>
+
+#include "cntr.hpp"
+
+#define GREEN cntr::herm_matrix<double>
+#define GREENF cntr::herm_matrix<float>
+#define CFUNC cntr::function<double>
+#define CFUNCF cntr::function<float>
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of the single precision instantiations: convolution_timestep and dyson_timestep
+  with herm_matrix<float> must agree with the double precision results to the accuracy
+  of single precision, and the mixed precision convolution (float storage, double sums)
+  must be more accurate than the single precision one.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+// max over time steps of the distance of a herm_matrix<float> to a herm_matrix<double>
+double precision_test_distance(GREENF &Gf, GREEN &G){
+  int tstp;
+  double err=0.0;
+  GREEN Gd(G.nt(),G.ntau(),G.size1(),G.sig());
+  for(tstp=-1; tstp<=G.nt(); tstp++){
+    Gd.set_timestep(tstp,Gf);
+    err=std::max(err,cntr::distance_norm2(tstp,Gd,G));
+  }
+  return err;
+}
+
+TEST_CASE("Mixed precision","[Mixed_precision]"){
+  const int fermion = -1;
+  const int SolveOrder = 5;
+  const int Ntau = 200;
+  const int Nt = 100;
+  const int Nst = 2;
+  const double dt = 0.02;
+  const double beta = 5.0;
+  const double mu = 0.2;
+  int tstp;
+  double err_float, err_mixed;
+  std::complex<double> I(0.0,1.0);
+  cdmatrix h0(Nst,Nst), h1(Nst,Nst);
+
+  h0(0,0) = -1.0;
+  h0(1,1) = 0.5;
+  h0(0,1) = I*0.3;
+  h0(1,0) = -I*0.3;
+  h1(0,0) = 0.2;
+  h1(1,1) = -0.4;
+  h1(0,1) = 0.7;
+  h1(1,0) = 0.7;
+
+  SECTION ("Convolution"){
+    GREEN A(Nt,Ntau,Nst,fermion), B(Nt,Ntau,Nst,fermion), C(Nt,Ntau,Nst,fermion);
+    GREENF Af(Nt,Ntau,Nst,fermion), Bf(Nt,Ntau,Nst,fermion);
+    GREENF Cf(Nt,Ntau,Nst,fermion), Cm(Nt,Ntau,Nst,fermion);
+
+    cntr::green_from_H(A,mu,h0,beta,dt);
+    cntr::green_from_H(B,mu,h1,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Af.set_timestep(tstp,A);
+      Bf.set_timestep(tstp,B);
+    }
+    for(tstp=-1; tstp<=Nt; tstp++){
+      cntr::convolution_timestep(tstp,C,A,B,beta,dt,SolveOrder);
+      cntr::convolution_timestep(tstp,Cf,Af,Bf,(float)beta,(float)dt,SolveOrder);
+      cntr::convolution_timestep_mixed(tstp,Cm,Af,Bf,beta,dt,SolveOrder);
+    }
+    err_float=precision_test_distance(Cf,C);
+    err_mixed=precision_test_distance(Cm,C);
+    REQUIRE(err_float<1e-3);
+    REQUIRE(err_mixed<1e-4);
+    REQUIRE(err_mixed<err_float);
+  }
+
+  SECTION ("Dyson"){
+    const double lam = 0.5;
+    CFUNC hfunc(Nt,Nst);
+    CFUNCF hfuncf(Nt,Nst);
+    GREEN G(Nt,Ntau,Nst,fermion), Sigma(Nt,Ntau,Nst,fermion);
+    GREENF Gf(Nt,Ntau,Nst,fermion), Sigmaf(Nt,Ntau,Nst,fermion);
+
+    // self-energy of a bath with a time-dependent coupling
+    cntr::green_from_H(Sigma,mu,h1,beta,dt);
+    for(tstp=-1; tstp<=Nt; tstp++){
+      Sigma.smul(tstp,lam*lam);
+      Sigmaf.set_timestep(tstp,Sigma);
+    }
+    hfunc.set_value(-1,h0);
+    hfuncf.set_value(-1,h0);
+    for(tstp=0; tstp<=Nt; tstp++){
+      cdmatrix ht = h0 + sin(2.0*tstp*dt)*h1;
+      hfunc.set_value(tstp,ht);
+      hfuncf.set_value(tstp,ht);
+    }
+    cntr::dyson_mat(G,mu,hfunc,Sigma,beta,SolveOrder);
+    cntr::dyson_start(G,mu,hfunc,Sigma,beta,dt,SolveOrder);
+    for(tstp=-1; tstp<=SolveOrder; tstp++) Gf.set_timestep(tstp,G);
+    for(tstp=SolveOrder+1; tstp<=Nt; tstp++){
+      cntr::dyson_timestep(tstp,G,mu,hfunc,Sigma,beta,dt,SolveOrder);
+      cntr::dyson_timestep(tstp,Gf,(float)mu,hfuncf,Sigmaf,(float)beta,(float)dt,SolveOrder);
+    }
+    // the rounding errors accumulate over the time steps, relative to G they stay ~1e-5
+    err_float=precision_test_distance(Gf,G);
+    REQUIRE(err_float<1e-2);
+  }
+}
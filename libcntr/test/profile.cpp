@@ -0,0 +1,61 @@
+#include "catch.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "cntr.hpp"
+
+using namespace std;
+
+/*///////////////////////////////////////////////////////////////////////////////////////
+
+  Tests of the kernel report: nested scopes are recorded under their path, in total and
+  per time step, and the JSON report lists all kernels. The kernels themselves only
+  record with CNTR_USE_PROFILE, so the scopes are opened explicitly here.
+
+///////////////////////////////////////////////////////////////////////////////////////*/
+
+TEST_CASE("Profile","[profile]"){
+  int tstp;
+  cntr::profile_entry e;
+
+  cntr::profile_reset();
+  for(tstp=0; tstp<3; tstp++){
+    cntr::profile_scope outer("outer",tstp,10.0,100.0);
+    for(int i=0; i<2; i++){
+      cntr::profile_scope inner("inner",tstp,1.0,8.0);
+    }
+  }
+  {
+    cntr::profile_scope io("io",CNTR_PROFILE_NO_TSTP,0.0,64.0);
+  }
+
+  SECTION ("counters"){
+    e=cntr::profile_get("outer");
+    REQUIRE(e.calls==3);
+    REQUIRE(e.flops==30.0);
+    REQUIRE(e.bytes==300.0);
+    REQUIRE(e.time>=0.0);
+    e=cntr::profile_get("outer/inner");
+    REQUIRE(e.calls==6);
+    REQUIRE(e.time<=cntr::profile_get("outer").time);
+    e=cntr::profile_get("outer/inner",1);
+    REQUIRE(e.calls==2);
+    REQUIRE(e.flops==2.0);
+    // not nested: no path prefix, no time steps
+    REQUIRE(cntr::profile_get("inner").calls==0);
+    REQUIRE(cntr::profile_get("io").calls==1);
+    REQUIRE(cntr::profile_get("io",0).calls==0);
+  }
+
+  SECTION ("json"){
+    std::ostringstream out;
+    cntr::profile_write_json(out);
+    std::string json=out.str();
+    REQUIRE(json.find("\"name\": \"outer/inner\"")!=std::string::npos);
+    REQUIRE(json.find("\"name\": \"io\"")!=std::string::npos);
+    REQUIRE(json.find("\"tstp\": 2")!=std::string::npos);
+    cntr::profile_reset();
+    REQUIRE(cntr::profile_get("outer").calls==0);
+  }
+}